@@ -25,6 +25,8 @@
 #include <unordered_map>
 #include <mutex>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -32,6 +34,7 @@ namespace rtps {
 
 class RTPSParticipantImpl;
 class Endpoint;
+class IPayloadPool;
 class RTPSWriter;
 class RTPSReader;
 struct SubmessageHeader_t;
@@ -63,6 +66,18 @@ public:
             const Locator_t& loc,
             CDRMessage_t* msg);
 
+    /**
+     * Process a new CDR message whose buffer is kept alive by a payload pool.
+     * The payloads of DATA submessages are then lent to the readers by that pool, instead of being copied.
+     * @param[in] loc Locator indicating the sending address.
+     * @param[in] msg Pointer to the message
+     * @param[in] payload_owner Pool lending the payloads of the message, or nullptr to copy them.
+     */
+    void processCDRMsg(
+            const Locator_t& loc,
+            CDRMessage_t* msg,
+            IPayloadPool* payload_owner);
+
     // Functions to associate/remove associatedendpoints
     void associateEndpoint(
             Endpoint* to_add);
@@ -74,6 +89,10 @@ private:
     std::mutex mtx_;
     std::vector<RTPSWriter*> associated_writers_;
     std::unordered_map<EntityId_t, std::vector<RTPSReader*>> associated_readers_;
+    //! Associated readers whose matches are not tracked by the participant.
+    std::vector<RTPSReader*> associated_unindexed_readers_;
+    //! Buffer where the readers matched with the writer of a submessage are retrieved.
+    std::vector<std::pair<GUID_t, RTPSReader*>> matched_readers_;
 
     RTPSParticipantImpl* participant_;
     //!Protocol version of the message
@@ -88,6 +107,8 @@ private:
     bool have_timestamp_;
     //!Timestamp associated with the message
     Time_t timestamp_;
+    //!Pool lending the payloads of the message being processed
+    IPayloadPool* payload_owner_;
 
 #if HAVE_SECURITY
     //!Buffer to process the decoded RTPS message
@@ -141,12 +162,22 @@ private:
     /**
      * Find all readers (in associated_readers_), with the given entity ID, and call the
      * callback provided.
+     * When the entity ID is unknown, only the readers that have matched the writer, or that may accept
+     * messages from unknown writers, are considered.
      */
     template<typename Functor>
     void findAllReaders(
             const EntityId_t& readerID,
+            const GUID_t& writerGUID,
             const Functor& callback);
 
+    /**
+     * Check whether a reader is in associated_readers_.
+     */
+    bool isAssociatedReader(
+            const GUID_t& readerGUID,
+            const RTPSReader* reader) const;
+
     /**@name Processing methods.
      * These methods are designed to read a part of the message
      * and perform the corresponding actions:
@@ -50,6 +50,17 @@ public:
     virtual void OnDataReceived(const octet* data, const uint32_t size,
         const Locator_t& localLocator, const Locator_t& remoteLocator) override;
 
+    /**
+    * Method called by the transport when receiving data whose payloads can be referenced after the call.
+    * @param data Pointer to the received data.
+    * @param size Number of bytes received.
+    * @param localLocator Locator identifying the local endpoint.
+    * @param remoteLocator Locator identifying the remote endpoint.
+    * @param payload_owner Pool lending the payloads contained in the data.
+    */
+    virtual void OnSharedDataReceived(const octet* data, const uint32_t size,
+        const Locator_t& localLocator, const Locator_t& remoteLocator, IPayloadPool* payload_owner) override;
+
     /**
      * Reports whether this resource supports the given local locator (i.e., said locator
      * maps to the transport channel managed by this resource).
@@ -21,6 +21,7 @@
 
 #include <thread>
 #include <atomic>
+#include <functional>
 #include <list>
 
 #include <fastdds/rtps/resources/AsyncInterestTree.h>
@@ -73,6 +74,14 @@ public:
         RTPSWriter* interested_writer,
         const std::chrono::time_point<std::chrono::steady_clock>& max_blocking_time);
 
+    /*!
+     * Sets a function to be called every time the thread has processed all the interested writers.
+     * @param callback Function to call, or an empty function to call nothing.
+     * @note Should be called before any writer wakes the thread up.
+     */
+    void set_run_finished_callback(
+        std::function<void()> callback);
+
 private:
 
     AsyncWriterThread(const AsyncWriterThread&) = delete;
@@ -90,6 +99,9 @@ private:
     bool running_ = false;
     bool run_scheduled_ = false;
     TimedConditionVariable cv_;
+
+    //! Called after each round of sends.
+    std::function<void()> run_finished_callback_;
 };
 
 } // namespace rtps
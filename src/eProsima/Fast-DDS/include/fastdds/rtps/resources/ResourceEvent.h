@@ -27,6 +27,7 @@
 
 #include <thread>
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace eprosima {
@@ -34,16 +35,18 @@ namespace fastrtps {
 namespace rtps {
 
 class TimedEventImpl;
+class TimerWheel;
 
 /**
  * This class centralizes all operations over timed events in the same thread.
+ * Scheduled events are kept on a hierarchical timer wheel, so starting and cancelling them is O(1).
  * @ingroup MANAGEMENT_MODULE
  */
 class ResourceEvent
 {
 public:
 
-    ResourceEvent() = default;
+    ResourceEvent();
 
     ~ResourceEvent();
 
@@ -117,8 +120,11 @@ private:
     //! Collection of events pending update action.
     std::vector<TimedEventImpl*> pending_timers_;
 
-    //! Collection of registered events waiting completion.
-    std::vector<TimedEventImpl*> active_timers_;
+    //! Registered events waiting completion.
+    std::unique_ptr<TimerWheel> active_timers_;
+
+    //! Collection of events being triggered by the execution thread.
+    std::vector<TimedEventImpl*> due_timers_;
 
     //! Current time as seen by the execution thread.
     std::chrono::steady_clock::time_point current_time_;
@@ -138,9 +144,6 @@ private:
     //! Method called by the internal thread.
     void event_service();
 
-    //! Sorts waiting timers in ascending order of trigger time.
-    void sort_timers();
-
     //! Updates internal register of current time.
     void update_current_time();
 
@@ -151,7 +154,7 @@ private:
     void resize_collections()
     {
         pending_timers_.reserve(timers_count_);
-        active_timers_.reserve(timers_count_);
+        due_timers_.reserve(timers_count_);
     }
 
 };
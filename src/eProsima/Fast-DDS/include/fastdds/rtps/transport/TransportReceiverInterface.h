@@ -16,6 +16,7 @@
 #define _FASTDDS_TRANSPORT_RECEIVER_INTERFACE_H
 
 #include <fastdds/rtps/common/Locator.h>
+#include <fastdds/rtps/history/IPayloadPool.h>
 
 namespace eprosima {
 namespace fastdds {
@@ -40,6 +41,23 @@ public:
      */
     virtual void OnDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
         const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator) = 0;
+
+    /**
+     * Method to be called by the transport when receiving data held in a buffer that can outlive the call.
+     * The payloads contained in the data can then be referenced by the readers, instead of being copied.
+     * @param data Pointer to the received data.
+     * @param size Number of bytes received.
+     * @param localLocator Locator identifying the local endpoint.
+     * @param remote_locator Locator identifying the remote endpoint.
+     * @param payload_owner Pool lending the payloads contained in the data.
+     */
+    virtual void OnSharedDataReceived(const fastrtps::rtps::octet* data, const uint32_t size,
+        const fastrtps::rtps::Locator_t& localLocator, const fastrtps::rtps::Locator_t& remote_locator,
+        fastrtps::rtps::IPayloadPool* payload_owner)
+    {
+        (void)payload_owner;
+        OnDataReceived(data, size, localLocator, remote_locator);
+    }
 };
 
 } // namespace rtps
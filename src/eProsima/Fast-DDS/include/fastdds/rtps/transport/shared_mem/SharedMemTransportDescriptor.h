@@ -30,6 +30,15 @@ class TransportInterface;
  */
 typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterface
 {
+    //! Algorithms to allocate the buffers of the shared memory segment
+    enum class SegmentAllocator : uint8_t
+    {
+        //! General purpose best-fit allocator. Uses an interprocess mutex.
+        BEST_FIT,
+        //! Lock-free allocator using power of two size classes. Reserves up to twice the segment size.
+        SLAB
+    };
+
     virtual ~SharedMemTransportDescriptor()
     {
 
@@ -101,12 +110,59 @@ typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterfac
         rtps_dump_file_ = rtps_dump_file;
     }
 
+    RTPS_DllAPI uint32_t listener_spin_time_us() const
+    {
+        return listener_spin_time_us_;
+    }
+
+    /**
+     * Sets how long the listeners poll an empty port before blocking on it.
+     * Spinning trades CPU time for lower latency, as no wake-up is needed for the data received meanwhile.
+     * @param listener_spin_time_us Time in microseconds. Zero, the default, makes listeners block at once.
+     */
+    RTPS_DllAPI void listener_spin_time_us(
+            uint32_t listener_spin_time_us)
+    {
+        listener_spin_time_us_ = listener_spin_time_us;
+    }
+
+    RTPS_DllAPI uint32_t payload_reference_threshold() const
+    {
+        return payload_reference_threshold_;
+    }
+
+    /**
+     * Sets the size from which received payloads are referenced by the readers, instead of copied to their histories.
+     * Referenced payloads keep the sender's buffer in use while the sample is in the reader history,
+     * so senders may need bigger segments.
+     * @param payload_reference_threshold Size in bytes. Zero, the default, makes readers always copy the payloads.
+     */
+    RTPS_DllAPI void payload_reference_threshold(
+            uint32_t payload_reference_threshold)
+    {
+        payload_reference_threshold_ = payload_reference_threshold;
+    }
+
+    RTPS_DllAPI SegmentAllocator segment_allocator() const
+    {
+        return segment_allocator_;
+    }
+
+    RTPS_DllAPI void segment_allocator(
+            SegmentAllocator segment_allocator)
+    {
+        segment_allocator_ = segment_allocator;
+    }
+
 private:
 
     uint32_t segment_size_;
     uint32_t port_queue_capacity_;
     uint32_t healthy_check_timeout_ms_;
     std::string rtps_dump_file_;
+    SegmentAllocator segment_allocator_;
+    uint32_t listener_spin_time_us_;
+    uint32_t payload_reference_threshold_;
 
 }SharedMemTransportDescriptor;
 
@@ -162,10 +162,16 @@ public:
             const SequenceNumber_t& max_seq,
             BinaryFunction f) const
     {
-        if (!changes_for_reader_.empty())
+        if (0 == changes_by_status_[UNSENT] && !has_holes_before(max_seq))
+        {
+            // Nothing to inform
+            return;
+        }
+
+        if (has_changes())
         {
             SequenceNumber_t current_seq = changes_low_mark_ + 1;
-            ChangeConstIterator it = changes_for_reader_.begin();
+            ChangeConstIterator it = changes_begin();
             while (it != changes_for_reader_.end())
             {
                 // Holes before this change are informed as irrelevant.
@@ -439,9 +445,82 @@ private:
 
     SequenceNumber_t changes_low_mark_;
 
+    //! Number of changes at the beginning of changes_for_reader_ already acknowledged but still not erased.
+    size_t acked_changes_count_;
+    //! Number of changes on changes_for_reader_ (excluding the acknowledged ones) on each status.
+    uint32_t changes_by_status_[UNDERWAY + 1];
+
     using ChangeIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::iterator;
     using ChangeConstIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::const_iterator;
 
+    //! @return Iterator pointing to the first change not acknowledged.
+    ChangeIterator changes_begin()
+    {
+        return changes_for_reader_.begin() + acked_changes_count_;
+    }
+
+    //! @return Iterator pointing to the first change not acknowledged.
+    ChangeConstIterator changes_begin() const
+    {
+        return changes_for_reader_.begin() + acked_changes_count_;
+    }
+
+    //! @return Number of changes not acknowledged.
+    size_t changes_size() const
+    {
+        return changes_for_reader_.size() - acked_changes_count_;
+    }
+
+    /**
+     * Check if there are sequence numbers without a change between the low mark and a given sequence number.
+     * @param max_seq Maximum sequence number to be considered without including it.
+     * @return true if there are holes.
+     */
+    bool has_holes_before(
+            const SequenceNumber_t& max_seq) const
+    {
+        if (!has_changes())
+        {
+            return changes_low_mark_ + 1 < max_seq;
+        }
+
+        // Changes are sorted and unique, so there are no holes when they are consecutive up to max_seq.
+        const SequenceNumber_t& last_seq = changes_for_reader_.back().getSequenceNumber();
+        return last_seq >= max_seq ||
+               changes_low_mark_ + static_cast<uint32_t>(changes_size()) != last_seq ||
+               last_seq + 1 != max_seq;
+    }
+
+    /**
+     * Change the status of a change, keeping changes_by_status_ updated.
+     * @param change Change to update.
+     * @param status New status.
+     */
+    void set_change_status(
+            ChangeForReader_t& change,
+            ChangeForReaderStatus_t status)
+    {
+        --changes_by_status_[change.getStatus()];
+        ++changes_by_status_[status];
+        change.setStatus(status);
+    }
+
+    /**
+     * Consider acknowledged all the changes before a given one.
+     * They are only erased from changes_for_reader_ when there are as many acknowledged changes as not acknowledged
+     * ones, so the cost of erasing them does not depend on the number of changes pending.
+     * @param first_not_acked Iterator pointing to the first change not acknowledged.
+     */
+    void erase_acked_changes(
+            ChangeIterator first_not_acked);
+
+    //! Erase the acknowledged changes from changes_for_reader_.
+    void compact_changes();
+
+    //! Erase a change not acknowledged from changes_for_reader_.
+    void erase_change(
+            ChangeIterator change);
+
     void disable_timers();
 
     /*
@@ -28,6 +28,12 @@
 #include <fastrtps/qos/LivelinessLostStatus.h>
 
 namespace eprosima {
+namespace fastdds {
+namespace rtps {
+class IReaderDataFilter;
+} // namespace rtps
+} // namespace fastdds
+
 namespace fastrtps {
 
 namespace rtps {
@@ -173,6 +179,15 @@ public:
     void get_liveliness_lost_status(
             LivelinessLostStatus& status);
 
+    /**
+     * Set the filter deciding which changes are sent to each matched reader.
+     * Only reliable publishers use it, best effort ones send all changes to all readers.
+     * @param filter The filter, which must outlive the publisher, or nullptr to send all changes to all readers.
+     * @return True if the filter is used, false if the publisher is best effort.
+     */
+    bool reader_data_filter(
+            fastdds::rtps::IReaderDataFilter* filter);
+
 private:
 
     PublisherImpl* mp_impl;
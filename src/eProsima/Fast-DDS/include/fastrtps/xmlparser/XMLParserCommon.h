@@ -81,6 +81,11 @@ extern const char* HEALTHY_CHECK_TIMEOUT_MS;
 extern const char* DISCARD;
 extern const char* FAIL;
 extern const char* RTPS_DUMP_FILE;
+extern const char* SEGMENT_ALLOCATOR;
+extern const char* BEST_FIT;
+extern const char* SLAB;
+extern const char* LISTENER_SPIN_TIME_US;
+extern const char* PAYLOAD_REFERENCE_THRESHOLD;
 
 // IntraprocessDeliveryType
 extern const char* OFF;
@@ -105,6 +105,12 @@ bool Publisher::updateAttributes(
     return mp_impl->updateAttributes(att);
 }
 
+bool Publisher::reader_data_filter(
+        fastdds::rtps::IReaderDataFilter* filter)
+{
+    return mp_impl->reader_data_filter(filter);
+}
+
 void Publisher::get_offered_deadline_missed_status(
         OfferedDeadlineMissedStatus& status)
 {
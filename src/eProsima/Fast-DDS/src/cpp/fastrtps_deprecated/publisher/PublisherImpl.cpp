@@ -662,6 +662,21 @@ void PublisherImpl::assert_liveliness()
     }
 }
 
+bool PublisherImpl::reader_data_filter(
+        fastdds::rtps::IReaderDataFilter* filter)
+{
+    // Stateless writers send each change to all their locators at once
+    StatefulWriter* stateful_writer = dynamic_cast<StatefulWriter*>(mp_writer);
+    if (stateful_writer == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<RecursiveTimedMutex> lock(mp_writer->getMutex());
+    stateful_writer->reader_data_filter(filter);
+    return true;
+}
+
 std::shared_ptr<rtps::IPayloadPool> PublisherImpl::payload_pool()
 {
     return payload_pool_;
@@ -37,6 +37,12 @@
 #include <rtps/history/ITopicPayloadPool.h>
 
 namespace eprosima {
+namespace fastdds {
+namespace rtps {
+class IReaderDataFilter;
+} // namespace rtps
+} // namespace fastdds
+
 namespace fastrtps {
 namespace rtps {
 class RTPSWriter;
@@ -194,6 +200,14 @@ public:
      */
     void assert_liveliness();
 
+    /**
+     * @brief Set the filter deciding which changes are sent to each matched reader
+     * @param filter The filter, or nullptr to send all changes to all readers
+     * @return True if the filter is used, false if the writer is stateless
+     */
+    bool reader_data_filter(
+            fastdds::rtps::IReaderDataFilter* filter);
+
     std::shared_ptr<rtps::IPayloadPool> payload_pool();
 
 private:
@@ -0,0 +1,49 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ILendingPayloadPool.hpp
+ */
+
+#ifndef RTPS_HISTORY_ILENDINGPAYLOADPOOL_HPP
+#define RTPS_HISTORY_ILENDINGPAYLOADPOOL_HPP
+
+#include <fastdds/rtps/history/IPayloadPool.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * A pool for payloads that live in buffers owned by someone else, usually a transport,
+ * and that can be kept alive after the reception has finished.
+ *
+ * When a received change is owned by one of these pools, readers ask it to share the payload with their own changes,
+ * instead of having their pools copy it.
+ * The pool cannot create new payloads, so @c get_payload(uint32_t, CacheChange_t&) always fails,
+ * and @c get_payload(SerializedPayload_t&, IPayloadPool*&, CacheChange_t&) fails for data it does not hold.
+ * In both cases the reader falls back to its own pool.
+ */
+class ILendingPayloadPool : public IPayloadPool
+{
+public:
+
+    virtual ~ILendingPayloadPool() = default;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif  // RTPS_HISTORY_ILENDINGPAYLOADPOOL_HPP
@@ -0,0 +1,197 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MatchedReadersIndex.hpp
+ */
+
+#ifndef _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
+#define _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
+
+#include <fastdds/rtps/common/Guid.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSReader;
+
+/**
+ * Index of the local readers that have matched each remote writer.
+ *
+ * It is kept up to date by the readers when they match or unmatch a writer, and used by MessageReceiver to deliver
+ * submessages not directed to a specific reader only to the readers interested on their writer.
+ * Readers are stored together with their GUID, so entries can be validated without dereferencing the reader.
+ * All methods are thread safe, and no other lock is taken while the internal one is held.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class MatchedReadersIndex
+{
+public:
+
+    //! A reader that has matched a writer, given by its GUID and a pointer to it.
+    using Entry = std::pair<GUID_t, RTPSReader*>;
+
+    using EntryList = std::vector<Entry>;
+
+    /**
+     * Whether the matches of a reader are tracked by the index.
+     * Builtin and vendor specific readers may accept data from writers they have not matched, so they are not
+     * tracked and should be checked on every submessage.
+     * @param reader_guid GUID of the reader.
+     * @return true if the reader is a user defined one.
+     */
+    static bool is_indexed(
+            const GUID_t& reader_guid)
+    {
+        return 0 == (reader_guid.entityId.value[3] & 0xC0);
+    }
+
+    /**
+     * Register a match between a reader and a writer.
+     * @param writer_guid GUID of the matched writer.
+     * @param reader_guid GUID of the reader.
+     * @param reader Pointer to the reader.
+     */
+    void add(
+            const GUID_t& writer_guid,
+            const GUID_t& reader_guid,
+            RTPSReader* reader)
+    {
+        if (!is_indexed(reader_guid))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        EntryList& readers = readers_by_writer_[writer_guid];
+        auto it = std::find_if(readers.begin(), readers.end(), [reader](const Entry& entry)
+                        {
+                            return entry.second == reader;
+                        });
+        if (it == readers.end())
+        {
+            readers.emplace_back(reader_guid, reader);
+        }
+    }
+
+    /**
+     * Unregister a match between a reader and a writer.
+     * @param writer_guid GUID of the unmatched writer.
+     * @param reader Pointer to the reader.
+     */
+    void remove(
+            const GUID_t& writer_guid,
+            RTPSReader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto readers = readers_by_writer_.find(writer_guid);
+        if (readers != readers_by_writer_.end())
+        {
+            remove_entry(readers->second, reader);
+            if (readers->second.empty())
+            {
+                readers_by_writer_.erase(readers);
+            }
+        }
+    }
+
+    /**
+     * Unregister all the matches of a reader.
+     * This has to be called before the reader is destroyed.
+     * @param reader Pointer to the reader.
+     */
+    void remove_reader(
+            RTPSReader* reader)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto it = readers_by_writer_.begin(); it != readers_by_writer_.end();)
+        {
+            remove_entry(it->second, reader);
+            if (it->second.empty())
+            {
+                it = readers_by_writer_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * Retrieve the readers that have matched a writer.
+     * @param writer_guid GUID of the writer.
+     * @param [out] readers List where the matched readers are copied. Previous contents are discarded.
+     */
+    void get_readers(
+            const GUID_t& writer_guid,
+            EntryList& readers) const
+    {
+        readers.clear();
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = readers_by_writer_.find(writer_guid);
+        if (it != readers_by_writer_.end())
+        {
+            readers.assign(it->second.begin(), it->second.end());
+        }
+    }
+
+private:
+
+    struct GuidHash
+    {
+        std::size_t operator ()(
+                const GUID_t& guid) const
+        {
+            // The participant id and the entity key are enough to tell most GUIDs apart.
+            uint32_t prefix_low;
+            uint32_t entity;
+            memcpy(&prefix_low, &guid.guidPrefix.value[8], sizeof(prefix_low));
+            memcpy(&entity, guid.entityId.value, sizeof(entity));
+            return (static_cast<std::size_t>(prefix_low) * 31u) ^ entity;
+        }
+
+    };
+
+    static void remove_entry(
+            EntryList& readers,
+            RTPSReader* reader)
+    {
+        readers.erase(
+            std::remove_if(readers.begin(), readers.end(), [reader](const Entry& entry)
+            {
+                return entry.second == reader;
+            }),
+            readers.end());
+    }
+
+    mutable std::mutex mutex_;
+
+    std::unordered_map<GUID_t, EntryList, GuidHash> readers_by_writer_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_MESSAGES_MATCHEDREADERSINDEX_HPP_
@@ -0,0 +1,372 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MessageAggregator.hpp
+ */
+
+#ifndef _RTPS_MESSAGES_MESSAGEAGGREGATOR_HPP_
+#define _RTPS_MESSAGES_MESSAGEAGGREGATOR_HPP_
+
+#include <fastdds/rtps/common/CDRMessage_t.h>
+#include <fastdds/rtps/common/Locator.h>
+#include <fastdds/rtps/messages/RTPS_messages.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Coalesces the RTPS messages sent by the different writers of a participant into bigger datagrams.
+ *
+ * Messages are kept per destination locator until flush() is called or the byte budget is exceeded.
+ * Every message added to the datagram of a locator drops its RTPS header, which should be the same for all of them.
+ * The interpreter state a message relies on (destination and timestamp) is preserved when concatenating:
+ * a datagram with a destination set is flushed before adding a message that does not set its own, and a timestamp is
+ * invalidated before adding a message that does not set its own.
+ * Messages that cannot be safely concatenated are sent right away, after flushing what was pending for the locator.
+ *
+ * All methods are thread safe. The send function is called with the internal lock held.
+ * @ingroup WRITER_MODULE
+ */
+class MessageAggregator
+{
+public:
+
+    using SendFunction = std::function<void (
+                const octet* data,
+                uint32_t length,
+                const Locator_t& locator,
+                const std::chrono::steady_clock::time_point& max_blocking_time_point)>;
+
+    //! Counters used to know the benefit of the aggregation.
+    struct Statistics
+    {
+        //! Number of times a message was added for a locator.
+        uint64_t messages_added = 0;
+        //! Number of datagrams actually sent.
+        uint64_t datagrams_sent = 0;
+    };
+
+    /**
+     * @param max_bytes Maximum size of the datagrams built.
+     * @param send Function used to send a datagram to a locator.
+     */
+    MessageAggregator(
+            uint32_t max_bytes,
+            SendFunction send)
+        : max_bytes_(max_bytes)
+        , send_(send)
+    {
+    }
+
+    /**
+     * Adds a message for a list of locators.
+     * @param msg Message to add. It should contain the RTPS header.
+     * @param destination_locators_begin Iterator at the first destination locator.
+     * @param destination_locators_end Iterator at the end destination locator.
+     * @param max_blocking_time_point Time limit for the sends this call may need to perform.
+     * @return true if there are datagrams pending, i.e. a flush should be scheduled.
+     */
+    template<class LocatorIteratorT>
+    bool add(
+            const CDRMessage_t& msg,
+            const LocatorIteratorT& destination_locators_begin,
+            const LocatorIteratorT& destination_locators_end,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point)
+    {
+        MessageInfo info;
+        bool aggregatable = analyze(msg, info);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        LocatorIteratorT it = destination_locators_begin;
+        while (it != destination_locators_end)
+        {
+            const Locator_t& locator = *it;
+            ++statistics_.messages_added;
+
+            if (aggregatable)
+            {
+                append(find_destination(locator, true), msg, info, max_blocking_time_point);
+            }
+            else
+            {
+                Destination* destination = find_destination(locator, false);
+                if (destination != nullptr)
+                {
+                    flush(*destination, max_blocking_time_point);
+                }
+                send(msg.buffer, msg.length, locator, max_blocking_time_point);
+            }
+
+            ++it;
+        }
+
+        return 0 < pending_destinations_;
+    }
+
+    /**
+     * Sends all the pending datagrams.
+     * Locators that had nothing pending since the previous flush are forgotten.
+     * @param max_blocking_time_point Time limit for the sends.
+     */
+    void flush(
+            const std::chrono::steady_clock::time_point& max_blocking_time_point)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        auto it = destinations_.begin();
+        while (it != destinations_.end())
+        {
+            if (it->used)
+            {
+                flush(*it, max_blocking_time_point);
+                it->used = false;
+                ++it;
+            }
+            else
+            {
+                it = destinations_.erase(it);
+            }
+        }
+    }
+
+    Statistics statistics() const
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return statistics_;
+    }
+
+    uint32_t max_bytes() const
+    {
+        return max_bytes_;
+    }
+
+private:
+
+    //! What needs to be known about the submessages of a message.
+    struct MessageInfo
+    {
+        //! Whether an INFO_DST comes before the first entity submessage.
+        bool starts_with_dst = false;
+        //! Whether an INFO_TS comes before the first entity submessage.
+        bool starts_with_ts = false;
+        //! Whether the message contains an INFO_DST.
+        bool sets_dst = false;
+        //! Whether there is a valid timestamp at the end of the message.
+        bool ts_valid_at_end = false;
+    };
+
+    //! Datagram being built for a locator.
+    struct Destination
+    {
+        explicit Destination(
+                const Locator_t& loc)
+            : locator(loc)
+        {
+        }
+
+        Locator_t locator;
+        std::vector<octet> buffer;
+        //! The destination of the submessages in buffer has been set.
+        bool dst_set = false;
+        //! There is a valid timestamp at the end of buffer.
+        bool ts_valid = false;
+        //! Something was added since the last flush cycle.
+        bool used = true;
+    };
+
+    /**
+     * Parses the submessages of a message.
+     * @return false if the message should not be concatenated with others.
+     */
+    bool analyze(
+            const CDRMessage_t& msg,
+            MessageInfo& info) const
+    {
+        if (msg.length <= RTPSMESSAGE_HEADER_SIZE || msg.length > max_bytes_ || (msg.length % 4) != 0)
+        {
+            return false;
+        }
+
+        bool leading = true;
+        uint32_t pos = RTPSMESSAGE_HEADER_SIZE;
+        while (pos < msg.length)
+        {
+            if (msg.length - pos < RTPSMESSAGE_SUBMESSAGEHEADER_SIZE)
+            {
+                return false;
+            }
+
+            octet id = msg.buffer[pos];
+            octet flags = msg.buffer[pos + 1];
+            uint16_t length = (flags & 0x01) ?
+                    static_cast<uint16_t>(msg.buffer[pos + 2] | (msg.buffer[pos + 3] << 8)) :
+                    static_cast<uint16_t>((msg.buffer[pos + 2] << 8) | msg.buffer[pos + 3]);
+            pos += RTPSMESSAGE_SUBMESSAGEHEADER_SIZE;
+
+            switch (id)
+            {
+                case INFO_DST:
+                    info.sets_dst = true;
+                    info.starts_with_dst |= leading;
+                    break;
+                case INFO_TS:
+                    info.ts_valid_at_end = (0 == (flags & 0x02));
+                    info.starts_with_ts |= leading;
+                    break;
+                case PAD:
+                    break;
+                case ACKNACK:
+                case HEARTBEAT:
+                case GAP:
+                case NACK_FRAG:
+                case HEARTBEAT_FRAG:
+                case DATA:
+                case DATA_FRAG:
+                    // A zero length means the submessage extends to the end of the message.
+                    if (0 == length)
+                    {
+                        return false;
+                    }
+                    leading = false;
+                    break;
+                default:
+                    // Submessages that change the source or the reply locators are not concatenated.
+                    return false;
+            }
+
+            if (length % 4 != 0 || length > msg.length - pos)
+            {
+                return false;
+            }
+            pos += length;
+        }
+
+        return true;
+    }
+
+    Destination* find_destination(
+            const Locator_t& locator,
+            bool create)
+    {
+        for (Destination& destination : destinations_)
+        {
+            if (destination.locator == locator)
+            {
+                return &destination;
+            }
+        }
+
+        if (!create)
+        {
+            return nullptr;
+        }
+
+        destinations_.emplace_back(locator);
+        destinations_.back().buffer.reserve(max_bytes_);
+        return &destinations_.back();
+    }
+
+    void append(
+            Destination* destination,
+            const CDRMessage_t& msg,
+            const MessageInfo& info,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point)
+    {
+        std::vector<octet>& buffer = destination->buffer;
+        destination->used = true;
+
+        if (!buffer.empty())
+        {
+            // INFO_TS with the invalidate flag, which has no timestamp.
+            const octet invalidate_ts[RTPSMESSAGE_SUBMESSAGEHEADER_SIZE] = { INFO_TS, 0x03, 0x00, 0x00 };
+            bool needs_ts_reset = destination->ts_valid && !info.starts_with_ts;
+            size_t new_size = buffer.size() + (msg.length - RTPSMESSAGE_HEADER_SIZE) +
+                    (needs_ts_reset ? sizeof(invalidate_ts) : 0);
+
+            if (new_size > max_bytes_ ||
+                    (destination->dst_set && !info.starts_with_dst) ||
+                    0 != memcmp(buffer.data(), msg.buffer, RTPSMESSAGE_HEADER_SIZE))
+            {
+                flush(*destination, max_blocking_time_point);
+            }
+            else
+            {
+                if (needs_ts_reset)
+                {
+                    buffer.insert(buffer.end(), invalidate_ts, invalidate_ts + sizeof(invalidate_ts));
+                }
+                buffer.insert(buffer.end(), msg.buffer + RTPSMESSAGE_HEADER_SIZE, msg.buffer + msg.length);
+                destination->dst_set |= info.sets_dst;
+                destination->ts_valid = info.ts_valid_at_end;
+                return;
+            }
+        }
+
+        buffer.assign(msg.buffer, msg.buffer + msg.length);
+        destination->dst_set = info.sets_dst;
+        destination->ts_valid = info.ts_valid_at_end;
+        ++pending_destinations_;
+    }
+
+    void flush(
+            Destination& destination,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point)
+    {
+        if (!destination.buffer.empty())
+        {
+            send(destination.buffer.data(), static_cast<uint32_t>(destination.buffer.size()), destination.locator,
+                    max_blocking_time_point);
+            destination.buffer.clear();
+            --pending_destinations_;
+        }
+    }
+
+    void send(
+            const octet* data,
+            uint32_t length,
+            const Locator_t& locator,
+            const std::chrono::steady_clock::time_point& max_blocking_time_point)
+    {
+        ++statistics_.datagrams_sent;
+        send_(data, length, locator, max_blocking_time_point);
+    }
+
+    const uint32_t max_bytes_;
+
+    SendFunction send_;
+
+    mutable std::mutex mutex_;
+
+    std::vector<Destination> destinations_;
+
+    //! Number of destinations with a non-empty datagram.
+    size_t pending_destinations_ = 0;
+
+    Statistics statistics_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_MESSAGES_MESSAGEAGGREGATOR_HPP_
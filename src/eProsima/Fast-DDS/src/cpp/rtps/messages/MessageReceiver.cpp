@@ -25,8 +25,10 @@
 #include <fastdds/rtps/writer/RTPSWriter.h>
 
 #include <fastdds/core/policy/ParameterList.hpp>
+#include <rtps/messages/MatchedReadersIndex.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 #include <mutex>
@@ -51,6 +53,7 @@ MessageReceiver::MessageReceiver(
     , dest_guid_prefix_(c_GuidPrefix_Unknown)
     , have_timestamp_(false)
     , timestamp_(c_TimeInvalid)
+    , payload_owner_(nullptr)
 #if HAVE_SECURITY
     , crypto_msg_(participant->is_secure() ? rec_buffer_size : 0)
     , crypto_submsg_(participant->is_secure() ? rec_buffer_size : 0)
@@ -106,6 +109,7 @@ MessageReceiver::~MessageReceiver()
     logInfo(RTPS_MSG_IN, "");
     assert(associated_writers_.empty());
     assert(associated_readers_.empty());
+    assert(associated_unindexed_readers_.empty());
 }
 
  #if HAVE_SECURITY
@@ -148,7 +152,7 @@ void MessageReceiver::process_data_message_with_security(
                 std::swap(change.serializedPayload.length, crypto_payload_.length);
             };
 
-    findAllReaders(reader_id, process_message);
+    findAllReaders(reader_id, change.writerGUID, process_message);
 }
 
 void MessageReceiver::process_data_fragment_message_with_security(
@@ -185,7 +189,7 @@ void MessageReceiver::process_data_fragment_message_with_security(
                 std::swap(change.serializedPayload.length, crypto_payload_.length);
             };
 
-    findAllReaders(reader_id, process_message);
+    findAllReaders(reader_id, change.writerGUID, process_message);
 }
 
 #endif // if HAVE SECURITY
@@ -199,7 +203,7 @@ void MessageReceiver::process_data_message_without_security(
                 reader->processDataMsg(&change);
             };
 
-    findAllReaders(reader_id, process_message);
+    findAllReaders(reader_id, change.writerGUID, process_message);
 }
 
 void MessageReceiver::process_data_fragment_message_without_security(
@@ -214,7 +218,7 @@ void MessageReceiver::process_data_fragment_message_without_security(
                 reader->processDataFragMsg(&change, sample_size, fragment_starting_num, fragments_in_submessage);
             };
 
-    findAllReaders(reader_id, process_message);
+    findAllReaders(reader_id, change.writerGUID, process_message);
 }
 
 void MessageReceiver::associateEndpoint(
@@ -258,6 +262,11 @@ void MessageReceiver::associateEndpoint(
 
             readers->second.push_back(reader);
         }
+
+        if (!MatchedReadersIndex::is_indexed(reader->getGuid()))
+        {
+            associated_unindexed_readers_.push_back(reader);
+        }
     }
 }
 
@@ -296,6 +305,10 @@ void MessageReceiver::removeEndpoint(
                     break;
                 }
             }
+
+            associated_unindexed_readers_.erase(
+                std::remove(associated_unindexed_readers_.begin(), associated_unindexed_readers_.end(), var),
+                associated_unindexed_readers_.end());
         }
     }
 }
@@ -313,6 +326,14 @@ void MessageReceiver::reset()
 void MessageReceiver::processCDRMsg(
         const Locator_t& loc,
         CDRMessage_t* msg)
+{
+    processCDRMsg(loc, msg, nullptr);
+}
+
+void MessageReceiver::processCDRMsg(
+        const Locator_t& loc,
+        CDRMessage_t* msg,
+        IPayloadPool* payload_owner)
 {
     (void)loc;
 
@@ -324,6 +345,15 @@ void MessageReceiver::processCDRMsg(
 
     reset();
 
+    payload_owner_ = payload_owner;
+#if HAVE_SECURITY
+    if (participant_->is_secure())
+    {
+        // Payloads may be decoded into temporary buffers, so they are always copied
+        payload_owner_ = nullptr;
+    }
+#endif // if HAVE_SECURITY
+
     GuidPrefix_t participantGuidPrefix = participant_->getGuid().guidPrefix;
     dest_guid_prefix_ = participantGuidPrefix;
 
@@ -634,9 +664,19 @@ bool MessageReceiver::willAReaderAcceptMsgDirectedTo(
     return false;
 }
 
+bool MessageReceiver::isAssociatedReader(
+        const GUID_t& readerGUID,
+        const RTPSReader* reader) const
+{
+    const auto readers = associated_readers_.find(readerGUID.entityId);
+    return readers != associated_readers_.end() &&
+           std::find(readers->second.begin(), readers->second.end(), reader) != readers->second.end();
+}
+
 template<typename Functor>
 void MessageReceiver::findAllReaders(
         const EntityId_t& readerID,
+        const GUID_t& writerGUID,
         const Functor& callback)
 {
     if (readerID != c_EntityId_Unknown)
@@ -652,14 +692,23 @@ void MessageReceiver::findAllReaders(
     }
     else
     {
-        for (const auto& readers : associated_readers_)
+        // Builtin readers may accept messages from writers they have not matched
+        for (const auto& it : associated_unindexed_readers_)
         {
-            for (const auto& it : readers.second)
+            if (it->m_acceptMessagesToUnknownReaders)
             {
-                if (it->m_acceptMessagesToUnknownReaders)
-                {
-                    callback(it);
-                }
+                callback(it);
+            }
+        }
+
+        // User readers only accept messages from matched writers.
+        // Readers are checked to be associated before using them, as they could have been removed.
+        participant_->matched_readers_index().get_readers(writerGUID, matched_readers_);
+        for (const auto& it : matched_readers_)
+        {
+            if (isAssociatedReader(it.first, it.second) && it.second->m_acceptMessagesToUnknownReaders)
+            {
+                callback(it.second);
             }
         }
     }
@@ -775,6 +824,13 @@ bool MessageReceiver::proc_Submsg_Data(
                 ch.serializedPayload.length = payload_size;
                 ch.serializedPayload.max_size = payload_size;
                 msg->pos = next_pos;
+
+                if (nullptr != payload_owner_)
+                {
+                    // Take a reference on the payload, so the readers can share it instead of copying it
+                    IPayloadPool* data_owner = nullptr;
+                    payload_owner_->get_payload(ch.serializedPayload, data_owner, ch);
+                }
             }
             else
             {
@@ -1036,7 +1092,7 @@ bool MessageReceiver::proc_Submsg_Heartbeat(
 
     std::lock_guard<std::mutex> guard(mtx_);
     //Look for the correct reader and writers:
-    findAllReaders(readerGUID.entityId,
+    findAllReaders(readerGUID.entityId, writerGUID,
             [&writerGUID, &HBCount, &firstSN, &lastSN, finalFlag, livelinessFlag](RTPSReader* reader)
             {
                 reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
@@ -1121,7 +1177,7 @@ bool MessageReceiver::proc_Submsg_Gap(
     }
 
     std::lock_guard<std::mutex> guard(mtx_);
-    findAllReaders(readerGUID.entityId,
+    findAllReaders(readerGUID.entityId, writerGUID,
             [&writerGUID, &gapStart, &gapList](RTPSReader* reader)
             {
                 reader->processGapMsg(writerGUID, gapStart, gapList);
@@ -102,6 +102,16 @@ void ReceiverResource::OnDataReceived(
         const uint32_t size,
         const Locator_t& localLocator,
         const Locator_t& remoteLocator)
+{
+    OnSharedDataReceived(data, size, localLocator, remoteLocator, nullptr);
+}
+
+void ReceiverResource::OnSharedDataReceived(
+        const octet* data,
+        const uint32_t size,
+        const Locator_t& localLocator,
+        const Locator_t& remoteLocator,
+        IPayloadPool* payload_owner)
 {
     (void)localLocator;
 
@@ -118,7 +128,7 @@ void ReceiverResource::OnDataReceived(
         msg.reserved_size = size;
 
         // TODO: Should we unlock in case UnregisterReceiver is called from callback ?
-        rcv->processCDRMsg(remoteLocator, &msg);
+        rcv->processCDRMsg(remoteLocator, &msg, payload_owner);
     }
 
 }
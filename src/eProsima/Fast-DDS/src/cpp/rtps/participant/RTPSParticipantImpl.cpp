@@ -339,6 +339,8 @@ namespace eprosima
                 }
 #endif // if HAVE_SECURITY
 
+                create_message_aggregator();
+
                 mp_builtinProtocols = new BuiltinProtocols();
 
                 if (c_GuidPrefix_Unknown != persistence_guid)
@@ -420,10 +422,94 @@ namespace eprosima
                 return m_allReaderList;
             }
 
+            void RTPSParticipantImpl::create_message_aggregator()
+            {
+#if HAVE_SECURITY
+                // Protected messages cannot be concatenated.
+                if (m_is_security_active)
+                {
+                    return;
+                }
+#endif // if HAVE_SECURITY
+
+                const std::string *window_property = PropertyPolicyHelper::find_property(
+                    m_att.properties, "fastdds.message_aggregation.flush_window_us");
+                uint32_t window_us = window_property != nullptr ?
+                    static_cast<uint32_t>(std::strtoul(window_property->c_str(), nullptr, 10)) : 0;
+                if (0 == window_us)
+                {
+                    return;
+                }
+
+                uint32_t max_bytes = getMaxMessageSize();
+                const std::string *max_bytes_property = PropertyPolicyHelper::find_property(
+                    m_att.properties, "fastdds.message_aggregation.max_bytes");
+                if (max_bytes_property != nullptr)
+                {
+                    uint32_t value = static_cast<uint32_t>(std::strtoul(max_bytes_property->c_str(), nullptr, 10));
+                    if (0 < value && value < max_bytes)
+                    {
+                        max_bytes = value;
+                    }
+                }
+
+                // Only used by the send function, which is called with the aggregator lock held.
+                aggregation_locators_.resize(1);
+
+                message_aggregator_.reset(new MessageAggregator(max_bytes,
+                    [this](
+                        const octet *data,
+                        uint32_t length,
+                        const Locator_t &locator,
+                        const std::chrono::steady_clock::time_point &max_blocking_time_point)
+                    {
+                        std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
+                        if (lock.try_lock_until(max_blocking_time_point))
+                        {
+                            aggregation_locators_[0] = locator;
+                            for (auto &send_resource : send_resource_list_)
+                            {
+                                Locators locators_begin(aggregation_locators_.begin());
+                                Locators locators_end(aggregation_locators_.end());
+                                send_resource->send(data, length, &locators_begin, &locators_end,
+                                                    max_blocking_time_point);
+                            }
+                        }
+                    }));
+
+                aggregation_flush_event_.reset(new TimedEvent(mp_event_thr,
+                    [this]() -> bool
+                    {
+                        message_aggregator_->flush(std::chrono::steady_clock::now() + std::chrono::hours(24));
+                        return false;
+                    },
+                    window_us / 1000.0));
+
+                // Asynchronous writers are flushed as soon as all of them have sent their changes.
+                async_thread_.set_run_finished_callback(
+                    [this]()
+                    {
+                        message_aggregator_->flush(std::chrono::steady_clock::now() + std::chrono::hours(24));
+                    });
+
+                logInfo(RTPS_PARTICIPANT, "Aggregating messages for " << window_us << " us, up to " << max_bytes
+                                                                      << " bytes");
+            }
+
             RTPSParticipantImpl::~RTPSParticipantImpl()
             {
                 disable();
 
+                if (message_aggregator_)
+                {
+                    aggregation_flush_event_.reset();
+                    message_aggregator_->flush(std::chrono::steady_clock::now() + std::chrono::hours(24));
+
+                    MessageAggregator::Statistics statistics = message_aggregator_->statistics();
+                    logInfo(RTPS_PARTICIPANT, statistics.messages_added << " messages sent in "
+                                                                        << statistics.datagrams_sent << " datagrams");
+                }
+
 #if HAVE_SECURITY
                 m_security_manager.destroy();
 #endif // if HAVE_SECURITY
@@ -1268,6 +1354,11 @@ namespace eprosima
                 }
                 m_receiverResourcelistMutex.unlock();
 
+                if (p_endpoint->getAttributes().endpointKind == READER)
+                {
+                    matched_readers_index_.remove_reader(static_cast<RTPSReader *>(p_endpoint));
+                }
+
                 bool found = false, found_in_users = false;
                 {
                     if (p_endpoint->getAttributes().endpointKind == WRITER)
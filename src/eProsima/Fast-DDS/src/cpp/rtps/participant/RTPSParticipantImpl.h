@@ -46,7 +46,10 @@
 #include <fastdds/rtps/messages/MessageReceiver.h>
 #include <fastdds/rtps/resources/ResourceEvent.h>
 #include <fastdds/rtps/resources/AsyncWriterThread.h>
+#include <fastdds/rtps/resources/TimedEvent.h>
 
+#include "../messages/MatchedReadersIndex.hpp"
+#include "../messages/MessageAggregator.hpp"
 #include "../messages/RTPSMessageGroup_t.hpp"
 #include "../messages/SendBuffersManager.hpp"
 
@@ -248,6 +251,12 @@ namespace eprosima
                                         return mp_event_thr;
                                 }
 
+                                //! Get the index of the local readers matched with each remote writer.
+                                MatchedReadersIndex &matched_readers_index()
+                                {
+                                        return matched_readers_index_;
+                                }
+
                                 /**
                                  * Send a message to several locations
                                  * @param msg Message to send.
@@ -255,6 +264,8 @@ namespace eprosima
                                  * @param destination_locators_end Iterator at the end destination locator.
                                  * @param max_blocking_time_point execution time limit timepoint.
                                  * @return true if at least one locator has been sent.
+                                 * @note When message aggregation is enabled, the message may be sent later together with
+                                 * the ones of other writers.
                                  */
                                 template <class LocatorIteratorT>
                                 bool sendSync(
@@ -263,6 +274,16 @@ namespace eprosima
                                     const LocatorIteratorT &destination_locators_end,
                                     std::chrono::steady_clock::time_point &max_blocking_time_point)
                                 {
+                                        if (message_aggregator_)
+                                        {
+                                                if (message_aggregator_->add(*msg, destination_locators_begin, destination_locators_end,
+                                                                             max_blocking_time_point))
+                                                {
+                                                        aggregation_flush_event_->restart_timer(max_blocking_time_point);
+                                                }
+                                                return true;
+                                        }
+
                                         bool ret_code = false;
                                         std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
 
@@ -504,10 +525,20 @@ namespace eprosima
                                 //! Receiver resource list needs its own mutext to avoid a race condition.
                                 std::mutex m_receiverResourcelistMutex;
 
+                                //! Local readers matched with each remote writer, used to dispatch received submessages.
+                                MatchedReadersIndex matched_readers_index_;
+
                                 //! SenderResource List
                                 std::timed_mutex m_send_resources_mutex_;
                                 fastdds::rtps::SendResourceList send_resource_list_;
 
+                                //! Coalesces the messages of all the writers per destination, when enabled.
+                                std::unique_ptr<MessageAggregator> message_aggregator_;
+                                //! Flushes message_aggregator_ when the aggregation window expires.
+                                std::unique_ptr<TimedEvent> aggregation_flush_event_;
+                                //! Destination given to the send resources when message_aggregator_ sends a datagram.
+                                std::vector<Locator_t> aggregation_locators_;
+
                                 //! Participant Listener
                                 RTPSParticipantListener *mp_participantListener;
                                 //! Pointer to the user participant
@@ -516,6 +547,11 @@ namespace eprosima
                                 RTPSParticipantImpl &operator=(
                                     const RTPSParticipantImpl &) = delete;
 
+                                /**
+                                 * Create message_aggregator_ if enabled through the participant properties.
+                                 */
+                                void create_message_aggregator();
+
                                 /**
                                  * Method to check if a specific entityId already exists in this RTPSParticipant
                                  * @param ent EnityId to check
@@ -26,6 +26,7 @@
 #include <rtps/reader/WriterProxy.h>
 #include <fastrtps/utils/TimeConversion.h>
 #include <rtps/history/HistoryAttributesExtension.hpp>
+#include <rtps/history/ILendingPayloadPool.hpp>
 
 #include <fastdds/rtps/builtin/BuiltinProtocols.h>
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
@@ -204,6 +205,7 @@ bool StatefulReader::matched_writer_add(
     }
 
     matched_writers_.push_back(wp);
+    mp_RTPSParticipant->matched_readers_index().add(wdata.guid(), m_guid, this);
 
     if (liveliness_lease_duration_ < c_TimeInfinite)
     {
@@ -270,6 +272,7 @@ bool StatefulReader::matched_writer_remove(
 
         if (wproxy != nullptr)
         {
+            mp_RTPSParticipant->matched_readers_index().remove(writer_guid, this);
             wproxy->stop();
             matched_writers_pool_.push_back(wproxy);
             return true;
@@ -390,9 +393,12 @@ bool StatefulReader::processDataMsg(
             // Copy metadata to reserved change
             change_to_add->copy_not_memcpy(change);
 
-            // Ask payload pool to copy the payload
+            // Reference the payload if its owner lends it, or ask payload pool to copy it
             IPayloadPool* payload_owner = change->payload_owner();
-            if (payload_pool_->get_payload(change->serializedPayload, payload_owner, *change_to_add))
+            ILendingPayloadPool* payload_lender = dynamic_cast<ILendingPayloadPool*>(payload_owner);
+            if ((nullptr != payload_lender &&
+                    payload_lender->get_payload(change->serializedPayload, payload_owner, *change_to_add)) ||
+                    payload_pool_->get_payload(change->serializedPayload, payload_owner, *change_to_add))
             {
                 change->payload_owner(payload_owner);
             }
@@ -410,7 +416,7 @@ bool StatefulReader::processDataMsg(
             if (!change_received(change_to_add, pWP))
             {
                 logInfo(RTPS_MSG_IN, IDSTRING "MessageReceiver not add change " << change_to_add->sequenceNumber);
-                payload_pool_->release_payload(*change_to_add);
+                change_to_add->payload_owner()->release_payload(*change_to_add);
                 change_pool_->release_cache(change_to_add);
             }
         }
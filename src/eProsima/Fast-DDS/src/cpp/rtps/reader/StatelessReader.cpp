@@ -25,6 +25,7 @@
 #include <fastdds/rtps/builtin/BuiltinProtocols.h>
 #include <fastdds/rtps/builtin/liveliness/WLP.h>
 #include <fastdds/rtps/writer/LivelinessManager.h>
+#include <rtps/history/ILendingPayloadPool.hpp>
 #include <rtps/participant/RTPSParticipantImpl.h>
 
 #include <mutex>
@@ -98,6 +99,7 @@ bool StatelessReader::matched_writer_add(
     if (att != nullptr)
     {
         add_persistence_guid(info.guid, info.persistence_guid);
+        mp_RTPSParticipant->matched_readers_index().add(info.guid, m_guid, this);
 
         m_acceptMessagesFromUnkownWriters = false;
         logInfo(RTPS_READER, "Writer " << info.guid << " added to reader " << m_guid);
@@ -156,6 +158,7 @@ bool StatelessReader::matched_writer_remove(
             }
 
             remove_persistence_guid(it->guid, it->persistence_guid, removed_by_lease);
+            mp_RTPSParticipant->matched_readers_index().remove(writer_guid, this);
             matched_writers_.erase(it);
 
             return true;
@@ -298,9 +301,12 @@ bool StatelessReader::processDataMsg(
         // Copy metadata to reserved change
         change_to_add->copy_not_memcpy(change);
 
-        // Ask payload pool to copy the payload
+        // Reference the payload if its owner lends it, or ask payload pool to copy it
         IPayloadPool* payload_owner = change->payload_owner();
-        if (payload_pool_->get_payload(change->serializedPayload, payload_owner, *change_to_add))
+        ILendingPayloadPool* payload_lender = dynamic_cast<ILendingPayloadPool*>(payload_owner);
+        if ((nullptr != payload_lender &&
+                payload_lender->get_payload(change->serializedPayload, payload_owner, *change_to_add)) ||
+                payload_pool_->get_payload(change->serializedPayload, payload_owner, *change_to_add))
         {
             change->payload_owner(payload_owner);
         }
@@ -318,7 +324,7 @@ bool StatelessReader::processDataMsg(
         if (!change_received(change_to_add))
         {
             logInfo(RTPS_MSG_IN, IDSTRING "MessageReceiver not add change " << change_to_add->sequenceNumber);
-            payload_pool_->release_payload(*change_to_add);
+            change_to_add->payload_owner()->release_payload(*change_to_add);
             change_pool_->release_cache(change_to_add);
         }
     }
@@ -107,6 +107,12 @@ void AsyncWriterThread::wake_up(
     }
 }
 
+void AsyncWriterThread::set_run_finished_callback(
+        std::function<void()> callback)
+{
+    run_finished_callback_ = callback;
+}
+
 void AsyncWriterThread::run()
 {
     std::unique_lock<RecursiveTimedMutex> cond_guard(condition_variable_mutex_);
@@ -128,6 +134,11 @@ void AsyncWriterThread::run()
             }
             interestTree_.mMutexActive.unlock();
 
+            if (run_finished_callback_)
+            {
+                run_finished_callback_();
+            }
+
             cond_guard.lock();
         }
         else
@@ -20,7 +20,9 @@
 #include <fastdds/dds/log/Log.hpp>
 
 #include "TimedEventImpl.h"
+#include "TimerWheel.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <thread>
 
@@ -35,6 +37,11 @@ static bool event_compare(
     return lhs->next_trigger_time() < rhs->next_trigger_time();
 }
 
+ResourceEvent::ResourceEvent()
+    : active_timers_(new TimerWheel())
+{
+}
+
 ResourceEvent::~ResourceEvent()
 {
     // All timer should be unregistered before destroying this object.
@@ -79,21 +86,21 @@ void ResourceEvent::unregister_timer(
             });
 
     bool should_notify = false;
-    std::vector<TimedEventImpl*>::iterator it;
 
     // Remove from pending
-    it = std::find(pending_timers_.begin(), pending_timers_.end(), event);
-    if (it != pending_timers_.end())
+    if (event->pending_index_ >= 0)
     {
-        pending_timers_.erase(it);
+        TimedEventImpl* last = pending_timers_.back();
+        pending_timers_[event->pending_index_] = last;
+        last->pending_index_ = event->pending_index_;
+        pending_timers_.pop_back();
+        event->pending_index_ = -1;
         should_notify = true;
     }
 
     // Remove from active
-    it = std::find(active_timers_.begin(), active_timers_.end(), event);
-    if (it != active_timers_.end())
+    if (active_timers_->remove(event))
     {
-        active_timers_.erase(it);
         should_notify = true;
     }
 
@@ -138,8 +145,9 @@ void ResourceEvent::notify(
 bool ResourceEvent::register_timer_nts(
         TimedEventImpl* event)
 {
-    if (std::find(pending_timers_.begin(), pending_timers_.end(), event) == pending_timers_.end())
+    if (event->pending_index_ < 0)
     {
+        event->pending_index_ = static_cast<int32_t>(pending_timers_.size());
         pending_timers_.push_back(event);
         return true;
     }
@@ -174,10 +182,11 @@ void ResourceEvent::event_service()
         cv_manipulation_.notify_all();
 
         // Wait for the first timer to be triggered
-        std::chrono::steady_clock::time_point next_trigger =
-                active_timers_.empty() ?
-                current_time_ + std::chrono::seconds(1) :
-                active_timers_[0]->next_trigger_time();
+        std::chrono::steady_clock::time_point next_trigger;
+        if (!active_timers_->next_wake_up_time(next_trigger))
+        {
+            next_trigger = current_time_ + std::chrono::seconds(1);
+        }
 
         cv_.wait_until(lock, next_trigger);
 
@@ -187,11 +196,6 @@ void ResourceEvent::event_service()
     }
 }
 
-void ResourceEvent::sort_timers()
-{
-    std::sort(active_timers_.begin(), active_timers_.end(), event_compare);
-}
-
 void ResourceEvent::update_current_time()
 {
     current_time_ = std::chrono::steady_clock::now();
@@ -202,65 +206,40 @@ void ResourceEvent::do_timer_actions()
     std::chrono::steady_clock::time_point cancel_time =
             current_time_ + std::chrono::hours(24);
 
-    bool did_something = false;
-
     // Process pending orders
     {
         std::lock_guard<TimedMutex> lock(mutex_);
         for (TimedEventImpl* tp : pending_timers_)
         {
+            tp->pending_index_ = -1;
+
             // Remove item from active timers
-            auto current_pos = std::lower_bound(active_timers_.begin(), active_timers_.end(), tp, event_compare);
-            current_pos = std::find(current_pos, active_timers_.end(), tp);
-            if (current_pos != active_timers_.end())
-            {
-                active_timers_.erase(current_pos);
-            }
+            active_timers_->remove(tp);
 
             // Update timer info
             if (tp->update(current_time_, cancel_time))
             {
                 // Timer has to be activated: add to active timers
-                std::vector<TimedEventImpl*>::iterator low_bound;
-
-                // Insert on correct position
-                low_bound = std::lower_bound(active_timers_.begin(), active_timers_.end(), tp, event_compare);
-                active_timers_.emplace(low_bound, tp);
+                active_timers_->insert(tp);
             }
         }
         pending_timers_.clear();
     }
 
-    // Trigger active timers
-    for (TimedEventImpl* tp : active_timers_)
+    // Trigger expired timers in ascending order of trigger time
+    active_timers_->collect_due(current_time_, due_timers_);
+    std::sort(due_timers_.begin(), due_timers_.end(), event_compare);
+    for (TimedEventImpl* tp : due_timers_)
     {
-        if (tp->next_trigger_time() <= current_time_)
-        {
-            did_something = true;
-            tp->trigger(current_time_, cancel_time);
-        }
-        else
+        tp->trigger(current_time_, cancel_time);
+
+        // Reschedule timers that restarted themselves
+        if (tp->next_trigger_time() < cancel_time)
         {
-            break;
+            active_timers_->insert(tp);
         }
     }
-
-    // If an action was made, keep active_timers_ sorted
-    if (did_something)
-    {
-        sort_timers();
-        active_timers_.erase(
-            std::lower_bound(active_timers_.begin(), active_timers_.end(), nullptr,
-            [cancel_time](
-                TimedEventImpl* a,
-                TimedEventImpl* b)
-            {
-                (void)b;
-                return a->next_trigger_time() < cancel_time;
-            }),
-            active_timers_.end()
-            );
-    }
+    due_timers_.clear();
 }
 
 void ResourceEvent::init_thread()
@@ -26,6 +26,7 @@
 #include <fastdds/rtps/resources/TimedEvent.h>
 
 #include <atomic>
+#include <cstdint>
 #include <thread>
 #include <memory>
 #include <functional>
@@ -45,6 +46,9 @@ class TimedEventImpl
 {
     using Callback = std::function<bool ()>;
 
+    friend class ResourceEvent;
+    friend class TimerWheel;
+
 public:
 
     enum StateCode
@@ -167,6 +171,18 @@ private:
 
     //! Protects interval_microsec_ and next_trigger_time_
     std::mutex mutex_;
+
+    //! Position on ResourceEvent's collection of pending events, or -1 if it is not pending.
+    int32_t pending_index_ = -1;
+
+    //! Slot of ResourceEvent's timer wheel where this event is scheduled, or -1 if it is not scheduled.
+    int32_t wheel_position_ = -1;
+
+    //! Previous event on the same timer wheel slot.
+    TimedEventImpl* wheel_prev_ = nullptr;
+
+    //! Next event on the same timer wheel slot.
+    TimedEventImpl* wheel_next_ = nullptr;
 };
 
 } // namespace rtps
@@ -0,0 +1,435 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TimerWheel.hpp
+ *
+ */
+
+#ifndef _RTPS_RESOURCES_TIMERWHEEL_HPP_
+#define _RTPS_RESOURCES_TIMERWHEEL_HPP_
+
+#include "TimedEventImpl.h"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // if defined(_MSC_VER)
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/*!
+ * Hashed hierarchical timer wheel holding the scheduled TimedEventImpl objects of a ResourceEvent.
+ *
+ * The first level hashes events into slots of one tick each, and every upper level hashes them into slots
+ * covering a whole revolution of the level below. Events on upper levels are cascaded down when the wheel
+ * reaches their slot, so inserting and removing an event is O(1), and expiring them only visits the slots that
+ * are not empty.
+ * Events are linked on the slots through the intrusive fields of TimedEventImpl.
+ * @warning Not thread safe. It should only be used by ResourceEvent's internal thread, or while that thread allows
+ * other threads to manipulate the timer collections.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class TimerWheel
+{
+public:
+
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /*!
+     * @brief Constructor.
+     * @param resolution Duration of one tick of the first level.
+     */
+    explicit TimerWheel(
+            std::chrono::microseconds resolution = std::chrono::milliseconds(1))
+        : resolution_(resolution)
+        , origin_(std::chrono::steady_clock::now())
+    {
+        for (auto& level : slots_)
+        {
+            level.fill(nullptr);
+        }
+        for (auto& level : occupied_)
+        {
+            level.fill(0u);
+        }
+    }
+
+    TimerWheel(
+            const TimerWheel&) = delete;
+    TimerWheel& operator =(
+            const TimerWheel&) = delete;
+
+    //! Returns whether there are no events on the wheel.
+    bool empty() const
+    {
+        return 0u == size_;
+    }
+
+    //! Returns the number of events on the wheel.
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /*!
+     * @brief Schedules an event at its next trigger time.
+     * @param event Event to be added. It should not be already on the wheel.
+     */
+    void insert(
+            TimedEventImpl* event)
+    {
+        assert(event->wheel_position_ < 0);
+        place(event, tick_of(event->next_trigger_time()));
+        ++size_;
+    }
+
+    /*!
+     * @brief Removes an event from the wheel.
+     * @param event Event to be removed.
+     * @return true if the event was on the wheel, false otherwise.
+     */
+    bool remove(
+            TimedEventImpl* event)
+    {
+        if (event->wheel_position_ < 0)
+        {
+            return false;
+        }
+
+        unlink(event);
+        --size_;
+        return true;
+    }
+
+    /*!
+     * @brief Removes from the wheel all the events whose trigger time is not after a given time.
+     * @param now Current time.
+     * @param due Collection where due events are appended, in no particular order.
+     */
+    void collect_due(
+            time_point now,
+            std::vector<TimedEventImpl*>& due)
+    {
+        tick_t now_tick = tick_of(now);
+
+        while (next_tick_ < now_tick)
+        {
+            if (0u == size_)
+            {
+                // Nothing to cascade, so the wheel can be moved forward at once.
+                next_tick_ = now_tick;
+                break;
+            }
+
+            size_t index = static_cast<size_t>(next_tick_ & slot_mask);
+            size_t occupied = next_occupied(0u, index);
+            tick_t target = next_tick_ - index + occupied;
+
+            if (target > now_tick || (occupied < slots_per_level && target == now_tick))
+            {
+                next_tick_ = now_tick;
+                break;
+            }
+
+            if (occupied < slots_per_level)
+            {
+                // The whole slot has expired.
+                TimedEventImpl* event = detach(0u, occupied);
+                while (nullptr != event)
+                {
+                    TimedEventImpl* next = event->wheel_next_;
+                    clear_links(event);
+                    --size_;
+                    due.push_back(event);
+                    event = next;
+                }
+                next_tick_ = target + 1u;
+            }
+            else
+            {
+                next_tick_ = target;
+            }
+
+            if (0u == (next_tick_ & slot_mask))
+            {
+                cascade();
+            }
+        }
+
+        // Only some of the events on the current slot may have expired.
+        size_t position = static_cast<size_t>(next_tick_ & slot_mask);
+        TimedEventImpl* event = slots_[0][position];
+        while (nullptr != event)
+        {
+            TimedEventImpl* next = event->wheel_next_;
+            if (event->next_trigger_time() <= now)
+            {
+                unlink(event);
+                --size_;
+                due.push_back(event);
+            }
+            event = next;
+        }
+    }
+
+    /*!
+     * @brief Calculates when the internal thread should wake up next.
+     *
+     * This will be the trigger time of the earliest event, unless that event is still on an upper level, in which
+     * case the wake up time is the moment of the next cascade.
+     * @param[out] next_time Calculated wake up time.
+     * @return false if the wheel is empty, true otherwise.
+     */
+    bool next_wake_up_time(
+            time_point& next_time) const
+    {
+        if (0u == size_)
+        {
+            return false;
+        }
+
+        size_t index = static_cast<size_t>(next_tick_ & slot_mask);
+        size_t occupied = next_occupied(0u, index);
+        if (occupied < slots_per_level)
+        {
+            next_time = earliest_trigger_time(slots_[0][occupied]);
+            return true;
+        }
+
+        for (size_t level = 1u; level < num_levels; ++level)
+        {
+            if (next_occupied(level, 0u) < slots_per_level)
+            {
+                next_time = time_of(next_tick_ - index + slots_per_level);
+                return true;
+            }
+        }
+
+        // Only events on the next revolution of the first level remain.
+        occupied = next_occupied(0u, 0u);
+        assert(occupied < slots_per_level);
+        next_time = earliest_trigger_time(slots_[0][occupied]);
+        return true;
+    }
+
+private:
+
+    using tick_t = uint64_t;
+
+    static constexpr size_t level_bits = 8u;
+    static constexpr size_t slots_per_level = size_t(1u) << level_bits;
+    static constexpr tick_t slot_mask = slots_per_level - 1u;
+    static constexpr size_t num_levels = 4u;
+    static constexpr size_t bitmap_words = slots_per_level / 64u;
+    static constexpr tick_t max_delta = (tick_t(1u) << (level_bits * num_levels)) - 1u;
+
+    //! Duration of one tick.
+    std::chrono::microseconds resolution_;
+
+    //! Time of tick 0.
+    time_point origin_;
+
+    //! First tick whose events may have not been collected.
+    tick_t next_tick_ = 0u;
+
+    //! Number of events on the wheel.
+    size_t size_ = 0u;
+
+    //! Heads of the event lists of every slot.
+    std::array<std::array<TimedEventImpl*, slots_per_level>, num_levels> slots_;
+
+    //! Bitmaps of the slots with events on every level.
+    std::array<std::array<uint64_t, bitmap_words>, num_levels> occupied_;
+
+    tick_t tick_of(
+            time_point time) const
+    {
+        if (time <= origin_)
+        {
+            return 0u;
+        }
+        return static_cast<tick_t>((time - origin_) / resolution_);
+    }
+
+    time_point time_of(
+            tick_t tick) const
+    {
+        return origin_ + resolution_ * static_cast<std::chrono::microseconds::rep>(tick);
+    }
+
+    static time_point earliest_trigger_time(
+            TimedEventImpl* event)
+    {
+        assert(nullptr != event);
+        time_point earliest = event->next_trigger_time();
+        for (event = event->wheel_next_; nullptr != event; event = event->wheel_next_)
+        {
+            time_point trigger_time = event->next_trigger_time();
+            if (trigger_time < earliest)
+            {
+                earliest = trigger_time;
+            }
+        }
+        return earliest;
+    }
+
+    static size_t first_bit(
+            uint64_t word)
+    {
+        assert(0u != word);
+#if defined(_MSC_VER)
+        unsigned long bit;
+        _BitScanForward64(&bit, word);
+        return static_cast<size_t>(bit);
+#else
+        return static_cast<size_t>(__builtin_ctzll(word));
+#endif // if defined(_MSC_VER)
+    }
+
+    //! Returns the first slot with events at or after from, or slots_per_level if there are none.
+    size_t next_occupied(
+            size_t level,
+            size_t from) const
+    {
+        size_t word = from / 64u;
+        uint64_t bits = occupied_[level][word] & (~uint64_t(0u) << (from % 64u));
+        while (0u == bits)
+        {
+            if (++word == bitmap_words)
+            {
+                return slots_per_level;
+            }
+            bits = occupied_[level][word];
+        }
+        return word * 64u + first_bit(bits);
+    }
+
+    void place(
+            TimedEventImpl* event,
+            tick_t expires)
+    {
+        if (expires < next_tick_)
+        {
+            expires = next_tick_;
+        }
+
+        tick_t delta = expires - next_tick_;
+        if (delta > max_delta)
+        {
+            // Out of range. It will be placed again when its slot is cascaded.
+            delta = max_delta;
+            expires = next_tick_ + max_delta;
+        }
+
+        size_t level = 0u;
+        while (delta >= slots_per_level)
+        {
+            delta >>= level_bits;
+            ++level;
+        }
+        size_t index = static_cast<size_t>((expires >> (level * level_bits)) & slot_mask);
+
+        TimedEventImpl*& head = slots_[level][index];
+        event->wheel_position_ = static_cast<int32_t>(level * slots_per_level + index);
+        event->wheel_prev_ = nullptr;
+        event->wheel_next_ = head;
+        if (nullptr != head)
+        {
+            head->wheel_prev_ = event;
+        }
+        head = event;
+        occupied_[level][index / 64u] |= uint64_t(1u) << (index % 64u);
+    }
+
+    void unlink(
+            TimedEventImpl* event)
+    {
+        size_t level = static_cast<size_t>(event->wheel_position_) / slots_per_level;
+        size_t index = static_cast<size_t>(event->wheel_position_) % slots_per_level;
+
+        if (nullptr != event->wheel_prev_)
+        {
+            event->wheel_prev_->wheel_next_ = event->wheel_next_;
+        }
+        else
+        {
+            slots_[level][index] = event->wheel_next_;
+            if (nullptr == event->wheel_next_)
+            {
+                occupied_[level][index / 64u] &= ~(uint64_t(1u) << (index % 64u));
+            }
+        }
+        if (nullptr != event->wheel_next_)
+        {
+            event->wheel_next_->wheel_prev_ = event->wheel_prev_;
+        }
+        clear_links(event);
+    }
+
+    static void clear_links(
+            TimedEventImpl* event)
+    {
+        event->wheel_position_ = -1;
+        event->wheel_prev_ = nullptr;
+        event->wheel_next_ = nullptr;
+    }
+
+    //! Empties a slot, returning the list of events it had.
+    TimedEventImpl* detach(
+            size_t level,
+            size_t index)
+    {
+        TimedEventImpl* head = slots_[level][index];
+        slots_[level][index] = nullptr;
+        occupied_[level][index / 64u] &= ~(uint64_t(1u) << (index % 64u));
+        return head;
+    }
+
+    //! Moves down the events of the upper level slots starting at next_tick_.
+    void cascade()
+    {
+        for (size_t level = 1u; level < num_levels; ++level)
+        {
+            size_t index = static_cast<size_t>((next_tick_ >> (level * level_bits)) & slot_mask);
+            TimedEventImpl* event = detach(level, index);
+            while (nullptr != event)
+            {
+                TimedEventImpl* next = event->wheel_next_;
+                clear_links(event);
+                place(event, tick_of(event->next_trigger_time()));
+                event = next;
+            }
+
+            if (0u != index)
+            {
+                break;
+            }
+        }
+    }
+
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif //_RTPS_RESOURCES_TIMERWHEEL_HPP_
@@ -20,6 +20,7 @@
 #include <fastrtps/rtps/common/Locator.h>
 
 #include <rtps/transport/shared_mem/SharedMemManager.hpp>
+#include <rtps/transport/shared_mem/SharedMemPayloadPool.hpp>
 #include <rtps/transport/shared_mem/SharedMemTransport.h>
 
 namespace eprosima {
@@ -37,13 +38,20 @@ public:
             const fastrtps::rtps::Locator_t& locator,
             TransportReceiverInterface* receiver,
             const std::string& dump_file,
+            uint32_t payload_reference_threshold,
             bool should_init_thread = true)
         : ChannelResource()
         , message_receiver_(receiver)
         , listener_(listener)
         , only_multicast_purpose_(false)
         , locator_(locator)
+        , payload_reference_threshold_(payload_reference_threshold)
     {
+        if (payload_reference_threshold_ > 0)
+        {
+            payload_pool_ = SharedMemPayloadPool::instance();
+        }
+
         if (!dump_file.empty())
         {
             auto packets_file_consumer = std::unique_ptr<SHMPacketFileConsumer>(
@@ -111,6 +119,11 @@ public:
         {
             logWarning(RTPS_MSG_IN, e.what());
         }
+
+        auto statistics = listener_->wait_statistics();
+        logInfo(RTPS_MSG_IN, "SHM channel " << locator_ << " received " << statistics.spin_hits
+                                            << " buffers while spinning for " << statistics.spin_time_ns
+                                            << " ns, and blocked " << statistics.blocking_waits << " times");
     }
 
 private:
@@ -141,7 +154,18 @@ private:
             }
 
             // Processes the data through the CDR Message interface.
-            if (message_receiver() != nullptr)
+            if (message_receiver() != nullptr && payload_pool_)
+            {
+                // The readers may keep references to the payloads, so the buffer outlives this iteration
+                payload_pool_->add_buffer(message, payload_reference_threshold_);
+                message_receiver()->OnSharedDataReceived(
+                    static_cast<fastrtps::rtps::octet*>(message->data()),
+                    message->size(),
+                    input_locator, remote_locator,
+                    payload_pool_.get());
+                payload_pool_->remove_buffer(message);
+            }
+            else if (message_receiver() != nullptr)
             {
                 message_receiver()->OnDataReceived(
                     static_cast<fastrtps::rtps::octet*>(message->data()),
@@ -206,6 +230,10 @@ private:
     bool only_multicast_purpose_;
     fastrtps::rtps::Locator_t locator_;
 
+    //! Payloads of at least this size are referenced by the readers. Zero to always copy them.
+    uint32_t payload_reference_threshold_;
+    std::shared_ptr<SharedMemPayloadPool> payload_pool_;
+
     SharedMemChannelResource(
             const SharedMemChannelResource&) = delete;
     SharedMemChannelResource& operator =(
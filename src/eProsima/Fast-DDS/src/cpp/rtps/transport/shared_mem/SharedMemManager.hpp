@@ -16,11 +16,16 @@
 #define _FASTDDS_SHAREDMEM_MANAGER_H_
 
 #include <atomic>
+#include <chrono>
 #include <list>
+#include <thread>
 #include <unordered_map>
 
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.h>
+
 #include <rtps/transport/shared_mem/SharedMemGlobal.hpp>
 #include <rtps/transport/shared_mem/RobustSharedLock.hpp>
+#include <rtps/transport/shared_mem/SharedMemSlabAllocator.hpp>
 #include <rtps/transport/shared_mem/SharedMemWatchdog.hpp>
 
 namespace eprosima {
@@ -38,6 +43,10 @@ using Log = fastdds::dds::Log;
 class SharedMemManager :
     public std::enable_shared_from_this<SharedMemManager>
 {
+public:
+
+    using SegmentAllocator = SharedMemTransportDescriptor::SegmentAllocator;
+
 private:
 
     struct BufferNode
@@ -352,7 +361,8 @@ public:
                 uint32_t size,
                 uint32_t payload_size,
                 uint32_t max_allocations,
-                const std::string& domain_name)
+                const std::string& domain_name,
+                SegmentAllocator allocator = SegmentAllocator::BEST_FIT)
             : segment_id_()
             , overflows_count_(0)
         {
@@ -387,6 +397,17 @@ public:
                 buffers_nodes[i].data_offset = 0;
                 free_buffers_.push_back(&buffers_nodes[i]);
             }
+
+            if (SegmentAllocator::SLAB == allocator)
+            {
+                // The slab allocator gets all the payload memory at once, and hands it out without locking the
+                // segment.
+                uint32_t arena_size = SharedMemSlabAllocator::arena_size_for(payload_size);
+                auto header = segment_->get().construct<SharedMemSlabAllocator::Header>
+                            (boost::interprocess::anonymous_instance)();
+                void* arena = segment_->get().allocate(arena_size);
+                slab_allocator_.reset(new SharedMemSlabAllocator(header, arena, arena_size));
+            }
         }
 
         ~Segment()
@@ -434,7 +455,7 @@ public:
             {
                 buffer_node = pop_free_node();
 
-                data = segment_->get().allocate(size);
+                data = allocate_data(size);
                 free_bytes_ -= size;
 
                 buffer_node->data_offset = segment_->get_offset_from_address(data);
@@ -500,6 +521,9 @@ public:
 
         uint32_t free_bytes_;
 
+        // Only used when the buffers are not allocated by the segment itself
+        std::unique_ptr<SharedMemSlabAllocator> slab_allocator_;
+
         void generate_segment_id_and_name(
                 const std::string& domain_name)
         {
@@ -542,15 +566,53 @@ public:
             return node;
         }
 
+        void* allocate_data(
+                uint32_t size)
+        {
+            if (slab_allocator_)
+            {
+                void* data = slab_allocator_->allocate(size);
+                if (nullptr == data)
+                {
+                    throw std::runtime_error("alloc_buffer: slab allocator overflow");
+                }
+                return data;
+            }
+
+            return segment_->get().allocate(size);
+        }
+
         void release_buffer(
                 BufferNode* buffer_node)
         {
-            segment_->get().deallocate(
-                segment_->get_address_from_offset(buffer_node->data_offset));
+            void* data = segment_->get_address_from_offset(buffer_node->data_offset);
+
+            if (slab_allocator_)
+            {
+                slab_allocator_->deallocate(data, buffer_node->data_size);
+            }
+            else
+            {
+                segment_->get().deallocate(data);
+            }
 
             free_bytes_ += buffer_node->data_size;
         }
 
+        /**
+         * @return true if a buffer of required_data_size bytes could be allocated.
+         */
+        bool has_room_for(
+                uint32_t required_data_size) const
+        {
+            if (slab_allocator_)
+            {
+                return slab_allocator_->can_allocate(required_data_size);
+            }
+
+            return free_bytes_ >= required_data_size;
+        }
+
         /**
          * Recover unreferenced buffers and, in case of overflow, also recovers the oldest buffers not being
          * processed by any listener (until enough free bytes is gathered to solve the overflow).
@@ -563,7 +625,7 @@ public:
             while (it != allocated_buffers_.end())
             {
                 // There is enough space to allocate the buffer
-                if (free_bytes_ >= required_data_size)
+                if (has_room_for(required_data_size))
                 {
                     if ((*it)->is_not_referenced())
                     {
@@ -614,7 +676,14 @@ public:
                 }
             }
 
-            return free_bytes_ >= required_data_size;
+            if (slab_allocator_ && allocated_buffers_.empty() && !has_room_for(required_data_size))
+            {
+                // The free memory has been split in blocks too small for the request. As there are no buffers
+                // in use, it can be joined again.
+                slab_allocator_->reset();
+            }
+
+            return has_room_for(required_data_size);
         }
 
     }; // Segment
@@ -629,12 +698,35 @@ public:
     {
     public:
 
+        /**
+         * Counters describing how pop() waited for buffers.
+         */
+        struct WaitStatistics
+        {
+            //! Number of buffers found while spinning.
+            uint64_t spin_hits;
+            //! Number of times the port condition had to be waited.
+            uint64_t blocking_waits;
+            //! Total time spent spinning, in nanoseconds.
+            uint64_t spin_time_ns;
+        };
+
+        /**
+         * @param shared_mem_manager Manager owning the port.
+         * @param port Port to listen to.
+         * @param spin_time Time pop() polls an empty port before blocking on its condition. Zero to always block.
+         */
         Listener(
                 SharedMemManager* shared_mem_manager,
-                std::shared_ptr<SharedMemGlobal::Port> port)
+                std::shared_ptr<SharedMemGlobal::Port> port,
+                std::chrono::microseconds spin_time = std::chrono::microseconds(0))
             : global_port_(port)
             , shared_mem_manager_(shared_mem_manager)
             , is_closed_(false)
+            , spin_time_(spin_time)
+            , spin_hits_(0)
+            , blocking_waits_(0)
+            , spin_time_ns_(0)
         {
             global_listener_ = global_port_->create_listener(&listener_index_);
         }
@@ -689,10 +781,21 @@ public:
                     SharedMemGlobal::PortCell* head_cell = nullptr;
                     buffer_ref.reset();
 
-                    while ( !is_closed_.load() && nullptr == (head_cell = global_listener_->head()))
+                    if (spin_time_.count() > 0)
+                    {
+                        head_cell = spin_for_head();
+                    }
+
+                    if (nullptr == head_cell && !is_closed_.load() &&
+                            nullptr == (head_cell = global_listener_->head()))
                     {
-                        // Wait until there's data to pop
-                        global_port_->wait_pop(*global_listener_, is_closed_, listener_index_);
+                        blocking_waits_.fetch_add(1, std::memory_order_relaxed);
+
+                        do
+                        {
+                            // Wait until there's data to pop
+                            global_port_->wait_pop(*global_listener_, is_closed_, listener_index_);
+                        } while ( !is_closed_.load() && nullptr == (head_cell = global_listener_->head()));
                     }
 
                     if (!head_cell)
@@ -787,8 +890,54 @@ public:
             global_port_->close_listener(&is_closed_);
         }
 
+        /**
+         * @return The counters of the waits done by pop() so far. They can be read from any thread.
+         */
+        WaitStatistics wait_statistics() const
+        {
+            return {
+                spin_hits_.load(std::memory_order_relaxed),
+                blocking_waits_.load(std::memory_order_relaxed),
+                spin_time_ns_.load(std::memory_order_relaxed)
+            };
+        }
+
     private:
 
+        /**
+         * Polls the port for spin_time_, without blocking.
+         * Senders do not signal the port condition when nobody is blocked on it, so receiving while spinning
+         * saves the wake-up on both sides.
+         * @return The head cell, or nullptr if the port is still empty or the listener has been closed.
+         */
+        SharedMemGlobal::PortCell* spin_for_head()
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto now = start;
+            SharedMemGlobal::PortCell* head_cell = nullptr;
+
+            while (!is_closed_.load() && now - start < spin_time_)
+            {
+                head_cell = global_listener_->head();
+                if (nullptr != head_cell)
+                {
+                    // The cell was not read under the port mutex, so synchronize with the pusher.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    spin_hits_.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                // Let the writer run if it shares the core with this thread.
+                std::this_thread::yield();
+                now = std::chrono::steady_clock::now();
+            }
+
+            spin_time_ns_.fetch_add(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()),
+                    std::memory_order_relaxed);
+
+            return head_cell;
+        }
+
         std::shared_ptr<SharedMemGlobal::Port> global_port_;
 
         std::unique_ptr<SharedMemGlobal::Listener> global_listener_;
@@ -798,6 +947,12 @@ public:
 
         std::atomic<bool> is_closed_;
 
+        std::chrono::microseconds spin_time_;
+
+        std::atomic<uint64_t> spin_hits_;
+        std::atomic<uint64_t> blocking_waits_;
+        std::atomic<uint64_t> spin_time_ns_;
+
     }; // Listener
 
     /**
@@ -905,9 +1060,13 @@ public:
             }
         }
 
-        std::shared_ptr<Listener> create_listener()
+        /**
+         * @param spin_time Time the listener polls the port before blocking. Zero to always block.
+         */
+        std::shared_ptr<Listener> create_listener(
+                std::chrono::microseconds spin_time = std::chrono::microseconds(0))
         {
-            return std::make_shared<Listener>(shared_mem_manager_, global_port_);
+            return std::make_shared<Listener>(shared_mem_manager_, global_port_, spin_time);
         }
 
     private:
@@ -936,10 +1095,20 @@ public:
      */
     std::shared_ptr<Segment> create_segment(
             uint32_t size,
-            uint32_t max_allocations)
+            uint32_t max_allocations,
+            SegmentAllocator allocator = SegmentAllocator::BEST_FIT)
     {
-        return std::make_shared<Segment>(size + segment_allocation_extra_size(max_allocations), size, max_allocations,
-                       global_segment_.domain_name());
+        uint32_t segment_size = size + segment_allocation_extra_size(max_allocations);
+
+        if (SegmentAllocator::SLAB == allocator)
+        {
+            // Room for the rounded up arena and the allocator structures.
+            segment_size += SharedMemSlabAllocator::arena_size_for(size) - size +
+                    static_cast<uint32_t>(sizeof(SharedMemSlabAllocator::Header)) + 2 * per_allocation_extra_size_;
+        }
+
+        return std::make_shared<Segment>(segment_size, size, max_allocations,
+                       global_segment_.domain_name(), allocator);
     }
 
     /**
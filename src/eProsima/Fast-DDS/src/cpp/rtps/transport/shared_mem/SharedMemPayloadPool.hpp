@@ -0,0 +1,210 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTDDS_SHAREDMEM_PAYLOAD_POOL_H_
+#define _FASTDDS_SHAREDMEM_PAYLOAD_POOL_H_
+
+#include <fastdds/rtps/common/CacheChange.h>
+
+#include <rtps/history/ILendingPayloadPool.hpp>
+#include <rtps/transport/shared_mem/SharedMemManager.hpp>
+
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Lends to the readers the payloads contained in received shared memory buffers.
+ *
+ * While a buffer is being processed by the MessageReceiver, it is registered with add_buffer().
+ * Every change referencing one of its payloads holds a reference on the buffer, which keeps
+ * its processing count incremented, so the sender does not reuse it until all those changes are released.
+ *
+ * There is a single instance in the process, as changes in the readers' histories can outlive the transport
+ * the buffer was received by.
+ */
+class SharedMemPayloadPool : public fastrtps::rtps::ILendingPayloadPool
+{
+public:
+
+    static const std::shared_ptr<SharedMemPayloadPool>& instance()
+    {
+        static std::shared_ptr<SharedMemPayloadPool> pool(new SharedMemPayloadPool());
+        return pool;
+    }
+
+    /**
+     * Makes the payloads of a buffer available to be referenced.
+     * @param buffer Received buffer.
+     * @param min_payload_size Payloads smaller than this are not referenced, but copied by the readers.
+     */
+    void add_buffer(
+            const std::shared_ptr<SharedMemManager::Buffer>& buffer,
+            uint32_t min_payload_size)
+    {
+        auto begin = static_cast<const fastrtps::rtps::octet*>(buffer->data());
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = buffers_.find(begin);
+        if (it == buffers_.end())
+        {
+            buffers_.emplace(begin, BufferEntry{buffer, begin + buffer->size(), min_payload_size, 1u});
+        }
+        else
+        {
+            // Also received on another port. Both buffers share the same data.
+            ++it->second.references;
+        }
+    }
+
+    /**
+     * Releases the reference taken by add_buffer().
+     * The buffer is kept alive until all the changes referencing its payloads are released.
+     * @param buffer Buffer given to add_buffer().
+     */
+    void remove_buffer(
+            const std::shared_ptr<SharedMemManager::Buffer>& buffer)
+    {
+        std::shared_ptr<SharedMemManager::Buffer> released;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = buffers_.find(static_cast<const fastrtps::rtps::octet*>(buffer->data()));
+        assert(it != buffers_.end());
+        dereference(it, released);
+    }
+
+    //! This pool cannot create payloads.
+    bool get_payload(
+            uint32_t /*size*/,
+            fastrtps::rtps::CacheChange_t& /*cache_change*/) override
+    {
+        return false;
+    }
+
+    /**
+     * Shares a payload contained in a registered buffer.
+     * @return false if the payload is not contained in a registered buffer, or if @c data_owner
+     * is nullptr and the payload is smaller than the size given to add_buffer().
+     */
+    bool get_payload(
+            fastrtps::rtps::SerializedPayload_t& data,
+            fastrtps::rtps::IPayloadPool*& data_owner,
+            fastrtps::rtps::CacheChange_t& cache_change) override
+    {
+        if (data_owner != nullptr && data_owner != this)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = find_buffer(data.data, data.length);
+        if (it == buffers_.end() || (data_owner == nullptr && data.length < it->second.min_payload_size))
+        {
+            return false;
+        }
+
+        ++it->second.references;
+        data_owner = this;
+
+        cache_change.serializedPayload.data = data.data;
+        cache_change.serializedPayload.length = data.length;
+        cache_change.serializedPayload.max_size = data.length;
+        cache_change.payload_owner(this);
+        return true;
+    }
+
+    bool release_payload(
+            fastrtps::rtps::CacheChange_t& cache_change) override
+    {
+        assert(cache_change.payload_owner() == this);
+
+        std::shared_ptr<SharedMemManager::Buffer> released;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            auto it = find_buffer(cache_change.serializedPayload.data, 0);
+            assert(it != buffers_.end());
+            dereference(it, released);
+        }
+
+        cache_change.serializedPayload.length = 0;
+        cache_change.serializedPayload.pos = 0;
+        cache_change.serializedPayload.max_size = 0;
+        cache_change.serializedPayload.data = nullptr;
+        cache_change.payload_owner(nullptr);
+        return true;
+    }
+
+    //! @return The number of buffers kept alive by the pool.
+    size_t buffers_in_use() const
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return buffers_.size();
+    }
+
+private:
+
+    struct BufferEntry
+    {
+        std::shared_ptr<SharedMemManager::Buffer> buffer;
+        const fastrtps::rtps::octet* end;
+        uint32_t min_payload_size;
+        uint32_t references;
+    };
+
+    using BufferMap = std::map<const fastrtps::rtps::octet*, BufferEntry>;
+
+    SharedMemPayloadPool() = default;
+
+    BufferMap::iterator find_buffer(
+            const fastrtps::rtps::octet* data,
+            uint32_t length)
+    {
+        auto it = buffers_.upper_bound(data);
+        if (it == buffers_.begin())
+        {
+            return buffers_.end();
+        }
+
+        --it;
+        return (data + length <= it->second.end && data < it->second.end) ? it : buffers_.end();
+    }
+
+    //! Drops a reference on a buffer. The last one is moved to @c released, to be freed out of the lock.
+    void dereference(
+            BufferMap::iterator it,
+            std::shared_ptr<SharedMemManager::Buffer>& released)
+    {
+        assert(it->second.references > 0);
+        if (--it->second.references == 0)
+        {
+            released = std::move(it->second.buffer);
+            buffers_.erase(it);
+        }
+    }
+
+    mutable std::mutex mutex_;
+
+    BufferMap buffers_;
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_SHAREDMEM_PAYLOAD_POOL_H_
@@ -0,0 +1,329 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FASTDDS_SHAREDMEM_SLAB_ALLOCATOR_H_
+#define _FASTDDS_SHAREDMEM_SLAB_ALLOCATOR_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+
+namespace eprosima {
+namespace fastdds {
+namespace rtps {
+
+/**
+ * Lock-free size-class allocator for the buffers of a shared-memory segment.
+ *
+ * The arena is a power of two bytes long and is handed out in blocks whose size is a power of two
+ * (from MIN_BLOCK_SIZE up to the whole arena). Each size class keeps a lock-free stack of free blocks,
+ * linked through their first bytes. Blocks are first carved from the untouched end of the arena and,
+ * when that is exhausted, by splitting the smallest free block of a larger class.
+ * Split blocks are not merged back, but the whole arena can be reclaimed with reset() when no block is in use.
+ *
+ * The state of the allocator (Header) is meant to live inside the shared-memory segment, but only the
+ * process owning the segment should allocate and deallocate.
+ */
+class SharedMemSlabAllocator
+{
+public:
+
+    static constexpr uint32_t MIN_BLOCK_SIZE_BITS = 8;
+    static constexpr uint32_t MIN_BLOCK_SIZE = 1u << MIN_BLOCK_SIZE_BITS;
+    static constexpr uint32_t MAX_ARENA_SIZE_BITS = 31;
+    static constexpr uint32_t MAX_SIZE_CLASSES = MAX_ARENA_SIZE_BITS - MIN_BLOCK_SIZE_BITS + 1;
+
+    /**
+     * Allocator state shared through the segment.
+     */
+    struct Header
+    {
+        Header()
+            : next_unused(0)
+        {
+            for (auto& free_list : free_lists)
+            {
+                free_list.store(make_head(0, NULL_OFFSET), std::memory_order_relaxed);
+            }
+        }
+
+        //! Tagged heads of the free block stacks of every size class.
+        std::atomic<uint64_t> free_lists[MAX_SIZE_CLASSES];
+        //! Offset of the first byte of the arena never allocated.
+        std::atomic<uint32_t> next_unused;
+    };
+
+    /**
+     * Computes the size of the arena needed to hold a buffer of a given size.
+     * @param payload_size Size of the biggest buffer that should fit in the arena.
+     * @return the arena size, which is a power of two.
+     * @throw std::runtime_error if payload_size is too large.
+     */
+    static uint32_t arena_size_for(
+            uint32_t payload_size)
+    {
+        if (payload_size > (1u << MAX_ARENA_SIZE_BITS))
+        {
+            throw std::runtime_error("segment too large for the slab allocator");
+        }
+
+        return block_size_of(size_class_of(payload_size));
+    }
+
+    /**
+     * @param header Allocator state, already constructed.
+     * @param arena First byte of the arena. Should be aligned to at least 8 bytes.
+     * @param arena_size Size of the arena, as returned by arena_size_for().
+     */
+    SharedMemSlabAllocator(
+            Header* header,
+            void* arena,
+            uint32_t arena_size)
+        : header_(header)
+        , arena_(static_cast<uint8_t*>(arena))
+        , arena_size_(arena_size)
+        , num_classes_(size_class_of(arena_size) + 1)
+    {
+        assert(arena_size == block_size_of(num_classes_ - 1));
+    }
+
+    /**
+     * Allocates a block.
+     * @param size Requested size in bytes.
+     * @return A pointer to a block of at least size bytes, or nullptr if there is no room for it.
+     */
+    void* allocate(
+            uint32_t size)
+    {
+        if (size > arena_size_)
+        {
+            return nullptr;
+        }
+
+        uint32_t size_class = size_class_of(size);
+        uint32_t offset = pop(size_class);
+
+        if (NULL_OFFSET == offset)
+        {
+            offset = carve(block_size_of(size_class));
+        }
+
+        if (NULL_OFFSET == offset)
+        {
+            offset = split(size_class);
+        }
+
+        return (NULL_OFFSET == offset) ? nullptr : arena_ + offset;
+    }
+
+    /**
+     * Returns a block to its size class.
+     * @param data Pointer returned by allocate().
+     * @param size Size given to allocate().
+     */
+    void deallocate(
+            void* data,
+            uint32_t size)
+    {
+        assert(data >= arena_ && static_cast<uint8_t*>(data) < arena_ + arena_size_);
+        push(size_class_of(size), static_cast<uint32_t>(static_cast<uint8_t*>(data) - arena_));
+    }
+
+    /**
+     * Checks whether an allocation would succeed.
+     * @param size Requested size in bytes.
+     * @return true if a block of size bytes is available.
+     */
+    bool can_allocate(
+            uint32_t size) const
+    {
+        if (size > arena_size_)
+        {
+            return false;
+        }
+
+        uint32_t size_class = size_class_of(size);
+        if (arena_size_ - header_->next_unused.load(std::memory_order_relaxed) >= block_size_of(size_class))
+        {
+            return true;
+        }
+
+        for (uint32_t i = size_class; i < num_classes_; ++i)
+        {
+            if (NULL_OFFSET != head_offset(header_->free_lists[i].load(std::memory_order_relaxed)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Makes the whole arena available again.
+     * @pre There are no allocated blocks, and no other thread is using the allocator.
+     */
+    void reset()
+    {
+        for (uint32_t i = 0; i < num_classes_; ++i)
+        {
+            uint64_t head = header_->free_lists[i].load(std::memory_order_relaxed);
+            header_->free_lists[i].store(make_head(head_tag(head) + 1, NULL_OFFSET), std::memory_order_relaxed);
+        }
+        header_->next_unused.store(0, std::memory_order_release);
+    }
+
+    uint32_t arena_size() const
+    {
+        return arena_size_;
+    }
+
+    //! @return The size of the block that would be given for a request of size bytes.
+    static uint32_t block_size(
+            uint32_t size)
+    {
+        return block_size_of(size_class_of(size));
+    }
+
+private:
+
+    static constexpr uint32_t NULL_OFFSET = 0xFFFFFFFFu;
+
+    Header* header_;
+    uint8_t* arena_;
+    uint32_t arena_size_;
+    uint32_t num_classes_;
+
+    static uint64_t make_head(
+            uint32_t tag,
+            uint32_t offset)
+    {
+        return (static_cast<uint64_t>(tag) << 32) | offset;
+    }
+
+    static uint32_t head_tag(
+            uint64_t head)
+    {
+        return static_cast<uint32_t>(head >> 32);
+    }
+
+    static uint32_t head_offset(
+            uint64_t head)
+    {
+        return static_cast<uint32_t>(head);
+    }
+
+    static uint32_t size_class_of(
+            uint32_t size)
+    {
+        uint32_t size_class = 0;
+        while (block_size_of(size_class) < size)
+        {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    static uint32_t block_size_of(
+            uint32_t size_class)
+    {
+        return MIN_BLOCK_SIZE << size_class;
+    }
+
+    std::atomic<uint32_t>& link(
+            uint32_t offset)
+    {
+        return *reinterpret_cast<std::atomic<uint32_t>*>(arena_ + offset);
+    }
+
+    uint32_t pop(
+            uint32_t size_class)
+    {
+        std::atomic<uint64_t>& free_list = header_->free_lists[size_class];
+        uint64_t head = free_list.load(std::memory_order_acquire);
+
+        while (NULL_OFFSET != head_offset(head))
+        {
+            // The tag protects from the block being popped and pushed again between both reads.
+            uint32_t next = link(head_offset(head)).load(std::memory_order_relaxed);
+            if (free_list.compare_exchange_weak(head, make_head(head_tag(head) + 1, next),
+                    std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return head_offset(head);
+            }
+        }
+
+        return NULL_OFFSET;
+    }
+
+    void push(
+            uint32_t size_class,
+            uint32_t offset)
+    {
+        std::atomic<uint64_t>& free_list = header_->free_lists[size_class];
+        uint64_t head = free_list.load(std::memory_order_relaxed);
+
+        do
+        {
+            link(offset).store(head_offset(head), std::memory_order_relaxed);
+        } while (!free_list.compare_exchange_weak(head, make_head(head_tag(head) + 1, offset),
+                std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    uint32_t carve(
+            uint32_t block_size)
+    {
+        uint32_t offset = header_->next_unused.load(std::memory_order_relaxed);
+
+        while (arena_size_ - offset >= block_size)
+        {
+            if (header_->next_unused.compare_exchange_weak(offset, offset + block_size,
+                    std::memory_order_relaxed, std::memory_order_relaxed))
+            {
+                return offset;
+            }
+        }
+
+        return NULL_OFFSET;
+    }
+
+    uint32_t split(
+            uint32_t size_class)
+    {
+        for (uint32_t bigger_class = size_class + 1; bigger_class < num_classes_; ++bigger_class)
+        {
+            uint32_t offset = pop(bigger_class);
+            if (NULL_OFFSET != offset)
+            {
+                // Keep the first part and give back the upper halves to the classes in between.
+                while (bigger_class > size_class)
+                {
+                    --bigger_class;
+                    push(bigger_class, offset + block_size_of(bigger_class));
+                }
+                return offset;
+            }
+        }
+
+        return NULL_OFFSET;
+    }
+
+};
+
+} // namespace rtps
+} // namespace fastdds
+} // namespace eprosima
+
+#endif // _FASTDDS_SHAREDMEM_SLAB_ALLOCATOR_H_
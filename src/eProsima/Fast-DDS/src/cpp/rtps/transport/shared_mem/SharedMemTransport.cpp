@@ -255,7 +255,7 @@ bool SharedMemTransport::init()
     {
         shared_mem_manager_ = SharedMemManager::create(SHM_MANAGER_DOMAIN);
         shared_mem_segment_ = shared_mem_manager_->create_segment(configuration_.segment_size(),
-                        configuration_.port_queue_capacity());
+                        configuration_.port_queue_capacity(), configuration_.segment_allocator());
 
         // Memset the whole segment to zero in order to force physical map of the buffer
         auto buffer = shared_mem_segment_->alloc_buffer(configuration_.segment_size(),
@@ -316,10 +316,11 @@ SharedMemChannelResource* SharedMemTransport::CreateInputChannelResource(
             locator.port,
             configuration_.port_queue_capacity(),
             configuration_.healthy_check_timeout_ms(),
-            open_mode)->create_listener(),
+            open_mode)->create_listener(std::chrono::microseconds(configuration_.listener_spin_time_us())),
         locator,
         receiver,
-        configuration_.rtps_dump_file());
+        configuration_.rtps_dump_file(),
+        configuration_.payload_reference_threshold());
 }
 
 bool SharedMemTransport::OpenOutputChannel(
@@ -24,6 +24,8 @@ namespace rtps {
 static constexpr uint32_t shm_default_segment_size = 0;
 static constexpr uint32_t shm_default_port_queue_capacity = 512;
 static constexpr uint32_t shm_default_healthy_check_timeout_ms = 1000;
+static constexpr uint32_t shm_default_listener_spin_time_us = 0;
+static constexpr uint32_t shm_default_payload_reference_threshold = 0;
 
 } // rtps
 } // fastdds
@@ -38,6 +40,9 @@ SharedMemTransportDescriptor::SharedMemTransportDescriptor()
     , port_queue_capacity_(shm_default_port_queue_capacity)
     , healthy_check_timeout_ms_(shm_default_healthy_check_timeout_ms)
     , rtps_dump_file_("")
+    , segment_allocator_(SegmentAllocator::BEST_FIT)
+    , listener_spin_time_us_(shm_default_listener_spin_time_us)
+    , payload_reference_threshold_(shm_default_payload_reference_threshold)
 {
     maxMessageSize = s_maximumMessageSize;
 }
@@ -49,6 +54,9 @@ SharedMemTransportDescriptor::SharedMemTransportDescriptor(
     , port_queue_capacity_(t.port_queue_capacity_)
     , healthy_check_timeout_ms_(t.healthy_check_timeout_ms_)
     , rtps_dump_file_(t.rtps_dump_file_)
+    , segment_allocator_(t.segment_allocator_)
+    , listener_spin_time_us_(t.listener_spin_time_us_)
+    , payload_reference_threshold_(t.payload_reference_threshold_)
 {
     maxMessageSize = t.max_message_size();
 }
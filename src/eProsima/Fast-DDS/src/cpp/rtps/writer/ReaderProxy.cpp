@@ -34,11 +34,23 @@
 #include <mutex>
 #include <cassert>
 #include <algorithm>
+#include <iterator>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Growing the collection of changes one by one would copy all the pending changes on each addition,
+ * so it grows in chunks the size of the initial allocation.
+ */
+static size_t changes_allocation_increment(
+        const HistoryAttributes& history_attributes)
+{
+    return history_attributes.initialReservedCaches > 0 ?
+           static_cast<size_t>(history_attributes.initialReservedCaches) : 1u;
+}
+
 ReaderProxy::ReaderProxy(
         const WriterTimes& times,
         const RemoteLocatorsAllocationAttributes& loc_alloc,
@@ -52,12 +64,14 @@ ReaderProxy::ReaderProxy(
     , is_reliable_(false)
     , disable_positive_acks_(false)
     , writer_(writer)
-    , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att, 0))
+    , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att,
+            changes_allocation_increment(writer->mp_history->m_att)))
     , nack_supression_event_(nullptr)
     , initial_heartbeat_event_(nullptr)
     , timers_enabled_(false)
     , last_acknack_count_(0)
     , last_nackfrag_count_(0)
+    , acked_changes_count_(0)
 {
     nack_supression_event_ = new TimedEvent(writer_->getRTPSParticipant()->getEventResource(),
                     [&]() -> bool
@@ -162,6 +176,8 @@ void ReaderProxy::stop()
     disable_timers();
 
     changes_for_reader_.clear();
+    acked_changes_count_ = 0;
+    std::fill(std::begin(changes_by_status_), std::end(changes_by_status_), 0u);
     last_acknack_count_ = 0;
     last_nackfrag_count_ = 0;
     changes_low_mark_ = SequenceNumber_t();
@@ -215,7 +231,7 @@ void ReaderProxy::add_change(
             change.getSequenceNumber() > changes_for_reader_.back().getSequenceNumber());
 
     // For best effort readers, changes are acked when being sent
-    if (changes_for_reader_.empty() && change.getStatus() == ACKNOWLEDGED)
+    if (!has_changes() && change.getStatus() == ACKNOWLEDGED)
     {
         changes_low_mark_ = change.getSequenceNumber();
         return;
@@ -227,7 +243,17 @@ void ReaderProxy::add_change(
         return;
     }
 
-    if (changes_for_reader_.push_back(change) == nullptr)
+    // Acknowledged changes may be occupying the room for this one
+    if (changes_for_reader_.size() == changes_for_reader_.max_size())
+    {
+        compact_changes();
+    }
+
+    if (changes_for_reader_.push_back(change) != nullptr)
+    {
+        ++changes_by_status_[change.getStatus()];
+    }
+    else
     {
         // This should never happen
         logError(RTPS_READER_PROXY, "Error adding change " << change.getSequenceNumber()
@@ -239,13 +265,13 @@ void ReaderProxy::add_change(
 
 bool ReaderProxy::has_changes() const
 {
-    return !changes_for_reader_.empty();
+    return 0 < changes_size();
 }
 
 bool ReaderProxy::change_is_acked(
         const SequenceNumber_t& seq_num) const
 {
-    if (seq_num <= changes_low_mark_ || changes_for_reader_.empty())
+    if (seq_num <= changes_low_mark_ || !has_changes())
     {
         return true;
     }
@@ -263,19 +289,19 @@ bool ReaderProxy::change_is_acked(
 
 SequenceNumber_t ReaderProxy::first_relevant_sequence_number() const
 {
-    if (changes_for_reader_.empty())
+    if (!has_changes())
     {
         return changes_low_mark_ + 1;
     }
 
-    return changes_for_reader_.front().getSequenceNumber();
+    return changes_begin()->getSequenceNumber();
 }
 
 bool ReaderProxy::change_is_unsent(
         const SequenceNumber_t& seq_num,
         bool& is_irrelevant) const
 {
-    if (seq_num <= changes_low_mark_ || changes_for_reader_.empty())
+    if (seq_num <= changes_low_mark_ || !has_changes())
     {
         return false;
     }
@@ -309,7 +335,7 @@ void ReaderProxy::acked_changes_set(
             ++chit;
             ++future_low_mark;
         }
-        changes_for_reader_.erase(changes_for_reader_.begin(), chit);
+        erase_acked_changes(chit);
     }
     else
     {
@@ -317,6 +343,9 @@ void ReaderProxy::acked_changes_set(
 
         if (seq_num == SequenceNumber_t() && durability_kind_ != DurabilityKind_t::VOLATILE)
         {
+            // Changes below the current low mark may become pending again
+            compact_changes();
+
             // Special case. Currently only used on Builtin StatefulWriters
             // after losing lease duration, and on late joiners to set
             // changes_low_mark_ to match that of the writer.
@@ -351,7 +380,10 @@ void ReaderProxy::acked_changes_set(
                             should_sort = true;
                             ChangeForReader_t cr(change);
                             cr.setStatus(UNACKNOWLEDGED);
-                            changes_for_reader_.push_back(cr);
+                            if (changes_for_reader_.push_back(cr) != nullptr)
+                            {
+                                ++changes_by_status_[UNACKNOWLEDGED];
+                            }
                         }
                     }
                 }
@@ -380,7 +412,7 @@ bool ReaderProxy::requested_changes_set(
                 ChangeIterator chit = find_change(sit, true);
                 if (chit != changes_for_reader_.end() && UNACKNOWLEDGED == chit->getStatus())
                 {
-                    chit->setStatus(REQUESTED);
+                    set_change_status(*chit, REQUESTED);
                     chit->markAllFragmentsAsUnsent();
                     isSomeoneWasSetRequested = true;
                 }
@@ -451,8 +483,8 @@ bool ReaderProxy::set_change_to_status(
         if (status == ACKNOWLEDGED && changes_low_mark_ == seq_num)
         {
             // Erase the first change when it is acknowledged
-            assert(it == changes_for_reader_.begin());
-            changes_for_reader_.erase(it);
+            assert(it == changes_begin());
+            erase_acked_changes(it + 1);
             acked_changes_set(seq_num + 1);
         }
         else
@@ -460,7 +492,7 @@ bool ReaderProxy::set_change_to_status(
             // Otherwise change status
             if (it->getStatus() != status)
             {
-                it->setStatus(status);
+                set_change_status(*it, status);
                 change_was_modified = true;
             }
         }
@@ -513,29 +545,34 @@ bool ReaderProxy::convert_status_on_all_changes(
     // NOTE: This is only called for REQUESTED=>UNSENT (acknack response) or
     //       UNDERWAY=>UNACKNOWLEDGED (nack supression)
 
-    bool at_least_one_modified = false;
-    for (ChangeForReader_t& change : changes_for_reader_)
+    if (0 == changes_by_status_[previous])
     {
-        if (change.getStatus() == previous)
+        return false;
+    }
+
+    for (ChangeIterator it = changes_begin(); it != changes_for_reader_.end(); ++it)
+    {
+        if (it->getStatus() == previous)
         {
-            at_least_one_modified = true;
-            change.setStatus(next);
+            it->setStatus(next);
         }
     }
 
-    return at_least_one_modified;
+    changes_by_status_[next] += changes_by_status_[previous];
+    changes_by_status_[previous] = 0;
+    return true;
 }
 
 void ReaderProxy::change_has_been_removed(
         const SequenceNumber_t& seq_num)
 {
     // Check sequence number is in the container, because it was not clean up.
-    if (changes_for_reader_.empty() || seq_num < changes_for_reader_.begin()->getSequenceNumber())
+    if (!has_changes() || seq_num < changes_begin()->getSequenceNumber())
     {
         return;
     }
 
-    auto chit = find_change(seq_num);
+    ChangeIterator chit = find_change(seq_num, true);
 
     if (chit == this->changes_for_reader_.end())
     {
@@ -550,7 +587,7 @@ void ReaderProxy::change_has_been_removed(
     }
 
     // Element may not be in the container when marked as irrelevant.
-    changes_for_reader_.erase(chit);
+    erase_change(chit);
 
     // When removing the next-to-be-acknowledged, we should auto-acknowledge it.
     if ((changes_low_mark_ + 1) == seq_num)
@@ -561,15 +598,7 @@ void ReaderProxy::change_has_been_removed(
 
 bool ReaderProxy::has_unacknowledged() const
 {
-    for (const ChangeForReader_t& it : changes_for_reader_)
-    {
-        if (it.getStatus() == UNACKNOWLEDGED)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return 0 < changes_by_status_[UNACKNOWLEDGED];
 }
 
 bool ReaderProxy::requested_fragment_set(
@@ -588,7 +617,7 @@ bool ReaderProxy::requested_fragment_set(
     // If it was UNSENT, we shouldn't switch back to REQUESTED to prevent stalling.
     if (changeIter->getStatus() != UNSENT)
     {
-        changeIter->setStatus(REQUESTED);
+        set_change_status(*changeIter, REQUESTED);
     }
 
     return true;
@@ -628,7 +657,7 @@ ReaderProxy::ChangeIterator ReaderProxy::find_change(
 {
     ReaderProxy::ChangeIterator it;
     ReaderProxy::ChangeIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
+    it = std::lower_bound(changes_begin(), end, seq_num, change_less_than_sequence);
 
     return (!exact)
            ? it
@@ -642,17 +671,45 @@ ReaderProxy::ChangeConstIterator ReaderProxy::find_change(
 {
     ReaderProxy::ChangeConstIterator it;
     ReaderProxy::ChangeConstIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
+    it = std::lower_bound(changes_begin(), end, seq_num, change_less_than_sequence);
 
     return it == end
            ? it
            : it->getSequenceNumber() == seq_num ? it : end;
 }
 
+void ReaderProxy::erase_acked_changes(
+        ChangeIterator first_not_acked)
+{
+    for (ChangeIterator it = changes_begin(); it != first_not_acked; ++it)
+    {
+        --changes_by_status_[it->getStatus()];
+    }
+
+    acked_changes_count_ = first_not_acked - changes_for_reader_.begin();
+    if (acked_changes_count_ >= changes_size())
+    {
+        compact_changes();
+    }
+}
+
+void ReaderProxy::compact_changes()
+{
+    changes_for_reader_.erase(changes_for_reader_.begin(), changes_begin());
+    acked_changes_count_ = 0;
+}
+
+void ReaderProxy::erase_change(
+        ChangeIterator change)
+{
+    --changes_by_status_[change->getStatus()];
+    changes_for_reader_.erase(change);
+}
+
 bool ReaderProxy::are_there_gaps()
 {
-    return (0 < changes_for_reader_.size() &&
-           changes_low_mark_ + uint32_t(changes_for_reader_.size()) !=
+    return (has_changes() &&
+           changes_low_mark_ + uint32_t(changes_size()) !=
            changes_for_reader_.rbegin()->getSequenceNumber());
 }
 
@@ -665,12 +722,12 @@ void ReaderProxy::send_gaps(
         try
         {
             if (are_there_gaps() ||
-                    (0 < changes_for_reader_.size() && next_seq != changes_for_reader_.rbegin()->getSequenceNumber()))
+                    (has_changes() && next_seq != changes_for_reader_.rbegin()->getSequenceNumber()))
             {
                 RTPSGapBuilder gap_builder(group);
                 SequenceNumber_t current_seq = changes_low_mark_ + 1;
 
-                for (ReaderProxy::ChangeConstIterator cit = changes_for_reader_.begin();
+                for (ReaderProxy::ChangeConstIterator cit = changes_begin();
                         cit != changes_for_reader_.end(); ++cit)
                 {
                     SequenceNumber_t seq_num = cit->getSequenceNumber();
@@ -312,6 +312,13 @@ void StatefulWriter::unsent_change_added_to_history(
             //TODO(Ricardo) Temporal.
             bool expectsInlineQos = false;
 
+            // The readers the change is not relevant for are deselected, so that it is only sent to the
+            // others. The selection is restored once the change was sent.
+            if (nullptr != reader_data_filter_)
+            {
+                locator_selector_.reset(true);
+            }
+
             // First step is to add the new CacheChange_t to all reader proxies.
             // It has to be done before sending, because if a timeout is caught, we will not include the
             // CacheChange_t in some reader proxies.
@@ -335,9 +342,23 @@ void StatefulWriter::unsent_change_added_to_history(
                     changeForReader.setStatus(UNACKNOWLEDGED);
                 }
 
-                changeForReader.setRelevance(it->rtps_is_relevant(change));
+                bool is_relevant = it->rtps_is_relevant(change);
+                changeForReader.setRelevance(is_relevant);
                 it->add_change(changeForReader, true, max_blocking_time);
-                expectsInlineQos |= it->expects_inline_qos();
+                if (is_relevant)
+                {
+                    expectsInlineQos |= it->expects_inline_qos();
+                }
+                else
+                {
+                    it->locator_selector_entry()->enable(false);
+                }
+            }
+
+            if (nullptr != reader_data_filter_ && locator_selector_.state_has_changed())
+            {
+                mp_RTPSParticipant->network_factory().select_locators(locator_selector_);
+                compute_selected_guids();
             }
 
             try
@@ -377,6 +398,11 @@ void StatefulWriter::unsent_change_added_to_history(
                         if (it->is_local_reader())
                         {
                             intraprocess_heartbeat(it, false);
+                            if (nullptr != reader_data_filter_ && !it->locator_selector_entry()->enabled)
+                            {
+                                intraprocess_gap(it, change->sequenceNumber);
+                                continue;
+                            }
                             bool delivered = intraprocess_delivery(change, it);
                             it->set_change_to_status(
                                 change->sequenceNumber,
@@ -389,7 +415,16 @@ void StatefulWriter::unsent_change_added_to_history(
                 {
                     for (ReaderProxy* it : matched_readers_)
                     {
-                        if (it->is_local_reader())
+                        if (nullptr != reader_data_filter_ && !it->locator_selector_entry()->enabled)
+                        {
+                            // The change isn't relevant for this reader
+                            if (it->is_local_reader())
+                            {
+                                intraprocess_heartbeat(it, false);
+                                intraprocess_gap(it, change->sequenceNumber);
+                            }
+                        }
+                        else if (it->is_local_reader())
                         {
                             intraprocess_heartbeat(it, false);
                             bool delivered = intraprocess_delivery(change, it);
@@ -437,6 +472,16 @@ void StatefulWriter::unsent_change_added_to_history(
             {
                 logError(RTPS_WRITER, "Max blocking time reached");
             }
+
+            if (nullptr != reader_data_filter_)
+            {
+                locator_selector_.reset(true);
+                if (locator_selector_.state_has_changed())
+                {
+                    mp_RTPSParticipant->network_factory().select_locators(locator_selector_);
+                    compute_selected_guids();
+                }
+            }
         }
         else
         {
@@ -1344,6 +1389,12 @@ bool StatefulWriter::matched_reader_add(
     matched_readers_.push_back(rp);
     update_reader_info(true);
 
+    // A late joiner may not have acknowledged changes already acknowledged by the rest of readers
+    if (rp->changes_low_mark() < min_readers_low_mark_)
+    {
+        min_readers_low_mark_ = rp->changes_low_mark();
+    }
+
     RTPSMessageGroup group(mp_RTPSParticipant, this, rp->message_sender());
 
     // Add initial heartbeat to message group
@@ -1585,6 +1636,13 @@ bool StatefulWriter::is_acked_by_all(
     }
 
     assert(mp_history->next_sequence_number() > change->sequenceNumber);
+
+    // Changes up to the lowest low mark of the readers are known to be acknowledged by all of them
+    if (change->sequenceNumber <= min_readers_low_mark_)
+    {
+        return true;
+    }
+
     return std::all_of(matched_readers_.begin(), matched_readers_.end(),
                    [change](const ReaderProxy* reader)
                    {
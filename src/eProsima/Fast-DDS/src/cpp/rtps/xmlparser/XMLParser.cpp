@@ -550,7 +550,8 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(
                 strcmp(name, SEGMENT_SIZE) == 0 || strcmp(name, PORT_QUEUE_CAPACITY) == 0 ||
                 strcmp(name, PORT_OVERFLOW_POLICY) == 0 || strcmp(name, SEGMENT_OVERFLOW_POLICY) == 0 ||
                 strcmp(name, HEALTHY_CHECK_TIMEOUT_MS) == 0 || strcmp(name, HEALTHY_CHECK_TIMEOUT_MS) == 0 ||
-                strcmp(name, RTPS_DUMP_FILE) == 0)
+                strcmp(name, RTPS_DUMP_FILE) == 0 || strcmp(name, SEGMENT_ALLOCATOR) == 0 ||
+                strcmp(name, LISTENER_SPIN_TIME_US) == 0 || strcmp(name, PAYLOAD_REFERENCE_THRESHOLD) == 0)
         {
             // Parsed outside of this method
         }
@@ -730,6 +731,9 @@ XMLP_ret XMLParser::parseXMLCommonSharedMemTransportData(
                 <xs:element name="port_queue_capacity" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="healthy_check_timeout_ms" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="rtps_dump_file" type="stringType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="segment_allocator" type="segmentAllocatorType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="listener_spin_time_us" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="payload_reference_threshold" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 </xs:all>
         </xs:complexType>
      */
@@ -769,6 +773,22 @@ XMLP_ret XMLParser::parseXMLCommonSharedMemTransportData(
                 }
                 transport_descriptor->healthy_check_timeout_ms(static_cast<uint32_t>(aux));
             }
+            else if (strcmp(name, LISTENER_SPIN_TIME_US) == 0)
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &aux, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                transport_descriptor->listener_spin_time_us(static_cast<uint32_t>(aux));
+            }
+            else if (strcmp(name, PAYLOAD_REFERENCE_THRESHOLD) == 0)
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &aux, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                transport_descriptor->payload_reference_threshold(static_cast<uint32_t>(aux));
+            }
             else if (strcmp(name, RTPS_DUMP_FILE) == 0)
             {
                 std::string str;
@@ -778,6 +798,30 @@ XMLP_ret XMLParser::parseXMLCommonSharedMemTransportData(
                 }
                 transport_descriptor->rtps_dump_file(str);
             }
+            else if (strcmp(name, SEGMENT_ALLOCATOR) == 0)
+            {
+                // segment_allocator - segmentAllocatorType
+                std::string str;
+                if (XMLP_ret::XML_OK != getXMLString(p_aux0, &str, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                if (str == BEST_FIT)
+                {
+                    transport_descriptor->segment_allocator(
+                        fastdds::rtps::SharedMemTransportDescriptor::SegmentAllocator::BEST_FIT);
+                }
+                else if (str == SLAB)
+                {
+                    transport_descriptor->segment_allocator(
+                        fastdds::rtps::SharedMemTransportDescriptor::SegmentAllocator::SLAB);
+                }
+                else
+                {
+                    logError(XMLPARSER, "Node '" << SEGMENT_ALLOCATOR << "' with bad content");
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
             else if (strcmp(name, MAX_MESSAGE_SIZE) == 0)
             {
                 // maxMessageSize - uint32Type
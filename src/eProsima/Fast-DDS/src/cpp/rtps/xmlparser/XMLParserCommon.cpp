@@ -65,6 +65,11 @@ const char* HEALTHY_CHECK_TIMEOUT_MS = "healthy_check_timeout_ms";
 const char* DISCARD = "DISCARD";
 const char* FAIL = "FAIL";
 const char* RTPS_DUMP_FILE = "rtps_dump_file";
+const char* SEGMENT_ALLOCATOR = "segment_allocator";
+const char* BEST_FIT = "BEST_FIT";
+const char* SLAB = "SLAB";
+const char* LISTENER_SPIN_TIME_US = "listener_spin_time_us";
+const char* PAYLOAD_REFERENCE_THRESHOLD = "payload_reference_threshold";
 
 const char* OFF = "OFF";
 const char* USER_DATA_ONLY = "USER_DATA_ONLY";
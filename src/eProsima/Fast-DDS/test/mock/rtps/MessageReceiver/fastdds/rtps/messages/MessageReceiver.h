@@ -30,6 +30,7 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+class IPayloadPool;
 class RTPSWriter;
 class RTPSReader;
 struct SubmessageHeader_t;
@@ -69,6 +70,14 @@ public:
     {
     }
 
+    void processCDRMsg(
+            const Locator_t& loc,
+            CDRMessage_t* msg,
+            IPayloadPool* /*payload_owner*/)
+    {
+        processCDRMsg(loc, msg);
+    }
+
     void setReceiverResource(
             ReceiverResource* /*receiverResource*/)
     {
@@ -0,0 +1,111 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/messages/MatchedReadersIndex.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+namespace {
+
+GUID_t make_guid(
+        uint8_t participant,
+        uint32_t key,
+        octet kind)
+{
+    GUID_t guid;
+    guid.guidPrefix.value[0] = 0x01;
+    guid.guidPrefix.value[1] = 0x0F;
+    guid.guidPrefix.value[11] = participant;
+    guid.entityId.value[0] = static_cast<octet>(key >> 16);
+    guid.entityId.value[1] = static_cast<octet>(key >> 8);
+    guid.entityId.value[2] = static_cast<octet>(key);
+    guid.entityId.value[3] = kind;
+    return guid;
+}
+
+/*!
+ * Readers each matched with their own remote writer. Readers are only used as opaque pointers by the index, so they
+ * are emulated with the addresses of the elements of a vector.
+ */
+struct MatchedReaders
+{
+    explicit MatchedReaders(
+            size_t count)
+        : storage(count)
+        , matched_writers(count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            GUID_t writer = make_guid(2, static_cast<uint32_t>(i), 0x02);
+            index.add(writer, make_guid(1, static_cast<uint32_t>(i), 0x07), reinterpret_cast<RTPSReader*>(&storage[i]));
+            matched_writers[i].push_back(writer);
+        }
+    }
+
+    std::vector<char> storage;
+    std::vector<std::vector<GUID_t>> matched_writers;
+    MatchedReadersIndex index;
+};
+
+} // namespace
+
+/*!
+ * Finding the readers of a submessage not directed to a specific reader by checking the matched writers of every
+ * reader, as MessageReceiver did before the index.
+ */
+static void BM_ScanMatchedWriters(
+        benchmark::State& state)
+{
+    MatchedReaders readers(static_cast<size_t>(state.range(0)));
+    GUID_t writer = make_guid(2, static_cast<uint32_t>(state.range(0) / 2), 0x02);
+
+    for (auto _ : state)
+    {
+        size_t found = 0;
+        for (const auto& writers : readers.matched_writers)
+        {
+            if (std::find(writers.begin(), writers.end(), writer) != writers.end())
+            {
+                ++found;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_ScanMatchedWriters)->RangeMultiplier(10)->Range(1, 1000);
+
+/*!
+ * Finding the same readers through the index.
+ */
+static void BM_IndexLookup(
+        benchmark::State& state)
+{
+    MatchedReaders readers(static_cast<size_t>(state.range(0)));
+    GUID_t writer = make_guid(2, static_cast<uint32_t>(state.range(0) / 2), 0x02);
+    MatchedReadersIndex::EntryList result;
+
+    for (auto _ : state)
+    {
+        readers.index.get_readers(writer, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_IndexLookup)->RangeMultiplier(10)->Range(1, 1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <fastrtps/rtps/resources/TimedEvent.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using eprosima::fastrtps::rtps::ResourceEvent;
+using eprosima::fastrtps::rtps::TimedEvent;
+using TimeClock = std::chrono::steady_clock;
+
+/*!
+ * Cost of restarting and cancelling a timer while many other timers are scheduled.
+ * The scheduled timers are far in the future, so that they stay registered in the service.
+ */
+static void BM_RestartCancel(
+        benchmark::State& state)
+{
+    ResourceEvent service;
+    service.init_thread();
+
+    std::vector<std::unique_ptr<TimedEvent>> scheduled;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        scheduled.emplace_back(new TimedEvent(service, []()
+                {
+                    return false;
+                }, 60000.0 + static_cast<double>(i)));
+        scheduled.back()->restart_timer();
+    }
+
+    TimedEvent event(service, []()
+            {
+                return false;
+            }, 1000.0);
+    for (auto _ : state)
+    {
+        event.restart_timer();
+        event.cancel_timer();
+    }
+
+    scheduled.clear();
+}
+BENCHMARK(BM_RestartCancel)->RangeMultiplier(16)->Range(1, 1 << 16);
+
+/*!
+ * Delay between the moment timers should trigger and the moment they do, with many timers of
+ * random periods scheduled at once.
+ */
+static void BM_TriggerLatency(
+        benchmark::State& state)
+{
+    const size_t num_events = static_cast<size_t>(state.range(0));
+
+    ResourceEvent service;
+    service.init_thread();
+
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> dis(1, 100);
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t num_triggered = 0;
+    std::vector<TimeClock::time_point> expected_times(num_events);
+    std::vector<double> latencies_us(num_events);
+
+    std::vector<std::unique_ptr<TimedEvent>> events;
+    std::vector<int> periods_ms;
+    for (size_t i = 0; i < num_events; ++i)
+    {
+        periods_ms.push_back(dis(gen));
+        events.emplace_back(new TimedEvent(service, [&, i]()
+                {
+                    std::lock_guard<std::mutex> guard(mtx);
+                    latencies_us[i] = std::chrono::duration<double, std::micro>(
+                        TimeClock::now() - expected_times[i]).count();
+                    ++num_triggered;
+                    cv.notify_one();
+                    return false;
+                }, periods_ms.back()));
+    }
+
+    std::vector<double> all_latencies_us;
+    for (auto _ : state)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            num_triggered = 0;
+        }
+        for (size_t i = 0; i < num_events; ++i)
+        {
+            expected_times[i] = TimeClock::now() + std::chrono::milliseconds(periods_ms[i]);
+            events[i]->restart_timer();
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        if (!cv.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return num_triggered == num_events;
+                }))
+        {
+            state.SkipWithError("Timers were not triggered");
+            break;
+        }
+        all_latencies_us.insert(all_latencies_us.end(), latencies_us.begin(), latencies_us.end());
+    }
+
+    if (!all_latencies_us.empty())
+    {
+        std::sort(all_latencies_us.begin(), all_latencies_us.end());
+        state.counters["latency_p50_us"] = all_latencies_us[all_latencies_us.size() / 2];
+        state.counters["latency_p99_us"] = all_latencies_us[all_latencies_us.size() * 99 / 100];
+        state.counters["latency_max_us"] = all_latencies_us.back();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_events));
+
+    events.clear();
+}
+BENCHMARK(BM_TriggerLatency)->Arg(1000)->Arg(100000)->Iterations(3)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,247 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/messages/MatchedReadersIndex.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+namespace {
+
+GUID_t make_guid(
+        uint8_t participant,
+        uint32_t key,
+        octet kind)
+{
+    GUID_t guid;
+    guid.guidPrefix.value[0] = 0x01;
+    guid.guidPrefix.value[1] = 0x0F;
+    guid.guidPrefix.value[11] = participant;
+    guid.entityId.value[0] = static_cast<octet>(key >> 16);
+    guid.entityId.value[1] = static_cast<octet>(key >> 8);
+    guid.entityId.value[2] = static_cast<octet>(key);
+    guid.entityId.value[3] = kind;
+    return guid;
+}
+
+GUID_t make_reader_guid(
+        uint32_t key)
+{
+    // User defined reader with key
+    return make_guid(1, key, 0x07);
+}
+
+GUID_t make_writer_guid(
+        uint32_t key)
+{
+    // User defined writer with key on a remote participant
+    return make_guid(2, key, 0x02);
+}
+
+/*!
+ * Readers are only used as opaque pointers by the index, so they are emulated with the addresses of the elements of
+ * a vector.
+ */
+struct FakeReaders
+{
+    explicit FakeReaders(
+            size_t count)
+        : storage(count)
+    {
+    }
+
+    RTPSReader* operator [](
+            size_t index)
+    {
+        return reinterpret_cast<RTPSReader*>(&storage[index]);
+    }
+
+    std::vector<char> storage;
+};
+
+} // namespace
+
+TEST(MatchedReadersIndexTests, is_indexed)
+{
+    EXPECT_TRUE(MatchedReadersIndex::is_indexed(make_reader_guid(1)));
+    EXPECT_TRUE(MatchedReadersIndex::is_indexed(make_guid(1, 1, 0x04)));
+
+    GUID_t builtin;
+    builtin.entityId = c_EntityId_SPDPReader;
+    EXPECT_FALSE(MatchedReadersIndex::is_indexed(builtin));
+    builtin.entityId = c_EntityId_SEDPSubReader;
+    EXPECT_FALSE(MatchedReadersIndex::is_indexed(builtin));
+    // Vendor specific
+    EXPECT_FALSE(MatchedReadersIndex::is_indexed(make_guid(1, 1, 0x47)));
+}
+
+TEST(MatchedReadersIndexTests, add_and_remove)
+{
+    MatchedReadersIndex index;
+    FakeReaders readers(3);
+    MatchedReadersIndex::EntryList result;
+
+    GUID_t writer_1 = make_writer_guid(1);
+    GUID_t writer_2 = make_writer_guid(2);
+
+    index.get_readers(writer_1, result);
+    EXPECT_TRUE(result.empty());
+
+    index.add(writer_1, make_reader_guid(1), readers[0]);
+    index.add(writer_1, make_reader_guid(2), readers[1]);
+    index.add(writer_2, make_reader_guid(2), readers[1]);
+    index.add(writer_2, make_reader_guid(3), readers[2]);
+
+    // Adding the same match twice has no effect
+    index.add(writer_1, make_reader_guid(1), readers[0]);
+
+    index.get_readers(writer_1, result);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(MatchedReadersIndex::Entry(make_reader_guid(1), readers[0]), result[0]);
+    EXPECT_EQ(MatchedReadersIndex::Entry(make_reader_guid(2), readers[1]), result[1]);
+
+    index.remove(writer_1, readers[0]);
+    index.get_readers(writer_1, result);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(readers[1], result[0].second);
+
+    // Removing an unknown match has no effect
+    index.remove(writer_1, readers[2]);
+    index.remove(make_writer_guid(3), readers[0]);
+    index.get_readers(writer_1, result);
+    EXPECT_EQ(1u, result.size());
+
+    index.get_readers(writer_2, result);
+    ASSERT_EQ(2u, result.size());
+
+    index.remove(writer_1, readers[1]);
+    index.get_readers(writer_1, result);
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(MatchedReadersIndexTests, remove_reader)
+{
+    MatchedReadersIndex index;
+    FakeReaders readers(2);
+    MatchedReadersIndex::EntryList result;
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        index.add(make_writer_guid(i), make_reader_guid(1), readers[0]);
+        index.add(make_writer_guid(i), make_reader_guid(2), readers[1]);
+    }
+
+    index.remove_reader(readers[0]);
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        index.get_readers(make_writer_guid(i), result);
+        ASSERT_EQ(1u, result.size());
+        EXPECT_EQ(readers[1], result[0].second);
+    }
+
+    index.remove_reader(readers[1]);
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        index.get_readers(make_writer_guid(i), result);
+        EXPECT_TRUE(result.empty());
+    }
+}
+
+TEST(MatchedReadersIndexTests, builtin_readers_not_indexed)
+{
+    MatchedReadersIndex index;
+    FakeReaders readers(1);
+    MatchedReadersIndex::EntryList result;
+
+    GUID_t builtin;
+    builtin.entityId = c_EntityId_SEDPPubReader;
+    GUID_t writer;
+    writer.entityId = c_EntityId_SEDPPubWriter;
+
+    index.add(writer, builtin, readers[0]);
+    index.get_readers(writer, result);
+    EXPECT_TRUE(result.empty());
+}
+
+/*!
+ * The readers found for a writer are the ones found by checking the matched writers of every reader, which is what
+ * MessageReceiver did before the index, in the order the matches were added.
+ */
+TEST(MatchedReadersIndexTests, same_readers_as_scan)
+{
+    const size_t num_readers = 200;
+    const uint32_t num_writers = 50;
+
+    MatchedReadersIndex index;
+    FakeReaders readers(num_readers);
+    std::vector<std::vector<GUID_t>> matched_writers(num_readers);
+
+    // Each reader matches a few writers, some of which it later unmatches
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> writer_dis(0, num_writers - 1);
+    for (size_t i = 0; i < num_readers; ++i)
+    {
+        for (int n = 0; n < 3; ++n)
+        {
+            GUID_t writer = make_writer_guid(writer_dis(gen));
+            index.add(writer, make_reader_guid(static_cast<uint32_t>(i)), readers[i]);
+            if (std::find(matched_writers[i].begin(), matched_writers[i].end(), writer) == matched_writers[i].end())
+            {
+                matched_writers[i].push_back(writer);
+            }
+        }
+    }
+    for (size_t i = 0; i < num_readers; i += 3)
+    {
+        index.remove(matched_writers[i].front(), readers[i]);
+        matched_writers[i].erase(matched_writers[i].begin());
+    }
+
+    MatchedReadersIndex::EntryList result;
+    for (uint32_t w = 0; w < num_writers; ++w)
+    {
+        GUID_t writer = make_writer_guid(w);
+        std::vector<RTPSReader*> expected;
+        for (size_t i = 0; i < num_readers; ++i)
+        {
+            if (std::find(matched_writers[i].begin(), matched_writers[i].end(), writer) != matched_writers[i].end())
+            {
+                expected.push_back(readers[i]);
+            }
+        }
+
+        index.get_readers(writer, result);
+        std::vector<RTPSReader*> found;
+        for (const auto& entry : result)
+        {
+            found.push_back(entry.second);
+        }
+        EXPECT_EQ(expected, found) << "writer " << w;
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
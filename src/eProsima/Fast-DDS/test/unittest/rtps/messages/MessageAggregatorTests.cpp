@@ -0,0 +1,372 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/messages/MessageAggregator.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+namespace {
+
+/*!
+ * Builds RTPS messages with little endian submessages filled with a given value.
+ */
+class MessageBuilder
+{
+public:
+
+    explicit MessageBuilder(
+            octet participant = 1)
+        : bytes_({ 'R', 'T', 'P', 'S', 2, 3, 1, 15, 1, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, participant })
+    {
+    }
+
+    MessageBuilder& submessage(
+            octet id,
+            uint16_t length,
+            octet value = 0xAB,
+            octet flags = 0x01)
+    {
+        bytes_.push_back(id);
+        bytes_.push_back(flags);
+        bytes_.push_back(static_cast<octet>(length));
+        bytes_.push_back(static_cast<octet>(length >> 8));
+        bytes_.insert(bytes_.end(), length, value);
+        return *this;
+    }
+
+    MessageBuilder& info_ts()
+    {
+        return submessage(INFO_TS, 8, 0x11);
+    }
+
+    MessageBuilder& info_dst()
+    {
+        return submessage(INFO_DST, 12, 0x22);
+    }
+
+    MessageBuilder& data(
+            uint16_t length = 64)
+    {
+        return submessage(DATA, length, 0x33);
+    }
+
+    MessageBuilder& heartbeat()
+    {
+        return submessage(HEARTBEAT, 28, 0x44);
+    }
+
+    const std::vector<octet>& bytes() const
+    {
+        return bytes_;
+    }
+
+    //! @return The message without its RTPS header.
+    std::vector<octet> body() const
+    {
+        return std::vector<octet>(bytes_.begin() + RTPSMESSAGE_HEADER_SIZE, bytes_.end());
+    }
+
+    CDRMessage_t& message()
+    {
+        message_.reset(new CDRMessage_t(static_cast<uint32_t>(bytes_.size())));
+        memcpy(message_->buffer, bytes_.data(), bytes_.size());
+        message_->length = static_cast<uint32_t>(bytes_.size());
+        return *message_;
+    }
+
+private:
+
+    std::vector<octet> bytes_;
+    std::unique_ptr<CDRMessage_t> message_;
+};
+
+//! A datagram given to the send function.
+struct Datagram
+{
+    Locator_t locator;
+    std::vector<octet> bytes;
+};
+
+Locator_t make_locator(
+        uint32_t port)
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_UDPv4;
+    locator.port = port;
+    locator.address[12] = 127;
+    locator.address[15] = 1;
+    return locator;
+}
+
+class MessageAggregatorTests : public ::testing::Test
+{
+public:
+
+    MessageAggregatorTests()
+        : aggregator(1024, [this](
+                    const octet* data,
+                    uint32_t length,
+                    const Locator_t& locator,
+                    const std::chrono::steady_clock::time_point&)
+                {
+                    sent.push_back({ locator, std::vector<octet>(data, data + length) });
+                })
+        , locators({ make_locator(7400), make_locator(7410) })
+    {
+    }
+
+    bool add(
+            MessageBuilder& builder,
+            size_t first_locator = 0,
+            size_t num_locators = 1)
+    {
+        return aggregator.add(builder.message(), Locators(locators.begin() + first_locator),
+                       Locators(locators.begin() + first_locator + num_locators), timeout());
+    }
+
+    static std::chrono::steady_clock::time_point timeout()
+    {
+        return std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    }
+
+    static std::vector<octet> concat(
+            std::vector<octet> first,
+            const std::vector<octet>& second)
+    {
+        first.insert(first.end(), second.begin(), second.end());
+        return first;
+    }
+
+    MessageAggregator aggregator;
+    std::vector<Locator_t> locators;
+    std::vector<Datagram> sent;
+};
+
+} // namespace
+
+TEST_F(MessageAggregatorTests, concatenates_messages_for_the_same_locator)
+{
+    MessageBuilder first;
+    first.info_ts().data();
+    MessageBuilder second;
+    second.info_ts().data(128);
+
+    EXPECT_TRUE(add(first, 0, 2));
+    EXPECT_TRUE(add(second));
+    EXPECT_TRUE(sent.empty());
+
+    aggregator.flush(timeout());
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(locators[0], sent[0].locator);
+    EXPECT_EQ(concat(first.bytes(), second.body()), sent[0].bytes);
+    EXPECT_EQ(locators[1], sent[1].locator);
+    EXPECT_EQ(first.bytes(), sent[1].bytes);
+
+    MessageAggregator::Statistics statistics = aggregator.statistics();
+    EXPECT_EQ(3u, statistics.messages_added);
+    EXPECT_EQ(2u, statistics.datagrams_sent);
+
+    // Nothing else to send
+    aggregator.flush(timeout());
+    EXPECT_EQ(2u, sent.size());
+}
+
+TEST_F(MessageAggregatorTests, flushes_when_budget_is_exceeded)
+{
+    MessageBuilder message;
+    message.info_ts().data(400);
+    ASSERT_LT(message.bytes().size() * 2, aggregator.max_bytes());
+    ASSERT_GT(message.bytes().size() * 3, aggregator.max_bytes());
+
+    add(message);
+    add(message);
+    EXPECT_TRUE(sent.empty());
+    add(message);
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(concat(message.bytes(), message.body()), sent[0].bytes);
+
+    aggregator.flush(timeout());
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(message.bytes(), sent[1].bytes);
+}
+
+TEST_F(MessageAggregatorTests, flushes_when_header_differs)
+{
+    MessageBuilder first(1);
+    first.info_ts().data();
+    MessageBuilder second(2);
+    second.info_ts().data();
+
+    add(first);
+    add(second);
+    aggregator.flush(timeout());
+
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(first.bytes(), sent[0].bytes);
+    EXPECT_EQ(second.bytes(), sent[1].bytes);
+}
+
+TEST_F(MessageAggregatorTests, keeps_destination)
+{
+    MessageBuilder directed;
+    directed.info_dst().heartbeat();
+    MessageBuilder undirected;
+    undirected.heartbeat();
+
+    // A message without destination can be followed by a directed one
+    add(undirected);
+    add(directed);
+    // But not the opposite
+    add(undirected);
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(concat(undirected.bytes(), directed.body()), sent[0].bytes);
+
+    aggregator.flush(timeout());
+    ASSERT_EQ(2u, sent.size());
+    EXPECT_EQ(undirected.bytes(), sent[1].bytes);
+
+    // Directed messages can follow directed messages
+    add(directed);
+    add(directed);
+    aggregator.flush(timeout());
+    ASSERT_EQ(3u, sent.size());
+    EXPECT_EQ(concat(directed.bytes(), directed.body()), sent[2].bytes);
+}
+
+TEST_F(MessageAggregatorTests, invalidates_timestamp)
+{
+    MessageBuilder timestamped;
+    timestamped.info_ts().data();
+    MessageBuilder not_timestamped;
+    not_timestamped.heartbeat();
+
+    add(timestamped);
+    add(not_timestamped);
+    add(not_timestamped);
+    aggregator.flush(timeout());
+
+    const std::vector<octet> invalidate_ts = { INFO_TS, 0x03, 0x00, 0x00 };
+    ASSERT_EQ(1u, sent.size());
+    EXPECT_EQ(concat(concat(concat(timestamped.bytes(), invalidate_ts), not_timestamped.body()),
+            not_timestamped.body()), sent[0].bytes);
+}
+
+TEST_F(MessageAggregatorTests, sends_other_messages_directly)
+{
+    MessageBuilder message;
+    message.info_ts().data();
+    MessageBuilder with_source;
+    with_source.submessage(INFO_SRC, 20).data();
+    MessageBuilder unaligned;
+    unaligned.data(62);
+    MessageBuilder to_end;
+    to_end.info_ts().submessage(DATA, 0);
+
+    for (MessageBuilder* other : { &with_source, &unaligned, &to_end })
+    {
+        sent.clear();
+
+        add(message);
+        // The message for the first locator is still pending
+        EXPECT_TRUE(add(*other, 1));
+        ASSERT_EQ(1u, sent.size());
+        EXPECT_EQ(locators[1], sent[0].locator);
+        EXPECT_EQ(other->bytes(), sent[0].bytes);
+
+        // What was pending for the locator is sent first
+        EXPECT_FALSE(add(*other));
+        ASSERT_EQ(3u, sent.size());
+        EXPECT_EQ(message.bytes(), sent[1].bytes);
+        EXPECT_EQ(other->bytes(), sent[2].bytes);
+    }
+}
+
+/*!
+ * Emulates 50 writers publishing at 100 Hz to the same two locators, with the aggregation window flushed every
+ * millisecond, and reports the datagrams per second saved by the aggregation.
+ */
+TEST(MessageAggregatorPerformance, packets_per_second_saved)
+{
+    using clock = std::chrono::steady_clock;
+    const uint32_t num_writers = 50;
+    const uint32_t rate_hz = 100;
+    const uint32_t window_us = 1000;
+    const uint32_t seconds = 10;
+
+    std::vector<Locator_t> locators = { make_locator(7400), make_locator(7410) };
+    uint64_t bytes_sent = 0;
+    MessageAggregator aggregator(65500, [&bytes_sent](
+                const octet*,
+                uint32_t length,
+                const Locator_t&,
+                const clock::time_point&)
+            {
+                bytes_sent += length;
+            });
+
+    for (uint32_t size : { 64u, 512u, 4096u })
+    {
+        MessageBuilder message;
+        message.info_ts().data(static_cast<uint16_t>(size));
+        CDRMessage_t& msg = message.message();
+        MessageAggregator::Statistics before = aggregator.statistics();
+
+        // Writers are evenly spread over the period
+        const uint64_t period_us = 1000000 / rate_hz;
+        const uint64_t total_messages = static_cast<uint64_t>(num_writers) * rate_hz * seconds;
+        uint64_t next_flush_us = window_us;
+        auto start = clock::now();
+        for (uint64_t n = 0; n < total_messages; ++n)
+        {
+            uint64_t now_us = n * period_us / num_writers;
+            if (now_us >= next_flush_us)
+            {
+                aggregator.flush(clock::time_point::max());
+                next_flush_us = now_us + window_us;
+            }
+            aggregator.add(msg, Locators(locators.begin()), Locators(locators.end()), clock::time_point::max());
+        }
+        aggregator.flush(clock::time_point::max());
+        auto elapsed = clock::now() - start;
+
+        MessageAggregator::Statistics after = aggregator.statistics();
+        uint64_t messages = after.messages_added - before.messages_added;
+        uint64_t datagrams = after.datagrams_sent - before.datagrams_sent;
+        EXPECT_EQ(total_messages * locators.size(), messages);
+        EXPECT_LT(datagrams, messages);
+
+        std::cout << size << " bytes: " << messages / seconds << " messages/s sent in " << datagrams / seconds
+                  << " datagrams/s (" << (messages - datagrams) / seconds << " packets/s saved), "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+            static_cast<double>(messages) << " ns per message" << std::endl;
+    }
+
+    EXPECT_LT(0u, bytes_sent);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -14,8 +14,10 @@
 
 #include "mock/MockEvent.h"
 #include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <memory>
 #include <thread>
 #include <random>
+#include <vector>
 #include <gtest/gtest.h>
 
 class TimedEventEnvironment : public ::testing::Environment
@@ -407,6 +409,100 @@ TEST(TimedEventMultithread, PendingRaceCheck)
     delete checking_thr;
 }
 
+/*!
+ * @fn TEST(TimedEventStress, Event_ManyTimers)
+ * @brief This test checks the event service copes with a large number of scheduled events.
+ * It starts 10000 events with random periods and cancels one out of four of them.
+ * All the other events have to be triggered once, never before their period elapsed,
+ * and the cancelled ones never.
+ */
+TEST(TimedEventStress, Event_ManyTimers)
+{
+    using TimedEvent = eprosima::fastrtps::rtps::TimedEvent;
+    using TimeClock = std::chrono::steady_clock;
+
+    constexpr size_t num_events = 10000;
+    constexpr int cancelled_period_ms = 1000;
+
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> dis(1, 500);
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t num_triggered = 0;
+    std::atomic<size_t> num_cancelled_triggered(0);
+    std::vector<TimeClock::time_point> expected_times(num_events);
+    std::vector<TimeClock::time_point> trigger_times(num_events);
+    std::vector<int> trigger_counts(num_events, 0);
+
+    std::vector<std::unique_ptr<TimedEvent>> events;
+    std::vector<int> periods_ms;
+    events.reserve(num_events);
+    periods_ms.reserve(num_events);
+    for (size_t i = 0; i < num_events; ++i)
+    {
+        bool cancelled = (i % 4) == 3;
+        periods_ms.push_back(cancelled ? cancelled_period_ms : dis(gen));
+
+        auto callback = [&, i, cancelled]()
+                {
+                    if (cancelled)
+                    {
+                        ++num_cancelled_triggered;
+                        return false;
+                    }
+
+                    std::lock_guard<std::mutex> guard(mtx);
+                    trigger_times[i] = TimeClock::now();
+                    ++trigger_counts[i];
+                    ++num_triggered;
+                    cv.notify_one();
+                    return false;
+                };
+        events.emplace_back(new TimedEvent(*env->service_, callback, periods_ms.back()));
+    }
+
+    TimeClock::time_point start_time = TimeClock::now();
+    for (size_t i = 0; i < num_events; ++i)
+    {
+        expected_times[i] = TimeClock::now() + std::chrono::milliseconds(periods_ms[i]);
+        events[i]->restart_timer();
+    }
+    for (size_t i = 3; i < num_events; i += 4)
+    {
+        events[i]->cancel_timer();
+    }
+
+    size_t expected_triggered = num_events - num_events / 4;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return num_triggered == expected_triggered;
+                }));
+    }
+
+    // Give the cancelled events time to be wrongly triggered.
+    std::this_thread::sleep_until(start_time + std::chrono::milliseconds(cancelled_period_ms + 100));
+    EXPECT_EQ(0u, num_cancelled_triggered.load());
+
+    {
+        std::lock_guard<std::mutex> guard(mtx);
+        EXPECT_EQ(expected_triggered, num_triggered);
+        for (size_t i = 0; i < num_events; ++i)
+        {
+            if ((i % 4) != 3)
+            {
+                EXPECT_EQ(1, trigger_counts[i]) << "event " << i;
+                EXPECT_TRUE(trigger_times[i] >= expected_times[i]) << "event " << i << " triggered early";
+            }
+        }
+    }
+
+    // Destroying the events unregisters them from the service.
+    events.clear();
+}
+
 int main(
         int argc,
         char** argv)
@@ -15,6 +15,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+#include <vector>
+
 #include <fastrtps/rtps/writer/ReaderProxy.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
@@ -133,6 +137,147 @@ TEST(ReaderProxyTests, are_there_gaps)
     ASSERT_FALSE(rproxy.are_there_gaps());
 }
 
+TEST(ReaderProxyTests, acked_changes_are_skipped)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        ChangeForReader_t change(SequenceNumber_t(0, i));
+        change.setStatus(UNACKNOWLEDGED);
+        rproxy.add_change(change, false);
+    }
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+
+    // Acknowledge one by one, so acknowledged changes are kept for a while at the beginning of the collection
+    for (uint32_t i = 1; i <= 9; ++i)
+    {
+        rproxy.acked_changes_set(SequenceNumber_t(0, i + 1));
+        ASSERT_EQ(SequenceNumber_t(0, i), rproxy.changes_low_mark());
+        ASSERT_EQ(SequenceNumber_t(0, i + 1), rproxy.first_relevant_sequence_number());
+        ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, i)));
+        ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, i + 1)));
+        ASSERT_FALSE(rproxy.are_there_gaps());
+        ASSERT_TRUE(rproxy.has_changes());
+        ASSERT_TRUE(rproxy.has_unacknowledged());
+    }
+
+    // Acknowledged changes cannot be requested
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 5));
+    requested.add(SequenceNumber_t(0, 5));
+    requested.add(SequenceNumber_t(0, 10));
+    ASSERT_TRUE(rproxy.requested_changes_set(requested));
+    ASSERT_FALSE(rproxy.has_unacknowledged());
+    ASSERT_TRUE(rproxy.perform_acknack_response());
+    ASSERT_FALSE(rproxy.perform_acknack_response());
+
+    bool is_irrelevant = true;
+    ASSERT_TRUE(rproxy.change_is_unsent(SequenceNumber_t(0, 10), is_irrelevant));
+    ASSERT_FALSE(is_irrelevant);
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 11));
+    ASSERT_FALSE(rproxy.has_changes());
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 10)));
+    ASSERT_EQ(SequenceNumber_t(0, 11), rproxy.first_relevant_sequence_number());
+}
+
+TEST(ReaderProxyTests, for_each_unsent_change)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+
+    std::vector<SequenceNumber_t> unsent;
+    std::vector<SequenceNumber_t> irrelevant;
+    auto collect = [&](const SequenceNumber_t& seq, const ChangeForReader_t* change)
+            {
+                (change != nullptr ? unsent : irrelevant).push_back(seq);
+            };
+
+    ChangeForReader_t change_1(SequenceNumber_t(0, 1));
+    change_1.setStatus(UNDERWAY);
+    rproxy.add_change(change_1, false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 2)), false);
+    ChangeForReader_t change_3(SequenceNumber_t(0, 3));
+    change_3.setStatus(UNDERWAY);
+    rproxy.add_change(change_3, false);
+
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 4), collect);
+    ASSERT_EQ(std::vector<SequenceNumber_t>{ SequenceNumber_t(0, 2) }, unsent);
+    ASSERT_TRUE(irrelevant.empty());
+
+    // Nothing to inform when all changes have been sent and there are no holes
+    rproxy.set_change_to_status(SequenceNumber_t(0, 2), UNDERWAY, false);
+    unsent.clear();
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 4), collect);
+    ASSERT_TRUE(unsent.empty());
+    ASSERT_TRUE(irrelevant.empty());
+
+    // But holes are still informed
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 6), collect);
+    ASSERT_TRUE(unsent.empty());
+    ASSERT_EQ((std::vector<SequenceNumber_t>{ SequenceNumber_t(0, 4), SequenceNumber_t(0, 5) }), irrelevant);
+
+    irrelevant.clear();
+    rproxy.change_has_been_removed(SequenceNumber_t(0, 2));
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 4), collect);
+    ASSERT_TRUE(unsent.empty());
+    ASSERT_EQ(std::vector<SequenceNumber_t>{ SequenceNumber_t(0, 2) }, irrelevant);
+
+    ASSERT_TRUE(rproxy.perform_nack_supression());
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+    ASSERT_FALSE(rproxy.perform_nack_supression());
+}
+
+/*!
+ * Measures the cost of processing an ACKNACK acknowledging a single change, and of checking for unacknowledged
+ * changes, with different numbers of changes pending acknowledgement.
+ */
+TEST(ReaderProxyPerformance, acknack_cost)
+{
+    using clock = std::chrono::steady_clock;
+
+    for (uint32_t depth : { 100u, 1000u, 10000u })
+    {
+        StatefulWriter writerMock;
+        WriterTimes wTimes;
+        RemoteLocatorsAllocationAttributes alloc;
+        ReaderProxy rproxy(wTimes, alloc, &writerMock);
+
+        uint32_t next_seq = 1;
+        for (; next_seq <= depth; ++next_seq)
+        {
+            ChangeForReader_t change(SequenceNumber_t(0, next_seq));
+            change.setStatus(UNACKNOWLEDGED);
+            rproxy.add_change(change, false);
+        }
+
+        // Keep the number of pending changes while acknowledging them one by one
+        const uint32_t iterations = 10000;
+        bool has_unacknowledged = true;
+        auto start = clock::now();
+        for (uint32_t n = 0; n < iterations; ++n)
+        {
+            rproxy.acked_changes_set(rproxy.changes_low_mark() + 2);
+            has_unacknowledged &= rproxy.has_unacknowledged();
+            ChangeForReader_t change(SequenceNumber_t(0, next_seq++));
+            change.setStatus(UNACKNOWLEDGED);
+            rproxy.add_change(change, false);
+        }
+        auto elapsed = clock::now() - start;
+
+        ASSERT_TRUE(has_unacknowledged);
+        ASSERT_EQ(SequenceNumber_t(0, iterations), rproxy.changes_low_mark());
+        std::cout << depth << " pending changes: "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+            static_cast<double>(iterations) << " ns per acknack" << std::endl;
+    }
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
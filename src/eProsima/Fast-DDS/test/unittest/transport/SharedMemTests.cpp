@@ -19,9 +19,11 @@
 #include <SharedMemGlobalMock.hpp>
 #include "../../../src/cpp/rtps/transport/shared_mem/SharedMemSenderResource.hpp"
 #include "../../../src/cpp/rtps/transport/shared_mem/SharedMemManager.hpp"
+#include "../../../src/cpp/rtps/transport/shared_mem/SharedMemPayloadPool.hpp"
 #include "../../../src/cpp/rtps/transport/shared_mem/SharedMemGlobal.hpp"
 #include "../../../src/cpp/rtps/transport/shared_mem/MultiProducerConsumerRingBuffer.hpp"
 
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <streambuf>
@@ -1619,6 +1621,632 @@ TEST_F(SHMTransportTests, buffer_recover)
     thread_listener2.join();
 }
 
+TEST_F(SHMTransportTests, slab_allocator)
+{
+    constexpr uint32_t min_block = SharedMemSlabAllocator::MIN_BLOCK_SIZE;
+
+    EXPECT_EQ(min_block, SharedMemSlabAllocator::arena_size_for(1u));
+    EXPECT_EQ(4u * min_block, SharedMemSlabAllocator::arena_size_for(3u * min_block));
+    EXPECT_EQ(min_block, SharedMemSlabAllocator::block_size(min_block));
+    EXPECT_EQ(2u * min_block, SharedMemSlabAllocator::block_size(min_block + 1u));
+
+    const uint32_t arena_size = 8u * min_block;
+    SharedMemSlabAllocator::Header header;
+    std::vector<uint64_t> arena(arena_size / sizeof(uint64_t));
+    SharedMemSlabAllocator allocator(&header, arena.data(), arena_size);
+
+    EXPECT_EQ(nullptr, allocator.allocate(arena_size + 1u));
+    EXPECT_FALSE(allocator.can_allocate(arena_size + 1u));
+
+    // Freed blocks are reused by requests of the same class
+    void* small = allocator.allocate(1u);
+    ASSERT_NE(nullptr, small);
+    allocator.deallocate(small, 1u);
+    EXPECT_EQ(small, allocator.allocate(min_block));
+
+    // The rest of the arena is carved
+    void* big = allocator.allocate(4u * min_block);
+    ASSERT_NE(nullptr, big);
+    void* medium = allocator.allocate(2u * min_block);
+    ASSERT_NE(nullptr, medium);
+    EXPECT_EQ(nullptr, allocator.allocate(2u * min_block));
+    EXPECT_FALSE(allocator.can_allocate(2u * min_block));
+    EXPECT_TRUE(allocator.can_allocate(min_block));
+
+    // Bigger free blocks are split for smaller requests
+    allocator.deallocate(big, 4u * min_block);
+    std::vector<void*> blocks;
+    while (allocator.can_allocate(min_block))
+    {
+        void* block = allocator.allocate(min_block);
+        ASSERT_NE(nullptr, block);
+        blocks.push_back(block);
+    }
+    EXPECT_EQ(5u, blocks.size());
+    for (void* block : blocks)
+    {
+        EXPECT_GE(static_cast<uint8_t*>(block), reinterpret_cast<uint8_t*>(arena.data()));
+        EXPECT_LT(static_cast<uint8_t*>(block), reinterpret_cast<uint8_t*>(arena.data()) + arena_size);
+    }
+
+    // Split blocks are only joined again by reset
+    for (void* block : blocks)
+    {
+        allocator.deallocate(block, min_block);
+    }
+    allocator.deallocate(small, min_block);
+    allocator.deallocate(medium, 2u * min_block);
+    EXPECT_FALSE(allocator.can_allocate(arena_size));
+    allocator.reset();
+    EXPECT_TRUE(allocator.can_allocate(arena_size));
+    EXPECT_EQ(static_cast<void*>(arena.data()), allocator.allocate(arena_size));
+}
+
+TEST_F(SHMTransportTests, slab_allocator_multithread)
+{
+    constexpr uint32_t num_threads = 4u;
+    constexpr uint32_t blocks_per_thread = 8u;
+    constexpr uint32_t iterations = 10000u;
+    const uint32_t block_size = SharedMemSlabAllocator::MIN_BLOCK_SIZE;
+    const uint32_t arena_size =
+            SharedMemSlabAllocator::arena_size_for(num_threads * blocks_per_thread * block_size * 2u);
+
+    SharedMemSlabAllocator::Header header;
+    std::vector<uint64_t> arena(arena_size / sizeof(uint64_t));
+    SharedMemSlabAllocator allocator(&header, arena.data(), arena_size);
+
+    std::atomic<uint32_t> allocations(0u);
+    std::atomic<uint32_t> corruptions(0u);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]()
+                {
+                    std::vector<std::pair<uint8_t*, uint32_t>> blocks;
+                    for (uint32_t i = 0; i < iterations; ++i)
+                    {
+                        // Mix allocation sizes, so blocks are split between threads
+                        uint32_t size = block_size << (i % 2u);
+                        auto block = static_cast<uint8_t*>(allocator.allocate(size));
+                        if (nullptr != block)
+                        {
+                            allocations.fetch_add(1u);
+                            memset(block, static_cast<int>(t), size);
+                            blocks.emplace_back(block, size);
+                        }
+
+                        if (blocks.size() == blocks_per_thread || (nullptr == block && !blocks.empty()))
+                        {
+                            for (auto& allocated : blocks)
+                            {
+                                // Nobody else should have been given the same memory
+                                for (uint32_t pos = 0; pos < allocated.second; ++pos)
+                                {
+                                    if (allocated.first[pos] != t)
+                                    {
+                                        corruptions.fetch_add(1u);
+                                        break;
+                                    }
+                                }
+                                allocator.deallocate(allocated.first, allocated.second);
+                            }
+                            blocks.clear();
+                        }
+                    }
+                });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_GT(allocations.load(), iterations);
+    EXPECT_EQ(0u, corruptions.load());
+}
+
+TEST_F(SHMTransportTests, slab_segment)
+{
+    const std::string domain_name("SHMTests");
+
+    auto shared_mem_manager = SharedMemManager::create(domain_name);
+
+    const uint32_t segment_size = 64u * 1024u;
+    auto segment = shared_mem_manager->create_segment(segment_size, 16u, SharedMemManager::SegmentAllocator::SLAB);
+
+    auto now = std::chrono::steady_clock::now();
+
+    // The whole payload can be allocated
+    {
+        auto buffer = segment->alloc_buffer(segment_size, now);
+        ASSERT_NE(nullptr, buffer);
+        memset(buffer->data(), 0, buffer->size());
+    }
+
+    // Released buffers are recovered, even if the memory was split for smaller ones
+    for (uint32_t i = 0; i < 64u; ++i)
+    {
+        uint32_t size = (i % 2u) ? 1024u : segment_size / 2u;
+        auto buffer = segment->alloc_buffer(size, now);
+        ASSERT_NE(nullptr, buffer);
+        EXPECT_EQ(size, buffer->size());
+        memset(buffer->data(), static_cast<int>(i), buffer->size());
+    }
+
+    {
+        auto buffer = segment->alloc_buffer(segment_size, now);
+        ASSERT_NE(nullptr, buffer);
+    }
+
+    // Buffers being processed are never recovered
+    {
+        auto buffer = segment->alloc_buffer(segment_size / 2u, now);
+        ASSERT_NE(nullptr, buffer);
+        EXPECT_THROW(segment->alloc_buffer(segment_size, now), std::exception);
+        auto other_buffer = segment->alloc_buffer(segment_size / 2u, now);
+        ASSERT_NE(nullptr, other_buffer);
+        EXPECT_NE(buffer->data(), other_buffer->data());
+    }
+
+    SharedMemTransportDescriptor slab_descriptor;
+    slab_descriptor.segment_allocator(SharedMemTransportDescriptor::SegmentAllocator::SLAB);
+    SharedMemTransport transport(slab_descriptor);
+    EXPECT_TRUE(transport.init());
+}
+
+/**
+ * Measures the allocation of buffers of mixed sizes, between 1KB and 4MB, from several publisher threads sharing
+ * a segment. Each thread keeps its last buffers alive, as if they were waiting to be processed by the listeners.
+ */
+TEST_F(SHMTransportTests, segment_allocators_performance)
+{
+    const std::string domain_name("SHMTests");
+    constexpr uint32_t num_threads = 4u;
+    constexpr uint32_t allocations_per_thread = 2000u;
+    constexpr uint32_t buffers_kept = 2u;
+    constexpr uint32_t segment_size = 64u * 1024u * 1024u;
+
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = 1024u; size <= 4u * 1024u * 1024u; size *= 2u)
+    {
+        // Sizes are not powers of two, as serialized payloads
+        sizes.push_back(size - size / 7u);
+        sizes.push_back(size);
+    }
+
+    for (auto allocator : { SharedMemManager::SegmentAllocator::BEST_FIT,
+                            SharedMemManager::SegmentAllocator::SLAB })
+    {
+        auto shared_mem_manager = SharedMemManager::create(domain_name);
+        auto segment = shared_mem_manager->create_segment(segment_size, num_threads * (buffers_kept + 1u) + 1u,
+                        allocator);
+
+        std::vector<std::vector<double>> latencies(num_threads);
+        std::atomic<uint32_t> overflows(0u);
+        std::vector<std::thread> threads;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&, t]()
+                    {
+                        std::vector<std::shared_ptr<SharedMemManager::Buffer>> kept(buffers_kept);
+                        std::vector<double>& thread_latencies = latencies[t];
+                        thread_latencies.reserve(allocations_per_thread);
+                        uint32_t seed = t + 1u;
+
+                        for (uint32_t i = 0; i < allocations_per_thread; ++i)
+                        {
+                            seed = seed * 1103515245u + 12345u;
+                            uint32_t size = sizes[(seed >> 16) % sizes.size()];
+
+                            kept[i % buffers_kept].reset();
+                            auto start = std::chrono::steady_clock::now();
+                            try
+                            {
+                                kept[i % buffers_kept] = segment->alloc_buffer(size, start);
+                            }
+                            catch (const std::exception&)
+                            {
+                                overflows.fetch_add(1u);
+                            }
+                            auto end = std::chrono::steady_clock::now();
+                            thread_latencies.push_back(
+                                std::chrono::duration<double, std::micro>(end - start).count());
+                        }
+                    });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::vector<double> all_latencies;
+        for (const auto& thread_latencies : latencies)
+        {
+            all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+        }
+        std::sort(all_latencies.begin(), all_latencies.end());
+        auto percentile = [&all_latencies](double p)
+                {
+                    return all_latencies[static_cast<size_t>(p * (all_latencies.size() - 1))];
+                };
+
+        std::cout << (SharedMemManager::SegmentAllocator::SLAB == allocator ? "SLAB    " : "BEST_FIT")
+                  << " allocations/s " << all_latencies.size() / elapsed
+                  << " p50 " << percentile(0.5) << "us"
+                  << " p99 " << percentile(0.99) << "us"
+                  << " p99.9 " << percentile(0.999) << "us"
+                  << " max " << all_latencies.back() << "us"
+                  << " overflows " << overflows.load() << std::endl;
+
+        if (SharedMemManager::SegmentAllocator::SLAB == allocator)
+        {
+            // The segment has room for the kept buffers even with the worst rounding
+            EXPECT_EQ(0u, overflows.load());
+        }
+    }
+}
+
+TEST_F(SHMTransportTests, spinning_listener)
+{
+    const std::string domain_name("SHMTests");
+
+    auto shared_mem_manager = SharedMemManager::create(domain_name);
+    auto segment = shared_mem_manager->create_segment(1024u, 16u);
+    auto read_port = shared_mem_manager->open_port(0, 16, 1000, SharedMemGlobal::Port::OpenMode::ReadExclusive);
+    auto write_port = shared_mem_manager->open_port(0, 16, 1000, SharedMemGlobal::Port::OpenMode::Write);
+    auto listener = read_port->create_listener(std::chrono::microseconds(1000000));
+
+    // Buffers already enqueued are found by the first poll
+    auto buffer = segment->alloc_buffer(16u, std::chrono::steady_clock::time_point());
+    ASSERT_TRUE(write_port->try_push(buffer));
+    buffer.reset();
+    auto received = listener->pop();
+    ASSERT_TRUE(received);
+    listener->stop_processing_buffer();
+    received.reset();
+
+    auto statistics = listener->wait_statistics();
+    EXPECT_EQ(1u, statistics.spin_hits);
+    EXPECT_EQ(0u, statistics.blocking_waits);
+
+    // A buffer pushed while spinning is received without waking up the listener
+    std::thread sender([&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                auto to_send = segment->alloc_buffer(16u, std::chrono::steady_clock::time_point());
+                ASSERT_TRUE(write_port->try_push(to_send));
+            });
+    received = listener->pop();
+    sender.join();
+    ASSERT_TRUE(received);
+    listener->stop_processing_buffer();
+    received.reset();
+
+    statistics = listener->wait_statistics();
+    EXPECT_EQ(2u, statistics.spin_hits);
+    EXPECT_EQ(0u, statistics.blocking_waits);
+    EXPECT_GE(statistics.spin_time_ns, 10000000u);
+
+    // Closing the listener stops the spin
+    std::thread closer([&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                listener->close();
+            });
+    EXPECT_FALSE(listener->pop());
+    closer.join();
+}
+
+TEST_F(SHMTransportTests, spinning_listener_blocks_after_spin_time)
+{
+    const std::string domain_name("SHMTests");
+
+    auto shared_mem_manager = SharedMemManager::create(domain_name);
+    auto segment = shared_mem_manager->create_segment(1024u, 16u);
+    auto read_port = shared_mem_manager->open_port(0, 16, 1000, SharedMemGlobal::Port::OpenMode::ReadExclusive);
+    auto write_port = shared_mem_manager->open_port(0, 16, 1000, SharedMemGlobal::Port::OpenMode::Write);
+    auto listener = read_port->create_listener(std::chrono::microseconds(100));
+
+    std::thread sender([&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                auto to_send = segment->alloc_buffer(16u, std::chrono::steady_clock::time_point());
+                ASSERT_TRUE(write_port->try_push(to_send));
+            });
+    auto received = listener->pop();
+    sender.join();
+    ASSERT_TRUE(received);
+    listener->stop_processing_buffer();
+
+    auto statistics = listener->wait_statistics();
+    EXPECT_EQ(0u, statistics.spin_hits);
+    EXPECT_EQ(1u, statistics.blocking_waits);
+    EXPECT_GE(statistics.spin_time_ns, 100000u);
+}
+
+/**
+ * Round trip of a small buffer between two threads, with listeners that block at once
+ * and with listeners that spin before blocking.
+ */
+TEST_F(SHMTransportTests, ping_pong_latency)
+{
+    const std::string domain_name("SHMTests");
+    constexpr uint32_t num_samples = 10000u;
+    constexpr uint32_t warmup_samples = 100u;
+    constexpr uint32_t sample_size = 64u;
+
+    for (auto spin_time : { std::chrono::microseconds(0), std::chrono::microseconds(100) })
+    {
+        auto shared_mem_manager = SharedMemManager::create(domain_name);
+        auto ping_port = shared_mem_manager->open_port(0, 64, 1000, SharedMemGlobal::Port::OpenMode::Write);
+        auto pong_port = shared_mem_manager->open_port(1, 64, 1000, SharedMemGlobal::Port::OpenMode::Write);
+        auto ping_listener = shared_mem_manager->open_port(0, 64, 1000,
+                        SharedMemGlobal::Port::OpenMode::ReadExclusive)->create_listener(spin_time);
+        auto pong_listener = shared_mem_manager->open_port(1, 64, 1000,
+                        SharedMemGlobal::Port::OpenMode::ReadExclusive)->create_listener(spin_time);
+        auto segment = shared_mem_manager->create_segment(sample_size * 64u, 64u);
+
+        std::thread echo([&]()
+                {
+                    for (uint32_t i = 0; i < num_samples + warmup_samples; ++i)
+                    {
+                        auto ping = ping_listener->pop();
+                        ASSERT_TRUE(ping);
+                        ping_listener->stop_processing_buffer();
+                        auto pong = segment->alloc_buffer(sample_size, std::chrono::steady_clock::time_point());
+                        memcpy(pong->data(), ping->data(), sample_size);
+                        ping.reset();
+                        ASSERT_TRUE(pong_port->try_push(pong));
+                    }
+                });
+
+        std::vector<double> latencies;
+        latencies.reserve(num_samples);
+        for (uint32_t i = 0; i < num_samples + warmup_samples; ++i)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            auto ping = segment->alloc_buffer(sample_size, t0);
+            memset(ping->data(), static_cast<int>(i), sample_size);
+            ASSERT_TRUE(ping_port->try_push(ping));
+            ping.reset();
+            auto pong = pong_listener->pop();
+            ASSERT_TRUE(pong);
+            pong_listener->stop_processing_buffer();
+            auto t1 = std::chrono::steady_clock::now();
+            ASSERT_EQ(static_cast<uint8_t>(i), static_cast<uint8_t*>(pong->data())[0]);
+
+            if (i >= warmup_samples)
+            {
+                latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            }
+        }
+
+        echo.join();
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p)
+                {
+                    return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+                };
+        auto ping_statistics = ping_listener->wait_statistics();
+        auto pong_statistics = pong_listener->wait_statistics();
+
+        std::cout << "spin " << spin_time.count() << "us"
+                  << " round trip p50 " << percentile(0.5) << "us"
+                  << " p99 " << percentile(0.99) << "us"
+                  << " max " << latencies.back() << "us"
+                  << " spin hits " << ping_statistics.spin_hits + pong_statistics.spin_hits
+                  << " blocking waits " << ping_statistics.blocking_waits + pong_statistics.blocking_waits
+                  << std::endl;
+
+        if (0 == spin_time.count())
+        {
+            EXPECT_EQ(0u, ping_statistics.spin_hits + pong_statistics.spin_hits);
+        }
+    }
+}
+
+TEST_F(SHMTransportTests, payload_pool_references_buffers)
+{
+    const std::string domain_name("SHMTests");
+    constexpr uint32_t buffer_size = 4096u;
+
+    auto shared_mem_manager = SharedMemManager::create(domain_name);
+    auto segment = shared_mem_manager->create_segment(buffer_size, 2u);
+    auto read_port = shared_mem_manager->open_port(0, 4, 1000, SharedMemGlobal::Port::OpenMode::ReadExclusive);
+    auto write_port = shared_mem_manager->open_port(0, 4, 1000, SharedMemGlobal::Port::OpenMode::Write);
+    auto listener = read_port->create_listener();
+    auto& pool = SharedMemPayloadPool::instance();
+
+    auto buffer = segment->alloc_buffer(buffer_size, std::chrono::steady_clock::time_point());
+    memset(buffer->data(), 0xAB, buffer_size);
+    ASSERT_TRUE(write_port->try_push(buffer));
+    buffer.reset();
+
+    auto message = listener->pop();
+    ASSERT_TRUE(message);
+    pool->add_buffer(message, 1024u);
+    auto message_data = static_cast<octet*>(message->data());
+
+    // What MessageReceiver does with the DATA submessages
+    CacheChange_t received;
+    received.writerGUID.entityId.value[3] = 0x02;
+    received.sequenceNumber = SequenceNumber_t(0, 1);
+    received.serializedPayload.data = message_data + 64u;
+    received.serializedPayload.length = 2048u;
+    received.serializedPayload.max_size = 2048u;
+
+    IPayloadPool* data_owner = nullptr;
+    ASSERT_TRUE(pool->get_payload(received.serializedPayload, data_owner, received));
+    EXPECT_EQ(pool.get(), data_owner);
+    EXPECT_EQ(pool.get(), received.payload_owner());
+
+    CacheChange_t small;
+    small.writerGUID = received.writerGUID;
+    small.sequenceNumber = SequenceNumber_t(0, 2);
+    small.serializedPayload.data = message_data + 2112u;
+    small.serializedPayload.length = 512u;
+    data_owner = nullptr;
+    EXPECT_FALSE(pool->get_payload(small.serializedPayload, data_owner, small));
+    EXPECT_EQ(nullptr, data_owner);
+    small.serializedPayload.length = buffer_size;
+    EXPECT_FALSE(pool->get_payload(small.serializedPayload, data_owner, small));
+    small.serializedPayload.data = nullptr;
+
+    // What readers do with the received change
+    CacheChange_t in_history;
+    data_owner = received.payload_owner();
+    ASSERT_TRUE(pool->get_payload(received.serializedPayload, data_owner, in_history));
+    EXPECT_EQ(message_data + 64u, in_history.serializedPayload.data);
+    EXPECT_EQ(2048u, in_history.serializedPayload.length);
+
+    // Reception finished
+    pool->release_payload(received);
+    pool->remove_buffer(message);
+    message.reset();
+    listener->stop_processing_buffer();
+
+    // The buffer cannot be reused while the change is in the history
+    EXPECT_EQ(1u, pool->buffers_in_use());
+    EXPECT_THROW(segment->alloc_buffer(buffer_size, std::chrono::steady_clock::time_point()), std::exception);
+    EXPECT_EQ(0xAB, in_history.serializedPayload.data[0]);
+    EXPECT_EQ(0xAB, in_history.serializedPayload.data[2047]);
+
+    pool->release_payload(in_history);
+    EXPECT_EQ(0u, pool->buffers_in_use());
+    EXPECT_NO_THROW(segment->alloc_buffer(buffer_size, std::chrono::steady_clock::time_point()));
+}
+
+/**
+ * Delivery of multi-megabyte payloads to a reader that keeps the last samples in its history.
+ * With copies, each payload is copied to the history before being read. With references,
+ * it is read straight from the shared memory buffer, which stays in use while in the history.
+ */
+TEST_F(SHMTransportTests, payload_reference_throughput)
+{
+    const std::string domain_name("SHMTests");
+    constexpr uint32_t num_samples = 200u;
+    constexpr uint32_t history_depth = 4u;
+    constexpr uint32_t port_capacity = 4u;
+    constexpr uint32_t header_size = 64u;
+
+    for (uint32_t payload_size : { 1u << 20, 4u << 20 })
+    {
+        for (bool reference : { false, true })
+        {
+            auto shared_mem_manager = SharedMemManager::create(domain_name);
+            auto segment = shared_mem_manager->create_segment((payload_size + header_size) *
+                            (history_depth + port_capacity + 2u), history_depth + port_capacity + 2u);
+            auto read_port = shared_mem_manager->open_port(0, port_capacity, 1000,
+                            SharedMemGlobal::Port::OpenMode::ReadExclusive);
+            auto write_port = shared_mem_manager->open_port(0, port_capacity, 1000,
+                            SharedMemGlobal::Port::OpenMode::Write);
+            auto listener = read_port->create_listener();
+            auto& pool = SharedMemPayloadPool::instance();
+
+            std::thread writer([&]()
+                    {
+                        for (uint32_t i = 0; i < num_samples; ++i)
+                        {
+                            std::shared_ptr<SharedMemManager::Buffer> buffer;
+                            while (!buffer)
+                            {
+                                try
+                                {
+                                    buffer = segment->alloc_buffer(payload_size + header_size,
+                                    std::chrono::steady_clock::time_point());
+                                }
+                                catch (const std::exception&)
+                                {
+                                    std::this_thread::yield();
+                                }
+                            }
+                            memset(buffer->data(), static_cast<int>(i), payload_size + header_size);
+                            while (!write_port->try_push(buffer))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+
+            // History of the reader, either with its own payloads or with references
+            std::vector<std::vector<octet>> copies(history_depth, std::vector<octet>(payload_size));
+            std::vector<std::unique_ptr<CacheChange_t>> history(history_depth);
+            uint64_t checksum = 0;
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < num_samples; ++i)
+            {
+                auto message = listener->pop();
+                ASSERT_TRUE(message);
+                const octet* payload = static_cast<octet*>(message->data()) + header_size;
+
+                if (reference)
+                {
+                    auto& change = history[i % history_depth];
+                    if (change)
+                    {
+                        pool->release_payload(*change);
+                    }
+                    change.reset(new CacheChange_t());
+                    change->writerGUID.entityId.value[3] = 0x02;
+                    change->sequenceNumber = SequenceNumber_t(0, i + 1);
+
+                    pool->add_buffer(message, 1u);
+                    SerializedPayload_t received;
+                    received.data = const_cast<octet*>(payload);
+                    received.length = payload_size;
+                    IPayloadPool* data_owner = nullptr;
+                    ASSERT_TRUE(pool->get_payload(received, data_owner, *change));
+                    received.data = nullptr;
+                    pool->remove_buffer(message);
+                    payload = change->serializedPayload.data;
+                }
+                else
+                {
+                    auto& copy = copies[i % history_depth];
+                    memcpy(copy.data(), payload, payload_size);
+                    payload = copy.data();
+                }
+
+                message.reset();
+                listener->stop_processing_buffer();
+
+                // Deserialization
+                uint64_t sum = 0;
+                for (uint32_t n = 0; n < payload_size; n += sizeof(uint64_t))
+                {
+                    uint64_t value;
+                    memcpy(&value, payload + n, sizeof(value));
+                    sum += value;
+                }
+                checksum += sum;
+            }
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+            writer.join();
+            for (auto& change : history)
+            {
+                if (change)
+                {
+                    pool->release_payload(*change);
+                }
+            }
+            EXPECT_EQ(0u, pool->buffers_in_use());
+            EXPECT_NE(0u, checksum);
+
+            std::cout << (reference ? "reference " : "copy      ") << (payload_size >> 20) << "MB payloads: "
+                      << num_samples / elapsed << " samples/s "
+                      << (static_cast<double>(payload_size) * num_samples / elapsed) / (1 << 20) << " MB/s"
+                      << std::endl;
+        }
+    }
+}
+
 TEST_F(SHMTransportTests, remote_segments_free)
 {
     const std::string domain_name("SHMTests");
@@ -0,0 +1,208 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <rttest/rttest.h>
+#include <rttest/utils.h>
+
+#include <builtin_interfaces/msg/time.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Measure the latencies of callbacks dispatched by a rclcpp executor into the histograms of rttest.
+//
+// By default, the wake-up latency of a timer firing at the rttest update period is recorded,
+// i.e. the time between the moment the timer was due and the moment its callback started.
+// With --round-trip, the timer publishes a timestamp instead, which is sent back by a second node
+// in the same process, and the time for the message to come back through intra-process
+// communication is recorded.
+// With --multi-threaded, the callbacks are dispatched by a MultiThreadedExecutor, and each of its
+// threads records the latencies of the callbacks it executes.
+//
+// The percentiles of all the threads are printed every second while the test runs.
+// The test stops after the number of iterations given to rttest, or runs until interrupted if it
+// is 0.
+
+using builtin_interfaces::msg::Time;
+
+static Time to_msg(const struct timespec & t)
+{
+  Time msg;
+  msg.sec = static_cast<int32_t>(t.tv_sec);
+  msg.nanosec = static_cast<uint32_t>(t.tv_nsec);
+  return msg;
+}
+
+// Get the time at which a timer is due, on the clock used by rttest.
+static struct timespec get_next_call_time(rclcpp::TimerBase & timer)
+{
+  struct timespec now, next_call_time;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  // Negative if the timer is already late
+  int64_t time_until_trigger = timer.time_until_trigger().count();
+  long_to_timespec(timespec_to_long(&now) + time_until_trigger, &next_call_time);
+  return next_call_time;
+}
+
+static void print_percentiles()
+{
+  struct rttest_latency_percentiles percentiles;
+  if (rttest_get_aggregate_latency_percentiles(&percentiles) != 0) {
+    printf("No latency recorded yet\n");
+    return;
+  }
+  printf(
+    "%zu samples, latency (ns): min %" PRId64 ", 50%% %" PRId64 ", 90%% %" PRId64
+    ", 99%% %" PRId64 ", 99.9%% %" PRId64 ", 99.99%% %" PRId64 ", max %" PRId64 "\n",
+    percentiles.samples, percentiles.min_latency, percentiles.p50_latency,
+    percentiles.p90_latency, percentiles.p99_latency, percentiles.p999_latency,
+    percentiles.p9999_latency, percentiles.max_latency);
+}
+
+int main(int argc, char * argv[])
+{
+  // Initialization phase.
+  // Take out the arguments of this program, which rttest wouldn't recognize.
+  bool multi_threaded = false;
+  bool round_trip = false;
+  std::vector<char *> rttest_argv;
+  for (int i = 0; i < argc; ++i) {
+    if (strcmp(argv[i], "--multi-threaded") == 0) {
+      multi_threaded = true;
+    } else if (strcmp(argv[i], "--round-trip") == 0) {
+      round_trip = true;
+    } else {
+      rttest_argv.push_back(argv[i]);
+    }
+  }
+  rttest_read_args(static_cast<int>(rttest_argv.size()), rttest_argv.data());
+  struct rttest_params params;
+  rttest_get_params(&params);
+
+  rclcpp::init(argc, argv);
+
+  auto options = rclcpp::NodeOptions().use_intra_process_comms(true);
+  auto ping_node = rclcpp::Node::make_shared("latency_ping", options);
+  auto pong_node = rclcpp::Node::make_shared("latency_pong", options);
+
+  std::atomic<size_t> samples{0};
+  auto count_sample = [&params, &samples]() {
+      if (++samples == params.iterations) {
+        rclcpp::shutdown();
+      }
+    };
+
+  // Send the timestamps back as they are, without copying them.
+  auto pong_publisher = pong_node->create_publisher<Time>("latency_pong", 10);
+  auto pong_subscription = pong_node->create_subscription<Time>(
+    "latency_ping", 10,
+    [&pong_publisher](Time::UniquePtr msg) {
+      pong_publisher->publish(std::move(msg));
+    });
+
+  auto ping_publisher = ping_node->create_publisher<Time>("latency_ping", 10);
+  auto ping_subscription = ping_node->create_subscription<Time>(
+    "latency_pong", 10,
+    [&count_sample](Time::UniquePtr msg) {
+      struct timespec sent_time, now, latency;
+      sent_time.tv_sec = msg->sec;
+      sent_time.tv_nsec = msg->nanosec;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      subtract_timespecs(&now, &sent_time, &latency);
+      rttest_record_latency(static_cast<int64_t>(timespec_to_long(&latency)));
+      count_sample();
+    });
+
+  // Time at which the timer is due next, only used by one thread at a time since the callbacks of
+  // the timer are mutually exclusive.
+  struct timespec deadline;
+  auto timer_callback =
+    [&](rclcpp::TimerBase & timer) {
+      if (round_trip) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        auto msg = std::make_unique<Time>(to_msg(now));
+        ping_publisher->publish(std::move(msg));
+      } else {
+        rttest_record_wakeup_latency(&deadline);
+        count_sample();
+      }
+      // The timer already scheduled its next call: if it was late by more than a period, the
+      // calls it missed are skipped, as their latencies are accounted for by this one.
+      deadline = get_next_call_time(timer);
+    };
+  auto period = std::chrono::nanoseconds(timespec_to_long(&params.update_period));
+  auto timer = ping_node->create_wall_timer(period, timer_callback);
+  deadline = get_next_call_time(*timer);
+
+  std::unique_ptr<rclcpp::Executor> executor;
+  if (multi_threaded) {
+    executor = std::make_unique<rclcpp::executors::MultiThreadedExecutor>();
+  } else {
+    executor = std::make_unique<rclcpp::executors::SingleThreadedExecutor>();
+  }
+  executor->add_node(ping_node);
+  executor->add_node(pong_node);
+
+  // Print the percentiles recorded by all the threads while the test is running, from a thread
+  // which isn't real-time.
+  std::mutex monitor_mutex;
+  std::condition_variable monitor_cv;
+  bool done = false;
+  std::thread monitor_thread(
+    [&]() {
+      std::unique_lock<std::mutex> lock(monitor_mutex);
+      while (!monitor_cv.wait_for(lock, std::chrono::seconds(1), [&done]() {return done;})) {
+        print_percentiles();
+      }
+    });
+
+  // The threads of the executor inherit the scheduling policy and priority of this thread.
+  if (rttest_set_sched_priority(params.sched_priority, params.sched_policy)) {
+    perror("Couldn't set scheduling priority and policy");
+  }
+  if (rttest_lock_and_prefault_dynamic() != 0) {
+    fprintf(stderr, "Couldn't lock all cached virtual memory.\n");
+    fprintf(stderr, "Pagefaults from reading pages not yet mapped into RAM will be recorded.\n");
+  }
+
+  // Execution phase
+  executor->spin();
+
+  // Teardown phase
+  {
+    std::lock_guard<std::mutex> lock(monitor_mutex);
+    done = true;
+  }
+  monitor_cv.notify_one();
+  monitor_thread.join();
+
+  printf(
+    "%s latencies of the %s executor:\n", round_trip ? "Round trip" : "Wake-up",
+    multi_threaded ? "multi-threaded" : "single-threaded");
+  print_percentiles();
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -35,9 +35,12 @@
 #ifndef MESSAGE_FILTERS__CACHE_H_
 #define MESSAGE_FILTERS__CACHE_H_
 
-#include <deque>
+#include <algorithm>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -54,6 +57,10 @@ using namespace std::placeholders;
  * Given a stream of messages, the most recent N messages are cached in a ring buffer,
  * from which time intervals of the cache can then be retrieved by the client.
  *
+ * The messages are kept sorted by stamp, messages arriving out of order being inserted at their
+ * place, so that queries are binary searches. Queries only take a shared lock on the cache, and
+ * run concurrently with each other.
+ *
  * Cache immediately passes messages through to its output connections.
  *
  * \section connections CONNECTIONS
@@ -100,6 +107,7 @@ public:
 
   /**
    * Set the size of the cache.
+   * If the cache holds more messages than the new size, the oldest ones are dropped.
    * \param cache_size The new size the cache should be. Must be > 0
    */
   void setCacheSize(unsigned int cache_size)
@@ -110,6 +118,23 @@ public:
       return ;
     }
 
+    std::lock_guard<std::shared_timed_mutex> lock(cache_lock_);
+
+    // Unwrap the ring buffer, keeping the newest messages which fit in it
+    size_t count = std::min<size_t>(size_, cache_size);
+    std::vector<Entry> entries;
+    std::vector<EventType> events;
+    entries.reserve(count);
+    events.reserve(count);
+    for (size_t i = size_ - count; i < size_; i++)
+    {
+      entries.push_back(Entry{entry(i).stamp, events.size()});
+      events.push_back(events_[entry(i).event]);
+    }
+    entries_.swap(entries);
+    events_.swap(events);
+    begin_ = 0;
+    size_ = count;
     cache_size_ = cache_size ;
   }
 
@@ -130,27 +155,40 @@ public:
   {
     namespace mt = message_filters::message_traits;
 
-    //printf("  Cache Size: %u\n", cache_.size()) ;
+    rclcpp::Time evt_stamp = mt::TimeStamp<M>::value(*evt.getMessage());
     {
-      std::lock_guard<std::mutex> lock(cache_lock_);
-
-      while (cache_.size() >= cache_size_)                       // Keep popping off old data until we have space for a new msg
-        cache_.pop_front() ;                                     // The front of the deque has the oldest elem, so we can get rid of it
-
-      // No longer naively pushing msgs to back. Want to make sure they're sorted correctly
-      //cache_.push_back(msg) ;                                    // Add the newest message to the back of the deque
-
-      typename std::deque<EventType >::reverse_iterator rev_it = cache_.rbegin();
-
-      // Keep walking backwards along deque until we hit the beginning,
-      //   or until we find a timestamp that's smaller than (or equal to) msg's timestamp
-      rclcpp::Time evt_stamp = mt::TimeStamp<M>::value(*evt.getMessage());
-      while(rev_it != cache_.rend() && mt::TimeStamp<M>::value(*(*rev_it).getMessage()) > evt_stamp)
-        rev_it++;
-
-      // Add msg to the cache
-      cache_.insert(rev_it.base(), evt);
-
+      std::lock_guard<std::shared_timed_mutex> lock(cache_lock_);
+
+      size_t event;
+      if (size_ == cache_size_)
+      {
+        // The oldest message is dropped, and its slots reused
+        event = entry(0).event;
+        begin_ = slot(1);
+        size_--;
+      }
+      else
+      {
+        // The ring buffer grows until it holds cache_size_ messages, and only then wraps around
+        event = events_.size();
+        entries_.emplace_back();
+        events_.emplace_back();
+      }
+      events_[event] = evt;
+
+      // Insert after the messages with an older or equal stamp, ie. usually at the back,
+      // shifting the newer ones when msg arrived out of order
+      size_t index = size_;
+      if (size_ > 0 && entry(size_ - 1).stamp > evt_stamp)
+      {
+        index = upperBound(evt_stamp);
+      }
+      for (size_t i = size_; i > index; i--)
+      {
+        entries_[slot(i)] = entries_[slot(i - 1)];
+      }
+      entries_[slot(index)] = Entry{evt_stamp, event};
+      size_++;
     }
 
     this->signalMessage(evt);
@@ -166,30 +204,19 @@ public:
    */
   std::vector<MConstPtr> getInterval(const rclcpp::Time& start, const rclcpp::Time& end) const
   {
-    namespace mt = message_filters::message_traits;
-    std::lock_guard<std::mutex> lock(cache_lock_);
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
     // Find the starting index. (Find the first index after [or at] the start of the interval)
-    size_t start_index = 0 ;
-    while(start_index < cache_.size() &&
-          mt::TimeStamp<M>::value(*cache_[start_index].getMessage()) < start)
-    {
-      start_index++ ;
-    }
+    size_t start_index = lowerBound(start);
 
     // Find the ending index. (Find the first index after the end of interval)
-    size_t end_index = start_index ;
-    while(end_index < cache_.size() &&
-          mt::TimeStamp<M>::value(*cache_[end_index].getMessage()) <= end)
-    {
-      end_index++ ;
-    }
+    size_t end_index = std::max(start_index, upperBound(end));
 
     std::vector<MConstPtr> interval_elems ;
     interval_elems.reserve(end_index - start_index) ;
     for (size_t i=start_index; i<end_index; i++)
     {
-      interval_elems.push_back(cache_[i].getMessage()) ;
+      interval_elems.push_back(message(i)) ;
     }
 
     return interval_elems ;
@@ -204,29 +231,30 @@ public:
    */
   std::vector<MConstPtr> getSurroundingInterval(const rclcpp::Time& start, const rclcpp::Time& end) const
   {
-    namespace mt = message_filters::message_traits;
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
-    std::lock_guard<std::mutex> lock(cache_lock_);
-    // Find the starting index. (Find the first index after [or at] the start of the interval)
-    int start_index = static_cast<int>(cache_.size()) - 1;
-    while(start_index > 0 &&
-          mt::TimeStamp<M>::value(*cache_[start_index].getMessage()) > start)
+    std::vector<MConstPtr> interval_elems;
+    if (size_ == 0)
     {
-      start_index--;
+      return interval_elems;
     }
 
-    int end_index = start_index;
-    while(end_index < static_cast<int>(cache_.size()) - 1 &&
-          mt::TimeStamp<M>::value(*cache_[end_index].getMessage()) < end)
+    // Find the starting index. (Find the last index before [or at] the start of the interval,
+    // or the first index if there is none)
+    size_t start_index = upperBound(start);
+    if (start_index > 0)
     {
-      end_index++;
+      start_index--;
     }
 
-    std::vector<MConstPtr> interval_elems;
+    // Find the ending index. (Find the first index after [or at] the end of the interval,
+    // or the last index if there is none)
+    size_t end_index = std::min(std::max(start_index, lowerBound(end)), size_ - 1);
+
     interval_elems.reserve(end_index - start_index + 1) ;
-    for (int i=start_index; i<=end_index; i++)
+    for (size_t i=start_index; i<=end_index; i++)
     {
-      interval_elems.push_back(cache_[i].getMessage()) ;
+      interval_elems.push_back(message(i)) ;
     }
 
     return interval_elems;
@@ -239,23 +267,13 @@ public:
    */
   MConstPtr getElemBeforeTime(const rclcpp::Time& time) const
   {
-    namespace mt = message_filters::message_traits;
-
-    std::lock_guard<std::mutex> lock(cache_lock_);
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
     MConstPtr out ;
 
-    unsigned int i=0 ;
-    int elem_index = -1 ;
-    while (i<cache_.size() &&
-           mt::TimeStamp<M>::value(*cache_[i].getMessage()) < time)
-    {
-      elem_index = i ;
-      i++ ;
-    }
-
-    if (elem_index >= 0)
-      out = cache_[elem_index].getMessage() ;
+    size_t index = lowerBound(time);
+    if (index > 0)
+      out = message(index - 1) ;
 
     return out ;
   }
@@ -267,25 +285,13 @@ public:
    */
   MConstPtr getElemAfterTime(const rclcpp::Time& time) const
   {
-    namespace mt = message_filters::message_traits;
-
-    std::lock_guard<std::mutex> lock(cache_lock_);
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
     MConstPtr out ;
 
-    int i = static_cast<int>(cache_.size()) - 1 ;
-    int elem_index = -1 ;
-    while (i>=0 &&
-        mt::TimeStamp<M>::value(*cache_[i].getMessage()) > time)
-    {
-      elem_index = i ;
-      i-- ;
-    }
-
-    if (elem_index >= 0)
-      out = cache_[elem_index].getMessage() ;
-    else
-      out.reset() ;
+    size_t index = upperBound(time);
+    if (index < size_)
+      out = message(index) ;
 
     return out ;
   }
@@ -295,14 +301,12 @@ public:
    */
   rclcpp::Time getLatestTime() const
   {
-    namespace mt = message_filters::message_traits;
-
-    std::lock_guard<std::mutex> lock(cache_lock_);
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
     rclcpp::Time latest_time;
 
-    if (cache_.size() > 0)
-      latest_time = mt::TimeStamp<M>::value(*cache_.back().getMessage());
+    if (size_ > 0)
+      latest_time = entry(size_ - 1).stamp;
 
     return latest_time ;
   }
@@ -312,28 +316,94 @@ public:
    */
   rclcpp::Time getOldestTime() const
   {
-    namespace mt = message_filters::message_traits;
-
-    std::lock_guard<std::mutex> lock(cache_lock_);
+    std::shared_lock<std::shared_timed_mutex> lock(cache_lock_);
 
     rclcpp::Time oldest_time;
 
-    if (cache_.size() > 0)
-      oldest_time = mt::TimeStamp<M>::value(*cache_.front().getMessage());
+    if (size_ > 0)
+      oldest_time = entry(0).stamp;
 
     return oldest_time ;
   }
 
 
 private:
+  struct Entry
+  {
+    rclcpp::Time stamp;                 //!< Stamp of the message, so that searches don't dereference it
+    size_t event;                       //!< Index of the message in events_
+  };
+
   void callback(const EventType& evt)
   {
     add(evt);
   }
 
-  mutable std::mutex cache_lock_ ;            //!< Lock for cache_
-  std::deque<EventType> cache_ ;        //!< Cache for the messages
-  unsigned int cache_size_ ;            //!< Maximum number of elements allowed in the cache.
+  /// Position in entries_ of the i-th oldest message, with i <= size_
+  size_t slot(size_t i) const
+  {
+    size_t position = begin_ + i;
+    return position < entries_.size() ? position : position - entries_.size();
+  }
+
+  const Entry& entry(size_t i) const
+  {
+    return entries_[slot(i)];
+  }
+
+  MConstPtr message(size_t i) const
+  {
+    return events_[entry(i).event].getMessage();
+  }
+
+  /// Index of the oldest message stamped at or after time, or size_ if there is none
+  size_t lowerBound(const rclcpp::Time& time) const
+  {
+    size_t first = 0;
+    size_t count = size_;
+    while (count > 0)
+    {
+      size_t half = count / 2;
+      if (entry(first + half).stamp < time)
+      {
+        first += half + 1;
+        count -= half + 1;
+      }
+      else
+      {
+        count = half;
+      }
+    }
+    return first;
+  }
+
+  /// Index of the oldest message stamped after time, or size_ if there is none
+  size_t upperBound(const rclcpp::Time& time) const
+  {
+    size_t first = 0;
+    size_t count = size_;
+    while (count > 0)
+    {
+      size_t half = count / 2;
+      if (entry(first + half).stamp <= time)
+      {
+        first += half + 1;
+        count -= half + 1;
+      }
+      else
+      {
+        count = half;
+      }
+    }
+    return first;
+  }
+
+  mutable std::shared_timed_mutex cache_lock_ ;  //!< Lock for the ring buffer
+  std::vector<Entry> entries_ ;         //!< Ring buffer of the messages, sorted by stamp from begin_
+  std::vector<EventType> events_ ;      //!< Messages, which stay in place when entries_ is shifted
+  size_t begin_ = 0 ;                   //!< Position of the oldest message in entries_
+  size_t size_ = 0 ;                    //!< Number of messages in the cache
+  unsigned int cache_size_ = 0 ;        //!< Maximum number of elements allowed in the cache.
 
   Connection incoming_connection_;
 };
@@ -36,8 +36,10 @@
 #define MESSAGE_FILTERS__SIGNAL9_H_
 
 
+#include <algorithm>
 #include <functional>
 #include <mutex>
+#include <shared_mutex>
 
 #include "message_filters/connection.h"
 #include "message_filters/null_types.h"
@@ -171,7 +173,7 @@ public:
   {
     CallbackHelper9T<P0, P1, P2, P3, P4, P5, P6, P7, P8>* helper = new CallbackHelper9T<P0, P1, P2, P3, P4, P5, P6, P7, P8>(callback);
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::shared_timed_mutex> lock(mutex_);
     callbacks_.push_back(CallbackHelper9Ptr(helper));
     return Connection(std::bind(&Signal9::removeCallback, this, callbacks_.back()));
   }
@@ -282,7 +284,7 @@ public:
 
   void removeCallback(const CallbackHelper9Ptr& helper)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::shared_timed_mutex> lock(mutex_);
     typename V_CallbackHelper9::iterator it = std::find(callbacks_.begin(), callbacks_.end(), helper);
     if (it != callbacks_.end())
     {
@@ -293,7 +295,8 @@ public:
   void call(const M0Event& e0, const M1Event& e1, const M2Event& e2, const M3Event& e3, const M4Event& e4,
             const M5Event& e5, const M6Event& e6, const M7Event& e7, const M8Event& e8)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Shared, so that synchronizers dispatching from several threads call back concurrently
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
     bool nonconst_force_copy = callbacks_.size() > 1;
     typename V_CallbackHelper9::iterator it = callbacks_.begin();
     typename V_CallbackHelper9::iterator end = callbacks_.end();
@@ -305,7 +308,7 @@ public:
   }
 
 private:
-  std::mutex mutex_;
+  std::shared_timed_mutex mutex_;
   V_CallbackHelper9 callbacks_;
 };
 
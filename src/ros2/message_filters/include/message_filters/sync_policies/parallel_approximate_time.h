@@ -0,0 +1,856 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2020, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef MESSAGE_FILTERS__SYNC_PARALLEL_APPROXIMATE_TIME_H_
+#define MESSAGE_FILTERS__SYNC_PARALLEL_APPROXIMATE_TIME_H_
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <inttypes.h>
+
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+#include <rcutils/logging_macros.h>
+
+#include "message_filters/connection.h"
+#include "message_filters/message_traits.h"
+#include "message_filters/null_types.h"
+#include "message_filters/signal9.h"
+#include "message_filters/synchronizer.h"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Unbounded lock-free queue, with any number of producers and a single consumer.
+ *
+ * A push allocates a node and does a single atomic exchange. The consumer may transiently not
+ * see an element while the push of the element before it is still in progress.
+ */
+template<typename T>
+class MpscQueue
+{
+public:
+  MpscQueue()
+  : head_(new Node())
+  , tail_(head_.load(std::memory_order_relaxed))
+  {
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  ~MpscQueue()
+  {
+    while (pop())
+    {
+    }
+    delete tail_;
+  }
+
+  void push(T&& value)
+  {
+    Node* node = new Node();
+    node->value = std::move(value);
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  // Consumer only, returns nullptr if the queue looks empty
+  T* front()
+  {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    return next ? &next->value : nullptr;
+  }
+
+  // Consumer only, returns false if the queue looks empty
+  bool pop()
+  {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (!next)
+    {
+      return false;
+    }
+    // The popped node becomes the stub, its value is released right away
+    next->value = T();
+    delete tail_;
+    tail_ = next;
+    return true;
+  }
+
+private:
+  struct Node
+  {
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  std::atomic<Node*> head_;  // Last pushed node
+  Node* tail_;  // Stub node, before the first element
+};
+
+/**
+ * \brief Synchronization policy matching the messages like ApproximateTime, for high rates and
+ * many inputs.
+ *
+ * The sets of messages output are the same as the ones of ApproximateTime for the same order of
+ * arrival, the differences are in how the work is spread across threads:
+ *  - Messages are pushed on lock-free per-input queues, the thread delivering a message never
+ *    waits for another thread: when another one is already matching messages, it takes the new
+ *    message over.
+ *  - The candidate search works on the timestamps cached at arrival, and hides messages behind a
+ *    per-input cursor instead of moving them to separate queues, so that giving up a candidate
+ *    doesn't copy the messages back.
+ *  - With callback threads, the matched sets are handed to a pool of worker threads, so that
+ *    callbacks overlap with each other and with the matching. The callbacks may then be called
+ *    out of order, and must be thread safe.
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType, typename M4 = NullType,
+         typename M5 = NullType, typename M6 = NullType, typename M7 = NullType, typename M8 = NullType>
+struct ParallelApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<ParallelApproximateTime> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef Events Tuple;
+
+  /**
+   * \param queue_size Maximum number of messages kept per input, and of matched sets waiting for
+   *   a callback thread
+   * \param num_callback_threads Number of threads calling the callbacks, 0 to call them from the
+   *   thread delivering the message which completes the set, like ApproximateTime
+   */
+  ParallelApproximateTime(uint32_t queue_size, size_t num_callback_threads = 0)
+  : parent_(0)
+  , queue_size_(queue_size)
+  , num_callback_threads_(num_callback_threads)
+  , max_interval_duration_(std::numeric_limits<int64_t>::max())
+  , age_penalty_(0.1)
+  , inter_message_lower_bounds_(9, 0)
+  {
+    // The synchronizer will tend to drop many messages with a queue size of 1. At least 2 is recommended.
+    assert(queue_size_ > 0);
+    initState();
+  }
+
+  // Copies the configuration only, as Synchronizer does before connecting the inputs
+  ParallelApproximateTime(const ParallelApproximateTime& e)
+  : parent_(0)
+  , queue_size_(e.queue_size_)
+  , num_callback_threads_(e.num_callback_threads_)
+  , max_interval_duration_(e.max_interval_duration_)
+  , age_penalty_(e.age_penalty_)
+  , inter_message_lower_bounds_(e.inter_message_lower_bounds_)
+  {
+    initState();
+  }
+
+  ParallelApproximateTime& operator=(const ParallelApproximateTime&) = delete;
+
+  ~ParallelApproximateTime()
+  {
+    shutdown();
+  }
+
+  void initParent(Sync* parent)
+  {
+    parent_ = parent;
+    for (size_t i = 0; i < num_callback_threads_; ++i)
+    {
+      workers_.emplace_back(&ParallelApproximateTime::runWorker, this);
+    }
+  }
+
+  // Stops the callback threads, dropping the sets they didn't take yet
+  void shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sets_mutex_);
+      stopping_ = true;
+    }
+    sets_condition_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+      worker.join();
+    }
+    workers_.clear();
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type& evt)
+  {
+    namespace mt = message_filters::message_traits;
+    typedef typename std::tuple_element<i, Messages>::type Message;
+
+    Input<typename std::tuple_element<i, Events>::type> input;
+    input.sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+    input.stamp = mt::TimeStamp<Message>::value(*evt.getMessage()).nanoseconds();
+    input.event = evt;
+    std::get<i>(inputs_).push(std::move(input));
+
+    if (num_pending_inputs_.fetch_add(1, std::memory_order_acq_rel) != 0)
+    {
+      // The thread matching messages takes this one as well
+      return;
+    }
+    size_t count = 1;
+    do
+    {
+      for (size_t n = 0; n < count; ++n)
+      {
+        takeInput();
+      }
+      count = num_pending_inputs_.fetch_sub(count, std::memory_order_acq_rel) - count;
+    } while (count != 0);
+  }
+
+  void setAgePenalty(double age_penalty)
+  {
+    // For correctness we only need age_penalty > -1.0, but most likely a negative age_penalty is a mistake.
+    assert(age_penalty >= 0);
+    age_penalty_ = age_penalty;
+  }
+
+  void setInterMessageLowerBound(int i, rclcpp::Duration lower_bound)
+  {
+    assert(lower_bound >= rclcpp::Duration(0, 0));
+    inter_message_lower_bounds_[i] = lower_bound.nanoseconds();
+  }
+
+  void setMaxIntervalDuration(rclcpp::Duration max_interval_duration)
+  {
+    assert(max_interval_duration >= rclcpp::Duration(0, 0));
+    max_interval_duration_ = max_interval_duration.nanoseconds();
+  }
+
+private:
+  template<typename Event>
+  struct Input
+  {
+    uint64_t sequence;  // Order of arrival across all inputs
+    int64_t stamp;
+    Event event;
+  };
+
+  // Messages kept for an input. The first <cursor> ones are the ones ApproximateTime moves to its
+  // "past" vectors, the others are the ones left in its deques.
+  struct Queue
+  {
+    std::deque<int64_t> stamps;
+    size_t cursor;
+    bool has_dropped_messages;
+    bool warned_about_incorrect_bound;
+  };
+
+  typedef std::tuple<MpscQueue<Input<M0Event> >, MpscQueue<Input<M1Event> >, MpscQueue<Input<M2Event> >,
+                     MpscQueue<Input<M3Event> >, MpscQueue<Input<M4Event> >, MpscQueue<Input<M5Event> >,
+                     MpscQueue<Input<M6Event> >, MpscQueue<Input<M7Event> >, MpscQueue<Input<M8Event> > > InputTuple;
+  typedef std::tuple<std::deque<M0Event>, std::deque<M1Event>, std::deque<M2Event>, std::deque<M3Event>,
+                     std::deque<M4Event>, std::deque<M5Event>, std::deque<M6Event>, std::deque<M7Event>,
+                     std::deque<M8Event> > EventDequeTuple;
+
+  static const uint32_t NO_PIVOT = 9;  // Special value for the pivot indicating that no pivot has been selected
+
+  void initState()
+  {
+    for (Queue& queue : queues_)
+    {
+      queue.cursor = 0;
+      queue.has_dropped_messages = false;
+      queue.warned_about_incorrect_bound = false;
+    }
+    num_non_empty_queues_ = 0;
+    pivot_ = NO_PIVOT;
+    candidate_start_ = 0;
+    candidate_end_ = 0;
+    pivot_time_ = 0;
+    next_sequence_ = 0;
+    num_pending_inputs_ = 0;
+    stopping_ = false;
+  }
+
+  // Whether messages are left after the cursor of queue i
+  bool isQueued(uint32_t i) const
+  {
+    return queues_[i].cursor < queues_[i].stamps.size();
+  }
+
+  template<int i>
+  void peekInput(uint32_t& index, uint64_t& sequence)
+  {
+    if (i >= RealTypeCount::value)
+    {
+      return;
+    }
+    auto input = std::get<i>(inputs_).front();
+    if (input && input->sequence < sequence)
+    {
+      index = i;
+      sequence = input->sequence;
+    }
+  }
+
+  // Moves the earliest message which arrived from its input queue to the matching state
+  void takeInput()
+  {
+    while (1)
+    {
+      uint32_t index = NO_PIVOT;
+      uint64_t sequence = std::numeric_limits<uint64_t>::max();
+      peekInput<0>(index, sequence);
+      peekInput<1>(index, sequence);
+      peekInput<2>(index, sequence);
+      peekInput<3>(index, sequence);
+      peekInput<4>(index, sequence);
+      peekInput<5>(index, sequence);
+      peekInput<6>(index, sequence);
+      peekInput<7>(index, sequence);
+      peekInput<8>(index, sequence);
+      switch (index)
+      {
+      case 0:
+        takeInput<0>();
+        return;
+      case 1:
+        takeInput<1>();
+        return;
+      case 2:
+        takeInput<2>();
+        return;
+      case 3:
+        takeInput<3>();
+        return;
+      case 4:
+        takeInput<4>();
+        return;
+      case 5:
+        takeInput<5>();
+        return;
+      case 6:
+        takeInput<6>();
+        return;
+      case 7:
+        takeInput<7>();
+        return;
+      case 8:
+        takeInput<8>();
+        return;
+      default:
+        // The message was counted, but its push is not visible yet
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  template<int i>
+  void takeInput()
+  {
+    auto input = std::get<i>(inputs_).front();
+    assert(input);
+    Queue& queue = queues_[i];
+    bool was_queued = isQueued(i);
+    queue.stamps.push_back(input->stamp);
+    std::get<i>(events_).push_back(std::move(input->event));
+    std::get<i>(inputs_).pop();
+
+    if (!was_queued)
+    {
+      // We have just added the first message, so it was empty before
+      ++num_non_empty_queues_;
+      if (num_non_empty_queues_ == (uint32_t)RealTypeCount::value)
+      {
+        // All queues have messages
+        process();
+      }
+    }
+    else
+    {
+      checkInterMessageBound(i);
+    }
+    // Check whether we have more messages than allowed in the queue.
+    // Note that during the above call to process(), queue i may contain queue_size_+1 messages.
+    if (queue.stamps.size() > queue_size_)
+    {
+      // Cancel ongoing candidate search, if any
+      for (uint32_t j = 0; j < (uint32_t)RealTypeCount::value; ++j)
+      {
+        queues_[j].cursor = 0;
+      }
+      // Drop the oldest message in the offending topic
+      eraseFront(i, 1);
+      countNonEmptyQueues();
+      queue.has_dropped_messages = true;
+      if (pivot_ != NO_PIVOT)
+      {
+        // The candidate is no longer valid. Destroy it.
+        pivot_ = NO_PIVOT;
+        // There might still be enough messages to create a new candidate:
+        process();
+      }
+    }
+  }
+
+  void checkInterMessageBound(uint32_t i)
+  {
+    Queue& queue = queues_[i];
+    if (queue.warned_about_incorrect_bound)
+    {
+      return;
+    }
+    assert(queue.stamps.size() >= 2);
+    int64_t msg_time = queue.stamps.back();
+    int64_t previous_msg_time = queue.stamps[queue.stamps.size() - 2];
+    if (msg_time < previous_msg_time)
+    {
+      RCUTILS_LOG_WARN_ONCE("Messages of type %u arrived out of order (will print only once)", i);
+      queue.warned_about_incorrect_bound = true;
+    }
+    else if ((msg_time - previous_msg_time) < inter_message_lower_bounds_[i])
+    {
+      RCUTILS_LOG_WARN_ONCE("Messages of type %u arrived closer ("
+        "%" PRId64 ") than the lower bound you provided ("
+        "%" PRId64 ") (will print only once)",
+        i,
+        msg_time - previous_msg_time,
+        inter_message_lower_bounds_[i]);
+      queue.warned_about_incorrect_bound = true;
+    }
+  }
+
+  template<int i>
+  void eraseFront(size_t count)
+  {
+    std::deque<typename std::tuple_element<i, Events>::type>& events = std::get<i>(events_);
+    events.erase(events.begin(), events.begin() + count);
+  }
+
+  // Erases the first <count> messages of queue <index>, which must have them
+  void eraseFront(uint32_t index, size_t count)
+  {
+    std::deque<int64_t>& stamps = queues_[index].stamps;
+    assert(count <= stamps.size());
+    stamps.erase(stamps.begin(), stamps.begin() + count);
+    switch (index)
+    {
+    case 0:
+      eraseFront<0>(count);
+      break;
+    case 1:
+      eraseFront<1>(count);
+      break;
+    case 2:
+      eraseFront<2>(count);
+      break;
+    case 3:
+      eraseFront<3>(count);
+      break;
+    case 4:
+      eraseFront<4>(count);
+      break;
+    case 5:
+      eraseFront<5>(count);
+      break;
+    case 6:
+      eraseFront<6>(count);
+      break;
+    case 7:
+      eraseFront<7>(count);
+      break;
+    case 8:
+      eraseFront<8>(count);
+      break;
+    default:
+      std::abort();
+    }
+  }
+
+  void countNonEmptyQueues()
+  {
+    num_non_empty_queues_ = 0;
+    for (uint32_t i = 0; i < (uint32_t)RealTypeCount::value; ++i)
+    {
+      if (isQueued(i))
+      {
+        ++num_non_empty_queues_;
+      }
+    }
+  }
+
+  // Assumes that queue number <index> has no hidden message, and is non empty
+  void queueDeleteFront(uint32_t index)
+  {
+    assert(queues_[index].cursor == 0);
+    eraseFront(index, 1);
+    if (!isQueued(index))
+    {
+      --num_non_empty_queues_;
+    }
+  }
+
+  // Assumes that queue number <index> is non empty
+  void queueMoveFrontToPast(uint32_t index)
+  {
+    assert(isQueued(index));
+    ++queues_[index].cursor;
+    if (!isQueued(index))
+    {
+      --num_non_empty_queues_;
+    }
+  }
+
+  void makeCandidate()
+  {
+    // Delete all past messages, since we have found a better candidate. The candidate is then made
+    // of the first message of each queue.
+    for (uint32_t i = 0; i < (uint32_t)RealTypeCount::value; ++i)
+    {
+      eraseFront(i, queues_[i].cursor);
+      queues_[i].cursor = 0;
+    }
+  }
+
+  template<int i>
+  void takeFront(Tuple& candidate)
+  {
+    if (i >= RealTypeCount::value)
+    {
+      return;
+    }
+    std::deque<typename std::tuple_element<i, Events>::type>& events = std::get<i>(events_);
+    std::get<i>(candidate) = std::move(events.front());
+    events.pop_front();
+    queues_[i].stamps.pop_front();
+    queues_[i].cursor = 0;
+  }
+
+  void publishCandidate()
+  {
+    Tuple candidate;
+    // Recover hidden messages, and delete the ones corresponding to the candidate
+    takeFront<0>(candidate);
+    takeFront<1>(candidate);
+    takeFront<2>(candidate);
+    takeFront<3>(candidate);
+    takeFront<4>(candidate);
+    takeFront<5>(candidate);
+    takeFront<6>(candidate);
+    takeFront<7>(candidate);
+    takeFront<8>(candidate);
+    pivot_ = NO_PIVOT;
+    countNonEmptyQueues();
+
+    if (workers_.empty())
+    {
+      signal(candidate);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(sets_mutex_);
+      if (sets_.size() >= queue_size_)
+      {
+        RCUTILS_LOG_WARN_ONCE(
+          "Callback threads can't keep up, dropping the oldest synchronized set (will print only once)");
+        sets_.pop_front();
+      }
+      sets_.push_back(std::move(candidate));
+    }
+    sets_condition_.notify_one();
+  }
+
+  void signal(const Tuple& set)
+  {
+    parent_->signal(std::get<0>(set), std::get<1>(set), std::get<2>(set), std::get<3>(set),
+                    std::get<4>(set), std::get<5>(set), std::get<6>(set), std::get<7>(set),
+                    std::get<8>(set));
+  }
+
+  void runWorker()
+  {
+    while (1)
+    {
+      Tuple set;
+      {
+        std::unique_lock<std::mutex> lock(sets_mutex_);
+        sets_condition_.wait(lock, [this]() {return stopping_ || !sets_.empty();});
+        if (stopping_)
+        {
+          return;
+        }
+        set = std::move(sets_.front());
+        sets_.pop_front();
+      }
+      signal(set);
+    }
+  }
+
+  // Assumes: all queues are non empty, i.e. num_non_empty_queues_ == RealTypeCount::value
+  // end = true: look for the latest head of queue
+  //       false: look for the earliest head of queue
+  void getCandidateBoundary(uint32_t& index, int64_t& time, bool end) const
+  {
+    time = queues_[0].stamps[queues_[0].cursor];
+    index = 0;
+    for (uint32_t i = 1; i < (uint32_t)RealTypeCount::value; ++i)
+    {
+      int64_t head_time = queues_[i].stamps[queues_[i].cursor];
+      if ((head_time < time) ^ end)
+      {
+        time = head_time;
+        index = i;
+      }
+    }
+  }
+
+  // Assumes: we have a pivot and candidate
+  int64_t getVirtualTime(uint32_t i) const
+  {
+    const Queue& queue = queues_[i];
+    if (!isQueued(i))
+    {
+      assert(queue.cursor > 0);  // Because we have a candidate
+      int64_t msg_time_lower_bound = queue.stamps.back() + inter_message_lower_bounds_[i];
+      if (msg_time_lower_bound > pivot_time_)  // Take the max
+      {
+        return msg_time_lower_bound;
+      }
+      return pivot_time_;
+    }
+    return queue.stamps[queue.cursor];
+  }
+
+  // Assumes: we have a pivot and candidate
+  // end = true: look for the latest head of queue
+  //       false: look for the earliest head of queue
+  void getVirtualCandidateBoundary(uint32_t& index, int64_t& time, bool end) const
+  {
+    time = getVirtualTime(0);
+    index = 0;
+    for (uint32_t i = 1; i < (uint32_t)RealTypeCount::value; ++i)
+    {
+      int64_t virtual_time = getVirtualTime(i);
+      if ((virtual_time < time) ^ end)
+      {
+        time = virtual_time;
+        index = i;
+      }
+    }
+  }
+
+  // Rounded toward zero like rclcpp::Duration::operator*()
+  int64_t penalize(int64_t duration) const
+  {
+    return static_cast<int64_t>(static_cast<long double>(duration) * (1 + age_penalty_));
+  }
+
+  // Only called by the thread taking the inputs
+  void process()
+  {
+    // While no queue is empty
+    while (num_non_empty_queues_ == (uint32_t)RealTypeCount::value)
+    {
+      // Find the start and end of the current interval
+      int64_t end_time, start_time;
+      uint32_t end_index, start_index;
+      getCandidateBoundary(end_index, end_time, true);
+      getCandidateBoundary(start_index, start_time, false);
+      for (uint32_t i = 0; i < (uint32_t)RealTypeCount::value; i++)
+      {
+        if (i != end_index)
+        {
+          // No dropped message could have been better to use than the ones we have,
+          // so it becomes ok to use this topic as pivot in the future
+          queues_[i].has_dropped_messages = false;
+        }
+      }
+      if (pivot_ == NO_PIVOT)
+      {
+        // We do not have a candidate
+        // INVARIANT: no message is hidden
+        if (end_time - start_time > max_interval_duration_)
+        {
+          // This interval is too big to be a valid candidate, move to the next
+          queueDeleteFront(start_index);
+          continue;
+        }
+        if (queues_[end_index].has_dropped_messages)
+        {
+          // The topic that would become pivot has dropped messages, so it is not a good pivot
+          queueDeleteFront(start_index);
+          continue;
+        }
+        // This is a valid candidate, and we don't have any, so take it
+        makeCandidate();
+        candidate_start_ = start_time;
+        candidate_end_ = end_time;
+        pivot_ = end_index;
+        pivot_time_ = end_time;
+        queueMoveFrontToPast(start_index);
+      }
+      else
+      {
+        // We already have a candidate
+        // Is this one better than the current candidate?
+        if (penalize(end_time - candidate_end_) >= (start_time - candidate_start_))
+        {
+          // This is not a better candidate, move to the next
+          queueMoveFrontToPast(start_index);
+        }
+        else
+        {
+          // This is a better candidate
+          makeCandidate();
+          candidate_start_ = start_time;
+          candidate_end_ = end_time;
+          queueMoveFrontToPast(start_index);
+          // Keep the same pivot (and pivot time)
+        }
+      }
+      // INVARIANT: we have a candidate and pivot
+      assert(pivot_ != NO_PIVOT);
+      if (start_index == pivot_)
+      {
+        // We have exhausted all possible candidates for this pivot, we now can output the best one
+        publishCandidate();
+      }
+      else if (penalize(end_time - candidate_end_) >= (pivot_time_ - candidate_start_))
+      {
+        // We have not exhausted all candidates, but this candidate is already provably optimal
+        // Indeed, any future candidate must contain the interval [pivot_time_ end_time], which
+        // is already too big.
+        publishCandidate();
+      }
+      else if (num_non_empty_queues_ < (uint32_t)RealTypeCount::value)
+      {
+        // Before giving up, use the rate bounds, if provided, to further try to prove optimality
+        size_t num_virtual_moves[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+        while (1)
+        {
+          int64_t end_time, start_time;
+          uint32_t end_index, start_index;
+          getVirtualCandidateBoundary(end_index, end_time, true);
+          getVirtualCandidateBoundary(start_index, start_time, false);
+          if (penalize(end_time - candidate_end_) >= (pivot_time_ - candidate_start_))
+          {
+            // We have proved optimality
+            // As above, any future candidate must contain the interval [pivot_time_ end_time], which
+            // is already too big.
+            publishCandidate();  // This cleans up the virtual moves as a byproduct
+            break;  // From the while(1) loop only
+          }
+          if (penalize(end_time - candidate_end_) < (start_time - candidate_start_))
+          {
+            // We cannot prove optimality
+            // Indeed, we have a virtual (i.e. optimistic) candidate that is better than the current
+            // candidate
+            // Cleanup the virtual search:
+            for (uint32_t i = 0; i < (uint32_t)RealTypeCount::value; ++i)
+            {
+              assert(num_virtual_moves[i] <= queues_[i].cursor);
+              queues_[i].cursor -= num_virtual_moves[i];
+            }
+            countNonEmptyQueues();
+            break;
+          }
+          // Note: we cannot reach this point with start_index == pivot_ since in that case we would
+          //       have start_time == pivot_time, in which case the two tests above are the negation
+          //       of each other, so that one must be true. Therefore the while loop always terminates.
+          assert(start_index != pivot_);
+          assert(start_time < pivot_time_);
+          queueMoveFrontToPast(start_index);
+          num_virtual_moves[start_index]++;
+        }  // while(1)
+      }
+    }  // while(num_non_empty_queues_ == (uint32_t)RealTypeCount::value)
+  }
+
+  Sync* parent_;
+  uint32_t queue_size_;
+  size_t num_callback_threads_;
+
+  // Filled by any thread
+  InputTuple inputs_;
+  std::atomic<uint64_t> next_sequence_;
+  // Messages pushed on the inputs and not taken yet. The thread bringing it from 0 takes the inputs
+  // until it goes back to 0, and is the only one touching the matching state below.
+  std::atomic<size_t> num_pending_inputs_;
+
+  // Matching state
+  Queue queues_[9];
+  EventDequeTuple events_;  // Messages of the queues, along with their stamps
+  uint32_t num_non_empty_queues_;  // Number of queues with messages after their cursor
+  int64_t candidate_start_;
+  int64_t candidate_end_;
+  int64_t pivot_time_;
+  uint32_t pivot_;  // Equal to NO_PIVOT if there is no candidate
+
+  int64_t max_interval_duration_;
+  double age_penalty_;
+  std::vector<int64_t> inter_message_lower_bounds_;
+
+  // Matched sets waiting for a callback thread
+  std::vector<std::thread> workers_;
+  std::mutex sets_mutex_;
+  std::condition_variable sets_condition_;
+  std::deque<Tuple> sets_;
+  bool stopping_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_PARALLEL_APPROXIMATE_TIME_H_
@@ -214,6 +214,7 @@ public:
   ~Synchronizer()
   {
     disconnectAll();
+    Policy::shutdown();
   }
 
   void init()
@@ -385,6 +386,14 @@ struct PolicyBase
                      MessageEvent<M3 const>, MessageEvent<M4 const>, MessageEvent<M5 const>,
                      MessageEvent<M6 const>, MessageEvent<M7 const>, MessageEvent<M8 const> > Events;
 
+  /// Stop calling the synchronizer, before it is destroyed.
+  /**
+   * Policies calling the synchronizer from their own threads stop them here.
+   */
+  void shutdown()
+  {
+  }
+
   typedef typename std::tuple_element<0, Events>::type M0Event;
   typedef typename std::tuple_element<1, Events>::type M1Event;
   typedef typename std::tuple_element<2, Events>::type M2Event;
@@ -0,0 +1,186 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2020, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/cache.h"
+#include "message_filters/message_traits.h"
+
+using performance_test_fixture::PerformanceTest;
+using message_filters::Cache;
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg& m)
+  {
+    return m.header.stamp;
+  }
+};
+}
+}
+
+namespace
+{
+constexpr unsigned int kCacheSize = 10000;
+// Period of the messages, in nanoseconds
+constexpr int64_t kPeriod = 1000000;
+
+rclcpp::Time stampOf(int64_t index)
+{
+  return rclcpp::Time(index * kPeriod);
+}
+}  // namespace
+
+class FullCache : public PerformanceTest
+{
+public:
+  FullCache()
+  : cache(kCacheSize)
+  {
+    for (unsigned int i = 0; i < 4 * kCacheSize; i++)
+    {
+      msgs.push_back(std::make_shared<Msg>());
+    }
+  }
+
+  void SetUp(benchmark::State & st)
+  {
+    // Fill the cache with messages newer than the ones of the previous runs
+    for (int64_t end = next_index + kCacheSize; next_index < end; next_index++)
+    {
+      cache.add(buildMsg(next_index));
+    }
+    PerformanceTest::SetUp(st);
+  }
+
+protected:
+  /// Stamp the next message of the pool, which has long been dropped from the cache
+  MsgConstPtr buildMsg(int64_t index)
+  {
+    const std::shared_ptr<Msg> & msg = msgs[next_msg];
+    next_msg = (next_msg + 1) % msgs.size();
+    msg->header.stamp = stampOf(index);
+    msg->data = static_cast<int>(index);
+    return msg;
+  }
+
+  Cache<Msg> cache;
+  std::vector<std::shared_ptr<Msg>> msgs;
+  size_t next_msg = 0;
+  int64_t next_index = 0;
+};
+
+BENCHMARK_F(FullCache, add_in_order)(benchmark::State & st)
+{
+  for (auto _ : st)
+  {
+    cache.add(buildMsg(next_index++));
+  }
+}
+
+BENCHMARK_F(FullCache, add_out_of_order)(benchmark::State & st)
+{
+  // Messages in order, each followed by one late by a tenth of the cache
+  for (auto _ : st)
+  {
+    cache.add(buildMsg(next_index++));
+    cache.add(buildMsg(next_index - kCacheSize / 10));
+  }
+}
+
+BENCHMARK_F(FullCache, get_interval)(benchmark::State & st)
+{
+  const rclcpp::Time start = stampOf(next_index - kCacheSize / 2);
+  const rclcpp::Time end = stampOf(next_index - kCacheSize / 2 + 10);
+
+  for (auto _ : st)
+  {
+    std::vector<MsgConstPtr> interval = cache.getInterval(start, end);
+    benchmark::DoNotOptimize(interval);
+  }
+}
+
+BENCHMARK_F(FullCache, get_surrounding_interval)(benchmark::State & st)
+{
+  const rclcpp::Time start = stampOf(next_index - kCacheSize / 2) + rclcpp::Duration(0, kPeriod / 2);
+  const rclcpp::Time end = stampOf(next_index - kCacheSize / 2 + 10) + rclcpp::Duration(0, kPeriod / 2);
+
+  for (auto _ : st)
+  {
+    std::vector<MsgConstPtr> interval = cache.getSurroundingInterval(start, end);
+    benchmark::DoNotOptimize(interval);
+  }
+}
+
+BENCHMARK_F(FullCache, get_elem_before_time)(benchmark::State & st)
+{
+  const rclcpp::Time time = stampOf(next_index - kCacheSize / 2);
+
+  for (auto _ : st)
+  {
+    MsgConstPtr elem = cache.getElemBeforeTime(time);
+    benchmark::DoNotOptimize(elem);
+  }
+}
+
+BENCHMARK_F(FullCache, get_elem_after_time)(benchmark::State & st)
+{
+  const rclcpp::Time time = stampOf(next_index - kCacheSize / 2);
+
+  for (auto _ : st)
+  {
+    MsgConstPtr elem = cache.getElemAfterTime(time);
+    benchmark::DoNotOptimize(elem);
+  }
+}
@@ -35,8 +35,10 @@
 #include <gtest/gtest.h>
 
 #include <rclcpp/rclcpp.hpp>
+#include <atomic>
 #include <memory>
 #include <functional>
+#include <thread>
 #include "message_filters/cache.h"
 #include "message_filters/message_traits.h"
 
@@ -192,6 +194,107 @@ TEST(Cache, easyElemBeforeAfter)
   EXPECT_TRUE(!elem_ptr) ;
 }
 
+TEST(Cache, unsortedEviction)
+{
+  Cache<Msg> cache(3) ;
+
+  cache.add(buildMsg(10, 1)) ;
+  cache.add(buildMsg(30, 3)) ;
+  cache.add(buildMsg(20, 2)) ;
+  EXPECT_EQ(cache.getOldestTime(), rclcpp::Time(10, 0)) ;
+  EXPECT_EQ(cache.getLatestTime(), rclcpp::Time(30, 0)) ;
+
+  // The oldest message is dropped, whatever the order they arrived in
+  cache.add(buildMsg(25, 4)) ;
+  vector<std::shared_ptr<Msg const> > interval_data = cache.getInterval(rclcpp::Time(0, 0), rclcpp::Time(80, 0)) ;
+  ASSERT_EQ(interval_data.size(), (unsigned int) 3) ;
+  EXPECT_EQ(interval_data[0]->data, 2) ;
+  EXPECT_EQ(interval_data[1]->data, 4) ;
+  EXPECT_EQ(interval_data[2]->data, 3) ;
+
+  // Messages with the same stamp are kept in the order they arrived in
+  cache.add(buildMsg(25, 5)) ;
+  cache.add(buildMsg(25, 6)) ;
+  interval_data = cache.getInterval(rclcpp::Time(25, 0), rclcpp::Time(25, 0)) ;
+  ASSERT_EQ(interval_data.size(), (unsigned int) 2) ;
+  EXPECT_EQ(interval_data[0]->data, 5) ;
+  EXPECT_EQ(interval_data[1]->data, 6) ;
+  EXPECT_EQ(cache.getElemAfterTime(rclcpp::Time(20, 0))->data, 5) ;
+  EXPECT_EQ(cache.getElemBeforeTime(rclcpp::Time(30, 0))->data, 6) ;
+}
+
+TEST(Cache, resize)
+{
+  Cache<Msg> cache(5) ;
+  fillCacheEasy(cache, 0, 8) ;
+
+  // The newest messages are kept
+  cache.setCacheSize(2) ;
+  vector<std::shared_ptr<Msg const> > interval_data = cache.getInterval(rclcpp::Time(0, 0), rclcpp::Time(80, 0)) ;
+  ASSERT_EQ(interval_data.size(), (unsigned int) 2) ;
+  EXPECT_EQ(interval_data[0]->data, 6) ;
+  EXPECT_EQ(interval_data[1]->data, 7) ;
+
+  cache.setCacheSize(4) ;
+  fillCacheEasy(cache, 8, 11) ;
+  interval_data = cache.getInterval(rclcpp::Time(0, 0), rclcpp::Time(200, 0)) ;
+  ASSERT_EQ(interval_data.size(), (unsigned int) 4) ;
+  EXPECT_EQ(interval_data[0]->data, 7) ;
+  EXPECT_EQ(interval_data[3]->data, 10) ;
+}
+
+TEST(Cache, emptyCache)
+{
+  Cache<Msg> cache(10) ;
+
+  EXPECT_TRUE(cache.getInterval(rclcpp::Time(0, 0), rclcpp::Time(80, 0)).empty()) ;
+  EXPECT_TRUE(cache.getSurroundingInterval(rclcpp::Time(0, 0), rclcpp::Time(80, 0)).empty()) ;
+  EXPECT_TRUE(!cache.getElemBeforeTime(rclcpp::Time(80, 0))) ;
+  EXPECT_TRUE(!cache.getElemAfterTime(rclcpp::Time(0, 0))) ;
+}
+
+TEST(Cache, concurrentQueries)
+{
+  Cache<Msg> cache(100) ;
+  std::atomic<bool> done(false) ;
+  std::atomic<int> num_unsorted(0) ;
+
+  std::vector<std::thread> readers ;
+  for (int i = 0; i < 4; i++)
+  {
+    readers.emplace_back([&]()
+      {
+        while (!done)
+        {
+          vector<std::shared_ptr<Msg const> > interval_data = cache.getInterval(rclcpp::Time(0, 0), rclcpp::Time(100000, 0)) ;
+          for (size_t j = 1; j < interval_data.size(); j++)
+          {
+            if (interval_data[j - 1]->header.stamp > interval_data[j]->header.stamp)
+            {
+              num_unsorted++ ;
+            }
+          }
+          std::this_thread::yield() ;
+        }
+      });
+  }
+  // Out of order by pairs
+  for (int i = 0; i < 2000; i += 2)
+  {
+    cache.add(buildMsg(i + 1, i + 1)) ;
+    cache.add(buildMsg(i, i)) ;
+  }
+  done = true ;
+  for (std::thread& reader : readers)
+  {
+    reader.join() ;
+  }
+
+  EXPECT_EQ(num_unsorted, 0) ;
+  EXPECT_EQ(cache.getOldestTime(), rclcpp::Time(1900, 0)) ;
+  EXPECT_EQ(cache.getLatestTime(), rclcpp::Time(1999, 0)) ;
+}
+
 struct EventHelper
 {
 public:
@@ -0,0 +1,338 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2020, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.h"
+#include "message_filters/sync_policies/approximate_time.h"
+#include "message_filters/sync_policies/parallel_approximate_time.h"
+#include "message_filters/message_traits.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::placeholders;
+using namespace message_filters;
+using namespace message_filters::sync_policies;
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg& m)
+  {
+    return m.header.stamp;
+  }
+};
+}
+}
+
+typedef std::vector<int> Set;  // Data of the messages of a synchronized set
+
+struct Input
+{
+  int topic;
+  MsgPtr msg;
+};
+
+// Messages of several periodic topics with jitter and random drops, arriving in a random order
+std::vector<Input> makeInputs(std::mt19937& generator, int num_topics, int num_messages)
+{
+  std::uniform_int_distribution<int> period(5, 40);
+  std::uniform_int_distribution<int> jitter(0, 10);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::vector<int> periods;
+  std::vector<int> stamps(num_topics, 0);
+  for (int i = 0; i < num_topics; ++i)
+  {
+    periods.push_back(period(generator));
+  }
+
+  std::vector<Input> inputs;
+  for (int n = 0; n < num_messages; ++n)
+  {
+    // The topic which publishes next, with stamps increasing on each topic
+    int topic = 0;
+    for (int i = 1; i < num_topics; ++i)
+    {
+      if (stamps[i] < stamps[topic])
+      {
+        topic = i;
+      }
+    }
+    stamps[topic] += periods[topic];
+    if (percent(generator) < 10)
+    {
+      continue;  // Dropped
+    }
+    MsgPtr msg(std::make_shared<Msg>());
+    msg->header.stamp = rclcpp::Time(0, 0) + rclcpp::Duration(0, stamps[topic] + jitter(generator));
+    msg->data = n;
+    inputs.push_back(Input{topic, msg});
+  }
+  // Shuffle a bit across topics
+  std::uniform_int_distribution<size_t> offset(0, 3);
+  for (size_t n = 0; n + 4 < inputs.size(); ++n)
+  {
+    std::swap(inputs[n], inputs[n + offset(generator)]);
+  }
+  return inputs;
+}
+
+template<class Sync>
+void addPairInput(Sync& sync, const Input& input)
+{
+  if (input.topic == 0)
+  {
+    sync.template add<0>(input.msg);
+  }
+  else
+  {
+    sync.template add<1>(input.msg);
+  }
+}
+
+template<class Sync>
+void addQuadInput(Sync& sync, const Input& input)
+{
+  switch (input.topic)
+  {
+    case 0:
+      sync.template add<0>(input.msg);
+      break;
+    case 1:
+      sync.template add<1>(input.msg);
+      break;
+    case 2:
+      sync.template add<2>(input.msg);
+      break;
+    case 3:
+      sync.template add<3>(input.msg);
+      break;
+  }
+}
+
+template<template<typename...> class Policy, class ... Args>
+std::vector<Set> runPairs(const std::vector<Input>& inputs, Args ... args)
+{
+  std::vector<Set> sets;
+  Policy<Msg, Msg> policy(args ...);
+  Synchronizer<Policy<Msg, Msg> > sync(policy);
+  sync.setInterMessageLowerBound(0, rclcpp::Duration(0, 3));
+  auto callback = [&sets](const MsgConstPtr& p, const MsgConstPtr& q)
+    {
+      sets.push_back(Set{p->data, q->data});
+    };
+  sync.registerCallback(std::bind(callback, _1, _2));
+  for (const Input& input : inputs)
+  {
+    addPairInput(sync, input);
+  }
+  return sets;
+}
+
+template<template<typename...> class Policy, class ... Args>
+std::vector<Set> runQuads(const std::vector<Input>& inputs, Args ... args)
+{
+  std::vector<Set> sets;
+  Policy<Msg, Msg, Msg, Msg> policy(args ...);
+  Synchronizer<Policy<Msg, Msg, Msg, Msg> > sync(policy);
+  sync.setAgePenalty(0.5);
+  auto callback = [&sets](const MsgConstPtr& p, const MsgConstPtr& q, const MsgConstPtr& r, const MsgConstPtr& s)
+    {
+      sets.push_back(Set{p->data, q->data, r->data, s->data});
+    };
+  sync.registerCallback(std::bind(callback, _1, _2, _3, _4));
+  for (const Input& input : inputs)
+  {
+    addQuadInput(sync, input);
+  }
+  return sets;
+}
+
+TEST(ParallelApproxTimeSync, SameSetsAsApproximateTime)
+{
+  std::mt19937 generator(42);
+  for (uint32_t queue_size : {2u, 3u, 5u, 10u})
+  {
+    for (int round = 0; round < 20; ++round)
+    {
+      std::vector<Input> pairs = makeInputs(generator, 2, 300);
+      std::vector<Set> expected = runPairs<ApproximateTime>(pairs, queue_size);
+      EXPECT_FALSE(expected.empty());
+      EXPECT_EQ(expected, runPairs<ParallelApproximateTime>(pairs, queue_size));
+
+      std::vector<Input> quads = makeInputs(generator, 4, 600);
+      expected = runQuads<ApproximateTime>(quads, queue_size);
+      EXPECT_FALSE(expected.empty());
+      EXPECT_EQ(expected, runQuads<ParallelApproximateTime>(quads, queue_size));
+    }
+  }
+}
+
+TEST(ParallelApproxTimeSync, ConcurrentInputs)
+{
+  // Each topic is delivered by its own thread, all the messages of a frame having the same stamp
+  const int num_frames = 2000;
+  ParallelApproximateTime<Msg, Msg, Msg, Msg> policy(num_frames);
+  Synchronizer<ParallelApproximateTime<Msg, Msg, Msg, Msg> > sync(policy);
+  std::atomic<int> num_sets(0);
+  std::atomic<int> num_mismatches(0);
+  auto callback = [&](const MsgConstPtr& p, const MsgConstPtr& q, const MsgConstPtr& r, const MsgConstPtr& s)
+    {
+      if (p->data != q->data || p->data != r->data || p->data != s->data)
+      {
+        ++num_mismatches;
+      }
+      ++num_sets;
+    };
+  sync.registerCallback(std::bind(callback, _1, _2, _3, _4));
+
+  std::vector<std::thread> threads;
+  for (int topic = 0; topic < 4; ++topic)
+  {
+    threads.emplace_back(
+      [&sync, topic]()
+      {
+        for (int frame = 0; frame < num_frames; ++frame)
+        {
+          MsgPtr msg(std::make_shared<Msg>());
+          msg->header.stamp = rclcpp::Time(frame, 0);
+          msg->data = frame;
+          addQuadInput(sync, Input{topic, msg});
+        }
+      });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(0, num_mismatches);
+  EXPECT_EQ(num_frames, num_sets);
+}
+
+TEST(ParallelApproxTimeSync, CallbackThreadsOverlap)
+{
+  ParallelApproximateTime<Msg, Msg> policy(10, 2);
+  std::mutex mutex;
+  std::condition_variable condition;
+  int num_running = 0;
+  int max_running = 0;
+  int num_sets = 0;
+  {
+    Synchronizer<ParallelApproximateTime<Msg, Msg> > sync(policy);
+    auto callback = [&](const MsgConstPtr&, const MsgConstPtr&)
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++num_running;
+        max_running = std::max(max_running, num_running);
+        condition.notify_all();
+        // Wait for the other callback, which can only run concurrently
+        condition.wait_for(lock, std::chrono::seconds(10), [&]() {return max_running == 2;});
+        --num_running;
+        ++num_sets;
+        condition.notify_all();
+      };
+    sync.registerCallback(std::bind(callback, _1, _2));
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+      MsgPtr msg(std::make_shared<Msg>());
+      msg->header.stamp = rclcpp::Time(frame, 0);
+      sync.add<0>(msg);
+      sync.add<1>(msg);
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(condition.wait_for(lock, std::chrono::seconds(10), [&]() {return num_sets == 3;}));
+  }
+  EXPECT_EQ(2, max_running);
+}
+
+TEST(ParallelApproxTimeSync, AddFromCallback)
+{
+  // Messages added by the callback are matched once it returns, instead of deadlocking
+  Synchronizer<ParallelApproximateTime<Msg, Msg> > sync(ParallelApproximateTime<Msg, Msg>(10));
+  std::vector<int> frames;
+  auto callback = [&](const MsgConstPtr& p, const MsgConstPtr&)
+    {
+      frames.push_back(p->data);
+      if (p->data < 3)
+      {
+        MsgPtr msg(std::make_shared<Msg>());
+        msg->header.stamp = rclcpp::Time(p->data + 1, 0);
+        msg->data = p->data + 1;
+        sync.add<0>(msg);
+        sync.add<1>(msg);
+      }
+    };
+  sync.registerCallback(std::bind(callback, _1, _2));
+
+  MsgPtr msg(std::make_shared<Msg>());
+  msg->header.stamp = rclcpp::Time(0, 0);
+  msg->data = 0;
+  sync.add<0>(msg);
+  sync.add<1>(msg);
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), frames);
+}
+
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -490,6 +490,51 @@ RCL_WARN_UNUSED
 const char *
 rcl_node_get_logger_name(const rcl_node_t * node);
 
+/// Expand a topic or service name and apply the remap rules of the node to it.
+/**
+ * The input name is expanded to a fully qualified name using the name and
+ * namespace of the node, the local and global topic or service remap rules
+ * that apply to the node are used to remap it, and the result is validated.
+ *
+ * The match side of the remap rules is expanded once for the node, the first
+ * time a name is resolved, and successfully resolved names are cached by the
+ * node, so resolving the same name again does not walk the remap rules.
+ * Both are released when the node is finalized.
+ *
+ * The resulting name is allocated with the given allocator, and it is up to
+ * the caller to deallocate it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] node the node whose name, namespace and remap rules are used
+ * \param[in] input_name the topic or service name to be resolved
+ * \param[in] allocator the allocator used to allocate the output name
+ * \param[in] is_service `true` if the name is a service name, `false` if it is a topic name
+ * \param[out] output_name the fully qualified and remapped name
+ * \return `RCL_RET_OK` if the name was resolved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if the topic name is invalid, or
+ * \return `RCL_RET_SERVICE_NAME_INVALID` if the service name is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_resolve_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  rcl_allocator_t allocator,
+  bool is_service,
+  char ** output_name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@ extern "C"
 #include "rcl/arguments.h"
 #include "rcl/error_handling.h"
 #include "rcl/domain_id.h"
+#include "rcl/expand_topic_name.h"
 #include "rcl/localhost.h"
 #include "rcl/logging.h"
 #include "rcl/logging_rosout.h"
@@ -42,16 +43,21 @@ extern "C"
 #include "rcutils/macros.h"
 #include "rcutils/repl_str.h"
 #include "rcutils/snprintf.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
+#include "rcutils/types/hash_map.h"
+#include "rcutils/types/string_map.h"
 
 #include "rmw/error_handling.h"
 #include "rmw/security_options.h"
 #include "rmw/rmw.h"
+#include "rmw/validate_full_topic_name.h"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 #include "tracetools/tracetools.h"
 
 #include "./context_impl.h"
+#include "./remap_impl.h"
 
 typedef struct rcl_node_impl_t
 {
@@ -61,6 +67,15 @@ typedef struct rcl_node_impl_t
   rcl_guard_condition_t * graph_guard_condition;
   const char * logger_name;
   const char * fq_name;
+  /// Topic and service remap rules of the node, prepared when the first name is resolved.
+  rcl_remap_table_t remap_table;
+  /// Map from topic names to their resolved names.
+  rcutils_hash_map_t resolved_topic_names;
+  /// Map from service names to their resolved names.
+  rcutils_hash_map_t resolved_service_names;
+  /// Protects the remap table and the resolved names, as they are updated while resolving.
+  /// It is only held to look up, insert or install entries, so contention is short lived.
+  atomic_bool name_cache_lock;
 } rcl_node_impl_t;
 
 
@@ -102,6 +117,46 @@ const char * rcl_create_node_logger_name(
   return node_logger_name;
 }
 
+/// Deallocate the names in a map of resolved names, and the map itself.
+static void
+_rcl_node_resolved_names_fini(rcutils_hash_map_t * resolved_names, rcl_allocator_t allocator)
+{
+  if (NULL == resolved_names->impl) {
+    return;
+  }
+  char * name = NULL;
+  char * resolved_name = NULL;
+  rcutils_ret_t ret = rcutils_hash_map_get_next_key_and_data(
+    resolved_names, NULL, &name, &resolved_name);
+  while (RCUTILS_RET_OK == ret) {
+    char * previous_name = name;
+    char * previous_resolved_name = resolved_name;
+    ret = rcutils_hash_map_get_next_key_and_data(
+      resolved_names, &previous_name, &name, &resolved_name);
+    allocator.deallocate(previous_name, allocator.state);
+    allocator.deallocate(previous_resolved_name, allocator.state);
+  }
+  if (RCUTILS_RET_OK != rcutils_hash_map_fini(resolved_names)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to fini resolved names map: %s", rcutils_get_error_string().str);
+    rcutils_reset_error();
+  }
+}
+
+/// Deallocate the remap table and the resolved names of a node.
+static void
+_rcl_node_name_cache_fini(rcl_node_impl_t * impl)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (RCL_RET_OK != rcl_remap_table_fini(&impl->remap_table)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to fini remap table: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  _rcl_node_resolved_names_fini(&impl->resolved_topic_names, allocator);
+  _rcl_node_resolved_names_fini(&impl->resolved_service_names, allocator);
+}
+
 rcl_node_t
 rcl_get_zero_initialized_node()
 {
@@ -207,6 +262,10 @@ rcl_node_init(
   node->impl->graph_guard_condition = NULL;
   node->impl->logger_name = NULL;
   node->impl->fq_name = NULL;
+  node->impl->remap_table = rcl_get_zero_initialized_remap_table();
+  node->impl->resolved_topic_names = rcutils_get_zero_initialized_hash_map();
+  node->impl->resolved_service_names = rcutils_get_zero_initialized_hash_map();
+  atomic_init(&node->impl->name_cache_lock, false);
   node->impl->options = rcl_node_get_default_options();
   node->context = context;
   // Initialize node impl.
@@ -330,6 +389,7 @@ fail:
     if (node->impl->fq_name) {
       allocator->deallocate((char *)node->impl->fq_name, allocator->state);
     }
+    _rcl_node_name_cache_fini(node->impl);
     if (node->impl->rmw_node_handle) {
       ret = rmw_destroy_node(node->impl->rmw_node_handle);
       if (ret != RMW_RET_OK) {
@@ -408,6 +468,7 @@ rcl_node_fini(rcl_node_t * node)
   // assuming that allocate and deallocate are ok since they are checked in init
   allocator.deallocate((char *)node->impl->logger_name, allocator.state);
   allocator.deallocate((char *)node->impl->fq_name, allocator.state);
+  _rcl_node_name_cache_fini(node->impl);
   if (NULL != node->impl->options.arguments.impl) {
     rcl_ret_t ret = rcl_arguments_fini(&(node->impl->options.arguments));
     if (ret != RCL_RET_OK) {
@@ -528,6 +589,251 @@ rcl_node_get_logger_name(const rcl_node_t * node)
   return node->impl->logger_name;
 }
 
+static void
+_rcl_node_lock_name_cache(rcl_node_impl_t * impl)
+{
+  while (rcutils_atomic_exchange_bool(&impl->name_cache_lock, true)) {
+  }
+}
+
+static void
+_rcl_node_unlock_name_cache(rcl_node_impl_t * impl)
+{
+  rcutils_atomic_store(&impl->name_cache_lock, false);
+}
+
+/// Get the remap table of a node, preparing it the first time.
+/**
+ * The table is prepared without holding the lock and then installed, unless a concurrent call
+ * installed its own first. Once installed, the table is not modified until the node is fini'd.
+ */
+static rcl_ret_t
+_rcl_node_get_remap_table(const rcl_node_t * node, const rcl_remap_table_t ** table)
+{
+  rcl_node_impl_t * impl = node->impl;
+  _rcl_node_lock_name_cache(impl);
+  const bool is_ready = NULL != impl->remap_table.expanded_matches;
+  _rcl_node_unlock_name_cache(impl);
+  if (is_ready) {
+    *table = &impl->remap_table;
+    return RCL_RET_OK;
+  }
+
+  rcl_arguments_t * global_args = NULL;
+  if (impl->options.use_global_arguments) {
+    global_args = &(node->context->global_arguments);
+  }
+  rcl_remap_table_t new_table = rcl_get_zero_initialized_remap_table();
+  rcl_ret_t ret = rcl_remap_table_init(
+    &(impl->options.arguments), global_args, rcl_node_get_name(node),
+    rcl_node_get_namespace(node), impl->options.allocator, &new_table);
+  if (RCL_RET_OK != ret) {
+    return RCL_RET_BAD_ALLOC == ret ? ret : RCL_RET_ERROR;
+  }
+
+  _rcl_node_lock_name_cache(impl);
+  if (NULL == impl->remap_table.expanded_matches) {
+    impl->remap_table = new_table;
+    new_table = rcl_get_zero_initialized_remap_table();
+  }
+  _rcl_node_unlock_name_cache(impl);
+
+  if (RCL_RET_OK != rcl_remap_table_fini(&new_table)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to fini remap table: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  *table = &impl->remap_table;
+  return RCL_RET_OK;
+}
+
+/// Expand, remap and validate a name that is not in the resolved names of the node.
+static rcl_ret_t
+_rcl_node_resolve_uncached_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  rcl_allocator_t allocator,
+  bool is_service,
+  char ** output_name)
+{
+  const char * node_name = rcl_node_get_name(node);
+  const char * node_namespace = rcl_node_get_namespace(node);
+  const rcl_ret_t name_invalid_ret =
+    is_service ? RCL_RET_SERVICE_NAME_INVALID : RCL_RET_TOPIC_NAME_INVALID;
+
+  // Expand the given name.
+  char * expanded_name = NULL;
+  char * remapped_name = NULL;
+  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RCL_RET_ERROR;
+  }
+  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_BAD_ALLOC != ret) {
+      ret = RCL_RET_ERROR;
+    }
+    goto cleanup;
+  }
+  ret = rcl_expand_topic_name(
+    input_name, node_name, node_namespace, &substitutions_map, allocator, &expanded_name);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_TOPIC_NAME_INVALID == ret || RCL_RET_UNKNOWN_SUBSTITUTION == ret) {
+      ret = name_invalid_ret;
+    } else {
+      ret = RCL_RET_ERROR;
+    }
+    goto cleanup;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Expanded name '%s'", expanded_name);
+
+  // Remap the expanded name, preparing the remap rules of the node if needed.
+  const rcl_remap_table_t * remap_table = NULL;
+  ret = _rcl_node_get_remap_table(node, &remap_table);
+  if (RCL_RET_OK != ret) {
+    goto cleanup;
+  }
+  const char * replacement = rcl_remap_table_find(
+    remap_table, is_service ? RCL_SERVICE_REMAP : RCL_TOPIC_REMAP, expanded_name);
+  if (NULL != replacement) {
+    ret = rcl_expand_topic_name(
+      replacement, node_name, node_namespace, &substitutions_map, allocator, &remapped_name);
+    if (RCL_RET_OK != ret) {
+      ret = RCL_RET_ERROR;
+      goto cleanup;
+    }
+  } else {
+    remapped_name = expanded_name;
+    expanded_name = NULL;
+  }
+
+  // Validate the remapped name.
+  int validation_result;
+  rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_name, &validation_result, NULL);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    ret = RCL_RET_ERROR;
+    goto cleanup;
+  }
+  if (RMW_TOPIC_VALID != validation_result) {
+    RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+    ret = name_invalid_ret;
+    goto cleanup;
+  }
+
+cleanup:
+  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    ret = RCL_RET_ERROR;
+  }
+  if (NULL != expanded_name) {
+    allocator.deallocate(expanded_name, allocator.state);
+  }
+  if (RCL_RET_OK != ret) {
+    if (NULL != remapped_name) {
+      allocator.deallocate(remapped_name, allocator.state);
+    }
+    return ret;
+  }
+  *output_name = remapped_name;
+  return RCL_RET_OK;
+}
+
+/// Remember a resolved name, ignoring any failure as the name can be resolved again.
+/**
+ * The strings are copied before locking the cache. A name cached by a concurrent call is kept, so
+ * cached names are never modified nor freed until the node is fini'd.
+ */
+static void
+_rcl_node_cache_resolved_name(
+  rcl_node_impl_t * impl,
+  rcutils_hash_map_t * resolved_names,
+  const char * input_name,
+  const char * resolved_name)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  char * name = rcutils_strdup(input_name, allocator);
+  char * resolved_name_copy = rcutils_strdup(resolved_name, allocator);
+  bool is_cached = false;
+  if (NULL != name && NULL != resolved_name_copy) {
+    _rcl_node_lock_name_cache(impl);
+    rcutils_ret_t ret = RCUTILS_RET_OK;
+    if (NULL == resolved_names->impl) {
+      ret = rcutils_hash_map_init(
+        resolved_names, 2, sizeof(char *), sizeof(char *),
+        rcutils_hash_map_string_hash_func, rcutils_hash_map_string_cmp_func, &allocator);
+    }
+    if (RCUTILS_RET_OK == ret && !rcutils_hash_map_key_exists(resolved_names, &name)) {
+      is_cached = RCUTILS_RET_OK == rcutils_hash_map_set(resolved_names, &name, &resolved_name_copy);
+    }
+    _rcl_node_unlock_name_cache(impl);
+  }
+  if (!is_cached) {
+    rcutils_reset_error();
+    allocator.deallocate(name, allocator.state);
+    allocator.deallocate(resolved_name_copy, allocator.state);
+  }
+}
+
+rcl_ret_t
+rcl_node_resolve_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  rcl_allocator_t allocator,
+  bool is_service,
+  char ** output_name)
+{
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_NODE_INVALID);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_TOPIC_NAME_INVALID);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_SERVICE_NAME_INVALID);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_BAD_ALLOC);
+  RCUTILS_CAN_SET_MSG_AND_RETURN_WITH_ERROR_OF(RCL_RET_ERROR);
+
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_name, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_node_is_valid_except_context(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+
+  rcl_node_impl_t * impl = node->impl;
+  rcutils_hash_map_t * resolved_names =
+    is_service ? &impl->resolved_service_names : &impl->resolved_topic_names;
+
+  // Cached names are never modified until the node is fini'd, so they can be copied unlocked.
+  char * resolved_name = NULL;
+  _rcl_node_lock_name_cache(impl);
+  if (NULL != resolved_names->impl &&
+    RCUTILS_RET_OK != rcutils_hash_map_get(resolved_names, &input_name, &resolved_name))
+  {
+    resolved_name = NULL;
+  }
+  _rcl_node_unlock_name_cache(impl);
+
+  if (NULL != resolved_name) {
+    *output_name = rcutils_strdup(resolved_name, allocator);
+    if (NULL == *output_name) {
+      RCL_SET_ERROR_MSG("failed to allocate memory for resolved name");
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RCL_RET_OK;
+  }
+
+  rcl_ret_t ret = _rcl_node_resolve_uncached_name(
+    node, input_name, allocator, is_service, output_name);
+  if (RCL_RET_OK == ret) {
+    _rcl_node_cache_resolved_name(impl, resolved_names, input_name, *output_name);
+  }
+  return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,7 +20,9 @@
 #include "rcl/expand_topic_name.h"
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/strdup.h"
+#include "rcutils/types/hash_map.h"
 #include "rcutils/types/string_map.h"
 
 #ifdef __cplusplus
@@ -323,6 +325,207 @@ rcl_remap_node_namespace(
     allocator, output_namespace);
 }
 
+rcl_remap_table_t
+rcl_get_zero_initialized_remap_table(void)
+{
+  static rcl_remap_table_t zero_table = {
+    .topic_rules = {NULL},
+    .service_rules = {NULL},
+    .expanded_matches = NULL,
+    .num_expanded_matches = 0u
+  };
+  return zero_table;
+}
+
+/// Hash the topic and service rules of a set of arguments that apply to a node.
+RCL_LOCAL
+rcl_ret_t
+_rcl_remap_table_add_rules(
+  rcl_remap_table_t * table,
+  const rcl_arguments_t * arguments,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions)
+{
+  if (NULL == arguments || NULL == arguments->impl) {
+    return RCL_RET_OK;
+  }
+  for (int i = 0; i < arguments->impl->num_remap_rules; ++i) {
+    const rcl_remap_t * rule = &(arguments->impl->remap_rules[i]);
+    if (!(rule->impl->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP))) {
+      continue;
+    }
+    if (rule->impl->node_name != NULL && 0 != strcmp(rule->impl->node_name, node_name)) {
+      continue;
+    }
+    char * expanded_match = NULL;
+    rcl_ret_t ret = rcl_expand_topic_name(
+      rule->impl->match, node_name, node_namespace,
+      substitutions, table->allocator, &expanded_match);
+    if (RCL_RET_OK != ret) {
+      if (
+        RCL_RET_NODE_INVALID_NAMESPACE == ret ||
+        RCL_RET_NODE_INVALID_NAME == ret ||
+        RCL_RET_BAD_ALLOC == ret)
+      {
+        return ret;
+      }
+      // rules that cannot be expanded would never match
+      rcl_reset_error();
+      continue;
+    }
+    table->expanded_matches[table->num_expanded_matches++] = expanded_match;
+
+    // Keep the first rule matching a name, as later ones would never be used.
+    const char * replacement = rule->impl->replacement;
+    if (
+      (rule->impl->type & RCL_TOPIC_REMAP) &&
+      !rcutils_hash_map_key_exists(&table->topic_rules, &expanded_match))
+    {
+      if (RCUTILS_RET_OK != rcutils_hash_map_set(
+          &table->topic_rules, &expanded_match, &replacement))
+      {
+        RCL_SET_ERROR_MSG("failed to add remap rule to topic rules");
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+    if (
+      (rule->impl->type & RCL_SERVICE_REMAP) &&
+      !rcutils_hash_map_key_exists(&table->service_rules, &expanded_match))
+    {
+      if (RCUTILS_RET_OK != rcutils_hash_map_set(
+          &table->service_rules, &expanded_match, &replacement))
+      {
+        RCL_SET_ERROR_MSG("failed to add remap rule to service rules");
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_remap_table_init(
+  const rcl_arguments_t * local_arguments,
+  const rcl_arguments_t * global_arguments,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_allocator_t allocator,
+  rcl_remap_table_t * table)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(table, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != table->expanded_matches) {
+    RCL_SET_ERROR_MSG("table must be zero initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  table->allocator = allocator;
+  size_t max_rules = 0u;
+  if (NULL != local_arguments && NULL != local_arguments->impl) {
+    max_rules += (size_t)local_arguments->impl->num_remap_rules;
+  }
+  if (NULL != global_arguments && NULL != global_arguments->impl) {
+    max_rules += (size_t)global_arguments->impl->num_remap_rules;
+  }
+  // Allocate at least one element, so expanded_matches tells whether the table is initialized.
+  table->expanded_matches = allocator.allocate(
+    sizeof(char *) * (max_rules > 0u ? max_rules : 1u), allocator.state);
+  if (NULL == table->expanded_matches) {
+    RCL_SET_ERROR_MSG("failed to allocate memory for remap table");
+    return RCL_RET_BAD_ALLOC;
+  }
+  table->num_expanded_matches = 0u;
+
+  rcl_ret_t ret = RCL_RET_OK;
+  rcutils_string_map_t substitutions = rcutils_get_zero_initialized_string_map();
+  table->topic_rules = rcutils_get_zero_initialized_hash_map();
+  table->service_rules = rcutils_get_zero_initialized_hash_map();
+  size_t capacity = max_rules > 1u ? max_rules : 2u;
+  if (
+    RCUTILS_RET_OK != rcutils_hash_map_init(
+      &table->topic_rules, capacity, sizeof(char *), sizeof(const char *),
+      rcutils_hash_map_string_hash_func, rcutils_hash_map_string_cmp_func, &allocator) ||
+    RCUTILS_RET_OK != rcutils_hash_map_init(
+      &table->service_rules, capacity, sizeof(char *), sizeof(const char *),
+      rcutils_hash_map_string_hash_func, rcutils_hash_map_string_cmp_func, &allocator))
+  {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+
+  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions, 0, allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    ret = RCUTILS_RET_BAD_ALLOC == rcutils_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+    goto fail;
+  }
+  ret = rcl_get_default_topic_name_substitutions(&substitutions);
+  if (RCL_RET_OK == ret) {
+    ret = _rcl_remap_table_add_rules(
+      table, local_arguments, node_name, node_namespace, &substitutions);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = _rcl_remap_table_add_rules(
+      table, global_arguments, node_name, node_namespace, &substitutions);
+  }
+  if (RCUTILS_RET_OK != rcutils_string_map_fini(&substitutions)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    ret = RCL_RET_ERROR;
+  }
+  if (RCL_RET_OK == ret) {
+    return RCL_RET_OK;
+  }
+fail:
+  if (RCL_RET_OK != rcl_remap_table_fini(table)) {
+    RCL_SET_ERROR_MSG("Error while finalizing remap table due to another error");
+  }
+  return ret;
+}
+
+const char *
+rcl_remap_table_find(
+  const rcl_remap_table_t * table,
+  rcl_remap_type_t type_bitmask,
+  const char * name)
+{
+  const rcutils_hash_map_t * rules =
+    (RCL_SERVICE_REMAP == type_bitmask) ? &table->service_rules : &table->topic_rules;
+  const char * replacement = NULL;
+  if (RCUTILS_RET_OK != rcutils_hash_map_get(rules, &name, &replacement)) {
+    return NULL;
+  }
+  return replacement;
+}
+
+rcl_ret_t
+rcl_remap_table_fini(rcl_remap_table_t * table)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(table, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  if (NULL != table->topic_rules.impl &&
+    RCUTILS_RET_OK != rcutils_hash_map_fini(&table->topic_rules))
+  {
+    ret = RCL_RET_ERROR;
+  }
+  if (NULL != table->service_rules.impl &&
+    RCUTILS_RET_OK != rcutils_hash_map_fini(&table->service_rules))
+  {
+    ret = RCL_RET_ERROR;
+  }
+  if (NULL != table->expanded_matches) {
+    for (size_t i = 0u; i < table->num_expanded_matches; ++i) {
+      table->allocator.deallocate(table->expanded_matches[i], table->allocator.state);
+    }
+    table->allocator.deallocate(table->expanded_matches, table->allocator.state);
+  }
+  *table = rcl_get_zero_initialized_remap_table();
+  return ret;
+}
+
 rcl_ret_t
 rcl_remap_fini(
   rcl_remap_t * rule)
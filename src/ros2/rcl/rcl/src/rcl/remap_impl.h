@@ -16,10 +16,12 @@
 #define RCL__REMAP_IMPL_H_
 
 #include "rcl/allocator.h"
+#include "rcl/arguments.h"
 #include "rcl/macros.h"
 #include "rcl/remap.h"
 #include "rcl/types.h"
 #include "rcl/visibility_control.h"
+#include "rcutils/types/hash_map.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -51,6 +53,77 @@ typedef struct rcl_remap_impl_t
   rcl_allocator_t allocator;
 } rcl_remap_impl_t;
 
+/// Topic and service remap rules that apply to a node, hashed by their expanded match side.
+typedef struct rcl_remap_table_t
+{
+  /// Map from an expanded topic name to the replacement of the first topic rule matching it.
+  rcutils_hash_map_t topic_rules;
+  /// Map from an expanded service name to the replacement of the first service rule matching it.
+  rcutils_hash_map_t service_rules;
+  /// Expanded match side of the rules, which the maps above use as keys.
+  char ** expanded_matches;
+  /// Number of strings in expanded_matches.
+  size_t num_expanded_matches;
+
+  /// Allocator used to allocate objects in this struct
+  rcl_allocator_t allocator;
+} rcl_remap_table_t;
+
+/// Return a rcl_remap_table_t struct with members initialized to zero values.
+RCL_LOCAL
+rcl_remap_table_t
+rcl_get_zero_initialized_remap_table(void);
+
+/// Expand and hash the topic and service remap rules that apply to a node.
+/**
+ * Local rules take precedence over global ones, and within each set the first
+ * rule matching a name wins, as it does in rcl_remap_topic_name().
+ * Rules whose match side cannot be expanded for the node are ignored.
+ *
+ * The replacements are not copied, so the arguments must outlive the table.
+ *
+ * \param[in] local_arguments command line arguments of the node, or NULL
+ * \param[in] global_arguments global command line arguments, or NULL
+ * \param[in] node_name the name of the node
+ * \param[in] node_namespace the namespace of the node
+ * \param[in] allocator the allocator used to allocate the table
+ * \param[out] table a zero initialized remap table
+ * \return RCL_RET_OK if the table was initialized, or
+ * \return RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return RCL_RET_NODE_INVALID_NAME if the node name is invalid, or
+ * \return RCL_RET_NODE_INVALID_NAMESPACE if the node namespace is invalid, or
+ * \return RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_LOCAL
+rcl_ret_t
+rcl_remap_table_init(
+  const rcl_arguments_t * local_arguments,
+  const rcl_arguments_t * global_arguments,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_allocator_t allocator,
+  rcl_remap_table_t * table);
+
+/// Find the replacement of the first rule matching an expanded name.
+/**
+ * \param[in] table an initialized remap table
+ * \param[in] type_bitmask either RCL_TOPIC_REMAP or RCL_SERVICE_REMAP
+ * \param[in] name the fully qualified name to be remapped
+ * \return the unexpanded replacement of the rule, or NULL if no rule matches the name
+ */
+RCL_LOCAL
+const char *
+rcl_remap_table_find(
+  const rcl_remap_table_t * table,
+  rcl_remap_type_t type_bitmask,
+  const char * name);
+
+/// Finalize a remap table, deallocating all its memory.
+RCL_LOCAL
+rcl_ret_t
+rcl_remap_table_fini(rcl_remap_table_t * table);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,7 @@ extern "C"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/event.h"
+#include "tracetools/tracetools.h"
 
 #include "./context_impl.h"
 
@@ -606,6 +607,11 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     is_timer_timeout ? "true" : "false");
 
   // Wait.
+  TRACEPOINT(
+    rcl_wait_start,
+    (const void *)wait_set,
+    timeout_argument ?
+    (int64_t)RCL_S_TO_NS(timeout_argument->sec) + (int64_t)timeout_argument->nsec : -1);
   rmw_ret_t ret = rmw_wait(
     &wait_set->impl->rmw_subscriptions,
     &wait_set->impl->rmw_guard_conditions,
@@ -614,6 +620,7 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     &wait_set->impl->rmw_events,
     wait_set->impl->rmw_wait_set,
     timeout_argument);
+  TRACEPOINT(rcl_wait_end, (const void *)wait_set, (int64_t)ret);
 
   // Items that are not ready will have been set to NULL by rmw_wait.
   // We now update our handles accordingly.
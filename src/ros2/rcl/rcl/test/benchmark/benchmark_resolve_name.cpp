@@ -0,0 +1,162 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/expand_topic_name.h"
+#include "rcl/rcl.h"
+#include "rcl/remap.h"
+#include "rcutils/types/string_map.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr const char kTopicName[] = "chatter";
+}
+
+/// Creates a node with as many global remap rules as given by the benchmark argument.
+class ResolveNamePerformanceTest : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & state)
+  {
+    allocator = rcl_get_default_allocator();
+
+    std::vector<std::string> rules;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      rules.push_back("/foo" + std::to_string(i) + ":=/bar" + std::to_string(i));
+    }
+    std::vector<const char *> argv{"process_name", "--ros-args"};
+    for (const std::string & rule : rules) {
+      argv.push_back("-r");
+      argv.push_back(rule.c_str());
+    }
+
+    init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, allocator);
+    if (RCL_RET_OK != ret) {
+      state.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(static_cast<int>(argv.size()), argv.data(), &init_options, &context);
+    if (RCL_RET_OK != ret) {
+      state.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&node, "node", "/ns", &context, &node_options);
+    if (RCL_RET_OK != ret) {
+      state.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+
+    performance_test_fixture::PerformanceTest::SetUp(state);
+  }
+
+  void TearDown(benchmark::State & state)
+  {
+    performance_test_fixture::PerformanceTest::TearDown(state);
+
+    if (RCL_RET_OK != rcl_node_fini(&node)) {
+      rcl_reset_error();
+    }
+    if (RCL_RET_OK != rcl_shutdown(&context)) {
+      rcl_reset_error();
+    }
+    if (RCL_RET_OK != rcl_context_fini(&context)) {
+      rcl_reset_error();
+    }
+    if (RCL_RET_OK != rcl_init_options_fini(&init_options)) {
+      rcl_reset_error();
+    }
+  }
+
+protected:
+  rcl_allocator_t allocator;
+  rcl_init_options_t init_options;
+  rcl_context_t context;
+  rcl_node_t node;
+};
+
+// What publishers, subscriptions, services and clients used to do for every name.
+BENCHMARK_DEFINE_F(ResolveNamePerformanceTest, expand_and_remap)(benchmark::State & state)
+{
+  reset_heap_counters();
+  for (auto _ : state) {
+    rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
+    rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, allocator);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      state.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      break;
+    }
+    rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
+    char * expanded_topic_name = NULL;
+    if (RCL_RET_OK == ret) {
+      ret = rcl_expand_topic_name(
+        kTopicName, rcl_node_get_name(&node), rcl_node_get_namespace(&node),
+        &substitutions_map, allocator, &expanded_topic_name);
+    }
+    rcutils_string_map_fini(&substitutions_map);
+    char * remapped_topic_name = NULL;
+    if (RCL_RET_OK == ret) {
+      ret = rcl_remap_topic_name(
+        NULL, &context.global_arguments, expanded_topic_name,
+        rcl_node_get_name(&node), rcl_node_get_namespace(&node), allocator,
+        &remapped_topic_name);
+    }
+    allocator.deallocate(expanded_topic_name, allocator.state);
+    allocator.deallocate(remapped_topic_name, allocator.state);
+    if (RCL_RET_OK != ret) {
+      state.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+}
+BENCHMARK_REGISTER_F(ResolveNamePerformanceTest, expand_and_remap)->Arg(0)->Arg(10)->Arg(100);
+
+BENCHMARK_DEFINE_F(ResolveNamePerformanceTest, resolve_name)(benchmark::State & state)
+{
+  // Warmup and fill the node cache
+  char * resolved_name = NULL;
+  if (RCL_RET_OK != rcl_node_resolve_name(&node, kTopicName, allocator, false, &resolved_name)) {
+    state.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+    return;
+  }
+  allocator.deallocate(resolved_name, allocator.state);
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    rcl_ret_t ret = rcl_node_resolve_name(&node, kTopicName, allocator, false, &resolved_name);
+    if (RCL_RET_OK != ret) {
+      state.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    allocator.deallocate(resolved_name, allocator.state);
+  }
+}
+BENCHMARK_REGISTER_F(ResolveNamePerformanceTest, resolve_name)->Arg(0)->Arg(10)->Arg(100);
@@ -337,3 +337,69 @@ TEST_F(CLASSNAME(TestRemapIntegrationFixture, RMW_IMPLEMENTATION), remap_using_n
   }
   EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node));
 }
+
+TEST_F(CLASSNAME(TestRemapIntegrationFixture, RMW_IMPLEMENTATION), resolve_name) {
+  int argc;
+  char ** argv;
+  SCOPE_GLOBAL_ARGS(
+    argc, argv,
+    "process_name",
+    "--ros-args",
+    "-r", "/foo/bar:=/bar/foo",
+    "-r", "other_node:/foo/baz:=/not/applied",
+    "-r", "~/private:=relative/private",
+    "-r", "rosservice://srv:=/remapped/srv");
+
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_node_init(&node, "node_name", "/ns", &context, &default_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  struct
+  {
+    const char * input_name;
+    bool is_service;
+    const char * expected_name;
+  } cases[] = {
+    {"/foo/bar", false, "/bar/foo"},
+    {"/foo/baz", false, "/foo/baz"},
+    {"~/private", false, "/ns/relative/private"},
+    {"{node}/topic", false, "/ns/node_name/topic"},
+    {"srv", false, "/ns/srv"},
+    {"srv", true, "/remapped/srv"},
+  };
+  // The second time around names come from the node cache, which must give the same results.
+  for (int i = 0; i < 2; ++i) {
+    for (const auto & test_case : cases) {
+      char * output_name = NULL;
+      rcl_ret_t ret = rcl_node_resolve_name(
+        &node, test_case.input_name, allocator, test_case.is_service, &output_name);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+      EXPECT_STREQ(test_case.expected_name, output_name) << test_case.input_name;
+      allocator.deallocate(output_name, allocator.state);
+    }
+  }
+
+  char * output_name = NULL;
+  EXPECT_EQ(
+    RCL_RET_TOPIC_NAME_INVALID,
+    rcl_node_resolve_name(&node, "invalid name", allocator, false, &output_name));
+  rcl_reset_error();
+  EXPECT_EQ(NULL, output_name);
+  EXPECT_EQ(
+    RCL_RET_SERVICE_NAME_INVALID,
+    rcl_node_resolve_name(&node, "{unknown}/srv", allocator, true, &output_name));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_node_resolve_name(&node, NULL, allocator, false, &output_name));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_node_resolve_name(&node, "/foo/bar", allocator, false, NULL));
+  rcl_reset_error();
+}
@@ -20,6 +20,8 @@ extern "C"
 #include "rcl_action/action_server.h"
 #include "./action_server_impl.h"
 
+#include <string.h>
+
 #include "rcl_action/default_qos.h"
 #include "rcl_action/goal_handle.h"
 #include "rcl_action/names.h"
@@ -32,6 +34,7 @@ extern "C"
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/strdup.h"
+#include "rcutils/types/hash_map.h"
 
 #include "rmw/rmw.h"
 
@@ -43,6 +46,27 @@ rcl_action_get_zero_initialized_server(void)
   return null_action_server;
 }
 
+// Implementation only
+static size_t
+_goal_uuid_hash(const void * key)
+{
+  // FNV-1a over the UUID bytes
+  const uint8_t * uuid = (const uint8_t *)key;
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0u; i < UUID_SIZE; ++i) {
+    hash ^= (uint64_t)uuid[i];
+    hash *= 1099511628211ULL;
+  }
+  return (size_t)hash;
+}
+
+// Implementation only
+static int
+_goal_uuid_cmp(const void * uuid0, const void * uuid1)
+{
+  return memcmp(uuid0, uuid1, UUID_SIZE);
+}
+
 #define SERVICE_INIT(Type) \
   char * Type ## _service_name = NULL; \
   ret = rcl_action_get_ ## Type ## _service_name(action_name, allocator, &Type ## _service_name); \
@@ -158,6 +182,8 @@ rcl_action_server_init(
   action_server->impl->options = *options;  // copy options
   action_server->impl->goal_handles = NULL;
   action_server->impl->num_goal_handles = 0u;
+  action_server->impl->goal_handles_capacity = 0u;
+  action_server->impl->goal_handles_map = rcutils_get_zero_initialized_hash_map();
   action_server->impl->clock = NULL;
 
   rcl_ret_t ret = RCL_RET_OK;
@@ -192,6 +218,19 @@ rcl_action_server_init(
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
   }
+
+  // Initialize goal handle lookup by UUID
+  rcutils_ret_t rcutils_ret = rcutils_hash_map_init(
+    &action_server->impl->goal_handles_map, 2u, UUID_SIZE, sizeof(rcl_action_goal_handle_t *),
+    _goal_uuid_hash, _goal_uuid_cmp, &allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
+      ret = RCL_RET_BAD_ALLOC;
+    } else {
+      ret = RCL_RET_ERROR;
+    }
+    goto fail;
+  }
   return ret;
 fail:
   {
@@ -249,6 +288,13 @@ rcl_action_server_fini(rcl_action_server_t * action_server, rcl_node_t * node)
     }
     allocator.deallocate(action_server->impl->goal_handles, allocator.state);
     action_server->impl->goal_handles = NULL;
+    action_server->impl->num_goal_handles = 0u;
+    action_server->impl->goal_handles_capacity = 0u;
+    if (NULL != action_server->impl->goal_handles_map.impl) {
+      if (rcutils_hash_map_fini(&action_server->impl->goal_handles_map) != RCUTILS_RET_OK) {
+        ret = RCL_RET_ERROR;
+      }
+    }
     // Deallocate struct
     allocator.deallocate(action_server->impl, allocator.state);
     action_server->impl = NULL;
@@ -339,6 +385,37 @@ _nanosec_to_goal_info_stamp(const int64_t * nanosec, rcl_action_goal_info_t * go
   goal_info->stamp.nanosec = *nanosec % RCUTILS_S_TO_NS(1);
 }
 
+// Implementation only
+static rcl_ret_t
+_get_goal_handle_nanosec(const rcl_action_goal_handle_t * goal_handle, int64_t * nanosec)
+{
+  rcl_action_goal_info_t goal_info;
+  rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
+  if (RCL_RET_OK != ret) {
+    return RCL_RET_ERROR;  // error already set
+  }
+  *nanosec = _goal_info_stamp_to_nanosec(&goal_info);
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+_find_goal_handle(
+  const rcl_action_server_impl_t * impl,
+  const uint8_t * uuid,
+  rcl_action_goal_handle_t ** goal_handle)
+{
+  if (!rcutils_hash_map_key_exists(&impl->goal_handles_map, uuid)) {
+    *goal_handle = NULL;
+    return RCL_RET_OK;
+  }
+  if (RCUTILS_RET_OK != rcutils_hash_map_get(&impl->goal_handles_map, uuid, goal_handle)) {
+    RCL_SET_ERROR_MSG("failed to look up goal handle");
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_action_goal_handle_t *
 rcl_action_accept_new_goal(
   rcl_action_server_t * action_server,
@@ -355,51 +432,87 @@ rcl_action_accept_new_goal(
     return NULL;
   }
 
-  // Allocate space in the goal handle pointer array
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
-  rcl_action_goal_handle_t ** goal_handles = action_server->impl->goal_handles;
-  const size_t num_goal_handles = action_server->impl->num_goal_handles;
-  // TODO(jacobperron): Don't allocate for every accepted goal handle,
-  //                    instead double the memory allocated if needed.
-  const size_t new_num_goal_handles = num_goal_handles + 1u;
-  void * tmp_ptr = allocator.reallocate(
-    goal_handles, new_num_goal_handles * sizeof(rcl_action_goal_handle_t *), allocator.state);
-  if (!tmp_ptr) {
-    RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
-    return NULL;
+  rcl_action_server_impl_t * impl = action_server->impl;
+  rcl_allocator_t allocator = impl->options.allocator;
+  const size_t num_goal_handles = impl->num_goal_handles;
+
+  // Grow the goal handle pointer array geometrically, so accepting goals is amortized O(1)
+  if (num_goal_handles == impl->goal_handles_capacity) {
+    const size_t new_capacity =
+      (0u == impl->goal_handles_capacity) ? 8u : 2u * impl->goal_handles_capacity;
+    void * tmp_ptr = allocator.reallocate(
+      impl->goal_handles, new_capacity * sizeof(rcl_action_goal_handle_t *), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
+      return NULL;
+    }
+    impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
+    impl->goal_handles_capacity = new_capacity;
   }
-  goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
 
   // Allocate space for a new goal handle
-  tmp_ptr = allocator.allocate(sizeof(rcl_action_goal_handle_t), allocator.state);
-  if (!tmp_ptr) {
+  rcl_action_goal_handle_t * goal_handle =
+    (rcl_action_goal_handle_t *)allocator.allocate(
+    sizeof(rcl_action_goal_handle_t), allocator.state);
+  if (!goal_handle) {
     RCL_SET_ERROR_MSG("memory allocation failed for new goal handle");
     return NULL;
   }
-  goal_handles[num_goal_handles] = (rcl_action_goal_handle_t *) tmp_ptr;
 
   // Re-stamp goal info with current time
   rcl_action_goal_info_t goal_info_stamp_now = rcl_action_get_zero_initialized_goal_info();
   goal_info_stamp_now = *goal_info;
   rcl_time_point_value_t now_time_point;
-  rcl_ret_t ret = rcl_clock_get_now(action_server->impl->clock, &now_time_point);
+  rcl_ret_t ret = rcl_clock_get_now(impl->clock, &now_time_point);
   if (RCL_RET_OK != ret) {
+    allocator.deallocate(goal_handle, allocator.state);
     return NULL;  // Error already set
   }
   _nanosec_to_goal_info_stamp(&now_time_point, &goal_info_stamp_now);
 
   // Create a new goal handle
-  *goal_handles[num_goal_handles] = rcl_action_get_zero_initialized_goal_handle();
-  ret = rcl_action_goal_handle_init(
-    goal_handles[num_goal_handles], &goal_info_stamp_now, allocator);
+  *goal_handle = rcl_action_get_zero_initialized_goal_handle();
+  ret = rcl_action_goal_handle_init(goal_handle, &goal_info_stamp_now, allocator);
   if (RCL_RET_OK != ret) {
+    allocator.deallocate(goal_handle, allocator.state);
     RCL_SET_ERROR_MSG("failed to initialize goal handle");
     return NULL;
   }
 
-  action_server->impl->goal_handles = goal_handles;
-  action_server->impl->num_goal_handles = new_num_goal_handles;
-  return goal_handles[num_goal_handles];
+  // Index the goal handle by its UUID
+  if (RCUTILS_RET_OK != rcutils_hash_map_set(
+      &impl->goal_handles_map, goal_info_stamp_now.goal_id.uuid, &goal_handle))
+  {
+    rcl_ret_t ret_throwaway = rcl_action_goal_handle_fini(goal_handle);
+    (void)ret_throwaway;
+    allocator.deallocate(goal_handle, allocator.state);
+    RCL_SET_ERROR_MSG("failed to index new goal handle");
+    return NULL;
+  }
+
+  // Keep goal handles ordered by acceptance time, so expiration only needs to look at the oldest
+  // goals. Goals are stamped with the current time, hence they normally go at the back, unless
+  // the clock jumped backwards.
+  size_t index = num_goal_handles;
+  while (index > 0u) {
+    int64_t previous_nanosec;
+    if (RCL_RET_OK != _get_goal_handle_nanosec(impl->goal_handles[index - 1u], &previous_nanosec)) {
+      rcl_reset_error();
+      break;
+    }
+    if (previous_nanosec <= now_time_point) {
+      break;
+    }
+    --index;
+  }
+  if (index < num_goal_handles) {
+    memmove(
+      &impl->goal_handles[index + 1u], &impl->goal_handles[index],
+      (num_goal_handles - index) * sizeof(rcl_action_goal_handle_t *));
+  }
+  impl->goal_handles[index] = goal_handle;
+  impl->num_goal_handles = num_goal_handles + 1u;
+  return goal_handle;
 }
 
 // Implementation only
@@ -411,8 +524,19 @@ _recalculate_expire_timer(
   size_t num_goal_handles,
   rcl_clock_t * clock)
 {
-  size_t num_inactive_goals = 0u;
-  int64_t minimum_period = timeout;
+  // Goal handles are sorted by acceptance time, so the first inactive goal expires first
+  rcl_action_goal_handle_t * oldest_inactive_goal = NULL;
+  for (size_t i = 0; i < num_goal_handles; ++i) {
+    if (!rcl_action_goal_handle_is_active(goal_handles[i])) {
+      oldest_inactive_goal = goal_handles[i];
+      break;
+    }
+  }
+
+  if (NULL == oldest_inactive_goal) {
+    // No idea when the next goal will expire, so cancel timer
+    return rcl_timer_cancel(expire_timer);
+  }
 
   // Get current time (nanosec)
   int64_t current_time;
@@ -421,43 +545,30 @@ _recalculate_expire_timer(
     return RCL_RET_ERROR;
   }
 
-  for (size_t i = 0; i < num_goal_handles; ++i) {
-    rcl_action_goal_handle_t * goal_handle = goal_handles[i];
-    if (!rcl_action_goal_handle_is_active(goal_handle)) {
-      ++num_inactive_goals;
-
-      rcl_action_goal_info_t goal_info;
-      ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        return RCL_RET_ERROR;
-      }
-
-      int64_t delta = timeout - (current_time - _goal_info_stamp_to_nanosec(&goal_info));
-      if (delta < minimum_period) {
-        minimum_period = delta;
-      }
-    }
+  rcl_action_goal_info_t goal_info;
+  ret = rcl_action_goal_handle_get_info(oldest_inactive_goal, &goal_info);
+  if (RCL_RET_OK != ret) {
+    return RCL_RET_ERROR;
   }
 
-  if (0u == num_goal_handles || 0u == num_inactive_goals) {
-    // No idea when the next goal will expire, so cancel timer
-    return rcl_timer_cancel(expire_timer);
-  } else {
-    if (minimum_period < 0) {
-      // Time jumped backwards
-      minimum_period = 0;
-    }
-    // Un-cancel timer
-    ret = rcl_timer_reset(expire_timer);
-    if (RCL_RET_OK != ret) {
-      return ret;
-    }
-    // Make timer fire when next goal expires
-    int64_t old_period;
-    ret = rcl_timer_exchange_period(expire_timer, minimum_period, &old_period);
-    if (RCL_RET_OK != ret) {
-      return ret;
-    }
+  int64_t minimum_period = timeout - (current_time - _goal_info_stamp_to_nanosec(&goal_info));
+  if (minimum_period > timeout) {
+    minimum_period = timeout;
+  }
+  if (minimum_period < 0) {
+    // Time jumped backwards
+    minimum_period = 0;
+  }
+  // Un-cancel timer
+  ret = rcl_timer_reset(expire_timer);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  // Make timer fire when next goal expires
+  int64_t old_period;
+  ret = rcl_timer_exchange_period(expire_timer, minimum_period, &old_period);
+  if (RCL_RET_OK != ret) {
+    return ret;
   }
   return RCL_RET_OK;
 }
@@ -591,26 +702,26 @@ rcl_action_expire_goals(
     return RCL_RET_ERROR;
   }
 
-  // Used for shrinking goal handle array
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
+  rcl_action_server_impl_t * impl = action_server->impl;
+  rcl_allocator_t allocator = impl->options.allocator;
 
   size_t num_goals_expired = 0u;
   rcl_ret_t ret_final = RCL_RET_OK;
-  const int64_t timeout = (int64_t)action_server->impl->options.result_timeout.nanoseconds;
+  const int64_t timeout = (int64_t)impl->options.result_timeout.nanoseconds;
   rcl_action_goal_handle_t * goal_handle;
   rcl_action_goal_info_t goal_info;
   int64_t goal_time;
-  size_t num_goal_handles = action_server->impl->num_goal_handles;
-  for (size_t i = 0u; i < num_goal_handles; ++i) {
+  const size_t num_goal_handles = impl->num_goal_handles;
+  // Goal handles are sorted by acceptance time, so only a prefix of the array can be expired.
+  // Surviving goal handles in that prefix are compacted in place, preserving their order.
+  size_t num_kept = 0u;
+  size_t i = 0u;
+  for (; i < num_goal_handles; ++i) {
     if (output_expired && num_goals_expired >= expired_goals_capacity) {
       // no more space to output expired goals, so stop expiring them
       break;
     }
-    goal_handle = action_server->impl->goal_handles[i];
-    // Expiration only applys to terminated goals
-    if (rcl_action_goal_handle_is_active(goal_handle)) {
-      continue;
-    }
+    goal_handle = impl->goal_handles[i];
     rcl_action_goal_info_t * info_ptr = &goal_info;
     if (output_expired) {
       info_ptr = &(expired_goals[num_goals_expired]);
@@ -618,41 +729,48 @@ rcl_action_expire_goals(
     ret = rcl_action_goal_handle_get_info(goal_handle, info_ptr);
     if (RCL_RET_OK != ret) {
       ret_final = RCL_RET_ERROR;
+      impl->goal_handles[num_kept++] = goal_handle;
       continue;
     }
     goal_time = _goal_info_stamp_to_nanosec(info_ptr);
-    if ((current_time - goal_time) > timeout) {
-      // Deallocate space used to store pointer to goal handle
-      allocator.deallocate(action_server->impl->goal_handles[i], allocator.state);
-      action_server->impl->goal_handles[i] = NULL;
-      // Move all pointers after backwards one to fill the gap
-      for (size_t post_i = i; (post_i + 1) < num_goal_handles; ++post_i) {
-        action_server->impl->goal_handles[post_i] = action_server->impl->goal_handles[post_i + 1];
-      }
-      // decrement i to check the same index again now that it has a new goal handle
-      --i;
-      --num_goal_handles;
-      ++num_goals_expired;
+    if ((current_time - goal_time) <= timeout) {
+      // This goal and all goals accepted after it have not timed out yet
+      break;
+    }
+    // Expiration only applys to terminated goals
+    if (rcl_action_goal_handle_is_active(goal_handle) ||
+      RCUTILS_RET_OK != rcutils_hash_map_unset(&impl->goal_handles_map, info_ptr->goal_id.uuid))
+    {
+      impl->goal_handles[num_kept++] = goal_handle;
+      continue;
     }
+    // Deallocate space used to store pointer to goal handle
+    allocator.deallocate(goal_handle, allocator.state);
+    ++num_goals_expired;
   }
 
   if (num_goals_expired > 0u) {
-    // Shrink goal handle array if some goals expired
-    if (0u == num_goal_handles) {
-      allocator.deallocate(action_server->impl->goal_handles, allocator.state);
-      action_server->impl->goal_handles = NULL;
-      action_server->impl->num_goal_handles = num_goal_handles;
-    } else {
+    // Move all pointers after the expired prefix backwards to fill the gaps
+    memmove(
+      &impl->goal_handles[num_kept], &impl->goal_handles[i],
+      (num_goal_handles - i) * sizeof(rcl_action_goal_handle_t *));
+    impl->num_goal_handles = num_kept + (num_goal_handles - i);
+
+    if (0u == impl->num_goal_handles) {
+      allocator.deallocate(impl->goal_handles, allocator.state);
+      impl->goal_handles = NULL;
+      impl->goal_handles_capacity = 0u;
+    } else if (impl->num_goal_handles < impl->goal_handles_capacity / 4u) {
+      // Shrink goal handle array if it became mostly empty
+      const size_t new_capacity = impl->goal_handles_capacity / 2u;
       void * tmp_ptr = allocator.reallocate(
-        action_server->impl->goal_handles,
-        num_goal_handles * sizeof(rcl_action_goal_handle_t *),
-        allocator.state);
+        impl->goal_handles, new_capacity * sizeof(rcl_action_goal_handle_t *), allocator.state);
       if (!tmp_ptr) {
         RCL_SET_ERROR_MSG("failed to shrink size of goal handle array");
         ret_final = RCL_RET_ERROR;
       } else {
-        action_server->impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
-        action_server->impl->num_goal_handles = num_goal_handles;
+        impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
+        impl->goal_handles_capacity = new_capacity;
       }
     }
   }
@@ -733,28 +851,20 @@ rcl_action_process_cancel_request(
   // Determine how many goals should transition to canceling
   if (!uuidcmpzero(request_uuid) && (0u == request_nanosec)) {
     // UUID is not zero and timestamp is zero; cancel exactly one goal (if it exists)
-    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
     // Assume the goal ID is invalid until we find it
     cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_UNKNOWN_GOAL_ID;
-    rcl_action_goal_handle_t * goal_handle;
-    for (size_t i = 0u; i < total_num_goals; ++i) {
-      goal_handle = action_server->impl->goal_handles[i];
-      rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        ret_final = RCL_RET_ERROR;
-        continue;
-      }
-
-      if (uuidcmp(request_uuid, goal_info.goal_id.uuid)) {
-        if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
-          goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
-          cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_NONE;
-        } else {
-          // If the goal is not cancelable, it must be because it is in a terminal state
-          cancel_response->msg.return_code =
-            action_msgs__srv__CancelGoal_Response__ERROR_GOAL_TERMINATED;
-        }
-        break;
+    rcl_action_goal_handle_t * goal_handle = NULL;
+    rcl_ret_t ret = _find_goal_handle(action_server->impl, request_uuid, &goal_handle);
+    if (RCL_RET_OK != ret) {
+      ret_final = RCL_RET_ERROR;
+    } else if (NULL != goal_handle) {
+      if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
+        goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+        cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_NONE;
+      } else {
+        // If the goal is not cancelable, it must be because it is in a terminal state
+        cancel_response->msg.return_code =
+          action_msgs__srv__CancelGoal_Response__ERROR_GOAL_TERMINATED;
       }
     }
   } else {
@@ -873,20 +983,8 @@ rcl_action_server_goal_exists(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, false);
 
-  rcl_action_goal_info_t gh_goal_info = rcl_action_get_zero_initialized_goal_info();
-  rcl_ret_t ret;
-  for (size_t i = 0u; i < action_server->impl->num_goal_handles; ++i) {
-    ret = rcl_action_goal_handle_get_info(action_server->impl->goal_handles[i], &gh_goal_info);
-    if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("failed to get info for goal handle");
-      return false;
-    }
-    // Compare UUIDs
-    if (uuidcmp(gh_goal_info.goal_id.uuid, goal_info->goal_id.uuid)) {
-      return true;
-    }
-  }
-  return false;
+  return rcutils_hash_map_key_exists(
+    &action_server->impl->goal_handles_map, goal_info->goal_id.uuid);
 }
 
 bool
@@ -17,6 +17,7 @@
 
 #include "rcl_action/types.h"
 #include "rcl/rcl.h"
+#include "rcutils/types/hash_map.h"
 
 /// Internal rcl_action implementation struct.
 typedef struct rcl_action_server_impl_t
@@ -29,9 +30,12 @@ typedef struct rcl_action_server_impl_t
   rcl_timer_t expire_timer;
   char * action_name;
   rcl_action_server_options_t options;
-  // Array of goal handles
+  // Array of goal handles, kept sorted by goal acceptance time
   rcl_action_goal_handle_t ** goal_handles;
   size_t num_goal_handles;
+  size_t goal_handles_capacity;
+  // Map from goal UUID to goal handle pointer
+  rcutils_hash_map_t goal_handles_map;
   // Clock
   rcl_clock_t * clock;
   // Wait set records
@@ -490,12 +490,11 @@ TEST_F(TestActionServer, test_action_server_goal_exists) {
   EXPECT_FALSE(rcl_action_server_goal_exists(&this->action_server, &different_goal));
   EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
 
-  // Check corrupted goal_handles
+  // Lookup goes through the UUID index and doesn't need to touch goal handles
   rcl_get_default_allocator().deallocate(goal_handle, rcl_get_default_allocator().state);
   this->action_server.impl->goal_handles[this->action_server.impl->num_goal_handles - 1] = nullptr;
   EXPECT_FALSE(rcl_action_server_goal_exists(&this->action_server, &different_goal));
-  EXPECT_TRUE(rcl_error_is_set());
-  rcl_reset_error();
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
 
   // Reset for teardown
   this->action_server.impl->num_goal_handles--;
@@ -606,6 +605,73 @@ TEST_F(TestActionServer, test_action_clear_expired_goals)
   }
 }
 
+TEST_F(TestActionServer, test_action_expire_many_goals)
+{
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(&this->clock));
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(&this->clock, RCUTILS_S_TO_NS(1)));
+
+  // Accept goals one second apart, terminating every other goal
+  const int num_goals = 100;
+  std::vector<rcl_action_goal_handle_t> handles;
+  rcl_action_goal_info_t goal_info_in = rcl_action_get_zero_initialized_goal_info();
+  for (int i = 0; i < num_goals; ++i) {
+    ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(&this->clock, RCUTILS_S_TO_NS(1 + i)));
+    for (int j = 0; j < UUID_SIZE; ++j) {
+      goal_info_in.goal_id.uuid[j] = static_cast<uint8_t>(i + j);
+    }
+    rcl_action_goal_handle_t * goal_handle =
+      rcl_action_accept_new_goal(&this->action_server, &goal_info_in);
+    ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+    handles.push_back(*goal_handle);
+    if (0 == i % 2) {
+      ASSERT_EQ(RCL_RET_OK, rcl_action_update_goal_state(goal_handle, GOAL_EVENT_EXECUTE));
+      ASSERT_EQ(RCL_RET_OK, rcl_action_update_goal_state(goal_handle, GOAL_EVENT_SUCCEED));
+    }
+  }
+  for (int i = 0; i < num_goals; ++i) {
+    for (int j = 0; j < UUID_SIZE; ++j) {
+      goal_info_in.goal_id.uuid[j] = static_cast<uint8_t>(i + j);
+    }
+    EXPECT_TRUE(rcl_action_server_goal_exists(&this->action_server, &goal_info_in));
+  }
+
+  // Move time so that the first ten goals are past the result timeout
+  const int64_t timeout =
+    static_cast<int64_t>(this->action_server.impl->options.result_timeout.nanoseconds);
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_set_ros_time_override(&this->clock, RCUTILS_S_TO_NS(11) + timeout - 1));
+
+  rcl_action_goal_info_t expired_goals[10u];
+  size_t num_expired = 0u;
+  rcl_ret_t ret = rcl_action_expire_goals(&this->action_server, expired_goals, 10u, &num_expired);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ASSERT_EQ(num_expired, 5u);
+  for (size_t i = 0u; i < num_expired; ++i) {
+    EXPECT_EQ(expired_goals[i].goal_id.uuid[0], 2 * i);
+    EXPECT_FALSE(rcl_action_server_goal_exists(&this->action_server, &expired_goals[i]));
+  }
+
+  // Remaining goals are still sorted by acceptance time
+  rcl_action_goal_handle_t ** goal_handle_array = nullptr;
+  size_t num_goals_out = 0u;
+  ret = rcl_action_server_get_goal_handles(
+    &this->action_server, &goal_handle_array, &num_goals_out);
+  ASSERT_EQ(ret, RCL_RET_OK);
+  ASSERT_EQ(num_goals_out, static_cast<size_t>(num_goals) - 5u);
+  int32_t previous_sec = 0;
+  for (size_t i = 0u; i < num_goals_out; ++i) {
+    rcl_action_goal_info_t goal_info_out = rcl_action_get_zero_initialized_goal_info();
+    ASSERT_EQ(RCL_RET_OK, rcl_action_goal_handle_get_info(goal_handle_array[i], &goal_info_out));
+    EXPECT_LE(previous_sec, goal_info_out.stamp.sec);
+    previous_sec = goal_info_out.stamp.sec;
+  }
+
+  for (auto & handle : handles) {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(&handle));
+  }
+}
+
 TEST_F(TestActionServer, test_action_process_cancel_request)
 {
   rcl_action_cancel_request_t cancel_request = rcl_action_get_zero_initialized_cancel_request();
@@ -16,6 +16,8 @@
 #define RCLCPP__ALLOCATOR__ALLOCATOR_COMMON_HPP_
 
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "rcl/allocator.h"
 
@@ -63,11 +65,29 @@ void * retyped_reallocate(void * untyped_pointer, size_t size, void * untyped_al
 }
 
 
+/// Whether an allocator provides the rcl allocator to use in its place.
+/**
+ * Such an allocator has a `rcl_allocator_t get_rcl_allocator() const` method, returning an rcl
+ * allocator which allocates from the same memory, counts sizes in bytes and doesn't refer to the
+ * allocator object, so that it stays valid after the allocator is destroyed.
+ */
+template<typename Alloc, typename = void>
+struct has_rcl_allocator : std::false_type {};
+
+template<typename Alloc>
+struct has_rcl_allocator<
+  Alloc,
+  typename std::enable_if<
+    std::is_same<
+      decltype(std::declval<const Alloc &>().get_rcl_allocator()), rcl_allocator_t
+    >::value>::type>: std::true_type {};
+
 // Convert a std::allocator_traits-formatted Allocator into an rcl allocator
 template<
   typename T,
   typename Alloc,
-  typename std::enable_if<!std::is_same<Alloc, std::allocator<void>>::value>::type * = nullptr>
+  typename std::enable_if<!std::is_same<Alloc, std::allocator<void>>::value &&
+  !has_rcl_allocator<Alloc>::value>::type * = nullptr>
 rcl_allocator_t get_rcl_allocator(Alloc & allocator)
 {
   rcl_allocator_t rcl_allocator = rcl_get_default_allocator();
@@ -82,6 +102,16 @@ rcl_allocator_t get_rcl_allocator(Alloc & allocator)
   return rcl_allocator;
 }
 
+// Use the rcl allocator provided by the Allocator
+template<
+  typename T,
+  typename Alloc,
+  typename std::enable_if<has_rcl_allocator<Alloc>::value>::type * = nullptr>
+rcl_allocator_t get_rcl_allocator(Alloc & allocator)
+{
+  return allocator.get_rcl_allocator();
+}
+
 // TODO(jacquelinekay) Workaround for an incomplete implementation of std::allocator<void>
 template<
   typename T,
@@ -0,0 +1,75 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__ASYNC_LOGGING_HPP_
+#define RCLCPP__ASYNC_LOGGING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// What to do with a log message when the queue of the logging thread is full.
+enum class AsyncLoggingDropPolicy
+{
+  /// Drop the message and count it, the logging call never waits.
+  DropNewest,
+  /// Wait for the background thread to make room, no message is ever lost.
+  Block
+};
+
+/// Options of the asynchronous logging mode.
+/**
+ * When enabled, log calls only format the user message into a queue owned by the calling
+ * thread, and a background thread dispatches it to the console, rosout and the external
+ * logging library.
+ * The messages of a thread keep their order, messages of different threads may be reordered.
+ */
+struct AsyncLoggingOptions
+{
+  /// Whether log calls are dispatched by a background thread.
+  bool enabled = false;
+
+  /// Number of messages each logging thread can queue.
+  size_t queue_size = 256;
+
+  /// Length after which the user part of a queued message is truncated.
+  size_t max_message_length = 1023;
+
+  /// What to do when a thread logs while its queue is full.
+  AsyncLoggingDropPolicy drop_policy = AsyncLoggingDropPolicy::DropNewest;
+};
+
+/// Get the number of log messages dropped because the asynchronous logging queues were full.
+/**
+ * \return the count since the process started, 0 if asynchronous logging was never enabled
+ */
+RCLCPP_PUBLIC
+uint64_t
+get_async_logging_dropped_count();
+
+/// Wait until all the messages logged so far by asynchronous logging have been dispatched.
+/**
+ * Returns immediately if asynchronous logging is not enabled.
+ */
+RCLCPP_PUBLIC
+void
+flush_async_logging();
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__ASYNC_LOGGING_HPP_
@@ -16,12 +16,13 @@
 #define RCLCPP__CLIENT_HPP_
 
 #include <atomic>
+#include <cstring>
 #include <future>
-#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 #include "rcl/client.h"
@@ -29,6 +30,9 @@
 #include "rcl/wait.h"
 
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/client_intra_process.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/experimental/service_intra_process.hpp"
 #include "rclcpp/function_traits.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_graph_interface.hpp"
@@ -150,9 +154,20 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Return the waitable for intra-process responses.
+  /**
+   * \return the waitable sharedpointer for intra-process, or nullptr if intra-process is not setup.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::Waitable::SharedPtr
+  get_intra_process_waitable() const;
+
 protected:
   RCLCPP_DISABLE_COPY(ClientBase)
 
+  using IntraProcessManagerWeakPtr =
+    std::weak_ptr<rclcpp::experimental::IntraProcessManager>;
+
   RCLCPP_PUBLIC
   bool
   wait_for_service_nanoseconds(std::chrono::nanoseconds timeout);
@@ -172,6 +187,10 @@ protected:
   std::shared_ptr<rcl_client_t> client_handle_;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  bool use_intra_process_;
+  IntraProcessManagerWeakPtr weak_ipm_;
+  rclcpp::Waitable::SharedPtr intra_process_waitable_;
 };
 
 template<typename ServiceT>
@@ -235,6 +254,11 @@ public:
       }
       rclcpp::exceptions::throw_from_rcl_error(ret, "could not create client");
     }
+
+    if (use_intra_process_) {
+      client_intra_process_ = std::make_shared<ClientIntraProcessT>(context_);
+      intra_process_waitable_ = client_intra_process_;
+    }
   }
 
   virtual ~Client()
@@ -295,18 +319,18 @@ public:
     std::unique_lock<std::mutex> lock(pending_requests_mutex_);
     auto typed_response = std::static_pointer_cast<typename ServiceT::Response>(response);
     int64_t sequence_number = request_header->sequence_number;
+    auto it = this->pending_requests_.find(sequence_number);
     // TODO(esteve) this should throw instead since it is not expected to happen in the first place
-    if (this->pending_requests_.count(sequence_number) == 0) {
+    if (it == this->pending_requests_.end()) {
       RCUTILS_LOG_ERROR_NAMED(
         "rclcpp",
         "Received invalid sequence number. Ignoring...");
       return;
     }
-    auto tuple = this->pending_requests_[sequence_number];
-    auto call_promise = std::get<0>(tuple);
-    auto callback = std::get<1>(tuple);
-    auto future = std::get<2>(tuple);
-    this->pending_requests_.erase(sequence_number);
+    auto call_promise = std::move(std::get<0>(it->second));
+    auto callback = std::move(std::get<1>(it->second));
+    auto future = std::move(std::get<2>(it->second));
+    this->pending_requests_.erase(it);
     // Unlock here to allow the service to be called recursively from one of its callbacks.
     lock.unlock();
 
@@ -332,6 +356,22 @@ public:
   SharedFuture
   async_send_request(SharedRequest request, CallbackT && cb)
   {
+    auto service_intra_process = get_service_intra_process();
+    if (service_intra_process) {
+      // The service is in this process, give it the request directly.
+      SharedPromise call_promise = std::make_shared<Promise>();
+      SharedFuture f(call_promise->get_future());
+      auto request_header = std::make_shared<rmw_request_id_t>();
+      memset(request_header->writer_guid, 0, sizeof(request_header->writer_guid));
+      const void * client_id = client_intra_process_.get();
+      memcpy(request_header->writer_guid, &client_id, sizeof(client_id));
+      request_header->sequence_number = ++intra_process_sequence_number_;
+      service_intra_process->store_intra_process_request(
+        std::move(request_header), std::move(request), client_intra_process_,
+        std::make_tuple(call_promise, CallbackType(std::forward<CallbackT>(cb)), f));
+      return f;
+    }
+
     std::lock_guard<std::mutex> lock(pending_requests_mutex_);
     int64_t sequence_number;
     rcl_ret_t ret = rcl_send_request(get_client_handle().get(), request.get(), &sequence_number);
@@ -375,8 +415,32 @@ public:
 private:
   RCLCPP_DISABLE_COPY(Client)
 
-  std::map<int64_t, std::tuple<SharedPromise, CallbackType, SharedFuture>> pending_requests_;
+  using ClientIntraProcessT = rclcpp::experimental::ClientIntraProcess<ServiceT>;
+  using ServiceIntraProcessT = rclcpp::experimental::ServiceIntraProcess<ServiceT>;
+
+  /// Return the service in this process the requests are given to, if any.
+  typename ServiceIntraProcessT::SharedPtr
+  get_service_intra_process()
+  {
+    if (!client_intra_process_) {
+      return nullptr;
+    }
+    auto ipm = weak_ipm_.lock();
+    if (!ipm) {
+      return nullptr;
+    }
+    auto service = ipm->find_service_intra_process(
+      get_service_name(), rosidl_typesupport_cpp::get_service_type_support_handle<ServiceT>());
+    // The type support handle identifies the service type
+    return std::static_pointer_cast<ServiceIntraProcessT>(service);
+  }
+
+  std::unordered_map<int64_t, std::tuple<SharedPromise, CallbackType, SharedFuture>>
+  pending_requests_;
   std::mutex pending_requests_mutex_;
+
+  typename ClientIntraProcessT::SharedPtr client_intra_process_;
+  std::atomic<int64_t> intra_process_sequence_number_{0};
 };
 
 }  // namespace rclcpp
@@ -48,6 +48,9 @@ create_service(
   auto serv = Service<ServiceT>::make_shared(
     node_base->get_shared_rcl_node_handle(),
     service_name, any_service_callback, service_options);
+  if (node_base->get_use_intra_process_default()) {
+    serv->enable_intra_process(node_base->get_context());
+  }
   auto serv_base_ptr = std::dynamic_pointer_cast<ServiceBase>(serv);
   node_services->add_service(serv_base_ptr, group);
   return serv;
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "rclcpp/detail/resolve_enable_topic_statistics.hpp"
+#include "rclcpp/detail/resolve_message_memory_strategy.hpp"
 
 #include "rclcpp/node_interfaces/get_node_timers_interface.hpp"
 #include "rclcpp/node_interfaces/get_node_topics_interface.hpp"
@@ -59,7 +60,8 @@ namespace rclcpp
  * \param qos
  * \param callback
  * \param options
- * \param msg_mem_strat
+ * \param msg_mem_strat message memory strategy, nullptr to use the default one or the
+ *   recycling one if options.message_pool_size is not zero
  * \return the created subscription
  * \throws std::invalid_argument if topic statistics is enabled and the publish period is
  * less than or equal to zero.
@@ -85,9 +87,7 @@ create_subscription(
   const rclcpp::SubscriptionOptionsWithAllocator<AllocatorT> & options = (
     rclcpp::SubscriptionOptionsWithAllocator<AllocatorT>()
   ),
-  typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = (
-    MessageMemoryStrategyT::create_default()
-  )
+  typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = nullptr
 )
 {
   using rclcpp::node_interfaces::get_node_topics_interface;
@@ -115,7 +115,9 @@ create_subscription(
 
     subscription_topic_stats = std::make_shared<
       rclcpp::topic_statistics::SubscriptionTopicStatistics<CallbackMessageT>
-      >(node_topics->get_node_base_interface()->get_name(), publisher);
+      >(
+      node_topics->get_node_base_interface()->get_name(), publisher,
+      options.topic_stats_options.mode);
 
     std::weak_ptr<
       rclcpp::topic_statistics::SubscriptionTopicStatistics<CallbackMessageT>
@@ -144,7 +146,8 @@ create_subscription(
   auto factory = rclcpp::create_subscription_factory<MessageT>(
     std::forward<CallbackT>(callback),
     options,
-    msg_mem_strat,
+    rclcpp::detail::resolve_message_memory_strategy<MessageMemoryStrategyT, CallbackMessageT>(
+      msg_mem_strat, options),
     subscription_topic_stats
   );
 
@@ -0,0 +1,136 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
+#define RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rcutils/logging.h"
+
+#include "rclcpp/async_logging.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Queue log messages per thread and hand them to an output handler from a thread.
+/**
+ * The user message is formatted in the logging thread, since its arguments don't outlive the
+ * call, into a preallocated slot of a single producer, single consumer ring owned by that thread.
+ * Logging never allocates after the first message of a thread, and only takes a lock then.
+ * A background thread drains the rings and calls the output handler with the "%s" format.
+ */
+class AsyncLogDispatcher
+{
+public:
+  /// Constructor, starting the background thread.
+  /**
+   * \param[in] options sizes of the queues and drop policy, `enabled` is ignored
+   * \param[in] output_handler output handler the messages are dispatched to
+   */
+  RCLCPP_PUBLIC
+  AsyncLogDispatcher(
+    const AsyncLoggingOptions & options,
+    rcutils_logging_output_handler_t output_handler);
+
+  /// Destructor, dispatching the queued messages and stopping the background thread.
+  RCLCPP_PUBLIC
+  ~AsyncLogDispatcher();
+
+  /// Queue a message, with the arguments of a rcutils output handler.
+  /**
+   * Messages logged from the background thread itself, or after stop(), are dispatched
+   * synchronously.
+   */
+  RCLCPP_PUBLIC
+  void
+  log(
+    const rcutils_log_location_t * location,
+    int severity, const char * name, rcutils_time_point_value_t timestamp,
+    const char * format, va_list * args);
+
+  /// Wait until all messages queued before this call have been dispatched.
+  RCLCPP_PUBLIC
+  void
+  flush();
+
+  /// Dispatch the queued messages and stop the background thread.
+  RCLCPP_PUBLIC
+  void
+  stop();
+
+  /// Get the number of messages dropped because a queue was full.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_dropped_count() const;
+
+private:
+  struct Record;
+  struct ThreadQueue;
+
+  std::shared_ptr<ThreadQueue>
+  get_thread_queue();
+
+  void
+  run();
+
+  bool
+  drain();
+
+  bool
+  has_pending();
+
+  void
+  dispatch(
+    const rcutils_log_location_t * location, int severity, const char * name,
+    rcutils_time_point_value_t timestamp, const char * format, ...);
+
+  const AsyncLoggingOptions options_;
+  const rcutils_logging_output_handler_t output_handler_;
+  // Unique across dispatchers, to tell apart the queue cached by a thread for another one
+  const uint64_t id_;
+
+  std::mutex queues_mutex_;
+  std::vector<std::shared_ptr<ThreadQueue>> queues_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::condition_variable flushed_cv_;
+  std::atomic<bool> sleeping_{false};
+  std::atomic<bool> stopped_{false};
+  uint64_t flush_requested_{0};
+  uint64_t flush_done_{0};
+
+  std::atomic<uint64_t> dropped_{0};
+  uint64_t dropped_reported_{0};
+
+  std::thread thread_;
+  // Kept apart from thread_, which stop() modifies while other threads may log
+  std::thread::id thread_id_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
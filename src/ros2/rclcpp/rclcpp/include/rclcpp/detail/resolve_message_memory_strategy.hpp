@@ -0,0 +1,70 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__RESOLVE_MESSAGE_MEMORY_STRATEGY_HPP_
+#define RCLCPP__DETAIL__RESOLVE_MESSAGE_MEMORY_STRATEGY_HPP_
+
+#include <memory>
+#include <type_traits>
+
+#include "rclcpp/strategies/recycling_message_memory_strategy.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+template<typename MessageMemoryStrategyT, typename CallbackMessageT, typename OptionsT>
+typename MessageMemoryStrategyT::SharedPtr
+create_message_memory_strategy(const OptionsT & options, std::true_type /* can_recycle */)
+{
+  if (options.message_pool_size == 0) {
+    return MessageMemoryStrategyT::create_default();
+  }
+  using AllocatorT = typename std::decay<decltype(*options.get_allocator())>::type;
+  return std::make_shared<
+    rclcpp::strategies::recycling_message_memory_strategy::RecyclingMessageMemoryStrategy<
+      CallbackMessageT, AllocatorT>
+  >(options.message_pool_size, options.get_allocator());
+}
+
+template<typename MessageMemoryStrategyT, typename CallbackMessageT, typename OptionsT>
+typename MessageMemoryStrategyT::SharedPtr
+create_message_memory_strategy(const OptionsT &, std::false_type /* can_recycle */)
+{
+  return MessageMemoryStrategyT::create_default();
+}
+
+/// Return the message memory strategy to use, resolving it from the options if none is given.
+template<typename MessageMemoryStrategyT, typename CallbackMessageT, typename OptionsT>
+typename MessageMemoryStrategyT::SharedPtr
+resolve_message_memory_strategy(
+  typename MessageMemoryStrategyT::SharedPtr msg_mem_strat,
+  const OptionsT & options)
+{
+  if (msg_mem_strat) {
+    return msg_mem_strat;
+  }
+  using AllocatorT = typename std::decay<decltype(*options.get_allocator())>::type;
+  using RecyclingT =
+    rclcpp::strategies::recycling_message_memory_strategy::RecyclingMessageMemoryStrategy<
+    CallbackMessageT, AllocatorT>;
+  return create_message_memory_strategy<MessageMemoryStrategyT, CallbackMessageT>(
+    options, std::is_convertible<RecyclingT *, MessageMemoryStrategyT *>());
+}
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__RESOLVE_MESSAGE_MEMORY_STRATEGY_HPP_
@@ -0,0 +1,103 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__CLIENT_INTRA_PROCESS_HPP_
+#define RCLCPP__EXPERIMENTAL__CLIENT_INTRA_PROCESS_HPP_
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/experimental/client_intra_process_base.hpp"
+#include "rclcpp/macros.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Queues the responses of intra-process services until the executor of the client runs them.
+template<typename ServiceT>
+class ClientIntraProcess : public ClientIntraProcessBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ClientIntraProcess)
+
+  using SharedResponse = typename ServiceT::Response::SharedPtr;
+  using Promise = std::promise<SharedResponse>;
+  using SharedPromise = std::shared_ptr<Promise>;
+  using SharedFuture = std::shared_future<SharedResponse>;
+  using CallbackType = std::function<void (SharedFuture)>;
+  /// What completes a request: the promise of its response, the user callback and its future.
+  using CallbackInfo = std::tuple<SharedPromise, CallbackType, SharedFuture>;
+
+  explicit ClientIntraProcess(rclcpp::Context::SharedPtr context)
+  : ClientIntraProcessBase(context)
+  {}
+
+  /// Queue the response to a request, called by the intra-process service.
+  void
+  store_intra_process_response(SharedResponse response, CallbackInfo callback_info)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      responses_.emplace_back(std::move(response), std::move(callback_info));
+    }
+    trigger_guard_condition();
+  }
+
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override
+  {
+    (void)wait_set;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !responses_.empty();
+  }
+
+  void
+  execute() override
+  {
+    std::pair<SharedResponse, CallbackInfo> response;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (responses_.empty()) {
+        return;
+      }
+      response = std::move(responses_.front());
+      responses_.pop_front();
+      if (!responses_.empty()) {
+        // Wake the executor again for the next one, the guard condition was only triggered once
+        trigger_guard_condition();
+      }
+    }
+    std::get<0>(response.second)->set_value(std::move(response.first));
+    std::get<1>(response.second)(std::get<2>(response.second));
+  }
+
+private:
+  RCLCPP_DISABLE_COPY(ClientIntraProcess)
+
+  std::mutex mutex_;
+  std::deque<std::pair<SharedResponse, CallbackInfo>> responses_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__CLIENT_INTRA_PROCESS_HPP_
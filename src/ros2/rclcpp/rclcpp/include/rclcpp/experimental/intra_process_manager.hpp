@@ -30,7 +30,10 @@
 #include <utility>
 #include <vector>
 
+#include "rosidl_runtime_c/service_type_support_struct.h"
+
 #include "rclcpp/allocator/allocator_deleter.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
 #include "rclcpp/experimental/subscription_intra_process.hpp"
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 #include "rclcpp/logger.hpp"
@@ -39,6 +42,8 @@
 #include "rclcpp/publisher_base.hpp"
 #include "rclcpp/visibility_control.hpp"
 
+#include "tracetools/tracetools.h"
+
 namespace rclcpp
 {
 
@@ -86,6 +91,12 @@ namespace experimental
  * This information allows this class to operate efficiently by performing the
  * fewest number of copies of the message required.
  *
+ * Services are registered with this class in the same way, through a helper
+ * class called ServiceIntraProcess.
+ * A client which uses intra process communication looks up a registered
+ * service with the same name and type when it sends a request, and gives the
+ * request to it directly instead of sending it through the middleware.
+ *
  * This class is neither CopyConstructable nor CopyAssignable.
  */
 class IntraProcessManager
@@ -186,6 +197,9 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
+    TRACEPOINT(
+      rclcpp_intra_publish_start, intra_process_publisher_id,
+      static_cast<const void *>(message.get()));
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
 
     auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
@@ -194,6 +208,7 @@ public:
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
         "Calling do_intra_process_publish for invalid or no longer existing publisher id");
+      TRACEPOINT(rclcpp_intra_publish_end, intra_process_publisher_id);
       return;
     }
     const auto & sub_ids = publisher_it->second;
@@ -233,6 +248,7 @@ public:
       this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
         std::move(message), sub_ids.take_ownership_subscriptions, allocator);
     }
+    TRACEPOINT(rclcpp_intra_publish_end, intra_process_publisher_id);
   }
 
   template<
@@ -248,6 +264,9 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
+    TRACEPOINT(
+      rclcpp_intra_publish_start, intra_process_publisher_id,
+      static_cast<const void *>(message.get()));
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
 
     auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
@@ -256,6 +275,7 @@ public:
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
         "Calling do_intra_process_publish for invalid or no longer existing publisher id");
+      TRACEPOINT(rclcpp_intra_publish_end, intra_process_publisher_id);
       return nullptr;
     }
     const auto & sub_ids = publisher_it->second;
@@ -267,6 +287,7 @@ public:
         this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
           shared_msg, sub_ids.take_shared_subscriptions);
       }
+      TRACEPOINT(rclcpp_intra_publish_end, intra_process_publisher_id);
       return shared_msg;
     } else {
       // Construct a new shared pointer from the message for the buffers that
@@ -285,6 +306,7 @@ public:
           allocator);
       }
 
+      TRACEPOINT(rclcpp_intra_publish_end, intra_process_publisher_id);
       return shared_msg;
     }
   }
@@ -303,6 +325,36 @@ public:
   rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr
   get_subscription_intra_process(uint64_t intra_process_subscription_id);
 
+  /// Register a service with the manager, returns the service unique id.
+  /**
+   * \param service the ServiceIntraProcess to register.
+   * \return an unsigned 64-bit integer which is the service's unique id.
+   */
+  RCLCPP_PUBLIC
+  uint64_t
+  add_service(rclcpp::experimental::ServiceIntraProcessBase::SharedPtr service);
+
+  /// Unregister a service using the service's unique id.
+  RCLCPP_PUBLIC
+  void
+  remove_service(uint64_t intra_process_service_id);
+
+  RCLCPP_PUBLIC
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr
+  get_service_intra_process(uint64_t intra_process_service_id);
+
+  /// Find a service with the given name and type, for a client to send its requests to.
+  /**
+   * \param service_name the fully qualified name of the service.
+   * \param type_support_handle the type support handle of the service type.
+   * \return the first matching service, or nullptr if there is none.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr
+  find_service_intra_process(
+    const char * service_name,
+    const rosidl_service_type_support_t * type_support_handle) const;
+
 private:
   struct SubscriptionInfo
   {
@@ -335,6 +387,9 @@ private:
   using PublisherMap =
     std::unordered_map<uint64_t, PublisherInfo>;
 
+  using ServiceMap =
+    std::unordered_map<uint64_t, rclcpp::experimental::ServiceIntraProcessBase::SharedPtr>;
+
   using PublisherToSubscriptionIdsMap =
     std::unordered_map<uint64_t, SplittedSubscriptions>;
 
@@ -431,6 +486,7 @@ private:
   PublisherToSubscriptionIdsMap pub_to_subs_;
   SubscriptionMap subscriptions_;
   PublisherMap publishers_;
+  ServiceMap services_;
 
   mutable std::shared_timed_mutex mutex_;
 };
@@ -0,0 +1,136 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
+#define RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rmw/types.h"
+
+#include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/context.hpp"
+#include "rclcpp/experimental/client_intra_process.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/type_support_decl.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Queues the requests of intra-process clients until the executor of the service runs them.
+/**
+ * Requests and responses are passed by pointer: the service callback receives the request
+ * object the client sent, and the client receives the response object the callback filled.
+ */
+template<typename ServiceT>
+class ServiceIntraProcess : public ServiceIntraProcessBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ServiceIntraProcess)
+
+  using SharedRequest = typename ServiceT::Request::SharedPtr;
+  using ClientIntraProcessT = ClientIntraProcess<ServiceT>;
+
+  ServiceIntraProcess(
+    AnyServiceCallback<ServiceT> callback,
+    rclcpp::Context::SharedPtr context,
+    const std::string & service_name)
+  : ServiceIntraProcessBase(
+      context, service_name,
+      rosidl_typesupport_cpp::get_service_type_support_handle<ServiceT>()),
+    any_callback_(callback)
+  {}
+
+  /// Queue a request, called by the intra-process client.
+  /**
+   * \param[in] request_header header given to the service callback
+   * \param[in] request the request, which mustn't be modified until the response is received
+   * \param[in] client the client the response is given to, if it still exists then
+   * \param[in] callback_info what completes the request on the client side
+   */
+  void
+  store_intra_process_request(
+    std::shared_ptr<rmw_request_id_t> request_header,
+    SharedRequest request,
+    typename ClientIntraProcessT::WeakPtr client,
+    typename ClientIntraProcessT::CallbackInfo callback_info)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_.push_back(
+        {std::move(request_header), std::move(request), std::move(client),
+          std::move(callback_info)});
+    }
+    trigger_guard_condition();
+  }
+
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override
+  {
+    (void)wait_set;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !requests_.empty();
+  }
+
+  void
+  execute() override
+  {
+    PendingRequest request;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (requests_.empty()) {
+        return;
+      }
+      request = std::move(requests_.front());
+      requests_.pop_front();
+      if (!requests_.empty()) {
+        // Wake the executor again for the next one, the guard condition was only triggered once
+        trigger_guard_condition();
+      }
+    }
+    auto response = std::make_shared<typename ServiceT::Response>();
+    any_callback_.dispatch(request.header, request.request, response);
+    auto client = request.client.lock();
+    if (client) {
+      client->store_intra_process_response(std::move(response), std::move(request.callback_info));
+    }
+  }
+
+private:
+  RCLCPP_DISABLE_COPY(ServiceIntraProcess)
+
+  struct PendingRequest
+  {
+    std::shared_ptr<rmw_request_id_t> header;
+    SharedRequest request;
+    typename ClientIntraProcessT::WeakPtr client;
+    typename ClientIntraProcessT::CallbackInfo callback_info;
+  };
+
+  AnyServiceCallback<ServiceT> any_callback_;
+  std::mutex mutex_;
+  std::deque<PendingRequest> requests_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
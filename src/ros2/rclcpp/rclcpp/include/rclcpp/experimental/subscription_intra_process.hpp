@@ -134,6 +134,16 @@ public:
     return buffer_->use_take_shared_method();
   }
 
+  /// Set a function called with every message before it is dispatched to the callback.
+  /**
+   * This is used to collect topic statistics on intra-process messages.
+   */
+  void
+  set_message_received_callback(std::function<void(const MessageT &)> callback)
+  {
+    message_received_callback_ = std::move(callback);
+  }
+
 private:
   void
   trigger_guard_condition()
@@ -159,15 +169,22 @@ private:
 
     if (any_callback_.use_take_shared_method()) {
       ConstMessageSharedPtr msg = buffer_->consume_shared();
+      if (message_received_callback_ && msg) {
+        message_received_callback_(*msg);
+      }
       any_callback_.dispatch_intra_process(msg, msg_info);
     } else {
       MessageUniquePtr msg = buffer_->consume_unique();
+      if (message_received_callback_ && msg) {
+        message_received_callback_(*msg);
+      }
       any_callback_.dispatch_intra_process(std::move(msg), msg_info);
     }
   }
 
   AnySubscriptionCallback<CallbackMessageT, Alloc> any_callback_;
   BufferUniquePtr buffer_;
+  std::function<void(const MessageT &)> message_received_callback_;
 };
 
 }  // namespace experimental
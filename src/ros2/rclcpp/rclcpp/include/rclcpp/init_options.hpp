@@ -18,6 +18,7 @@
 #include <memory>
 
 #include "rcl/init_options.h"
+#include "rclcpp/async_logging.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
@@ -62,6 +63,21 @@ public:
   InitOptions &
   auto_initialize_logging(bool initialize_logging);
 
+  /// Return the options of asynchronous logging, used if logging is initialized.
+  RCLCPP_PUBLIC
+  const AsyncLoggingOptions &
+  async_logging_options() const;
+
+  /// Set the options of asynchronous logging, used if logging is initialized.
+  /**
+   * \param[in] async_logging_options options, with `enabled` set to dispatch log messages
+   *   from a background thread
+   * \throws std::invalid_argument if the queue size is zero
+   */
+  RCLCPP_PUBLIC
+  InitOptions &
+  async_logging_options(const AsyncLoggingOptions & async_logging_options);
+
   /// Assignment operator.
   RCLCPP_PUBLIC
   InitOptions &
@@ -87,6 +103,7 @@ protected:
 private:
   std::unique_ptr<rcl_init_options_t> init_options_;
   bool initialize_logging_{true};
+  AsyncLoggingOptions async_logging_options_;
 };
 
 }  // namespace rclcpp
@@ -194,7 +194,8 @@ public:
    * \param[in] qos QoS profile for Subcription.
    * \param[in] callback The user-defined callback function to receive a message
    * \param[in] options Additional options for the creation of the Subscription.
-   * \param[in] msg_mem_strat The message memory strategy to use for allocating messages.
+   * \param[in] msg_mem_strat The message memory strategy to use for allocating messages,
+   *   nullptr to pick it from the options.
    * \return Shared pointer to the created subscription.
    */
   template<
@@ -216,9 +217,7 @@ public:
     CallbackT && callback,
     const SubscriptionOptionsWithAllocator<AllocatorT> & options =
     SubscriptionOptionsWithAllocator<AllocatorT>(),
-    typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = (
-      MessageMemoryStrategyT::create_default()
-    )
+    typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = nullptr
   );
 
   /// Create a timer.
@@ -26,7 +26,10 @@
 #include "rcl/service.h"
 
 #include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/context.hpp"
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/experimental/service_intra_process.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/expand_topic_or_service_name.hpp"
@@ -121,9 +124,28 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Return the waitable for intra-process requests.
+  /**
+   * \return the waitable sharedpointer for intra-process, or nullptr if intra-process is not setup.
+   * \throws std::runtime_error if the intra process manager is destroyed
+   */
+  RCLCPP_PUBLIC
+  rclcpp::Waitable::SharedPtr
+  get_intra_process_waitable() const;
+
 protected:
   RCLCPP_DISABLE_COPY(ServiceBase)
 
+  using IntraProcessManagerWeakPtr =
+    std::weak_ptr<rclcpp::experimental::IntraProcessManager>;
+
+  /// Implemenation detail.
+  RCLCPP_PUBLIC
+  void
+  setup_intra_process(
+    uint64_t intra_process_service_id,
+    IntraProcessManagerWeakPtr weak_ipm);
+
   RCLCPP_PUBLIC
   rcl_node_t *
   get_rcl_node_handle();
@@ -138,6 +160,10 @@ protected:
   bool owns_rcl_handle_ = true;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  bool use_intra_process_ = false;
+  IntraProcessManagerWeakPtr weak_ipm_;
+  uint64_t intra_process_service_id_ = 0;
 };
 
 template<typename ServiceT>
@@ -340,6 +366,27 @@ public:
     send_response(*request_header, *response);
   }
 
+  /// Receive the requests of intra-process clients as well.
+  /**
+   * Clients of nodes using intra-process communications in the same context then pass their
+   * requests to this service by pointer instead of through the middleware.
+   * This is called by rclcpp::create_service(), before the service is added to a callback group.
+   *
+   * \param[in] context the context of the node of the service
+   */
+  void
+  enable_intra_process(rclcpp::Context::SharedPtr context)
+  {
+    using rclcpp::experimental::IntraProcessManager;
+    using ServiceIntraProcessT = rclcpp::experimental::ServiceIntraProcess<ServiceT>;
+
+    auto service_intra_process = std::make_shared<ServiceIntraProcessT>(
+      any_callback_, context, get_service_name());
+    auto ipm = context->get_sub_context<IntraProcessManager>();
+    uint64_t intra_process_service_id = ipm->add_service(service_intra_process);
+    this->setup_intra_process(intra_process_service_id, ipm);
+  }
+
   [[deprecated("use the send_response() which takes references instead of shared pointers")]]
   void
   send_response(
@@ -0,0 +1,115 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__STRATEGIES__RECYCLING_MESSAGE_MEMORY_STRATEGY_HPP_
+#define RCLCPP__STRATEGIES__RECYCLING_MESSAGE_MEMORY_STRATEGY_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/message_memory_strategy.hpp"
+
+namespace rclcpp
+{
+namespace strategies
+{
+namespace recycling_message_memory_strategy
+{
+
+/// Memory strategy reusing the messages received by a subscription.
+/**
+ * Messages given back to the strategy are kept in a pool of bounded size and handed out again
+ * by the next borrow_message() calls, instead of being freed and allocated for every take.
+ * Messages are not cleared before being reused: taking a message overwrites all of its fields,
+ * so that the strings and sequences of a recycled message keep their capacity and a message of
+ * the same size as a previous one is taken without any allocation.
+ *
+ * A message is only recycled if nothing else owns it anymore when it is returned, i.e. if the
+ * subscription callback did not keep the shared pointer it was given.
+ * Messages kept by callbacks are simply released and freed by their last owner.
+ *
+ * Messages can be borrowed and returned from several threads at the same time.
+ */
+template<typename MessageT, typename Alloc = std::allocator<void>>
+class RecyclingMessageMemoryStrategy
+  : public message_memory_strategy::MessageMemoryStrategy<MessageT, Alloc>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(RecyclingMessageMemoryStrategy)
+
+  /// Constructor
+  /**
+   * \param[in] pool_size maximum number of messages kept for reuse
+   * \param[in] allocator allocator used to create new messages
+   */
+  RecyclingMessageMemoryStrategy(size_t pool_size, std::shared_ptr<Alloc> allocator)
+  : message_memory_strategy::MessageMemoryStrategy<MessageT, Alloc>(allocator),
+    pool_size_(pool_size)
+  {
+    pool_.reserve(pool_size_);
+  }
+
+  explicit RecyclingMessageMemoryStrategy(size_t pool_size)
+  : RecyclingMessageMemoryStrategy(pool_size, std::make_shared<Alloc>())
+  {}
+
+  /// Borrow a message from the pool, or allocate a new one if the pool is empty.
+  /** \return Shared pointer to the message. */
+  std::shared_ptr<MessageT> borrow_message() override
+  {
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex_);
+      if (!pool_.empty()) {
+        std::shared_ptr<MessageT> msg = std::move(pool_.back());
+        pool_.pop_back();
+        return msg;
+      }
+    }
+    return message_memory_strategy::MessageMemoryStrategy<MessageT, Alloc>::borrow_message();
+  }
+
+  /// Put a message back into the pool if it has no other owner and the pool is not full.
+  /** \param[in] msg Shared pointer to the message we are returning, reset in any case. */
+  void return_message(std::shared_ptr<MessageT> & msg) override
+  {
+    if (msg && msg.use_count() == 1) {
+      std::lock_guard<std::mutex> lock(pool_mutex_);
+      if (pool_.size() < pool_size_) {
+        pool_.push_back(std::move(msg));
+        return;
+      }
+    }
+    msg.reset();
+  }
+
+  /// Get the number of messages currently waiting in the pool.
+  size_t pooled_message_count() const
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return pool_.size();
+  }
+
+private:
+  const size_t pool_size_;
+  mutable std::mutex pool_mutex_;
+  std::vector<std::shared_ptr<MessageT>> pool_;
+};
+
+}  // namespace recycling_message_memory_strategy
+}  // namespace strategies
+}  // namespace rclcpp
+
+#endif  // RCLCPP__STRATEGIES__RECYCLING_MESSAGE_MEMORY_STRATEGY_HPP_
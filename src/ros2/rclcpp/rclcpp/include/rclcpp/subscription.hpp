@@ -146,7 +146,16 @@ public:
     }
 
     // Setup intra process publishing if requested.
-    if (rclcpp::detail::resolve_use_intra_process(options, *node_base)) {
+    bool use_intra_process = rclcpp::detail::resolve_use_intra_process(options, *node_base);
+    if (use_intra_process && !options.content_filter_expression.empty()) {
+      // Messages published intra-process don't go through the filter of the middleware
+      if (options.use_intra_process_comm == IntraProcessSetting::Enable) {
+        throw std::invalid_argument(
+                "intraprocess communication is not allowed with a content filter");
+      }
+      use_intra_process = false;
+    }
+    if (use_intra_process) {
       using rclcpp::detail::resolve_intra_process_buffer_type;
 
       // Check if the QoS is compatible with intra-process.
@@ -177,6 +186,18 @@ public:
         this->get_topic_name(),  // important to get like this, as it has the fully-qualified name
         qos_profile,
         resolve_intra_process_buffer_type(options.intra_process_buffer_type, callback));
+      if (subscription_topic_statistics != nullptr) {
+        // Intra-process messages don't go through handle_message(), collect their statistics
+        // when the intra-process subscription executes them.
+        auto topic_statistics = subscription_topic_statistics;
+        subscription_intra_process->set_message_received_callback(
+          [topic_statistics](const CallbackMessageT & message) {
+            const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now());
+            const auto time = rclcpp::Time(nanos.time_since_epoch().count());
+            topic_statistics->handle_message(message, time);
+          });
+      }
       TRACEPOINT(
         rclcpp_subscription_init,
         (const void *)get_subscription_handle().get(),
@@ -57,6 +57,22 @@ struct SubscriptionOptionsBase
   std::shared_ptr<rclcpp::detail::RMWImplementationSpecificSubscriptionPayload>
   rmw_implementation_payload = nullptr;
 
+  /// Number of received messages kept for reuse instead of being freed, 0 to disable.
+  /**
+   * Only used when no message memory strategy is given explicitly when creating the
+   * subscription, see rclcpp::strategies::recycling_message_memory_strategy.
+   */
+  size_t message_pool_size = 0;
+
+  /// Expression selecting the messages delivered to the subscription, empty to receive all.
+  /**
+   * The middleware evaluates it before sending the messages, see
+   * rmw_subscription_options_t::content_filter_expression for its syntax.
+   * Intra-process communication bypasses the middleware, so it isn't used by content filtered
+   * subscriptions unless it is explicitly enabled, which is an error.
+   */
+  std::string content_filter_expression;
+
   // Options to configure topic statistics collector in the subscription.
   struct TopicStatisticsOptions
   {
@@ -69,6 +85,9 @@ struct SubscriptionOptionsBase
     // Topic statistics publication period in ms. Defaults to one second.
     // Only values greater than zero are allowed.
     std::chrono::milliseconds publish_period{std::chrono::seconds(1)};
+
+    // How topic statistics are collected. Defaults to moving averages.
+    TopicStatisticsMode mode = TopicStatisticsMode::MovingAverage;
   };
 
   TopicStatisticsOptions topic_stats_options;
@@ -105,6 +124,11 @@ struct SubscriptionOptionsWithAllocator : public SubscriptionOptionsBase
     result.allocator = allocator::get_rcl_allocator<MessageT>(*message_alloc);
     result.qos = qos.get_rmw_qos_profile();
     result.rmw_subscription_options.ignore_local_publications = this->ignore_local_publications;
+    // Only valid as long as this object, which outlives the creation of the subscription
+    if (!this->content_filter_expression.empty()) {
+      result.rmw_subscription_options.content_filter_expression =
+        this->content_filter_expression.c_str();
+    }
 
     // Apply payload to rcl_subscription_options if necessary.
     if (rmw_implementation_payload && rmw_implementation_payload->has_been_customized()) {
@@ -0,0 +1,220 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TOPIC_STATISTICS__LATENCY_HISTOGRAM_HPP_
+#define RCLCPP__TOPIC_STATISTICS__LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace rclcpp
+{
+namespace topic_statistics
+{
+
+/// Lock-free histogram of durations in nanoseconds, with log-linear buckets.
+/**
+ * Like HDR histograms, every power of two is split into 2^kSubBucketBits buckets of equal width,
+ * so that the relative error of any value read back from the histogram is bounded by
+ * 2^-kSubBucketBits (1.6%) from zero up to 2^kMaxValueBits nanoseconds (about 18 minutes).
+ * Larger values are counted in the last bucket, their exact maximum is still kept.
+ *
+ * Values can be recorded from any number of threads concurrently, with a few relaxed atomic
+ * operations and no allocation, so that the histogram is cheap enough to leave enabled.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr uint32_t kSubBucketBits = 6;
+  static constexpr uint32_t kMaxValueBits = 40;
+  static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) << kSubBucketBits;
+
+  /// Content of a histogram at some point in time.
+  struct Snapshot
+  {
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+
+    /// Get the mean of the recorded values, or NaN if there are none.
+    double mean() const
+    {
+      if (count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return static_cast<double>(sum) / static_cast<double>(count);
+    }
+
+    /// Get the standard deviation of the recorded values, or NaN if there are none.
+    /**
+     * Values are taken at the middle of their bucket.
+     */
+    double stddev() const
+    {
+      if (count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      const double average = mean();
+      double sum_of_squares = 0.0;
+      for (size_t i = 0; i < buckets.size(); ++i) {
+        if (buckets[i] == 0) {
+          continue;
+        }
+        const double upper = i + 1 < buckets.size() ?
+          static_cast<double>(bucket_upper_bound(i)) : static_cast<double>(max);
+        const double middle = 0.5 * (static_cast<double>(bucket_lower_bound(i)) + upper);
+        sum_of_squares += static_cast<double>(buckets[i]) * (middle - average) * (middle - average);
+      }
+      return std::sqrt(sum_of_squares / static_cast<double>(count));
+    }
+
+    /// Get the value below or at which a percentage of the recorded values are.
+    /**
+     * The highest value of the bucket the percentile falls in is returned, clamped to the
+     * recorded minimum and maximum.
+     *
+     * \param[in] percentile percentage in [0, 100]
+     * \return the percentile, or NaN if there are no values
+     */
+    double percentile(double percentile) const
+    {
+      if (count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      uint64_t rank =
+        static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+      if (rank == 0) {
+        rank = 1;
+      }
+      uint64_t cumulated = 0;
+      for (size_t i = 0; i < buckets.size(); ++i) {
+        cumulated += buckets[i];
+        if (cumulated >= rank) {
+          uint64_t value = bucket_upper_bound(i);
+          value = value < min ? min : value;
+          value = value > max ? max : value;
+          return static_cast<double>(value);
+        }
+      }
+      return static_cast<double>(max);
+    }
+  };
+
+  LatencyHistogram()
+  {
+    for (auto & bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Record a value.
+  void record(uint64_t value)
+  {
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t min = min_.load(std::memory_order_relaxed);
+    while (value < min &&
+      !min_.compare_exchange_weak(min, value, std::memory_order_relaxed))
+    {
+    }
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+      !max_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /// Get the content of the histogram and empty it.
+  /**
+   * Values recorded concurrently end up either in the returned snapshot or in the next one.
+   */
+  Snapshot collect_and_reset()
+  {
+    Snapshot snapshot;
+    snapshot.buckets.resize(buckets_.size());
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+      snapshot.buckets[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+      snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = sum_.exchange(0, std::memory_order_relaxed);
+    snapshot.min = min_.exchange(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    snapshot.max = max_.exchange(0, std::memory_order_relaxed);
+    if (snapshot.count == 0) {
+      snapshot.min = 0;
+    }
+    return snapshot;
+  }
+
+  /// Get the index of the bucket a value is counted in.
+  static size_t bucket_index(uint64_t value)
+  {
+    const uint64_t sub_bucket_count = uint64_t(1) << kSubBucketBits;
+    if (value < sub_bucket_count) {
+      return static_cast<size_t>(value);
+    }
+    if (value >> kMaxValueBits) {
+      return kBucketCount - 1;
+    }
+    // Position of the highest bit set, found by binary search
+    uint32_t magnitude = 0;
+    for (uint32_t step = 32; step > 0; step >>= 1) {
+      if (value >> (magnitude + step)) {
+        magnitude += step;
+      }
+    }
+    const uint32_t shift = magnitude - kSubBucketBits;
+    return static_cast<size_t>(
+      (uint64_t(shift + 1) << kSubBucketBits) + ((value >> shift) & (sub_bucket_count - 1)));
+  }
+
+  /// Get the lowest value counted in a bucket.
+  static uint64_t bucket_lower_bound(size_t index)
+  {
+    const uint64_t sub_bucket_count = uint64_t(1) << kSubBucketBits;
+    if (index < sub_bucket_count) {
+      return index;
+    }
+    const uint64_t group = index >> kSubBucketBits;
+    const uint64_t sub_bucket = index & (sub_bucket_count - 1);
+    return (sub_bucket_count + sub_bucket) << (group - 1);
+  }
+
+  /// Get the highest value counted in a bucket.
+  static uint64_t bucket_upper_bound(size_t index)
+  {
+    if (index + 1 >= kBucketCount) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    return bucket_lower_bound(index + 1) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace topic_statistics
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TOPIC_STATISTICS__LATENCY_HISTOGRAM_HPP_
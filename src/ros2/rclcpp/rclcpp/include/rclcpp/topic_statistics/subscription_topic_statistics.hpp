@@ -15,8 +15,11 @@
 #ifndef RCLCPP__TOPIC_STATISTICS__SUBSCRIPTION_TOPIC_STATISTICS_HPP_
 #define RCLCPP__TOPIC_STATISTICS__SUBSCRIPTION_TOPIC_STATISTICS_HPP_
 
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -30,8 +33,12 @@
 #include "rclcpp/time.hpp"
 #include "rclcpp/publisher.hpp"
 #include "rclcpp/timer.hpp"
+#include "rclcpp/topic_statistics/latency_histogram.hpp"
+#include "rclcpp/topic_statistics_state.hpp"
 
 #include "statistics_msgs/msg/metrics_message.hpp"
+#include "statistics_msgs/msg/statistic_data_point.hpp"
+#include "statistics_msgs/msg/statistic_data_type.hpp"
 
 namespace rclcpp
 {
@@ -45,10 +52,23 @@ using libstatistics_collector::collector::GenerateStatisticMessage;
 using statistics_msgs::msg::MetricsMessage;
 using libstatistics_collector::moving_average_statistics::StatisticData;
 
+namespace detail
+{
+/// Whether a message type has a header, and so a timestamp to compute its age from.
+template<typename M, typename = void>
+struct HasHeader : public std::false_type {};
+
+template<typename M>
+struct HasHeader<M, decltype((void) M::header)>: public std::true_type {};
+}  // namespace detail
+
 /**
  * Class used to collect, measure, and publish topic statistics data. Current statistics
  * supported for subscribers are received message age and received message period.
  *
+ * In TopicStatisticsMode::Histogram, both are recorded into lock-free latency histograms
+ * instead of the libstatistics_collector collectors, which also gives their percentiles.
+ *
  * \tparam CallbackMessageT the subscribed message type
  */
 template<typename CallbackMessageT>
@@ -75,13 +95,16 @@ public:
    * topic source
    * \param publisher instance constructed by the node in order to publish statistics data.
    * This class owns the publisher.
+   * \param mode how statistics are collected
    * \throws std::invalid_argument if publisher pointer is nullptr
    */
   SubscriptionTopicStatistics(
     const std::string & node_name,
-    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher)
+    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher,
+    TopicStatisticsMode mode = TopicStatisticsMode::MovingAverage)
   : node_name_(node_name),
-    publisher_(std::move(publisher))
+    publisher_(std::move(publisher)),
+    mode_(mode)
   {
     // TODO(dbbonnie): ros-tooling/aws-roadmap/issues/226, received message age
 
@@ -99,7 +122,8 @@ public:
 
   /// Handle a message received by the subscription to collect statistics.
   /**
-   * This method acquires a lock to prevent race conditions to collectors list.
+   * This method acquires a lock to prevent race conditions to collectors list, unless
+   * statistics are recorded into histograms.
    *
    * \param received_message the message received by the subscription
    * \param now_nanoseconds current time in nanoseconds
@@ -108,6 +132,16 @@ public:
     const CallbackMessageT & received_message,
     const rclcpp::Time now_nanoseconds) const
   {
+    if (TopicStatisticsMode::Histogram == mode_) {
+      const int64_t now = now_nanoseconds.nanoseconds();
+      record_message_age(received_message, now);
+      const int64_t previous = last_message_nanoseconds_.exchange(now, std::memory_order_relaxed);
+      if (previous != 0 && now >= previous) {
+        message_period_histogram_->record(static_cast<uint64_t>(now - previous));
+      }
+      return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     for (const auto & collector : subscriber_statistics_collectors_) {
       collector->OnMessageReceived(received_message, now_nanoseconds.nanoseconds());
@@ -132,7 +166,18 @@ public:
     std::vector<MetricsMessage> msgs;
     rclcpp::Time window_end{get_current_nanoseconds_since_epoch()};
 
-    {
+    if (TopicStatisticsMode::Histogram == mode_) {
+      msgs.push_back(
+        generate_histogram_message(
+          libstatistics_collector::topic_statistics_collector::topic_statistics_constants::
+          kMsgAgeStatName,
+          message_age_histogram_->collect_and_reset(), window_end));
+      msgs.push_back(
+        generate_histogram_message(
+          libstatistics_collector::topic_statistics_collector::topic_statistics_constants::
+          kMsgPeriodStatName,
+          message_period_histogram_->collect_and_reset(), window_end));
+    } else {
       std::lock_guard<std::mutex> lock(mutex_);
       for (auto & collector : subscriber_statistics_collectors_) {
         const auto collected_stats = collector->GetStatisticsResults();
@@ -178,6 +223,14 @@ private:
    */
   void bring_up()
   {
+    window_start_ = rclcpp::Time(get_current_nanoseconds_since_epoch());
+
+    if (TopicStatisticsMode::Histogram == mode_) {
+      message_age_histogram_ = std::make_unique<LatencyHistogram>();
+      message_period_histogram_ = std::make_unique<LatencyHistogram>();
+      return;
+    }
+
     auto received_message_age = std::make_unique<ReceivedMessageAge>();
     received_message_age->Start();
     subscriber_statistics_collectors_.emplace_back(std::move(received_message_age));
@@ -188,8 +241,6 @@ private:
       std::lock_guard<std::mutex> lock(mutex_);
       subscriber_statistics_collectors_.emplace_back(std::move(received_message_period));
     }
-
-    window_start_ = rclcpp::Time(get_current_nanoseconds_since_epoch());
   }
 
   /// Stop all collectors, clear measurements, stop publishing timer, and reset publisher.
@@ -215,6 +266,84 @@ private:
     publisher_.reset();
   }
 
+  /// Record the age of a message with a header.
+  template<typename T = CallbackMessageT>
+  typename std::enable_if<detail::HasHeader<T>::value>::type
+  record_message_age(const T & received_message, int64_t now_nanoseconds) const
+  {
+    const int64_t stamp_nanoseconds =
+      static_cast<int64_t>(received_message.header.stamp.sec) * 1000000000LL +
+      static_cast<int64_t>(received_message.header.stamp.nanosec);
+    // Unset timestamps and clock skew would give meaningless ages
+    if (stamp_nanoseconds > 0 && now_nanoseconds >= stamp_nanoseconds) {
+      message_age_histogram_->record(static_cast<uint64_t>(now_nanoseconds - stamp_nanoseconds));
+    }
+  }
+
+  /// Messages without a header have no age.
+  template<typename T = CallbackMessageT>
+  typename std::enable_if<!detail::HasHeader<T>::value>::type
+  record_message_age(const T &, int64_t) const
+  {
+  }
+
+  /// Generate the statistics message of a histogram, with values in milliseconds.
+  MetricsMessage generate_histogram_message(
+    const std::string & metric_name,
+    const LatencyHistogram::Snapshot & snapshot,
+    const rclcpp::Time & window_end) const
+  {
+    using statistics_msgs::msg::StatisticDataPoint;
+    using statistics_msgs::msg::StatisticDataType;
+    constexpr double kNanosecondsPerMillisecond = 1000000.0;
+
+    MetricsMessage message;
+    message.measurement_source_name = node_name_;
+    message.metrics_source = metric_name;
+    message.unit =
+      libstatistics_collector::topic_statistics_collector::topic_statistics_constants::
+      kMillisecondUnitName;
+    message.window_start = window_start_;
+    message.window_stop = window_end;
+
+    auto add_data_point = [&message](uint8_t data_type, double data) {
+        StatisticDataPoint data_point;
+        data_point.data_type = data_type;
+        data_point.data = data;
+        message.statistics.push_back(data_point);
+      };
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE,
+      snapshot.mean() / kNanosecondsPerMillisecond);
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM,
+      snapshot.count ? static_cast<double>(snapshot.min) / kNanosecondsPerMillisecond :
+      std::numeric_limits<double>::quiet_NaN());
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM,
+      snapshot.count ? static_cast<double>(snapshot.max) / kNanosecondsPerMillisecond :
+      std::numeric_limits<double>::quiet_NaN());
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_STDDEV,
+      snapshot.stddev() / kNanosecondsPerMillisecond);
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+      static_cast<double>(snapshot.count));
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_50,
+      snapshot.percentile(50.0) / kNanosecondsPerMillisecond);
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_90,
+      snapshot.percentile(90.0) / kNanosecondsPerMillisecond);
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99,
+      snapshot.percentile(99.0) / kNanosecondsPerMillisecond);
+    add_data_point(
+      StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99_9,
+      snapshot.percentile(99.9) / kNanosecondsPerMillisecond);
+    return message;
+  }
+
   /// Return the current nanoseconds (count) since epoch.
   /**
    * \return the current nanoseconds (count) since epoch
@@ -237,6 +366,13 @@ private:
   rclcpp::TimerBase::SharedPtr publisher_timer_;
   /// The start of the collection window, used in the published topic statistics message
   rclcpp::Time window_start_;
+  /// How statistics are collected
+  const TopicStatisticsMode mode_;
+  /// Histograms of the received message age and period, in TopicStatisticsMode::Histogram
+  std::unique_ptr<LatencyHistogram> message_age_histogram_;
+  std::unique_ptr<LatencyHistogram> message_period_histogram_;
+  /// Time the last message was received at, in nanoseconds, to compute the period
+  mutable std::atomic<int64_t> last_message_nanoseconds_{0};
 };
 }  // namespace topic_statistics
 }  // namespace rclcpp
@@ -30,6 +30,16 @@ enum class TopicStatisticsState
   NodeDefault
 };
 
+/// Represent how topic statistics are collected.
+/// Used as argument in create_subscriber.
+enum class TopicStatisticsMode
+{
+  /// Collect the mean, minimum, maximum and standard deviation of every metric.
+  MovingAverage,
+  /// Also collect percentiles, recording every metric into a lock-free latency histogram.
+  Histogram
+};
+
 }  // namespace rclcpp
 
 #endif  // RCLCPP__TOPIC_STATISTICS_STATE_HPP_
@@ -14,6 +14,8 @@
 
 #include "rclcpp/context.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -24,6 +26,8 @@
 #include "rcl/init.h"
 #include "rcl/logging.h"
 
+#include "rclcpp/async_logging.hpp"
+#include "rclcpp/detail/async_log_dispatcher.hpp"
 #include "rclcpp/detail/utilities.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/logging.hpp"
@@ -143,6 +147,70 @@ rclcpp_logging_output_handler(
 }
 }  // extern "C"
 
+/// Dispatcher of the asynchronous logging mode, null when it is disabled.
+/**
+ * Dispatchers are never deleted, since a log call may still be using one after logging is
+ * finalized; a stopped dispatcher dispatches synchronously.
+ */
+static std::atomic<rclcpp::detail::AsyncLogDispatcher *> g_async_log_dispatcher{nullptr};
+
+/// Messages dropped by the stopped dispatchers.
+static std::atomic<uint64_t> g_async_log_dropped_count{0};
+
+extern "C"
+{
+static
+void
+rclcpp_async_logging_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  rclcpp::detail::AsyncLogDispatcher * dispatcher = g_async_log_dispatcher.load();
+  if (dispatcher) {
+    dispatcher->log(location, severity, name, timestamp, format, args);
+  } else {
+    rclcpp_logging_output_handler(location, severity, name, timestamp, format, args);
+  }
+}
+}  // extern "C"
+
+/// Dispatch the messages queued by asynchronous logging, and disable it.
+/**
+ * Must not be called with the global logging mutex held, the dispatcher needs it.
+ */
+static
+void
+stop_async_logging()
+{
+  rclcpp::detail::AsyncLogDispatcher * dispatcher = g_async_log_dispatcher.load();
+  if (dispatcher) {
+    dispatcher->stop();
+    g_async_log_dispatcher.store(nullptr);
+    g_async_log_dropped_count += dispatcher->get_dropped_count();
+  }
+}
+
+uint64_t
+rclcpp::get_async_logging_dropped_count()
+{
+  uint64_t count = g_async_log_dropped_count.load();
+  rclcpp::detail::AsyncLogDispatcher * dispatcher = g_async_log_dispatcher.load();
+  if (dispatcher) {
+    count += dispatcher->get_dropped_count();
+  }
+  return count;
+}
+
+void
+rclcpp::flush_async_logging()
+{
+  rclcpp::detail::AsyncLogDispatcher * dispatcher = g_async_log_dispatcher.load();
+  if (dispatcher) {
+    dispatcher->flush();
+  }
+}
+
 Context::Context()
 : rcl_context_(nullptr),
   shutdown_reason_(""),
@@ -210,14 +278,23 @@ Context::init(
 
   if (init_options.auto_initialize_logging()) {
     logging_mutex_ = get_global_logging_mutex();
-    std::lock_guard<std::recursive_mutex> guard(*logging_mutex_);
+    std::unique_lock<std::recursive_mutex> guard(*logging_mutex_);
     size_t & count = get_logging_reference_count();
     if (0u == count) {
+      rcl_logging_output_handler_t output_handler = rclcpp_logging_output_handler;
+      if (init_options.async_logging_options().enabled) {
+        g_async_log_dispatcher.store(
+          new rclcpp::detail::AsyncLogDispatcher(
+            init_options.async_logging_options(), rclcpp_logging_output_handler));
+        output_handler = rclcpp_async_logging_output_handler;
+      }
       ret = rcl_logging_configure_with_output_handler(
         &rcl_context_->global_arguments,
         rcl_init_options_get_allocator(init_options_.get_rcl_init_options()),
-        rclcpp_logging_output_handler);
+        output_handler);
       if (RCL_RET_OK != ret) {
+        guard.unlock();
+        stop_async_logging();
         rcl_context_.reset();
         rclcpp::exceptions::throw_from_rcl_error(ret, "failed to configure logging");
       }
@@ -312,9 +389,15 @@ Context::shutdown(const std::string & reason)
   // shutdown logger
   if (logging_mutex_) {
     // logging was initialized by this context
-    std::lock_guard<std::recursive_mutex> guard(*logging_mutex_);
+    std::unique_lock<std::recursive_mutex> guard(*logging_mutex_);
     size_t & count = get_logging_reference_count();
-    if (0u == --count) {
+    if (0u == --count && g_async_log_dispatcher.load()) {
+      // queued messages are dispatched with the logging mutex held
+      guard.unlock();
+      stop_async_logging();
+      guard.lock();
+    }
+    if (0u == count) {
       rcl_ret_t rcl_ret = rcl_logging_fini();
       if (RCL_RET_OK != rcl_ret) {
         RCUTILS_SAFE_FWRITE_TO_STDERR(
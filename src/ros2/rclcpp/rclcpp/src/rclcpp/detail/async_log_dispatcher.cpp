@@ -0,0 +1,328 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/detail/async_log_dispatcher.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rcutils/time.h"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+// Length after which logger names are truncated
+static constexpr size_t kMaxNameLength = 255;
+
+struct AsyncLogDispatcher::Record
+{
+  rcutils_log_location_t location;
+  bool has_location;
+  bool has_name;
+  int severity;
+  rcutils_time_point_value_t timestamp;
+  std::vector<char> name;
+  std::vector<char> message;
+};
+
+struct AsyncLogDispatcher::ThreadQueue
+{
+  ThreadQueue(std::thread::id owner, size_t size, size_t max_message_length)
+  : owner(owner), records(size)
+  {
+    for (auto & record : records) {
+      record.name.resize(kMaxNameLength + 1);
+      record.message.resize(max_message_length + 1);
+    }
+  }
+
+  const std::thread::id owner;
+  std::vector<Record> records;
+  // Count of records read, only written by the background thread
+  std::atomic<size_t> head{0};
+  // Keep the indices written by different threads on different cache lines
+  char padding[64];
+  // Count of records written, only written by the owner thread
+  std::atomic<size_t> tail{0};
+};
+
+static std::atomic<uint64_t> g_next_dispatcher_id{1};
+
+AsyncLogDispatcher::AsyncLogDispatcher(
+  const AsyncLoggingOptions & options,
+  rcutils_logging_output_handler_t output_handler)
+: options_(options),
+  output_handler_(output_handler),
+  id_(g_next_dispatcher_id.fetch_add(1))
+{
+  if (0u == options_.queue_size) {
+    throw std::invalid_argument("asynchronous logging queue size must be greater than 0");
+  }
+  thread_ = std::thread(&AsyncLogDispatcher::run, this);
+  thread_id_ = thread_.get_id();
+}
+
+AsyncLogDispatcher::~AsyncLogDispatcher()
+{
+  stop();
+}
+
+std::shared_ptr<AsyncLogDispatcher::ThreadQueue>
+AsyncLogDispatcher::get_thread_queue()
+{
+  // Queue of the dispatcher the calling thread logged to last
+  struct CachedQueue
+  {
+    uint64_t dispatcher_id = 0;
+    std::shared_ptr<ThreadQueue> queue;
+  };
+  thread_local CachedQueue cached_queue;
+  if (cached_queue.dispatcher_id == id_) {
+    return cached_queue.queue;
+  }
+
+  const std::thread::id this_thread = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(queues_mutex_);
+  auto it = std::find_if(
+    queues_.begin(), queues_.end(),
+    [this_thread](const std::shared_ptr<ThreadQueue> & queue) {
+      return queue->owner == this_thread;
+    });
+  if (it != queues_.end()) {
+    cached_queue.queue = *it;
+  } else {
+    cached_queue.queue = std::make_shared<ThreadQueue>(
+      this_thread, options_.queue_size, options_.max_message_length);
+    queues_.push_back(cached_queue.queue);
+  }
+  cached_queue.dispatcher_id = id_;
+  return cached_queue.queue;
+}
+
+void
+AsyncLogDispatcher::log(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  if (stopped_.load(std::memory_order_relaxed) ||
+    std::this_thread::get_id() == thread_id_)
+  {
+    output_handler_(location, severity, name, timestamp, format, args);
+    return;
+  }
+
+  std::shared_ptr<ThreadQueue> queue = get_thread_queue();
+  const size_t size = queue->records.size();
+  const size_t tail = queue->tail.load(std::memory_order_relaxed);
+  while (tail - queue->head.load(std::memory_order_acquire) >= size) {
+    if (AsyncLoggingDropPolicy::DropNewest == options_.drop_policy) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (stopped_.load(std::memory_order_relaxed)) {
+      output_handler_(location, severity, name, timestamp, format, args);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      wake_cv_.notify_one();
+    }
+    std::this_thread::yield();
+  }
+
+  Record & record = queue->records[tail % size];
+  record.has_location = nullptr != location;
+  if (record.has_location) {
+    record.location = *location;
+  }
+  record.severity = severity;
+  record.timestamp = timestamp;
+  record.has_name = nullptr != name;
+  size_t length = 0;
+  if (record.has_name) {
+    for (; name[length] != '\0' && length < kMaxNameLength; ++length) {
+      record.name[length] = name[length];
+    }
+  }
+  record.name[length] = '\0';
+  va_list args_clone;
+  va_copy(args_clone, *args);
+  if (std::vsnprintf(record.message.data(), record.message.size(), format, args_clone) < 0) {
+    record.message[0] = '\0';
+  }
+  va_end(args_clone);
+
+  // Sequentially consistent, so that either this thread sees the background thread sleeping or
+  // the background thread sees the record
+  queue->tail.store(tail + 1);
+  if (sleeping_.load()) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
+}
+
+void
+AsyncLogDispatcher::flush()
+{
+  if (std::this_thread::get_id() == thread_id_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  const uint64_t requested = ++flush_requested_;
+  wake_cv_.notify_one();
+  flushed_cv_.wait(
+    lock, [this, requested]() {
+      return flush_done_ >= requested || stopped_.load();
+    });
+}
+
+void
+AsyncLogDispatcher::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopped_.store(true);
+    wake_cv_.notify_one();
+  }
+  if (thread_.joinable() && std::this_thread::get_id() != thread_id_) {
+    thread_.join();
+  }
+}
+
+uint64_t
+AsyncLogDispatcher::get_dropped_count() const
+{
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+void
+AsyncLogDispatcher::run()
+{
+  while (true) {
+    uint64_t flush_requested;
+    bool stopping;
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      flush_requested = flush_requested_;
+      stopping = stopped_.load();
+    }
+
+    drain();
+
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+      rcutils_time_point_value_t now = 0;
+      if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+        now = 0;
+      }
+      dispatch(
+        nullptr, RCUTILS_LOG_SEVERITY_WARN, "rclcpp", now,
+        "%" PRIu64 " log messages were dropped because the asynchronous logging queue was full",
+        dropped - dropped_reported_);
+      dropped_reported_ = dropped;
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    if (flush_requested > flush_done_) {
+      flush_done_ = flush_requested;
+      flushed_cv_.notify_all();
+    }
+    if (stopping) {
+      flushed_cv_.notify_all();
+      return;
+    }
+    if (flush_requested_ != flush_done_ || stopped_.load()) {
+      continue;
+    }
+    // Sequentially consistent, paired with the store of the tail by the logging threads
+    sleeping_.store(true);
+    if (!has_pending()) {
+      wake_cv_.wait(lock);
+    }
+    sleeping_.store(false);
+  }
+}
+
+bool
+AsyncLogDispatcher::drain()
+{
+  std::vector<std::shared_ptr<ThreadQueue>> queues;
+  {
+    std::lock_guard<std::mutex> lock(queues_mutex_);
+    queues = queues_;
+  }
+
+  bool dispatched = false;
+  for (const auto & queue : queues) {
+    const size_t size = queue->records.size();
+    size_t head = queue->head.load(std::memory_order_relaxed);
+    while (head != queue->tail.load()) {
+      const Record & record = queue->records[head % size];
+      dispatch(
+        record.has_location ? &record.location : nullptr, record.severity,
+        record.has_name ? record.name.data() : nullptr, record.timestamp, "%s",
+        record.message.data());
+      queue->head.store(++head, std::memory_order_release);
+      dispatched = true;
+    }
+  }
+  queues.clear();
+
+  // Forget the queues of the threads that exited, once they are empty
+  std::lock_guard<std::mutex> lock(queues_mutex_);
+  queues_.erase(
+    std::remove_if(
+      queues_.begin(), queues_.end(),
+      [](const std::shared_ptr<ThreadQueue> & queue) {
+        return queue.use_count() == 1 &&
+        queue->head.load(std::memory_order_relaxed) == queue->tail.load();
+      }),
+    queues_.end());
+  return dispatched;
+}
+
+bool
+AsyncLogDispatcher::has_pending()
+{
+  std::lock_guard<std::mutex> lock(queues_mutex_);
+  for (const auto & queue : queues_) {
+    if (queue->head.load(std::memory_order_relaxed) != queue->tail.load()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+AsyncLogDispatcher::dispatch(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  rcutils_time_point_value_t timestamp, const char * format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  output_handler_(location, severity, name, timestamp, format, &args);
+  va_end(args);
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -29,6 +29,8 @@
 
 #include "rcutils/logging_macros.h"
 
+#include "tracetools/tracetools.h"
+
 using rclcpp::exceptions::throw_from_rcl_error;
 using rclcpp::AnyExecutable;
 using rclcpp::Executor;
@@ -294,12 +296,34 @@ Executor::set_memory_strategy(rclcpp::memory_strategy::MemoryStrategy::SharedPtr
   memory_strategy_ = memory_strategy;
 }
 
+/// Get the entity an executable is for, to identify it in traces.
+static
+const void *
+get_executable_handle(const AnyExecutable & any_exec)
+{
+  if (any_exec.timer) {
+    return any_exec.timer.get();
+  }
+  if (any_exec.subscription) {
+    return any_exec.subscription.get();
+  }
+  if (any_exec.service) {
+    return any_exec.service.get();
+  }
+  if (any_exec.client) {
+    return any_exec.client.get();
+  }
+  return any_exec.waitable.get();
+}
+
 void
 Executor::execute_any_executable(AnyExecutable & any_exec)
 {
   if (!spinning.load()) {
     return;
   }
+  const void * handle = get_executable_handle(any_exec);
+  TRACEPOINT(rclcpp_executor_execute_start, handle);
   if (any_exec.timer) {
     execute_timer(any_exec.timer);
   }
@@ -315,6 +339,7 @@ Executor::execute_any_executable(AnyExecutable & any_exec)
   if (any_exec.waitable) {
     any_exec.waitable->execute();
   }
+  TRACEPOINT(rclcpp_executor_execute_end, handle);
   // Reset the callback_group, regardless of type
   any_exec.callback_group->can_be_taken_from().store(true);
   // Wake the wait, because it may need to be recalculated or work that
@@ -14,6 +14,8 @@
 
 #include "rclcpp/init_options.hpp"
 
+#include <stdexcept>
+
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/logging.hpp"
 
@@ -45,6 +47,7 @@ InitOptions::InitOptions(const InitOptions & other)
 {
   shutdown_on_sigint = other.shutdown_on_sigint;
   initialize_logging_ = other.initialize_logging_;
+  async_logging_options_ = other.async_logging_options_;
 }
 
 bool
@@ -60,6 +63,22 @@ InitOptions::auto_initialize_logging(bool initialize_logging)
   return *this;
 }
 
+const AsyncLoggingOptions &
+InitOptions::async_logging_options() const
+{
+  return async_logging_options_;
+}
+
+InitOptions &
+InitOptions::async_logging_options(const AsyncLoggingOptions & async_logging_options)
+{
+  if (0u == async_logging_options.queue_size) {
+    throw std::invalid_argument("async_logging_options.queue_size must be greater than 0");
+  }
+  async_logging_options_ = async_logging_options;
+  return *this;
+}
+
 InitOptions &
 InitOptions::operator=(const InitOptions & other)
 {
@@ -71,6 +90,7 @@ InitOptions::operator=(const InitOptions & other)
     }
     this->shutdown_on_sigint = other.shutdown_on_sigint;
     this->initialize_logging_ = other.initialize_logging_;
+    this->async_logging_options_ = other.async_logging_options_;
   }
   return *this;
 }
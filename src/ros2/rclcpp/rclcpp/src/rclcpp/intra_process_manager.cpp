@@ -15,6 +15,7 @@
 #include "rclcpp/experimental/intra_process_manager.hpp"
 
 #include <atomic>
+#include <cstring>
 #include <memory>
 #include <mutex>
 
@@ -161,6 +162,55 @@ IntraProcessManager::get_subscription_intra_process(uint64_t intra_process_subsc
   }
 }
 
+uint64_t
+IntraProcessManager::add_service(ServiceIntraProcessBase::SharedPtr service)
+{
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+  auto id = IntraProcessManager::get_next_unique_id();
+  services_[id] = service;
+  return id;
+}
+
+void
+IntraProcessManager::remove_service(uint64_t intra_process_service_id)
+{
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+  services_.erase(intra_process_service_id);
+}
+
+ServiceIntraProcessBase::SharedPtr
+IntraProcessManager::get_service_intra_process(uint64_t intra_process_service_id)
+{
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  auto service_it = services_.find(intra_process_service_id);
+  if (service_it == services_.end()) {
+    return nullptr;
+  } else {
+    return service_it->second;
+  }
+}
+
+ServiceIntraProcessBase::SharedPtr
+IntraProcessManager::find_service_intra_process(
+  const char * service_name,
+  const rosidl_service_type_support_t * type_support_handle) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  for (const auto & pair : services_) {
+    const auto & service = pair.second;
+    if (service->get_type_support_handle() == type_support_handle &&
+      strcmp(service->get_service_name(), service_name) == 0)
+    {
+      return service;
+    }
+  }
+  return nullptr;
+}
+
 uint64_t
 IntraProcessManager::get_next_unique_id()
 {
@@ -35,9 +35,15 @@ NodeServices::add_service(
       // TODO(jacquelinekay): use custom exception
       throw std::runtime_error("Cannot create service, group not in node.");
     }
-    group->add_service(service_base_ptr);
   } else {
-    node_base_->get_default_callback_group()->add_service(service_base_ptr);
+    group = node_base_->get_default_callback_group();
+  }
+  group->add_service(service_base_ptr);
+
+  auto intra_process_waitable = service_base_ptr->get_intra_process_waitable();
+  if (nullptr != intra_process_waitable) {
+    // Add to the callback group to be notified about intra-process requests.
+    group->add_waitable(intra_process_waitable);
   }
 
   // Notify the executor that a new service was created using the parent Node.
@@ -62,9 +68,15 @@ NodeServices::add_client(
       // TODO(jacquelinekay): use custom exception
       throw std::runtime_error("Cannot create client, group not in node.");
     }
-    group->add_client(client_base_ptr);
   } else {
-    node_base_->get_default_callback_group()->add_client(client_base_ptr);
+    group = node_base_->get_default_callback_group();
+  }
+  group->add_client(client_base_ptr);
+
+  auto intra_process_waitable = client_base_ptr->get_intra_process_waitable();
+  if (nullptr != intra_process_waitable) {
+    // Add to the callback group to be notified about intra-process responses.
+    group->add_waitable(intra_process_waitable);
   }
 
   // Notify the executor that a new client was created using the parent Node.
@@ -18,9 +18,12 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
@@ -32,7 +35,19 @@ ServiceBase::ServiceBase(std::shared_ptr<rcl_node_t> node_handle)
 {}
 
 ServiceBase::~ServiceBase()
-{}
+{
+  if (!use_intra_process_) {
+    return;
+  }
+  auto ipm = weak_ipm_.lock();
+  if (!ipm) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("rclcpp"),
+      "Intra process manager died before a service.");
+    return;
+  }
+  ipm->remove_service(intra_process_service_id_);
+}
 
 bool
 ServiceBase::take_type_erased_request(void * request_out, rmw_request_id_t & request_id_out)
@@ -84,3 +99,28 @@ ServiceBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+ServiceBase::setup_intra_process(
+  uint64_t intra_process_service_id,
+  IntraProcessManagerWeakPtr weak_ipm)
+{
+  intra_process_service_id_ = intra_process_service_id;
+  weak_ipm_ = weak_ipm;
+  use_intra_process_ = true;
+}
+
+rclcpp::Waitable::SharedPtr
+ServiceBase::get_intra_process_waitable() const
+{
+  if (!use_intra_process_) {
+    return nullptr;
+  }
+  auto ipm = weak_ipm_.lock();
+  if (!ipm) {
+    throw std::runtime_error(
+      "ServiceBase::get_intra_process_waitable() called "
+      "after destruction of intra process manager");
+  }
+  return ipm->get_service_intra_process(intra_process_service_id_);
+}
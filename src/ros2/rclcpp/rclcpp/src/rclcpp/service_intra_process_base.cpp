@@ -0,0 +1,76 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/experimental/service_intra_process_base.hpp"
+
+#include <string>
+
+#include "rcl/error_handling.h"
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
+
+using rclcpp::experimental::ServiceIntraProcessBase;
+
+ServiceIntraProcessBase::ServiceIntraProcessBase(
+  rclcpp::Context::SharedPtr context,
+  const std::string & service_name,
+  const rosidl_service_type_support_t * type_support_handle)
+: gc_(rcl_get_zero_initialized_guard_condition()),
+  service_name_(service_name),
+  type_support_handle_(type_support_handle)
+{
+  rcl_ret_t ret = rcl_guard_condition_init(
+    &gc_, context->get_rcl_context().get(), rcl_guard_condition_get_default_options());
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(
+      ret, "failed to create guard condition of intra-process service");
+  }
+}
+
+ServiceIntraProcessBase::~ServiceIntraProcessBase()
+{
+  if (RCL_RET_OK != rcl_guard_condition_fini(&gc_)) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "Error in destruction of guard condition of intra-process service: %s",
+      rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+}
+
+bool
+ServiceIntraProcessBase::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  return RCL_RET_OK == rcl_wait_set_add_guard_condition(wait_set, &gc_, NULL);
+}
+
+const char *
+ServiceIntraProcessBase::get_service_name() const
+{
+  return service_name_.c_str();
+}
+
+const rosidl_service_type_support_t *
+ServiceIntraProcessBase::get_type_support_handle() const
+{
+  return type_support_handle_;
+}
+
+void
+ServiceIntraProcessBase::trigger_guard_condition()
+{
+  rcl_ret_t ret = rcl_trigger_guard_condition(&gc_);
+  (void)ret;
+}
@@ -0,0 +1,66 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/message_memory_strategy.hpp"
+#include "rclcpp/strategies/recycling_message_memory_strategy.hpp"
+#include "test_msgs/msg/unbounded_sequences.hpp"
+
+using performance_test_fixture::PerformanceTest;
+using rclcpp::strategies::recycling_message_memory_strategy::RecyclingMessageMemoryStrategy;
+using MessageT = test_msgs::msg::UnboundedSequences;
+
+constexpr size_t kSequenceSize = 1024;
+
+// Borrow a message, fill it like a take would, and give it back, as the executor does
+static void borrow_take_return(
+  rclcpp::message_memory_strategy::MessageMemoryStrategy<MessageT> & strategy,
+  benchmark::State & st)
+{
+  for (auto _ : st) {
+    auto message = strategy.borrow_message();
+    message->int32_values.resize(kSequenceSize);
+    message->string_values.resize(1);
+    message->string_values[0].assign(kSequenceSize, 'a');
+    benchmark::DoNotOptimize(message);
+    benchmark::ClobberMemory();
+    strategy.return_message(message);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, default_borrow_return)(benchmark::State & st)
+{
+  auto strategy = rclcpp::message_memory_strategy::MessageMemoryStrategy<
+    MessageT>::create_default();
+
+  reset_heap_counters();
+  borrow_take_return(*strategy, st);
+}
+
+BENCHMARK_F(PerformanceTest, recycling_borrow_return)(benchmark::State & st)
+{
+  auto strategy = std::make_shared<RecyclingMessageMemoryStrategy<MessageT>>(1);
+  // Warm up the pool, every iteration then runs without any allocation
+  auto message = strategy->borrow_message();
+  message->int32_values.resize(kSequenceSize);
+  message->string_values.resize(1);
+  message->string_values[0].assign(kSequenceSize, 'a');
+  strategy->return_message(message);
+
+  reset_heap_counters();
+  borrow_take_return(*strategy, st);
+}
@@ -18,6 +18,39 @@
 
 #include "rclcpp/allocator/allocator_common.hpp"
 
+namespace
+{
+void * failing_allocate(size_t size, void * state)
+{
+  (void)size;
+  (void)state;
+  return nullptr;
+}
+
+// Provides the rcl allocator to use in its place
+template<typename T>
+struct AllocatorWithRclAllocator : public std::allocator<T>
+{
+  template<typename U>
+  struct rebind
+  {
+    using other = AllocatorWithRclAllocator<U>;
+  };
+
+  AllocatorWithRclAllocator() = default;
+
+  template<typename U>
+  AllocatorWithRclAllocator(const AllocatorWithRclAllocator<U> &) {}
+
+  rcl_allocator_t get_rcl_allocator() const
+  {
+    rcl_allocator_t allocator = rcl_get_default_allocator();
+    allocator.allocate = &failing_allocate;
+    return allocator;
+  }
+};
+}  // namespace
+
 TEST(TestAllocatorCommon, retyped_allocate) {
   std::allocator<int> allocator;
   void * untyped_allocator = &allocator;
@@ -65,3 +98,18 @@ TEST(TestAllocatorCommon, get_void_rcl_allocator) {
   EXPECT_NE(nullptr, rcl_allocator.zero_allocate);
   // Not testing state as that may or may not be null depending on platform
 }
+
+TEST(TestAllocatorCommon, get_provided_rcl_allocator) {
+  static_assert(
+    rclcpp::allocator::has_rcl_allocator<AllocatorWithRclAllocator<int>>::value,
+    "allocator should provide an rcl allocator");
+  static_assert(
+    !rclcpp::allocator::has_rcl_allocator<std::allocator<int>>::value,
+    "std::allocator shouldn't provide an rcl allocator");
+
+  AllocatorWithRclAllocator<int> allocator;
+  auto rcl_allocator = rclcpp::allocator::get_rcl_allocator<int>(allocator);
+  EXPECT_EQ(&failing_allocate, rcl_allocator.allocate);
+  EXPECT_EQ(rcl_get_default_allocator().deallocate, rcl_allocator.deallocate);
+  EXPECT_EQ(rcl_get_default_allocator().state, rcl_allocator.state);
+}
@@ -0,0 +1,133 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/detail/resolve_message_memory_strategy.hpp"
+#include "rclcpp/strategies/recycling_message_memory_strategy.hpp"
+#include "rclcpp/subscription_options.hpp"
+#include "test_msgs/msg/unbounded_sequences.hpp"
+
+using rclcpp::strategies::recycling_message_memory_strategy::RecyclingMessageMemoryStrategy;
+using MessageT = test_msgs::msg::UnboundedSequences;
+
+class TestRecyclingMessageMemoryStrategy : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    message_memory_strategy_ = std::make_shared<RecyclingMessageMemoryStrategy<MessageT>>(2);
+  }
+
+protected:
+  std::shared_ptr<RecyclingMessageMemoryStrategy<MessageT>> message_memory_strategy_;
+};
+
+TEST_F(TestRecyclingMessageMemoryStrategy, construct_destruct) {
+  ASSERT_NE(nullptr, message_memory_strategy_);
+  EXPECT_NE(nullptr, message_memory_strategy_->message_allocator_);
+  EXPECT_EQ(0u, message_memory_strategy_->pooled_message_count());
+}
+
+TEST_F(TestRecyclingMessageMemoryStrategy, borrow_return_reuses_message) {
+  auto message = message_memory_strategy_->borrow_message();
+  ASSERT_NE(nullptr, message);
+  message->int32_values.resize(100);
+  const MessageT * raw_message = message.get();
+
+  message_memory_strategy_->return_message(message);
+  EXPECT_EQ(nullptr, message);
+  EXPECT_EQ(1u, message_memory_strategy_->pooled_message_count());
+
+  // The same message is handed out again, sequences keep their capacity
+  message = message_memory_strategy_->borrow_message();
+  EXPECT_EQ(raw_message, message.get());
+  EXPECT_GE(message->int32_values.capacity(), 100u);
+  EXPECT_EQ(0u, message_memory_strategy_->pooled_message_count());
+  message_memory_strategy_->return_message(message);
+}
+
+TEST_F(TestRecyclingMessageMemoryStrategy, retained_message_not_recycled) {
+  auto message = message_memory_strategy_->borrow_message();
+  // Copy kept by a callback
+  auto retained = message;
+
+  message_memory_strategy_->return_message(message);
+  EXPECT_EQ(nullptr, message);
+  EXPECT_EQ(0u, message_memory_strategy_->pooled_message_count());
+
+  auto other_message = message_memory_strategy_->borrow_message();
+  EXPECT_NE(retained.get(), other_message.get());
+  EXPECT_EQ(1, retained.use_count());
+  message_memory_strategy_->return_message(other_message);
+}
+
+TEST_F(TestRecyclingMessageMemoryStrategy, pool_size_is_bounded) {
+  std::vector<std::shared_ptr<MessageT>> messages;
+  for (int i = 0; i < 4; ++i) {
+    messages.push_back(message_memory_strategy_->borrow_message());
+  }
+  for (auto & message : messages) {
+    message_memory_strategy_->return_message(message);
+    EXPECT_EQ(nullptr, message);
+  }
+  EXPECT_EQ(2u, message_memory_strategy_->pooled_message_count());
+}
+
+TEST_F(TestRecyclingMessageMemoryStrategy, concurrent_borrow_return) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(
+      [this]() {
+        for (int j = 0; j < 1000; ++j) {
+          auto message = message_memory_strategy_->borrow_message();
+          message->int32_values.push_back(j);
+          message_memory_strategy_->return_message(message);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(message_memory_strategy_->pooled_message_count(), 2u);
+}
+
+TEST(TestResolveMessageMemoryStrategy, from_options) {
+  using StrategyT = rclcpp::message_memory_strategy::MessageMemoryStrategy<MessageT>;
+  rclcpp::SubscriptionOptions options;
+
+  auto strategy =
+    rclcpp::detail::resolve_message_memory_strategy<StrategyT, MessageT>(nullptr, options);
+  ASSERT_NE(nullptr, strategy);
+  EXPECT_EQ(
+    nullptr,
+    std::dynamic_pointer_cast<RecyclingMessageMemoryStrategy<MessageT>>(strategy));
+
+  options.message_pool_size = 4;
+  strategy = rclcpp::detail::resolve_message_memory_strategy<StrategyT, MessageT>(nullptr, options);
+  EXPECT_NE(
+    nullptr,
+    std::dynamic_pointer_cast<RecyclingMessageMemoryStrategy<MessageT>>(strategy));
+
+  // A strategy given explicitly is always used
+  auto explicit_strategy = StrategyT::create_default();
+  EXPECT_EQ(
+    explicit_strategy,
+    (rclcpp::detail::resolve_message_memory_strategy<StrategyT, MessageT>(
+      explicit_strategy, options)));
+}
@@ -0,0 +1,270 @@
+// Copyright 2017 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/async_logging.hpp"
+#include "rclcpp/detail/async_log_dispatcher.hpp"
+#include "rclcpp/init_options.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/utilities.hpp"
+#include "rcutils/logging.h"
+
+using rclcpp::detail::AsyncLogDispatcher;
+
+struct LogEvent
+{
+  std::thread::id thread_id;
+  int level;
+  std::string name;
+  std::string message;
+};
+
+std::mutex g_log_events_mutex;
+std::vector<LogEvent> g_log_events;
+
+// Set to make the output handler wait until it is cleared
+std::mutex g_gate_mutex;
+std::condition_variable g_gate_cv;
+bool g_gate_closed = false;
+
+void
+capture_output_handler(
+  const rcutils_log_location_t * location,
+  int level, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  (void)location;
+  (void)timestamp;
+  {
+    std::unique_lock<std::mutex> lock(g_gate_mutex);
+    g_gate_cv.wait(lock, []() {return !g_gate_closed;});
+  }
+  char buffer[2048];
+  vsnprintf(buffer, sizeof(buffer), format, *args);
+  std::lock_guard<std::mutex> lock(g_log_events_mutex);
+  g_log_events.push_back({std::this_thread::get_id(), level, name ? name : "", buffer});
+}
+
+// Log from the dispatcher, like the rcutils logging macros would
+void
+log(AsyncLogDispatcher & dispatcher, const char * name, const char * format, ...)
+{
+  static const rcutils_log_location_t location = {"log", __FILE__, __LINE__};
+  va_list args;
+  va_start(args, format);
+  dispatcher.log(&location, RCUTILS_LOG_SEVERITY_INFO, name, 0, format, &args);
+  va_end(args);
+}
+
+class TestAsyncLogDispatcher : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    g_log_events.clear();
+    set_gate(false);
+  }
+
+  void TearDown()
+  {
+    set_gate(false);
+  }
+
+  static void set_gate(bool closed)
+  {
+    std::lock_guard<std::mutex> lock(g_gate_mutex);
+    g_gate_closed = closed;
+    g_gate_cv.notify_all();
+  }
+
+  // Events of a logger, the drop reports of the dispatcher are logged by "rclcpp"
+  static std::vector<LogEvent> get_events(const std::string & name)
+  {
+    std::vector<LogEvent> events;
+    std::lock_guard<std::mutex> lock(g_log_events_mutex);
+    for (const auto & event : g_log_events) {
+      if (event.name == name) {
+        events.push_back(event);
+      }
+    }
+    return events;
+  }
+};
+
+TEST_F(TestAsyncLogDispatcher, dispatch_in_background_thread) {
+  AsyncLogDispatcher dispatcher(rclcpp::AsyncLoggingOptions(), capture_output_handler);
+  for (int i = 0; i < 100; ++i) {
+    log(dispatcher, "logger", "message %d: %s", i, std::to_string(i).c_str());
+  }
+  dispatcher.flush();
+
+  auto events = get_events("logger");
+  ASSERT_EQ(100u, events.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ("message " + std::to_string(i) + ": " + std::to_string(i), events[i].message);
+    EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, events[i].level);
+    EXPECT_NE(std::this_thread::get_id(), events[i].thread_id);
+  }
+  EXPECT_EQ(0u, dispatcher.get_dropped_count());
+}
+
+TEST_F(TestAsyncLogDispatcher, truncate_long_messages) {
+  rclcpp::AsyncLoggingOptions options;
+  options.max_message_length = 8;
+  AsyncLogDispatcher dispatcher(options, capture_output_handler);
+  log(dispatcher, "logger", "%s", "0123456789abcdef");
+  dispatcher.flush();
+
+  auto events = get_events("logger");
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ("01234567", events[0].message);
+}
+
+TEST_F(TestAsyncLogDispatcher, drop_newest_when_full) {
+  rclcpp::AsyncLoggingOptions options;
+  options.queue_size = 4;
+  options.drop_policy = rclcpp::AsyncLoggingDropPolicy::DropNewest;
+  AsyncLogDispatcher dispatcher(options, capture_output_handler);
+
+  set_gate(true);
+  for (int i = 0; i < 20; ++i) {
+    log(dispatcher, "logger", "message %d", i);
+  }
+  // At most one message is being dispatched and four are queued
+  const uint64_t dropped = dispatcher.get_dropped_count();
+  EXPECT_GE(dropped, 15u);
+  set_gate(false);
+  dispatcher.flush();
+
+  auto events = get_events("logger");
+  EXPECT_EQ(20u, events.size() + dropped);
+  // Kept messages are the oldest ones, in order
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ("message " + std::to_string(i), events[i].message);
+  }
+  auto reports = get_events("rclcpp");
+  ASSERT_EQ(1u, reports.size());
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, reports[0].level);
+  EXPECT_EQ(
+    std::to_string(dropped) +
+    " log messages were dropped because the asynchronous logging queue was full",
+    reports[0].message);
+}
+
+TEST_F(TestAsyncLogDispatcher, block_when_full) {
+  rclcpp::AsyncLoggingOptions options;
+  options.queue_size = 4;
+  options.drop_policy = rclcpp::AsyncLoggingDropPolicy::Block;
+  AsyncLogDispatcher dispatcher(options, capture_output_handler);
+
+  set_gate(true);
+  std::atomic<bool> done{false};
+  std::thread thread(
+    [&dispatcher, &done]() {
+      for (int i = 0; i < 20; ++i) {
+        log(dispatcher, "logger", "message %d", i);
+      }
+      done = true;
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(done);
+  set_gate(false);
+  thread.join();
+  dispatcher.flush();
+
+  auto events = get_events("logger");
+  ASSERT_EQ(20u, events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ("message " + std::to_string(i), events[i].message);
+  }
+  EXPECT_EQ(0u, dispatcher.get_dropped_count());
+}
+
+TEST_F(TestAsyncLogDispatcher, keep_order_of_each_thread) {
+  rclcpp::AsyncLoggingOptions options;
+  options.drop_policy = rclcpp::AsyncLoggingDropPolicy::Block;
+  AsyncLogDispatcher dispatcher(options, capture_output_handler);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(
+      [&dispatcher, t]() {
+        const std::string name = "logger_" + std::to_string(t);
+        for (int i = 0; i < 1000; ++i) {
+          log(dispatcher, name.c_str(), "%d", i);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  dispatcher.flush();
+
+  for (int t = 0; t < 4; ++t) {
+    auto events = get_events("logger_" + std::to_string(t));
+    ASSERT_EQ(1000u, events.size());
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(std::to_string(i), events[i].message);
+    }
+  }
+}
+
+TEST_F(TestAsyncLogDispatcher, synchronous_after_stop) {
+  AsyncLogDispatcher dispatcher(rclcpp::AsyncLoggingOptions(), capture_output_handler);
+  log(dispatcher, "logger", "queued");
+  dispatcher.stop();
+  log(dispatcher, "logger", "synchronous");
+
+  auto events = get_events("logger");
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ("queued", events[0].message);
+  EXPECT_EQ("synchronous", events[1].message);
+  EXPECT_EQ(std::this_thread::get_id(), events[1].thread_id);
+}
+
+TEST(TestAsyncLogging, init_shutdown) {
+  rclcpp::AsyncLoggingOptions async_logging_options;
+  async_logging_options.enabled = true;
+  rclcpp::InitOptions init_options;
+  init_options.async_logging_options(async_logging_options);
+  EXPECT_TRUE(init_options.async_logging_options().enabled);
+
+  rclcpp::init(0, nullptr, init_options);
+  for (int i = 0; i < 10; ++i) {
+    RCLCPP_INFO(rclcpp::get_logger("test_async_logging"), "message %d", i);
+  }
+  rclcpp::flush_async_logging();
+  EXPECT_EQ(0u, rclcpp::get_async_logging_dropped_count());
+  rclcpp::shutdown();
+
+  // Synchronous again
+  RCLCPP_INFO(rclcpp::get_logger("test_async_logging"), "after shutdown");
+  rclcpp::flush_async_logging();
+}
+
+TEST(TestAsyncLogging, invalid_options) {
+  rclcpp::AsyncLoggingOptions async_logging_options;
+  async_logging_options.queue_size = 0;
+  EXPECT_THROW(
+    rclcpp::InitOptions().async_logging_options(async_logging_options), std::invalid_argument);
+}
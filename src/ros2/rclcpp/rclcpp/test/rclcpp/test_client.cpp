@@ -17,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/rclcpp.hpp"
@@ -328,3 +329,103 @@ TEST_F(TestClientWithServer, take_response) {
       rclcpp::exceptions::RCLError);
   }
 }
+
+class TestClientWithIntraProcessServer : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp()
+  {
+    auto options = rclcpp::NodeOptions().use_intra_process_comms(true);
+    server_node = std::make_shared<rclcpp::Node>("server_node", "ns", options);
+    client_node = std::make_shared<rclcpp::Node>("client_node", "ns", options);
+
+    auto callback = [this](
+      const test_msgs::srv::Empty::Request::SharedPtr request,
+      test_msgs::srv::Empty::Response::SharedPtr response) {
+        received_request = request;
+        sent_response = response;
+      };
+    service = server_node->create_service<test_msgs::srv::Empty>(service_name, callback);
+
+    executor.add_node(server_node);
+    executor.add_node(client_node);
+  }
+
+  std::shared_ptr<rclcpp::Node> server_node;
+  std::shared_ptr<rclcpp::Node> client_node;
+  rclcpp::executors::SingleThreadedExecutor executor;
+  std::shared_ptr<rclcpp::Service<test_msgs::srv::Empty>> service;
+  test_msgs::srv::Empty::Request::SharedPtr received_request;
+  test_msgs::srv::Empty::Response::SharedPtr sent_response;
+  const std::string service_name{"empty_service"};
+};
+
+TEST_F(TestClientWithIntraProcessServer, async_send_request) {
+  auto client = client_node->create_client<test_msgs::srv::Empty>(service_name);
+  auto request = std::make_shared<test_msgs::srv::Empty::Request>();
+
+  // The request doesn't go through rcl
+  auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_send_request, RCL_RET_ERROR);
+  bool callback_called = false;
+  auto future = client->async_send_request(
+    request,
+    [&callback_called](rclcpp::Client<test_msgs::srv::Empty>::SharedFuture) {
+      callback_called = true;
+    });
+
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(future, std::chrono::seconds(1)));
+  EXPECT_TRUE(callback_called);
+  // Neither the request nor the response were copied
+  EXPECT_EQ(request, received_request);
+  EXPECT_NE(nullptr, sent_response);
+  EXPECT_EQ(sent_response, future.get());
+}
+
+TEST_F(TestClientWithIntraProcessServer, async_send_requests_before_spinning) {
+  auto client = client_node->create_client<test_msgs::srv::Empty>(service_name);
+
+  std::vector<rclcpp::Client<test_msgs::srv::Empty>::SharedFuture> futures;
+  for (size_t i = 0; i < 3; ++i) {
+    futures.push_back(
+      client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>()));
+  }
+  for (auto & future : futures) {
+    EXPECT_EQ(
+      rclcpp::FutureReturnCode::SUCCESS,
+      executor.spin_until_future_complete(future, std::chrono::seconds(1)));
+  }
+}
+
+TEST_F(TestClientWithIntraProcessServer, service_destroyed) {
+  auto client = client_node->create_client<test_msgs::srv::Empty>(service_name);
+  service.reset();
+
+  // Requests go through rcl again
+  auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_send_request, RCL_RET_ERROR);
+  EXPECT_THROW(
+    client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>()),
+    rclcpp::exceptions::RCLError);
+}
+
+TEST_F(TestClientWithIntraProcessServer, client_without_intra_process) {
+  auto options = rclcpp::NodeOptions().use_intra_process_comms(false);
+  auto node = std::make_shared<rclcpp::Node>("inter_process_client_node", "ns", options);
+  auto client = node->create_client<test_msgs::srv::Empty>(service_name);
+
+  auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_send_request, RCL_RET_ERROR);
+  EXPECT_THROW(
+    client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>()),
+    rclcpp::exceptions::RCLError);
+}
@@ -0,0 +1,108 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/topic_statistics/latency_histogram.hpp"
+
+using rclcpp::topic_statistics::LatencyHistogram;
+
+TEST(TestLatencyHistogram, bucket_bounds) {
+  const double max_relative_error = 1.0 / (1 << LatencyHistogram::kSubBucketBits);
+  const size_t bucket_count = LatencyHistogram::kBucketCount;
+  std::mt19937_64 generator(42);
+  for (int i = 0; i < 100000; ++i) {
+    const uint64_t value = generator() >> (generator() % 64);
+    const size_t index = LatencyHistogram::bucket_index(value);
+    ASSERT_LT(index, bucket_count);
+    EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), value);
+    EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), value);
+    if (index + 1 < bucket_count) {
+      const uint64_t width = LatencyHistogram::bucket_upper_bound(index) -
+        LatencyHistogram::bucket_lower_bound(index);
+      EXPECT_LE(static_cast<double>(width), max_relative_error * static_cast<double>(value));
+    }
+  }
+  for (size_t index = 0; index + 1 < bucket_count; ++index) {
+    EXPECT_EQ(
+      LatencyHistogram::bucket_upper_bound(index) + 1,
+      LatencyHistogram::bucket_lower_bound(index + 1));
+  }
+}
+
+TEST(TestLatencyHistogram, empty) {
+  auto histogram = std::make_unique<LatencyHistogram>();
+  const auto snapshot = histogram->collect_and_reset();
+  EXPECT_EQ(0u, snapshot.count);
+  EXPECT_TRUE(std::isnan(snapshot.mean()));
+  EXPECT_TRUE(std::isnan(snapshot.stddev()));
+  EXPECT_TRUE(std::isnan(snapshot.percentile(99.0)));
+}
+
+TEST(TestLatencyHistogram, percentiles) {
+  auto histogram = std::make_unique<LatencyHistogram>();
+  std::mt19937_64 generator(42);
+  std::lognormal_distribution<double> distribution(13.0, 1.0);
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(static_cast<uint64_t>(distribution(generator)));
+    histogram->record(values.back());
+  }
+  std::sort(values.begin(), values.end());
+
+  const auto snapshot = histogram->collect_and_reset();
+  EXPECT_EQ(values.size(), snapshot.count);
+  EXPECT_EQ(values.front(), snapshot.min);
+  EXPECT_EQ(values.back(), snapshot.max);
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    const double exact = static_cast<double>(
+      values[static_cast<size_t>(std::ceil(percentile / 100.0 * values.size())) - 1]);
+    EXPECT_NEAR(exact, snapshot.percentile(percentile), exact / 50.0) << percentile;
+  }
+  EXPECT_EQ(static_cast<double>(values.back()), snapshot.percentile(100.0));
+
+  // The histogram is empty again after it was collected
+  EXPECT_EQ(0u, histogram->collect_and_reset().count);
+}
+
+TEST(TestLatencyHistogram, concurrent_recording) {
+  auto histogram = std::make_unique<LatencyHistogram>();
+  constexpr uint64_t kValuesPerThread = 100000;
+  std::vector<std::thread> threads;
+  for (uint64_t thread = 1; thread <= 4; ++thread) {
+    threads.emplace_back(
+      [&histogram, thread]() {
+        for (uint64_t i = 0; i < kValuesPerThread; ++i) {
+          histogram->record(thread * 1000);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = histogram->collect_and_reset();
+  EXPECT_EQ(4 * kValuesPerThread, snapshot.count);
+  EXPECT_EQ(10 * 1000 * kValuesPerThread, snapshot.sum);
+  EXPECT_EQ(1000u, snapshot.min);
+  EXPECT_EQ(4000u, snapshot.max);
+}
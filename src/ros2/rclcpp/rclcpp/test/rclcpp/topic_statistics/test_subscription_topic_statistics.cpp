@@ -130,8 +130,9 @@ class MessageWithHeaderPublisher : public rclcpp::Node
 public:
   MessageWithHeaderPublisher(
     const std::string & name, const std::string & topic,
-    const std::chrono::milliseconds & publish_period = std::chrono::milliseconds{100})
-  : Node(name)
+    const std::chrono::milliseconds & publish_period = std::chrono::milliseconds{100},
+    const rclcpp::NodeOptions & node_options = rclcpp::NodeOptions())
+  : Node(name, node_options)
   {
     publisher_ = create_publisher<MessageWithHeader>(topic, 10);
     publish_timer_ = this->create_wall_timer(
@@ -196,20 +197,27 @@ private:
 class MessageWithHeaderSubscriber : public rclcpp::Node
 {
 public:
-  MessageWithHeaderSubscriber(const std::string & name, const std::string & topic)
-  : Node(name)
+  MessageWithHeaderSubscriber(
+    const std::string & name, const std::string & topic,
+    rclcpp::TopicStatisticsMode mode = rclcpp::TopicStatisticsMode::MovingAverage,
+    const rclcpp::NodeOptions & node_options = rclcpp::NodeOptions())
+  : Node(name, node_options)
   {
     // manually enable topic statistics via options
     auto options = rclcpp::SubscriptionOptions();
     options.topic_stats_options.state = rclcpp::TopicStatisticsState::Enable;
+    options.topic_stats_options.mode = mode;
 
     auto callback = [](MessageWithHeader::UniquePtr msg) {
         (void) msg;
       };
+    // intra-process communication is not allowed with keep all history
+    auto qos = node_options.use_intra_process_comms() ?
+      rclcpp::QoS(rclcpp::KeepLast(10)) : rclcpp::QoS(rclcpp::KeepAll());
     subscription_ = create_subscription<MessageWithHeader,
         std::function<void(MessageWithHeader::UniquePtr)>>(
       topic,
-      rclcpp::QoS(rclcpp::KeepAll()),
+      qos,
       callback,
       options);
   }
@@ -252,6 +260,10 @@ void check_if_statistics_message_is_empty(const MetricsMessage & message_to_chec
       case StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM:
       case StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM:
       case StatisticDataType::STATISTICS_DATA_TYPE_STDDEV:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_50:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_90:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99_9:
         EXPECT_TRUE(std::isnan(stats_point.data)) << "unexpected value" << stats_point.data <<
           " for type:" << type;
         break;
@@ -286,6 +298,12 @@ void check_if_statistic_message_is_populated(const MetricsMessage & message_to_c
       case StatisticDataType::STATISTICS_DATA_TYPE_STDDEV:
         EXPECT_LT(0, stats_point.data) << "unexpected stddev " << stats_point.data;
         break;
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_50:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_90:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99:
+      case StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99_9:
+        EXPECT_LT(0, stats_point.data) << "unexpected percentile " << stats_point.data;
+        break;
       default:
         FAIL() << "received unknown statistics type: " << std::dec <<
           static_cast<unsigned int>(type);
@@ -476,3 +494,54 @@ TEST_F(TestSubscriptionTopicStatisticsFixture, test_receive_stats_for_message_wi
     check_if_statistic_message_is_populated(msg);
   }
 }
+
+/**
+ * Collect statistics into histograms, from messages received both through the middleware and
+ * intra-process, and check that percentiles are published along with the other statistics.
+ */
+TEST_F(TestSubscriptionTopicStatisticsFixture, test_receive_histogram_stats)
+{
+  for (bool use_intra_process_comms : {false, true}) {
+    const auto node_options =
+      rclcpp::NodeOptions().use_intra_process_comms(use_intra_process_comms);
+    auto msg_with_header_publisher = std::make_shared<MessageWithHeaderPublisher>(
+      kTestPubNodeName,
+      kTestSubStatsTopic,
+      std::chrono::milliseconds{100},
+      node_options);
+
+    auto statistics_listener =
+      std::make_shared<rclcpp::topic_statistics::MetricsMessageSubscriber>(
+      "test_receive_histogram_stats",
+      "/statistics",
+      kNumExpectedMessages);
+
+    auto msg_with_header_subscriber = std::make_shared<MessageWithHeaderSubscriber>(
+      kTestSubNodeName,
+      kTestSubStatsTopic,
+      rclcpp::TopicStatisticsMode::Histogram,
+      node_options);
+
+    rclcpp::executors::SingleThreadedExecutor ex;
+    ex.add_node(msg_with_header_publisher);
+    ex.add_node(statistics_listener);
+    ex.add_node(msg_with_header_subscriber);
+
+    ex.spin_until_future_complete(
+      statistics_listener->GetFuture(),
+      kTestDuration);
+
+    const auto received_messages = statistics_listener->GetReceivedMessages();
+    EXPECT_EQ(kNumExpectedMessages, received_messages.size());
+
+    for (const auto & msg : received_messages) {
+      EXPECT_EQ("ms", msg.unit);
+      std::set<uint8_t> data_types;
+      for (const auto & stats_point : msg.statistics) {
+        data_types.insert(stats_point.data_type);
+      }
+      EXPECT_EQ(1u, data_types.count(StatisticDataType::STATISTICS_DATA_TYPE_PERCENTILE_99_9));
+      check_if_statistic_message_is_populated(msg);
+    }
+  }
+}
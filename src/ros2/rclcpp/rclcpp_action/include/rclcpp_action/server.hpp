@@ -206,6 +206,12 @@ protected:
   void
   publish_status();
 
+  /// Publish the status of the goals after the state of one of them changed.
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  publish_status(const GoalUUID & uuid);
+
   /// \internal
   RCLCPP_ACTION_PUBLIC
   void
@@ -397,7 +403,7 @@ protected:
         // Send result message to anyone that asked
         shared_this->publish_result(uuid, result_message);
         // Publish a status message any time a goal handle changes state
-        shared_this->publish_status();
+        shared_this->publish_status(uuid);
         // notify base so it can recalculate the expired goal timer
         shared_this->notify_goal_terminal_state();
         // Delete data now (ServerBase and rcl_action_server_t keep data until goal handle expires)
@@ -412,9 +418,8 @@ protected:
         if (!shared_this) {
           return;
         }
-        (void)uuid;
         // Publish a status message any time a goal handle changes state
-        shared_this->publish_status();
+        shared_this->publish_status(uuid);
       };
 
     std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)> publish_feedback =
@@ -71,10 +71,139 @@ public:
   // rcl goal handles are kept so api to send result doesn't try to access freed memory
   std::unordered_map<GoalUUID, std::shared_ptr<rcl_action_goal_handle_t>> goal_handles_;
 
+  // Status message reused between publications, guarded by action_server_reentrant_mutex_.
+  // The goals changing state are updated in place, the message being rebuilt from all the goals
+  // of the action server only once some of them expired.
+  action_msgs::msg::GoalStatusArray status_msg_;
+  // Index of each goal in the status list
+  std::unordered_map<GoalUUID, size_t> status_indices_;
+  bool status_msg_stale_ = true;
+
   rclcpp::Logger logger_;
+
+  // Rebuild the status message from all the goals of the action server
+  void
+  rebuild_status_msg();
+
+  // Update the status of one goal in the status message, appending it if it is new
+  void
+  update_status_msg(const GoalUUID & uuid);
+
+  void
+  publish_status_msg();
 };
 }  // namespace rclcpp_action
 
+void
+rclcpp_action::ServerBaseImpl::rebuild_status_msg()
+{
+  rcl_ret_t ret;
+
+  // We need to hold the lock across this entire method because
+  // rcl_action_server_get_goal_handles() returns an internal pointer to the
+  // goal data.
+  std::lock_guard<std::recursive_mutex> lock(action_server_reentrant_mutex_);
+
+  // Get all goal handles known to C action server
+  rcl_action_goal_handle_t ** goal_handles = NULL;
+  size_t num_goals = 0;
+  ret = rcl_action_server_get_goal_handles(action_server_.get(), &goal_handles, &num_goals);
+
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+
+  // Populate the c++ status message directly from the goal handles
+  status_msg_.status_list.resize(num_goals);
+  status_indices_.clear();
+  for (size_t i = 0; i < num_goals; ++i) {
+    rcl_action_goal_info_t goal_info;
+    ret = rcl_action_goal_handle_get_info(goal_handles[i], &goal_info);
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(ret);
+    }
+    rcl_action_goal_state_t goal_status;
+    ret = rcl_action_goal_handle_get_status(goal_handles[i], &goal_status);
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(ret);
+    }
+
+    action_msgs::msg::GoalStatus & msg = status_msg_.status_list[i];
+    msg.status = goal_status;
+    // Convert C goal info to C++ goal info
+    convert(goal_info, &msg.goal_info.goal_id.uuid);
+    msg.goal_info.stamp.sec = goal_info.stamp.sec;
+    msg.goal_info.stamp.nanosec = goal_info.stamp.nanosec;
+    status_indices_[msg.goal_info.goal_id.uuid] = i;
+  }
+  status_msg_stale_ = false;
+}
+
+void
+rclcpp_action::ServerBaseImpl::update_status_msg(const GoalUUID & uuid)
+{
+  // Goal handles are looked up first, as unordered_map_mutex_ must not be locked while holding
+  // action_server_reentrant_mutex_
+  std::shared_ptr<rcl_action_goal_handle_t> goal_handle;
+  {
+    std::lock_guard<std::recursive_mutex> lock(unordered_map_mutex_);
+    auto it = goal_handles_.find(uuid);
+    if (it != goal_handles_.end()) {
+      goal_handle = it->second;
+    }
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(action_server_reentrant_mutex_);
+  if (status_msg_stale_) {
+    rebuild_status_msg();
+    return;
+  }
+  if (!goal_handle) {
+    return;
+  }
+
+  rcl_action_goal_info_t goal_info;
+  rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle.get(), &goal_info);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+  // The goal may have expired since it changed state, its data being gone with it
+  if (!rcl_action_server_goal_exists(action_server_.get(), &goal_info)) {
+    return;
+  }
+  rcl_action_goal_state_t goal_status;
+  ret = rcl_action_goal_handle_get_status(goal_handle.get(), &goal_status);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+
+  auto inserted = status_indices_.emplace(uuid, status_msg_.status_list.size());
+  if (inserted.second) {
+    status_msg_.status_list.emplace_back();
+  }
+  action_msgs::msg::GoalStatus & msg = status_msg_.status_list[inserted.first->second];
+  msg.status = goal_status;
+  msg.goal_info.goal_id.uuid = uuid;
+  msg.goal_info.stamp.sec = goal_info.stamp.sec;
+  msg.goal_info.stamp.nanosec = goal_info.stamp.nanosec;
+}
+
+void
+rclcpp_action::ServerBaseImpl::publish_status_msg()
+{
+  std::lock_guard<std::recursive_mutex> lock(action_server_reentrant_mutex_);
+  if (status_msg_stale_) {
+    rebuild_status_msg();
+  }
+
+  // Publish the message through the status publisher
+  rcl_ret_t ret = rcl_action_publish_status(action_server_.get(), &status_msg_);
+
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+}
+
 ServerBase::ServerBase(
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base,
   rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock,
@@ -312,7 +441,7 @@ ServerBase::execute_goal_request_received()
       }
     }
     // publish status since a goal's state has changed (was accepted or has begun execution)
-    publish_status();
+    publish_status(uuid);
 
     // Tell user to start executing action
     call_goal_accepted_callback(handle, uuid, message);
@@ -406,7 +535,10 @@ ServerBase::execute_cancel_request_received()
 
   if (!response->goals_canceling.empty()) {
     // at least one goal state changed, publish a new status message
-    publish_status();
+    for (const auto & goal_info : response->goals_canceling) {
+      pimpl_->update_status_msg(goal_info.goal_id.uuid);
+    }
+    pimpl_->publish_status_msg();
   }
 
   {
@@ -497,6 +629,10 @@ ServerBase::execute_check_expired_goals()
     {
       std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
       ret = rcl_action_expire_goals(pimpl_->action_server_.get(), expired_goals, 1, &num_expired);
+      if (num_expired) {
+        // Expired goals are dropped from the status message at its next publication
+        pimpl_->status_msg_stale_ = true;
+      }
     }
     if (RCL_RET_OK != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret);
@@ -516,60 +652,16 @@ ServerBase::execute_check_expired_goals()
 void
 ServerBase::publish_status()
 {
-  rcl_ret_t ret;
-
-  // We need to hold the lock across this entire method because
-  // rcl_action_server_get_goal_handles() returns an internal pointer to the
-  // goal data.
   std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+  pimpl_->rebuild_status_msg();
+  pimpl_->publish_status_msg();
+}
 
-  // Get all goal handles known to C action server
-  rcl_action_goal_handle_t ** goal_handles = NULL;
-  size_t num_goals = 0;
-  ret = rcl_action_server_get_goal_handles(
-    pimpl_->action_server_.get(), &goal_handles, &num_goals);
-
-  if (RCL_RET_OK != ret) {
-    rclcpp::exceptions::throw_from_rcl_error(ret);
-  }
-
-  auto status_msg = std::make_shared<action_msgs::msg::GoalStatusArray>();
-  status_msg->status_list.reserve(num_goals);
-  // Populate a c++ status message with the goals and their statuses
-  rcl_action_goal_status_array_t c_status_array =
-    rcl_action_get_zero_initialized_goal_status_array();
-  ret = rcl_action_get_goal_status_array(pimpl_->action_server_.get(), &c_status_array);
-  if (RCL_RET_OK != ret) {
-    rclcpp::exceptions::throw_from_rcl_error(ret);
-  }
-
-  RCLCPP_SCOPE_EXIT(
-  {
-    ret = rcl_action_goal_status_array_fini(&c_status_array);
-    if (RCL_RET_OK != ret) {
-      RCLCPP_ERROR(pimpl_->logger_, "Failed to fini status array message");
-    }
-  });
-
-  for (size_t i = 0; i < c_status_array.msg.status_list.size; ++i) {
-    auto & c_status_msg = c_status_array.msg.status_list.data[i];
-
-    action_msgs::msg::GoalStatus msg;
-    msg.status = c_status_msg.status;
-    // Convert C goal info to C++ goal info
-    convert(c_status_msg.goal_info, &msg.goal_info.goal_id.uuid);
-    msg.goal_info.stamp.sec = c_status_msg.goal_info.stamp.sec;
-    msg.goal_info.stamp.nanosec = c_status_msg.goal_info.stamp.nanosec;
-
-    status_msg->status_list.push_back(msg);
-  }
-
-  // Publish the message through the status publisher
-  ret = rcl_action_publish_status(pimpl_->action_server_.get(), status_msg.get());
-
-  if (RCL_RET_OK != ret) {
-    rclcpp::exceptions::throw_from_rcl_error(ret);
-  }
+void
+ServerBase::publish_status(const GoalUUID & uuid)
+{
+  pimpl_->update_status_msg(uuid);
+  pimpl_->publish_status_msg();
 }
 
 void
@@ -710,6 +710,94 @@ TEST_F(TestServer, publish_status_succeeded)
   EXPECT_EQ(uuid, msg->status_list.at(0).goal_info.goal_id.uuid);
 }
 
+TEST_F(TestServer, publish_status_several_goals)
+{
+  auto node = std::make_shared<rclcpp::Node>("status_several", "/rclcpp_action/status_several");
+  const GoalUUID uuid1{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+  const GoalUUID uuid2{{2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+  const GoalUUID uuid3{{3, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+
+  auto handle_goal = [](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  std::vector<std::shared_ptr<GoalHandle>> received_handles;
+  auto handle_accepted = [&received_handles](std::shared_ptr<GoalHandle> handle)
+    {
+      received_handles.push_back(handle);
+    };
+
+  const std::chrono::milliseconds result_timeout{50};
+
+  rcl_action_server_options_t options = rcl_action_server_get_default_options();
+  options.result_timeout.nanoseconds = RCL_MS_TO_NS(result_timeout.count());
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    handle_goal,
+    handle_cancel,
+    handle_accepted,
+    options);
+  (void)as;
+
+  // Subscribe to status messages
+  std::vector<action_msgs::msg::GoalStatusArray::SharedPtr> received_msgs;
+  auto subscriber = node->create_subscription<action_msgs::msg::GoalStatusArray>(
+    "fibonacci/_action/status", 10,
+    [&received_msgs](action_msgs::msg::GoalStatusArray::SharedPtr list)
+    {
+      received_msgs.push_back(list);
+    });
+
+  auto wait_for_status = [&](size_t num_msgs) {
+      // 10 seconds
+      const size_t max_tries = 10 * 1000 / 100;
+      for (size_t retry = 0; retry < max_tries && received_msgs.size() < num_msgs; ++retry) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        rclcpp::spin_some(node);
+      }
+    };
+
+  send_goal_request(node, uuid1);
+  send_goal_request(node, uuid2);
+  ASSERT_EQ(2u, received_handles.size());
+  received_handles[0]->succeed(std::make_shared<Fibonacci::Result>());
+  received_handles[1]->abort(std::make_shared<Fibonacci::Result>());
+  // One status message per goal acceptance and per terminal state
+  wait_for_status(4u);
+
+  // Goals keep the order they were accepted in, each one with its last state
+  ASSERT_EQ(4u, received_msgs.size());
+  auto msg = received_msgs.back();
+  ASSERT_EQ(2u, msg->status_list.size());
+  EXPECT_EQ(uuid1, msg->status_list.at(0).goal_info.goal_id.uuid);
+  EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_SUCCEEDED, msg->status_list.at(0).status);
+  EXPECT_EQ(uuid2, msg->status_list.at(1).goal_info.goal_id.uuid);
+  EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_ABORTED, msg->status_list.at(1).status);
+
+  // Wait for the expiration of the terminated goals
+  rclcpp::sleep_for(2 * result_timeout);
+  rclcpp::spin_some(node);
+
+  // The expired goals are no longer published
+  received_msgs.clear();
+  send_goal_request(node, uuid3);
+  wait_for_status(1u);
+  ASSERT_LT(0u, received_msgs.size());
+  msg = received_msgs.back();
+  ASSERT_EQ(1u, msg->status_list.size());
+  EXPECT_EQ(uuid3, msg->status_list.at(0).goal_info.goal_id.uuid);
+  EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_EXECUTING, msg->status_list.at(0).status);
+}
+
 TEST_F(TestServer, publish_status_aborted)
 {
   auto node = std::make_shared<rclcpp::Node>("status_aborted", "/rclcpp_action/status_aborted");
@@ -1155,10 +1243,10 @@ TEST_F(TestGoalRequestServer, publish_status_server_get_goal_handles_errors)
   EXPECT_THROW(SendClientGoalRequest(), rclcpp::exceptions::RCLError);
 }
 
-TEST_F(TestGoalRequestServer, publish_status_get_goal_status_array_errors)
+TEST_F(TestGoalRequestServer, publish_status_goal_handle_get_info_errors)
 {
   auto mock = mocking_utils::patch_and_return(
-    "lib:rclcpp_action", rcl_action_get_goal_status_array, RCL_RET_ERROR);
+    "lib:rclcpp_action", rcl_action_goal_handle_get_info, RCL_RET_ERROR);
 
   EXPECT_THROW(SendClientGoalRequest(), rclcpp::exceptions::RCLError);
 }
@@ -212,7 +212,8 @@ public:
    * \param[in] callback The user-defined callback function.
    * \param[in] qos The quality of service for this subscription.
    * \param[in] options The subscription options for this subscription.
-   * \param[in] msg_mem_strat The message memory strategy to use for allocating messages.
+   * \param[in] msg_mem_strat The message memory strategy to use for allocating messages,
+   *   nullptr to pick it from the options.
    * \return Shared pointer to the created subscription.
    */
   template<
@@ -233,9 +234,7 @@ public:
     CallbackT && callback,
     const SubscriptionOptionsWithAllocator<AllocatorT> & options =
     create_default_subscription_options<AllocatorT>(),
-    typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = (
-      MessageMemoryStrategyT::create_default()
-    )
+    typename MessageMemoryStrategyT::SharedPtr msg_mem_strat = nullptr
   );
 
   /// Create a timer.
@@ -256,6 +256,9 @@ void rcutils_logging_set_output_handler(rcutils_logging_output_handler_t functio
 /**
  * A formatter that is meant to be used by an output handler to format a log message to the match
  * the format specified in RCUTILS_CONSOLE_OUTPUT_FORMAT by performing token replacement.
+ * The format is parsed once by rcutils_logging_initialize() into a sequence of literals and
+ * tokens, so that formatting a message only copies the expanded tokens into the output buffer.
+ * The output buffer is only reallocated when it is too small for the formatted message.
  *
  * <hr>
  * Attribute          | Adherence
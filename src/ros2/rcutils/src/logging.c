@@ -91,6 +91,9 @@ static const char * g_rcutils_logging_default_output_format =
 
 static rcutils_allocator_t g_rcutils_logging_allocator;
 
+// Compile g_rcutils_logging_output_format_string, so that it isn't parsed for every message.
+static void compile_output_format(void);
+
 rcutils_logging_output_handler_t g_rcutils_logging_output_handler = NULL;
 static rcutils_string_map_t g_rcutils_logging_severities_map;
 
@@ -276,6 +279,8 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
         strlen(g_rcutils_logging_default_output_format) + 1);
     }
 
+    compile_output_format();
+
     g_rcutils_logging_severities_map = rcutils_get_zero_initialized_string_map();
     rcutils_ret_t string_map_ret = rcutils_string_map_init(
       &g_rcutils_logging_severities_map, 0, g_rcutils_logging_allocator);
@@ -521,26 +526,6 @@ bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
   }
   return severity >= logger_level;
 }
-#define SAFE_FWRITE_TO_STDERR_AND(action) \
-  RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str); \
-  rcutils_reset_error(); \
-  RCUTILS_SAFE_FWRITE_TO_STDERR("\n"); \
-  action;
-
-#define OK_OR_RETURN_NULL(op) \
-  if (op != RCUTILS_RET_OK) { \
-    SAFE_FWRITE_TO_STDERR_AND(return NULL); \
-  }
-
-#define OK_OR_RETURN_EARLY(op) \
-  if (op != RCUTILS_RET_OK) { \
-    return op; \
-  }
-
-#define APPEND_AND_RETURN_LOG_OUTPUT(s) \
-  OK_OR_RETURN_NULL(rcutils_char_array_strcat(logging_output, s)); \
-  return logging_output->buffer;
-
 
 void rcutils_log(
   const rcutils_log_location_t * location,
@@ -564,142 +549,243 @@ void rcutils_log(
   }
 }
 
-typedef struct logging_input
+typedef enum rcutils_logging_format_op_kind
 {
-  const char * name;
-  const rcutils_log_location_t * location;
-  const char * msg;
-  int severity;
-  rcutils_time_point_value_t timestamp;
-} logging_input;
-
-typedef const char * (* token_handler)(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output);
+  RCUTILS_LOGGING_FORMAT_OP_LITERAL,
+  RCUTILS_LOGGING_FORMAT_OP_SEVERITY,
+  RCUTILS_LOGGING_FORMAT_OP_NAME,
+  RCUTILS_LOGGING_FORMAT_OP_MESSAGE,
+  RCUTILS_LOGGING_FORMAT_OP_FUNCTION_NAME,
+  RCUTILS_LOGGING_FORMAT_OP_FILE_NAME,
+  RCUTILS_LOGGING_FORMAT_OP_TIME,
+  RCUTILS_LOGGING_FORMAT_OP_TIME_AS_NANOSECONDS,
+  RCUTILS_LOGGING_FORMAT_OP_LINE_NUMBER,
+} rcutils_logging_format_op_kind;
+
+typedef struct rcutils_logging_format_op
+{
+  rcutils_logging_format_op_kind kind;
+  // Literal ops only: characters of the output format string to copy
+  uint16_t offset;
+  uint16_t length;
+} rcutils_logging_format_op;
 
 typedef struct token_map_entry
 {
   const char * token;
-  token_handler handler;
+  rcutils_logging_format_op_kind kind;
 } token_map_entry;
 
-const char * expand_time(
-  const logging_input * logging_input, rcutils_char_array_t * logging_output,
-  rcutils_ret_t (* time_func)(const rcutils_time_point_value_t *, char *, size_t))
-{
-  // Temporary, local storage for integer/float conversion to string
-  // Note:
-  //   32 characters enough, because the most it can be is 20 characters
-  //   for the 19 possible digits in a signed 64-bit number plus the optional
-  //   decimal point in the floating point seconds version
-  char numeric_storage[32];
-  OK_OR_RETURN_NULL(time_func(&logging_input->timestamp, numeric_storage, sizeof(numeric_storage)));
-  APPEND_AND_RETURN_LOG_OUTPUT(numeric_storage);
-}
+static const token_map_entry tokens[] = {
+  {.token = "severity", .kind = RCUTILS_LOGGING_FORMAT_OP_SEVERITY},
+  {.token = "name", .kind = RCUTILS_LOGGING_FORMAT_OP_NAME},
+  {.token = "message", .kind = RCUTILS_LOGGING_FORMAT_OP_MESSAGE},
+  {.token = "function_name", .kind = RCUTILS_LOGGING_FORMAT_OP_FUNCTION_NAME},
+  {.token = "file_name", .kind = RCUTILS_LOGGING_FORMAT_OP_FILE_NAME},
+  {.token = "time", .kind = RCUTILS_LOGGING_FORMAT_OP_TIME},
+  {.token = "time_as_nanoseconds", .kind = RCUTILS_LOGGING_FORMAT_OP_TIME_AS_NANOSECONDS},
+  {.token = "line_number", .kind = RCUTILS_LOGGING_FORMAT_OP_LINE_NUMBER},
+};
 
-const char * expand_time_as_seconds(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
-{
-  return expand_time(logging_input, logging_output, rcutils_time_point_value_as_seconds_string);
-}
+// The output format string compiled into a list of ops, by compile_output_format().
+// Every op stands for at least one character of the format string, whose length fits in 16 bits.
+static rcutils_logging_format_op g_rcutils_logging_format_ops[RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN];
+static size_t g_rcutils_logging_format_op_count = 0;
 
-const char * expand_time_as_nanoseconds(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+static void add_literal_op(size_t offset, size_t length)
 {
-  return expand_time(logging_input, logging_output, rcutils_time_point_value_as_nanoseconds_string);
+  if (0u == length) {
+    return;
+  }
+  if (g_rcutils_logging_format_op_count > 0u) {
+    rcutils_logging_format_op * last =
+      &g_rcutils_logging_format_ops[g_rcutils_logging_format_op_count - 1u];
+    if (RCUTILS_LOGGING_FORMAT_OP_LITERAL == last->kind &&
+      (size_t)last->offset + last->length == offset)
+    {
+      last->length = (uint16_t)(last->length + length);
+      return;
+    }
+  }
+  rcutils_logging_format_op op = {
+    .kind = RCUTILS_LOGGING_FORMAT_OP_LITERAL, .offset = (uint16_t)offset,
+    .length = (uint16_t)length};
+  g_rcutils_logging_format_ops[g_rcutils_logging_format_op_count++] = op;
 }
 
-const char * expand_line_number(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+static void compile_output_format(void)
 {
-  // Allow 9 digits for the expansion of the line number (otherwise, truncate).
-  char line_number_expansion[10];
+  const char token_start_delimiter = '{';
+  const char token_end_delimiter = '}';
 
-  const rcutils_log_location_t * location = logging_input->location;
+  const char * str = g_rcutils_logging_output_format_string;
+  size_t size = strlen(g_rcutils_logging_output_format_string);
+  g_rcutils_logging_format_op_count = 0u;
 
-  if (!location) {
-    OK_OR_RETURN_NULL(rcutils_char_array_strcpy(logging_output, "0"));
-    return logging_output->buffer;
-  }
+  // Walk through the format string looking for known tokens, the rest is copied as is.
+  size_t i = 0;
+  while (i < size) {
+    size_t chars_to_start_delim = rcutils_find(str + i, token_start_delimiter);
+    if (chars_to_start_delim >= size - i) {
+      add_literal_op(i, size - i);
+      break;
+    }
+    add_literal_op(i, chars_to_start_delim);
+    i += chars_to_start_delim;
 
-  // Even in the case of truncation the result will still be null-terminated.
-  int written = rcutils_snprintf(
-    line_number_expansion, sizeof(line_number_expansion), "%zu", location->line_number);
-  if (written < 0) {
-    fprintf(stderr, "failed to format line number: '%zu'\n", location->line_number);
-    return NULL;
-  }
+    size_t chars_to_end_delim = rcutils_find(str + i, token_end_delimiter);
+    if (chars_to_end_delim >= size - i) {
+      // No end delimiters found in the remainder of the format string, so no more tokens.
+      add_literal_op(i, size - i);
+      break;
+    }
 
-  APPEND_AND_RETURN_LOG_OUTPUT(line_number_expansion);
+    size_t token_len = chars_to_end_delim - 1;  // Not including delimiters.
+    const token_map_entry * entry = NULL;
+    for (size_t t = 0; t < sizeof(tokens) / sizeof(tokens[0]); ++t) {
+      if (strlen(tokens[t].token) == token_len &&
+        strncmp(str + i + 1, tokens[t].token, token_len) == 0)
+      {
+        entry = &tokens[t];
+        break;
+      }
+    }
+
+    if (NULL == entry) {
+      // This wasn't a token; copy the start delimiter and continue the search as usual
+      // (the substring might contain more start delimiters).
+      add_literal_op(i, 1);
+      i++;
+      continue;
+    }
+
+    rcutils_logging_format_op op = {.kind = entry->kind, .offset = 0u, .length = 0u};
+    g_rcutils_logging_format_ops[g_rcutils_logging_format_op_count++] = op;
+    // Skip ahead to avoid re-processing the token characters (including the 2 delimiters).
+    i += token_len + 2;
+  }
 }
 
-const char * expand_severity(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+// Append characters to the formatted output, whose length is tracked by the caller.
+static rcutils_ret_t append_to_output(
+  rcutils_char_array_t * logging_output, size_t * length, const char * src, size_t n)
 {
-  const char * severity_string = g_rcutils_log_severity_names[logging_input->severity];
-  APPEND_AND_RETURN_LOG_OUTPUT(severity_string);
+  rcutils_ret_t status = rcutils_char_array_expand_as_needed(logging_output, *length + n + 1);
+  if (RCUTILS_RET_OK != status) {
+    return status;
+  }
+  memcpy(logging_output->buffer + *length, src, n);
+  *length += n;
+  logging_output->buffer[*length] = '\0';
+  logging_output->buffer_length = *length + 1;
+  return RCUTILS_RET_OK;
 }
 
-const char * expand_name(const logging_input * logging_input, rcutils_char_array_t * logging_output)
+// Write the decimal digits of a value, zero padded to a minimum count, and return their count.
+static size_t format_decimal(uint64_t value, size_t min_digits, char * str)
 {
-  if (NULL != logging_input->name) {
-    APPEND_AND_RETURN_LOG_OUTPUT(logging_input->name);
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[count++] = (char)('0' + value % 10u);
+    value /= 10u;
+  } while (value != 0u);
+  size_t length = 0;
+  for (; length + count < min_digits; ++length) {
+    str[length] = '0';
+  }
+  while (count > 0u) {
+    str[length++] = digits[--count];
   }
-  return logging_output->buffer;
+  return length;
 }
 
-const char * expand_message(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+// Seconds part of a formatted timestamp, "%.10" PRId64 "." with an optional minus sign.
+typedef struct rcutils_logging_time_prefix
 {
-  OK_OR_RETURN_NULL(rcutils_char_array_strcat(logging_output, logging_input->msg));
-  return logging_output->buffer;
-}
+  bool valid;
+  bool negative;
+  uint64_t seconds;
+  size_t length;
+  char str[24];
+} rcutils_logging_time_prefix;
+
+#ifdef RCUTILS_THREAD_LOCAL
+// Consecutive log calls of a thread mostly happen during the same second,
+// so only the nanoseconds of their timestamps need to be formatted.
+static RCUTILS_THREAD_LOCAL rcutils_logging_time_prefix gtls_rcutils_logging_time_prefix;
+#endif
 
-const char * expand_function_name(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+static rcutils_ret_t append_time_as_seconds(
+  rcutils_time_point_value_t timestamp, rcutils_char_array_t * logging_output, size_t * length)
 {
-  if (logging_input->location) {
-    APPEND_AND_RETURN_LOG_OUTPUT(logging_input->location->function_name);
+#ifdef RCUTILS_THREAD_LOCAL
+  rcutils_logging_time_prefix * prefix = &gtls_rcutils_logging_time_prefix;
+#else
+  rcutils_logging_time_prefix local_prefix = {.valid = false};
+  rcutils_logging_time_prefix * prefix = &local_prefix;
+#endif
+  // best to abs it to avoid issues with negative values in C89, see:
+  //   https://stackoverflow.com/a/3604984/671658
+  uint64_t abs_timestamp = (uint64_t)llabs(timestamp);
+  uint64_t seconds = abs_timestamp / (1000u * 1000u * 1000u);
+  uint64_t nanoseconds = abs_timestamp % (1000u * 1000u * 1000u);
+  bool negative = timestamp < 0;
+
+  if (!prefix->valid || prefix->seconds != seconds || prefix->negative != negative) {
+    size_t prefix_length = 0;
+    if (negative) {
+      prefix->str[prefix_length++] = '-';
+    }
+    prefix_length += format_decimal(seconds, 10u, prefix->str + prefix_length);
+    prefix->str[prefix_length++] = '.';
+    prefix->length = prefix_length;
+    prefix->seconds = seconds;
+    prefix->negative = negative;
+    prefix->valid = true;
   }
-  return logging_output->buffer;
+
+  rcutils_ret_t status = append_to_output(logging_output, length, prefix->str, prefix->length);
+  if (RCUTILS_RET_OK != status) {
+    return status;
+  }
+  char nanoseconds_str[9];
+  format_decimal(nanoseconds, 9u, nanoseconds_str);
+  return append_to_output(logging_output, length, nanoseconds_str, sizeof(nanoseconds_str));
 }
 
-const char * expand_file_name(
-  const logging_input * logging_input,
-  rcutils_char_array_t * logging_output)
+static rcutils_ret_t append_time_as_nanoseconds(
+  rcutils_time_point_value_t timestamp, rcutils_char_array_t * logging_output, size_t * length)
 {
-  if (logging_input->location) {
-    APPEND_AND_RETURN_LOG_OUTPUT(logging_input->location->file_name);
+  // Same as "%.19" PRId64
+  char str[21];
+  size_t str_length = 0;
+  if (timestamp < 0) {
+    str[str_length++] = '-';
   }
-  return logging_output->buffer;
+  str_length += format_decimal((uint64_t)llabs(timestamp), 19u, str + str_length);
+  return append_to_output(logging_output, length, str, str_length);
 }
 
-static const token_map_entry tokens[] = {
-  {.token = "severity", .handler = expand_severity},
-  {.token = "name", .handler = expand_name},
-  {.token = "message", .handler = expand_message},
-  {.token = "function_name", .handler = expand_function_name},
-  {.token = "file_name", .handler = expand_file_name},
-  {.token = "time", .handler = expand_time_as_seconds},
-  {.token = "time_as_nanoseconds", .handler = expand_time_as_nanoseconds},
-  {.token = "line_number", .handler = expand_line_number},
-};
+static rcutils_ret_t append_line_number(
+  const rcutils_log_location_t * location, rcutils_char_array_t * logging_output, size_t * length)
+{
+  if (!location) {
+    return append_to_output(logging_output, length, "0", 1);
+  }
+  // Allow 9 digits for the expansion of the line number (otherwise, truncate).
+  char str[20];
+  size_t str_length = format_decimal(location->line_number, 0u, str);
+  return append_to_output(logging_output, length, str, str_length > 9u ? 9u : str_length);
+}
 
-token_handler find_token_handler(const char * token)
+static rcutils_ret_t append_string(
+  const char * str, rcutils_char_array_t * logging_output, size_t * length)
 {
-  int token_number = sizeof(tokens) / sizeof(tokens[0]);
-  for (int token_index = 0; token_index < token_number; token_index++) {
-    if (strcmp(token, tokens[token_index].token) == 0) {
-      return tokens[token_index].handler;
-    }
+  if (NULL == str) {
+    return RCUTILS_RET_OK;
   }
-  return NULL;
+  return append_to_output(logging_output, length, str, strlen(str));
 }
 
 rcutils_ret_t rcutils_logging_format_message(
@@ -708,76 +794,48 @@ rcutils_ret_t rcutils_logging_format_message(
   const char * msg, rcutils_char_array_t * logging_output)
 {
   rcutils_ret_t status = RCUTILS_RET_OK;
-  // Process the format string looking for known tokens.
-  const char token_start_delimiter = '{';
-  const char token_end_delimiter = '}';
-
-  const char * str = g_rcutils_logging_output_format_string;
-  size_t size = strlen(g_rcutils_logging_output_format_string);
-
-  const logging_input logging_input = {
-    .location = location,
-    .severity = severity,
-    .name = name,
-    .timestamp = timestamp,
-    .msg = msg
-  };
-
-  // Walk through the format string and expand tokens when they're encountered.
-  size_t i = 0;
-  while (i < size) {
-    // Print everything up to the next token start delimiter.
-    size_t chars_to_start_delim = rcutils_find(str + i, token_start_delimiter);
-    size_t remaining_chars = size - i;
-
-    if (chars_to_start_delim > 0) {  // there are stuff before a token start delimiter
-      size_t chars_to_copy = chars_to_start_delim >
-        remaining_chars ? remaining_chars : chars_to_start_delim;
-      status = rcutils_char_array_strncat(logging_output, str + i, chars_to_copy);
-      OK_OR_RETURN_EARLY(status);
-      i += chars_to_copy;
-      if (i >= size) {  // perhaps no start delimiter was found
+  size_t length = strlen(logging_output->buffer);
+
+  for (size_t i = 0; i < g_rcutils_logging_format_op_count && RCUTILS_RET_OK == status; ++i) {
+    const rcutils_logging_format_op * op = &g_rcutils_logging_format_ops[i];
+    switch (op->kind) {
+      case RCUTILS_LOGGING_FORMAT_OP_LITERAL:
+        status = append_to_output(
+          logging_output, &length, g_rcutils_logging_output_format_string + op->offset,
+          op->length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_SEVERITY:
+        status = append_string(g_rcutils_log_severity_names[severity], logging_output, &length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_NAME:
+        status = append_string(name, logging_output, &length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_MESSAGE:
+        status = append_string(msg, logging_output, &length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_FUNCTION_NAME:
+        if (location) {
+          status = append_string(location->function_name, logging_output, &length);
+        }
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_FILE_NAME:
+        if (location) {
+          status = append_string(location->file_name, logging_output, &length);
+        }
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_TIME:
+        status = append_time_as_seconds(timestamp, logging_output, &length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_TIME_AS_NANOSECONDS:
+        status = append_time_as_nanoseconds(timestamp, logging_output, &length);
+        break;
+      case RCUTILS_LOGGING_FORMAT_OP_LINE_NUMBER:
+        status = append_line_number(location, logging_output, &length);
+        break;
+      default:
+        status = RCUTILS_RET_ERROR;
         break;
-      }
-    }
-
-    // We are at a token start delimiter: determine if there's a known token or not.
-    // Potential tokens can't possibly be longer than the format string itself.
-    char token[RCUTILS_LOGGING_MAX_OUTPUT_FORMAT_LEN];
-
-    // Look for a token end delimiter.
-    size_t chars_to_end_delim = rcutils_find(str + i, token_end_delimiter);
-    remaining_chars = size - i;
-
-    if (chars_to_end_delim > remaining_chars) {
-      // No end delimiters found in the remainder of the format string;
-      // there won't be any more tokens so shortcut the rest of the checking.
-      status = rcutils_char_array_strncat(logging_output, str + i, remaining_chars);
-      OK_OR_RETURN_EARLY(status);
-      break;
-    }
-
-    // Found what looks like a token; determine if it's recognized.
-    size_t token_len = chars_to_end_delim - 1;  // Not including delimiters.
-    memcpy(token, str + i + 1, token_len);  // Skip the start delimiter.
-    token[token_len] = '\0';
-
-    token_handler expand_token = find_token_handler(token);
-
-    if (!expand_token) {
-      // This wasn't a token; print the start delimiter and continue the search as usual
-      // (the substring might contain more start delimiters).
-      status = rcutils_char_array_strncat(logging_output, str + i, 1);
-      OK_OR_RETURN_EARLY(status);
-      i++;
-      continue;
-    }
-
-    if (!expand_token(&logging_input, logging_output)) {
-      return RCUTILS_RET_ERROR;
     }
-    // Skip ahead to avoid re-processing the token characters (including the 2 delimiters).
-    i += token_len + 2;
   }
 
   return status;
@@ -898,6 +956,16 @@ rcutils_ret_t rcutils_logging_format_message(
 # define SET_STANDARD_COLOR_IN_STREAM(is_colorized, status)
 #endif
 
+// Size of the buffers the console output handler formats messages into, before allocating.
+#define RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE (1024)
+
+#ifdef RCUTILS_THREAD_LOCAL
+// Buffers of the console output handler, reused by all the log calls of a thread.
+static RCUTILS_THREAD_LOCAL char gtls_rcutils_logging_msg_buf[RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE];
+static RCUTILS_THREAD_LOCAL char
+  gtls_rcutils_logging_output_buf[RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE];
+#endif
+
 void rcutils_logging_console_output_handler(
   const rcutils_log_location_t * location,
   int severity, const char * name, rcutils_time_point_value_t timestamp,
@@ -927,21 +995,28 @@ void rcutils_logging_console_output_handler(
 
   IS_OUTPUT_COLORIZED(is_colorized)
 
-  char msg_buf[1024] = "";
+#ifdef RCUTILS_THREAD_LOCAL
+  char * msg_buf = gtls_rcutils_logging_msg_buf;
+  char * output_buf = gtls_rcutils_logging_output_buf;
+#else
+  char msg_buf[RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE];
+  char output_buf[RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE];
+#endif
+  msg_buf[0] = '\0';
   rcutils_char_array_t msg_array = {
     .buffer = msg_buf,
     .owns_buffer = false,
     .buffer_length = 0u,
-    .buffer_capacity = sizeof(msg_buf),
+    .buffer_capacity = RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE,
     .allocator = g_rcutils_logging_allocator
   };
 
-  char output_buf[1024] = "";
+  output_buf[0] = '\0';
   rcutils_char_array_t output_array = {
     .buffer = output_buf,
     .owns_buffer = false,
     .buffer_length = 0u,
-    .buffer_capacity = sizeof(output_buf),
+    .buffer_capacity = RCUTILS_LOGGING_CONSOLE_BUFFER_SIZE,
     .allocator = g_rcutils_logging_allocator
   };
 
@@ -0,0 +1,86 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/env.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/logging.h"
+#include "rcutils/types/char_array.h"
+
+using performance_test_fixture::PerformanceTest;
+
+constexpr const char kAllTokensFormat[] =
+  "[{severity}] [{time}] [{time_as_nanoseconds}] [{name}]: {message} "
+  "({function_name}() at {file_name}:{line_number})";
+
+class LoggingPerformanceTest : public PerformanceTest
+{
+protected:
+  void format_messages(benchmark::State & st, const char * output_format)
+  {
+    if (!rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", output_format)) {
+      st.SkipWithError("Failed to set the output format");
+      return;
+    }
+    if (RCUTILS_RET_OK != rcutils_logging_initialize()) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+      return;
+    }
+
+    char buffer[1024];
+    rcutils_char_array_t output = rcutils_get_zero_initialized_char_array();
+    output.buffer = buffer;
+    output.buffer_capacity = sizeof(buffer);
+    output.owns_buffer = false;
+    output.allocator = rcutils_get_default_allocator();
+
+    const rcutils_log_location_t location = {"format_messages", __FILE__, __LINE__};
+    rcutils_time_point_value_t timestamp = 1600000000123456789LL;
+
+    reset_heap_counters();
+
+    for (auto _ : st) {
+      buffer[0] = '\0';
+      rcutils_ret_t ret = rcutils_logging_format_message(
+        &location, RCUTILS_LOG_SEVERITY_INFO, "benchmark.logger", timestamp++,
+        "The quick brown fox jumps over the lazy dog", &output);
+      if (RCUTILS_RET_OK != ret) {
+        st.SkipWithError(rcutils_get_error_string().str);
+        rcutils_reset_error();
+        break;
+      }
+      benchmark::DoNotOptimize(buffer);
+      benchmark::ClobberMemory();
+    }
+    st.SetItemsProcessed(st.iterations());
+
+    if (RCUTILS_RET_OK != rcutils_logging_shutdown()) {
+      st.SkipWithError(rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+};
+
+BENCHMARK_F(LoggingPerformanceTest, format_message_default)(benchmark::State & st)
+{
+  format_messages(st, "");
+}
+
+BENCHMARK_F(LoggingPerformanceTest, format_message_all_tokens)(benchmark::State & st)
+{
+  format_messages(st, kAllTokensFormat);
+}
@@ -53,6 +53,21 @@ struct rttest_results
   size_t major_pagefaults;
 };
 
+/// Latency distribution, read from the histograms of recorded latencies.
+/// Percentiles are exact below 256 ns and rounded up by less than 1% above.
+struct rttest_latency_percentiles
+{
+  // Number of latencies recorded
+  size_t samples;
+  int64_t min_latency;
+  int64_t max_latency;
+  int64_t p50_latency;
+  int64_t p90_latency;
+  int64_t p99_latency;
+  int64_t p999_latency;
+  int64_t p9999_latency;
+};
+
 /// \brief Initialize rttest with arguments
 /// \param[in] argc Size of argument vector
 /// \param[out] argv Argument vector
@@ -174,6 +189,34 @@ int rttest_calculate_statistics(struct rttest_results * results);
 /// \brief Get accumulated statistics
 int rttest_get_statistics(struct rttest_results * results);
 
+/// \brief Record a latency measured by the caller, e.g. the wake-up latency of
+/// an executor callback or the round trip time of a message.
+/// The latency is added to the histogram and the statistics of the calling
+/// thread, which gets its own rttest instance on its first call if it has none,
+/// with the parameters of the thread that called rttest_init.
+/// Only allocates on the first call of a thread.
+/// \param[in] latency Latency in nanoseconds, negative if the event was early
+/// \return Error code to propagate to main
+int rttest_record_latency(int64_t latency);
+
+/// \brief Record the latency of a wakeup that was scheduled for the given time.
+/// \param[in] deadline Time the thread was supposed to wake up, read from
+/// CLOCK_MONOTONIC
+/// \return Error code to propagate to main
+int rttest_record_wakeup_latency(const struct timespec * deadline);
+
+/// \brief Get the latency percentiles of the calling thread.
+/// \param[out] percentiles The struct to fill in
+/// \return Error code if no latency was recorded
+int rttest_get_latency_percentiles(struct rttest_latency_percentiles * percentiles);
+
+/// \brief Get the latency percentiles of all threads combined.
+/// Can be called from any thread while the other threads keep recording,
+/// to monitor a running test.
+/// \param[out] percentiles The struct to fill in
+/// \return Error code if no latency was recorded
+int rttest_get_aggregate_latency_percentiles(struct rttest_latency_percentiles * percentiles);
+
 /// \brief Get latency sample at the given iteration.
 /// \param[in] iteration Iteration of the test to get the sample from
 /// \param[out] The resulting sample: time in nanoseconds between the expected
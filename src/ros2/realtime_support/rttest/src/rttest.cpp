@@ -23,6 +23,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <cmath>
@@ -30,6 +31,8 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -120,21 +123,176 @@ public:
   size_t buffer_size;
 };
 
+/// Log-linear histogram of latencies, using a fixed amount of memory whatever the test duration.
+/**
+ * Latencies are counted in buckets whose width doubles every 2^sub_bucket_bits buckets,
+ * so that values below 2^(sub_bucket_bits + 1) ns are exact and larger ones are rounded
+ * by less than 2^-sub_bucket_bits.
+ * Early (negative) and late latencies have separate buckets.
+ *
+ * A single thread records into a histogram while any thread may read it.
+ */
+class rttest_latency_histogram
+{
+public:
+  static constexpr size_t sub_bucket_bits = 7;
+  static constexpr size_t sub_bucket_count = 1u << sub_bucket_bits;
+  // Buckets for the magnitudes of the latencies of one sign, covering all 64 bit values
+  static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+  rttest_latency_histogram()
+  : counts(new std::atomic<uint64_t>[2 * bucket_count])
+  {
+    reset();
+  }
+
+  rttest_latency_histogram(const rttest_latency_histogram & other)
+  : rttest_latency_histogram()
+  {
+    *this = other;
+  }
+
+  void operator=(const rttest_latency_histogram & other)
+  {
+    for (size_t i = 0; i < 2 * bucket_count; ++i) {
+      this->counts[i].store(other.counts[i].load(std::memory_order_relaxed));
+    }
+    this->min_latency.store(other.min_latency.load(std::memory_order_relaxed));
+    this->max_latency.store(other.max_latency.load(std::memory_order_relaxed));
+  }
+
+  void reset()
+  {
+    for (size_t i = 0; i < 2 * bucket_count; ++i) {
+      this->counts[i].store(0, std::memory_order_relaxed);
+    }
+    this->min_latency.store(INT64_MAX, std::memory_order_relaxed);
+    this->max_latency.store(INT64_MIN, std::memory_order_relaxed);
+  }
+
+  /// Count a latency, only to be called by the thread owning the histogram.
+  void record(int64_t latency)
+  {
+    // Read-modify-write without atomic instructions, since there is only one writer
+    size_t index = latency < 0 ?
+      bucket_index(0u - static_cast<uint64_t>(latency)) :
+      bucket_count + bucket_index(static_cast<uint64_t>(latency));
+    this->counts[index].store(
+      this->counts[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (latency < this->min_latency.load(std::memory_order_relaxed)) {
+      this->min_latency.store(latency, std::memory_order_relaxed);
+    }
+    if (latency > this->max_latency.load(std::memory_order_relaxed)) {
+      this->max_latency.store(latency, std::memory_order_relaxed);
+    }
+  }
+
+  /// Add the counts of this histogram to the ones of a snapshot.
+  void add_to(
+    std::vector<uint64_t> & snapshot_counts, int64_t & snapshot_min, int64_t & snapshot_max) const
+  {
+    snapshot_counts.resize(2 * bucket_count, 0);
+    for (size_t i = 0; i < 2 * bucket_count; ++i) {
+      snapshot_counts[i] += this->counts[i].load(std::memory_order_relaxed);
+    }
+    snapshot_min = std::min(snapshot_min, this->min_latency.load(std::memory_order_relaxed));
+    snapshot_max = std::max(snapshot_max, this->max_latency.load(std::memory_order_relaxed));
+  }
+
+  /// Fill the percentiles of the latencies counted in a snapshot.
+  /// \return -1 if the snapshot is empty
+  static int get_percentiles(
+    const std::vector<uint64_t> & snapshot_counts, int64_t snapshot_min, int64_t snapshot_max,
+    struct rttest_latency_percentiles * percentiles)
+  {
+    uint64_t total = std::accumulate(
+      snapshot_counts.begin(), snapshot_counts.end(), static_cast<uint64_t>(0));
+    if (total == 0) {
+      return -1;
+    }
+    percentiles->samples = total;
+    percentiles->min_latency = snapshot_min;
+    percentiles->max_latency = snapshot_max;
+
+    const double ratios[] = {0.5, 0.9, 0.99, 0.999, 0.9999};
+    int64_t * values[] = {
+      &percentiles->p50_latency, &percentiles->p90_latency, &percentiles->p99_latency,
+      &percentiles->p999_latency, &percentiles->p9999_latency};
+    size_t next = 0;
+    uint64_t seen = 0;
+    // Walk the buckets in increasing order of latency: early ones first, largest magnitude first
+    for (size_t n = 0; n < 2 * bucket_count && next < 5; ++n) {
+      size_t index = n < bucket_count ? bucket_count - 1 - n : n;
+      seen += snapshot_counts[index];
+      while (next < 5 && seen >= std::max<uint64_t>(1, std::ceil(ratios[next] * total))) {
+        // Report the largest latency the bucket may contain, within the observed range
+        int64_t value = index < bucket_count ?
+          static_cast<int64_t>(0u - bucket_lowest_value(index)) :
+          static_cast<int64_t>(std::min<uint64_t>(
+            bucket_highest_value(index - bucket_count), INT64_MAX));
+        *values[next++] = std::min(std::max(value, snapshot_min), snapshot_max);
+      }
+    }
+    return 0;
+  }
+
+private:
+  static size_t bucket_index(uint64_t value)
+  {
+    if (value < sub_bucket_count) {
+      return static_cast<size_t>(value);
+    }
+    size_t msb = 63 - __builtin_clzll(value);
+    size_t shift = msb - sub_bucket_bits;
+    return (shift + 1) * sub_bucket_count + static_cast<size_t>(value >> shift) - sub_bucket_count;
+  }
+
+  static uint64_t bucket_lowest_value(size_t index)
+  {
+    if (index < 2 * sub_bucket_count) {
+      return index;
+    }
+    size_t shift = index / sub_bucket_count - 1;
+    return static_cast<uint64_t>(index % sub_bucket_count + sub_bucket_count) << shift;
+  }
+
+  static uint64_t bucket_highest_value(size_t index)
+  {
+    if (index < 2 * sub_bucket_count) {
+      return index;
+    }
+    size_t shift = index / sub_bucket_count - 1;
+    return bucket_lowest_value(index) + ((static_cast<uint64_t>(1) << shift) - 1);
+  }
+
+  // Magnitudes of the early latencies, followed by the late ones
+  std::unique_ptr<std::atomic<uint64_t>[]> counts;
+  std::atomic<int64_t> min_latency;
+  std::atomic<int64_t> max_latency;
+};
+
 class Rttest
 {
 private:
   struct rttest_params params;
   struct rttest_sample_buffer sample_buffer;
+  rttest_latency_histogram latency_histogram;
   struct rusage prev_usage;
 
   pthread_t thread_id;
 
+  // Number of latencies accumulated in the results, and sum of their squared deviations
+  size_t latency_count = 0;
+  double latency_squared_deviations = 0.0;
+
   int record_jitter(
     const struct timespec * deadline,
     const struct timespec * result_time, const size_t iteration);
 
   int accumulate_statistics(size_t iteration);
 
+  void accumulate_latency(int64_t latency);
+
 public:
   int running = 0;
   struct rttest_results results;
@@ -179,6 +337,10 @@ public:
 
   int get_sample_at(const size_t iteration, int64_t & sample) const;
 
+  int record_latency(int64_t latency);
+
+  const rttest_latency_histogram & get_latency_histogram() const;
+
   int write_results();
 
   int write_results_file(char * filename);
@@ -195,11 +357,15 @@ public:
 };
 
 // Global variables, for tracking threads
+// Instances are only created and destroyed by their own thread, so they stay valid for it
+// after the mutex protecting the map is released.
 std::map<pthread_t, Rttest> rttest_instance_map;
+std::mutex rttest_instance_map_mutex;
 pthread_t initial_thread_id = 0;
 
 Rttest::Rttest()
 {
+  memset(&this->params, 0, sizeof(struct rttest_params));
   memset(&this->results, 0, sizeof(struct rttest_results));
   this->results.min_latency = INT_MAX;
   this->results.max_latency = INT_MIN;
@@ -248,10 +414,12 @@ int Rttest::record_jitter(
 
 Rttest * get_rttest_thread_instance(pthread_t thread_id)
 {
-  if (rttest_instance_map.count(thread_id) == 0) {
+  std::lock_guard<std::mutex> lock(rttest_instance_map_mutex);
+  auto it = rttest_instance_map.find(thread_id);
+  if (it == rttest_instance_map.end()) {
     return NULL;
   }
-  return &rttest_instance_map[thread_id];
+  return &it->second;
 }
 
 uint64_t rttest_parse_size_units(char * optarg)
@@ -400,8 +568,8 @@ int rttest_get_params(struct rttest_params * params_in)
 int rttest_init_new_thread()
 {
   auto thread_id = pthread_self();
-  auto thread_rttest_instance = get_rttest_thread_instance(thread_id);
-  if (thread_rttest_instance == nullptr) {
+  std::unique_lock<std::mutex> lock(rttest_instance_map_mutex);
+  if (rttest_instance_map.count(thread_id) == 0) {
     // Create the new Rttest instance for this thread
     rttest_instance_map.emplace(std::make_pair(thread_id, Rttest()));
   } else {
@@ -413,23 +581,31 @@ int rttest_init_new_thread()
   }
   rttest_instance_map[thread_id].set_params(
     rttest_instance_map[initial_thread_id].get_params());
-  rttest_instance_map[thread_id].initialize_dynamic_memory();
+  Rttest & thread_rttest_instance = rttest_instance_map[thread_id];
+  lock.unlock();
+  thread_rttest_instance.initialize_dynamic_memory();
   return 0;
 }
 
-int rttest_read_args(int argc, char ** argv)
+// Get the Rttest instance of the calling thread, creating it if needed.
+Rttest * create_rttest_thread_instance()
 {
   auto thread_id = pthread_self();
-  auto thread_rttest_instance = get_rttest_thread_instance(thread_id);
-  if (!thread_rttest_instance) {
+  std::lock_guard<std::mutex> lock(rttest_instance_map_mutex);
+  auto it = rttest_instance_map.find(thread_id);
+  if (it == rttest_instance_map.end()) {
     // Create the new Rttest instance for this thread
-    rttest_instance_map.emplace(std::make_pair(thread_id, Rttest()));
+    it = rttest_instance_map.emplace(std::make_pair(thread_id, Rttest())).first;
     if (rttest_instance_map.size() == 1 && initial_thread_id == 0) {
       initial_thread_id = thread_id;
     }
-    thread_rttest_instance = &rttest_instance_map[thread_id];
   }
-  return thread_rttest_instance->read_args(argc, argv);
+  return &it->second;
+}
+
+int rttest_read_args(int argc, char ** argv)
+{
+  return create_rttest_thread_instance()->read_args(argc, argv);
 }
 
 int Rttest::init(
@@ -478,19 +654,7 @@ int rttest_init(
   size_t sched_policy, int sched_priority, size_t stack_size,
   uint64_t prefault_dynamic_size, char * filename)
 {
-  auto thread_id = pthread_self();
-  auto thread_rttest_instance = get_rttest_thread_instance(thread_id);
-  if (thread_rttest_instance == nullptr) {
-    // Create the new Rttest instance for this thread
-    std::pair<pthread_t, Rttest> instance;
-    instance.first = thread_id;
-    rttest_instance_map.emplace(instance);
-    if (rttest_instance_map.size() == 1 && initial_thread_id == 0) {
-      initial_thread_id = thread_id;
-    }
-    thread_rttest_instance = &rttest_instance_map[thread_id];
-  }
-  return thread_rttest_instance->init(
+  return create_rttest_thread_instance()->init(
     iterations, update_period, sched_policy, sched_priority, stack_size,
     prefault_dynamic_size, filename);
 }
@@ -782,7 +946,15 @@ int Rttest::accumulate_statistics(size_t iteration)
   } else if (iteration > params.iterations) {
     return -1;
   }
-  int64_t latency = sample_buffer.latency_samples[i];
+  this->accumulate_latency(sample_buffer.latency_samples[i]);
+  this->results.minor_pagefaults += sample_buffer.minor_pagefaults[i];
+  this->results.major_pagefaults += sample_buffer.major_pagefaults[i];
+  return 0;
+}
+
+void Rttest::accumulate_latency(int64_t latency)
+{
+  this->latency_histogram.record(latency);
   if (latency > this->results.max_latency) {
     this->results.max_latency = latency;
   }
@@ -790,20 +962,91 @@ int Rttest::accumulate_statistics(size_t iteration)
     this->results.min_latency = latency;
   }
 
-  if (iteration > 0) {
-    // Accumulate the mean
-    this->results.mean_latency = this->results.mean_latency +
-      (sample_buffer.latency_samples[i] - this->results.mean_latency) / (iteration + 1);
-  } else {
-    // Initialize the mean
-    this->results.mean_latency = sample_buffer.latency_samples[i];
-  }
-  this->results.minor_pagefaults += sample_buffer.minor_pagefaults[i];
-  this->results.major_pagefaults += sample_buffer.major_pagefaults[i];
+  // Accumulate the mean and the standard deviation with Welford's method
+  ++this->latency_count;
+  double deviation = latency - this->results.mean_latency;
+  this->results.mean_latency += deviation / this->latency_count;
+  this->latency_squared_deviations += deviation * (latency - this->results.mean_latency);
+  this->results.latency_stddev =
+    std::sqrt(this->latency_squared_deviations / this->latency_count);
   this->results_initialized = true;
+}
+
+int Rttest::record_latency(int64_t latency)
+{
+  this->accumulate_latency(latency);
   return 0;
 }
 
+const rttest_latency_histogram & Rttest::get_latency_histogram() const
+{
+  return this->latency_histogram;
+}
+
+int rttest_record_latency(int64_t latency)
+{
+  auto thread_rttest_instance = get_rttest_thread_instance(pthread_self());
+  if (!thread_rttest_instance) {
+    // First latency of a thread that was not initialized, e.g. a thread of an executor
+    auto thread_id = pthread_self();
+    std::lock_guard<std::mutex> lock(rttest_instance_map_mutex);
+    thread_rttest_instance =
+      &rttest_instance_map.emplace(std::make_pair(thread_id, Rttest())).first->second;
+    auto initial_thread_instance = rttest_instance_map.find(initial_thread_id);
+    if (initial_thread_id != 0 && initial_thread_instance != rttest_instance_map.end()) {
+      thread_rttest_instance->set_params(initial_thread_instance->second.get_params());
+      // The filename is owned by the initial thread
+      thread_rttest_instance->get_params()->filename = nullptr;
+    }
+  }
+  return thread_rttest_instance->record_latency(latency);
+}
+
+int rttest_record_wakeup_latency(const struct timespec * deadline)
+{
+  if (deadline == NULL) {
+    return -1;
+  }
+  struct timespec current_time, latency;
+  clock_gettime(CLOCK_MONOTONIC, &current_time);
+  int parity = 1;
+  if (timespec_gt(deadline, &current_time)) {
+    parity = -1;
+  }
+  subtract_timespecs(&current_time, deadline, &latency);
+  return rttest_record_latency(parity * static_cast<int64_t>(timespec_to_long(&latency)));
+}
+
+int rttest_get_latency_percentiles(struct rttest_latency_percentiles * percentiles)
+{
+  auto thread_rttest_instance = get_rttest_thread_instance(pthread_self());
+  if (!thread_rttest_instance || percentiles == NULL) {
+    return -1;
+  }
+  std::vector<uint64_t> counts;
+  int64_t min_latency = INT64_MAX;
+  int64_t max_latency = INT64_MIN;
+  thread_rttest_instance->get_latency_histogram().add_to(counts, min_latency, max_latency);
+  return rttest_latency_histogram::get_percentiles(counts, min_latency, max_latency, percentiles);
+}
+
+int rttest_get_aggregate_latency_percentiles(struct rttest_latency_percentiles * percentiles)
+{
+  if (percentiles == NULL) {
+    return -1;
+  }
+  std::vector<uint64_t> counts;
+  int64_t min_latency = INT64_MAX;
+  int64_t max_latency = INT64_MIN;
+  {
+    std::lock_guard<std::mutex> lock(rttest_instance_map_mutex);
+    for (const auto & instance : rttest_instance_map) {
+      instance.second.get_latency_histogram().add_to(counts, min_latency, max_latency);
+    }
+  }
+  return rttest_latency_histogram::get_percentiles(counts, min_latency, max_latency, percentiles);
+}
+
 int Rttest::calculate_statistics(struct rttest_results * output)
 {
   if (output == NULL) {
@@ -929,6 +1172,20 @@ std::string Rttest::results_to_string(char * name)
   sstring << "    - Max: " << results.max_latency << " ns" << std::endl;
   sstring << "    - Mean: " << results.mean_latency << " ns" << std::endl;
   sstring << "    - Standard deviation: " << results.latency_stddev << std::endl;
+  std::vector<uint64_t> counts;
+  int64_t min_latency = INT64_MAX;
+  int64_t max_latency = INT64_MIN;
+  this->latency_histogram.add_to(counts, min_latency, max_latency);
+  struct rttest_latency_percentiles percentiles;
+  if (rttest_latency_histogram::get_percentiles(
+      counts, min_latency, max_latency, &percentiles) == 0)
+  {
+    sstring << "    - 50th percentile: " << percentiles.p50_latency << " ns" << std::endl;
+    sstring << "    - 90th percentile: " << percentiles.p90_latency << " ns" << std::endl;
+    sstring << "    - 99th percentile: " << percentiles.p99_latency << " ns" << std::endl;
+    sstring << "    - 99.9th percentile: " << percentiles.p999_latency << " ns" << std::endl;
+    sstring << "    - 99.99th percentile: " << percentiles.p9999_latency << " ns" << std::endl;
+  }
   sstring << std::endl;
 
   return sstring.str();
@@ -942,6 +1199,7 @@ int rttest_finish()
   }
   int status = thread_rttest_instance->finish();
 
+  std::lock_guard<std::mutex> lock(rttest_instance_map_mutex);
   rttest_instance_map.erase(pthread_self());
 
   return status;
@@ -952,8 +1210,7 @@ int Rttest::finish()
   this->running = 0;
   munlockall();
 
-  // Print statistics to screen
-  this->calculate_statistics(&this->results);
+  // Print statistics to screen, the results were accumulated while recording
   printf("%s\n", this->results_to_string(this->params.filename).c_str());
   free(this->params.filename);
 
@@ -15,6 +15,9 @@
 #include <sys/resource.h>
 
 #include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "rttest/rttest.h"
@@ -167,3 +170,123 @@ TEST(TestApi, running) {
   EXPECT_EQ(0, rttest_finish());
   EXPECT_EQ(0, rttest_running());
 }
+
+TEST(TestApi, latency_percentiles) {
+  struct rttest_latency_percentiles percentiles;
+  EXPECT_EQ(-1, rttest_get_latency_percentiles(&percentiles));
+
+  struct timespec update_period;
+  update_period.tv_sec = 0;
+  update_period.tv_nsec = 1000000;
+  EXPECT_EQ(0, rttest_init(0, update_period, SCHED_RR, 80, 0, 0, NULL));
+  EXPECT_EQ(-1, rttest_get_latency_percentiles(&percentiles));
+  EXPECT_EQ(-1, rttest_get_latency_percentiles(NULL));
+
+  // Small latencies are counted exactly
+  for (int64_t latency = 1; latency <= 100; ++latency) {
+    EXPECT_EQ(0, rttest_record_latency(latency));
+  }
+  EXPECT_EQ(0, rttest_get_latency_percentiles(&percentiles));
+  EXPECT_EQ(100u, percentiles.samples);
+  EXPECT_EQ(1, percentiles.min_latency);
+  EXPECT_EQ(100, percentiles.max_latency);
+  EXPECT_EQ(50, percentiles.p50_latency);
+  EXPECT_EQ(90, percentiles.p90_latency);
+  EXPECT_EQ(99, percentiles.p99_latency);
+  EXPECT_EQ(100, percentiles.p999_latency);
+
+  // Larger ones are rounded up by less than 1%
+  for (int64_t latency = 101; latency <= 1000000; ++latency) {
+    EXPECT_EQ(0, rttest_record_latency(latency));
+  }
+  EXPECT_EQ(0, rttest_get_latency_percentiles(&percentiles));
+  EXPECT_EQ(1000000u, percentiles.samples);
+  EXPECT_EQ(1000000, percentiles.max_latency);
+  EXPECT_GE(percentiles.p50_latency, 500000);
+  EXPECT_LE(percentiles.p50_latency, 505000);
+  EXPECT_GE(percentiles.p99_latency, 990000);
+  EXPECT_LE(percentiles.p99_latency, 999900);
+  EXPECT_GE(percentiles.p9999_latency, 999900);
+  EXPECT_LE(percentiles.p9999_latency, 1000000);
+
+  struct rttest_results results;
+  EXPECT_EQ(0, rttest_get_statistics(&results));
+  EXPECT_EQ(1, results.min_latency);
+  EXPECT_EQ(1000000, results.max_latency);
+  EXPECT_NEAR(500000.5, results.mean_latency, 1e-3);
+  EXPECT_NEAR(288675.13, results.latency_stddev, 1e-2);
+
+  EXPECT_EQ(0, rttest_finish());
+}
+
+TEST(TestApi, early_latency_percentiles) {
+  struct timespec update_period;
+  update_period.tv_sec = 0;
+  update_period.tv_nsec = 1000000;
+  EXPECT_EQ(0, rttest_init(0, update_period, SCHED_RR, 80, 0, 0, NULL));
+
+  for (int64_t latency = -5000; latency < 5000; ++latency) {
+    EXPECT_EQ(0, rttest_record_latency(latency));
+  }
+  struct rttest_latency_percentiles percentiles;
+  EXPECT_EQ(0, rttest_get_latency_percentiles(&percentiles));
+  EXPECT_EQ(-5000, percentiles.min_latency);
+  EXPECT_EQ(4999, percentiles.max_latency);
+  EXPECT_EQ(-1, percentiles.p50_latency);
+  EXPECT_GE(percentiles.p90_latency, 3999);
+  EXPECT_LE(percentiles.p90_latency, 4040);
+
+  // Wakeups that already happened are late
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  EXPECT_EQ(0, rttest_record_wakeup_latency(&deadline));
+  EXPECT_EQ(-1, rttest_record_wakeup_latency(NULL));
+  EXPECT_EQ(0, rttest_get_latency_percentiles(&percentiles));
+  EXPECT_EQ(10001u, percentiles.samples);
+  EXPECT_GT(percentiles.max_latency, 0);
+
+  EXPECT_EQ(0, rttest_finish());
+}
+
+TEST(TestApi, aggregate_latency_percentiles) {
+  const size_t thread_count = 4;
+  const int64_t samples_per_thread = 1000;
+  std::atomic<size_t> recorded{0};
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back(
+      [t, samples_per_thread, &recorded, &done]() {
+        // Threads that didn't initialize rttest get an instance when they first record
+        for (int64_t i = 0; i < samples_per_thread; ++i) {
+          EXPECT_EQ(0, rttest_record_latency(static_cast<int64_t>(t + 1) * 100));
+        }
+        struct rttest_latency_percentiles percentiles;
+        EXPECT_EQ(0, rttest_get_latency_percentiles(&percentiles));
+        EXPECT_EQ(static_cast<size_t>(samples_per_thread), percentiles.samples);
+        ++recorded;
+        while (!done) {
+          std::this_thread::yield();
+        }
+        EXPECT_EQ(0, rttest_finish());
+      });
+  }
+  while (recorded < thread_count) {
+    std::this_thread::yield();
+  }
+
+  struct rttest_latency_percentiles percentiles;
+  EXPECT_EQ(0, rttest_get_aggregate_latency_percentiles(&percentiles));
+  EXPECT_EQ(thread_count * samples_per_thread, percentiles.samples);
+  EXPECT_EQ(100, percentiles.min_latency);
+  EXPECT_EQ(400, percentiles.max_latency);
+  EXPECT_GE(percentiles.p50_latency, 200);
+  EXPECT_LE(percentiles.p50_latency, 202);
+
+  done = true;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(-1, rttest_get_aggregate_latency_percentiles(&percentiles));
+  EXPECT_EQ(-1, rttest_get_aggregate_latency_percentiles(NULL));
+}
@@ -0,0 +1,376 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-thread TLSF memory pools, exposed as a std allocator and as a rcutils allocator
+
+#ifndef TLSF_CPP__THREAD_LOCAL_TLSF_HPP_
+#define TLSF_CPP__THREAD_LOCAL_TLSF_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "rcutils/allocator.h"
+
+#include "tlsf/tlsf.h"
+
+namespace tlsf_cpp
+{
+
+/// A TLSF memory pool allocated from by a single thread, and freed into by any thread.
+/**
+ * Only the owner thread allocates, so that the pool needs no lock.
+ * Blocks freed by the owner thread go straight back to the pool, blocks freed by other threads
+ * are pushed on a lock-free list, which the owner thread returns to the pool when it allocates.
+ *
+ * The arena outlives its owner thread until all its blocks are freed: it is deleted by the last
+ * of release() and the deallocation of its last block.
+ */
+class tlsf_arena
+{
+public:
+  /// Allocate and prefault the pool, from the global heap.
+  explicit tlsf_arena(size_t pool_size)
+  : pool_(new char[pool_size]), refcount_(1), pending_(nullptr)
+  {
+    memset(pool_, 0, pool_size);
+    if (init_memory_pool(pool_size, pool_) == static_cast<size_t>(-1)) {
+      delete[] pool_;
+      throw std::bad_alloc();
+    }
+  }
+
+  tlsf_arena(const tlsf_arena &) = delete;
+  tlsf_arena & operator=(const tlsf_arena &) = delete;
+
+  /// Allocate a block, only from the owner thread.
+  /**
+   * \return the block aligned like std::max_align_t, or nullptr if the pool is exhausted
+   */
+  void * allocate(size_t size)
+  {
+    collect_pending();
+    if (size > SIZE_MAX - sizeof(block_header)) {
+      return nullptr;
+    }
+    auto header = static_cast<block_header *>(malloc_ex(sizeof(block_header) + size, pool_));
+    if (!header) {
+      return nullptr;
+    }
+    header->arena = this;
+    header->size = size;
+    refcount_.fetch_add(1, std::memory_order_relaxed);
+    return header + 1;
+  }
+
+  /// Free a block allocated by any arena, from any thread.
+  /**
+   * \param[in] ptr the block, nullptr is ignored
+   * \param[in] current the arena owned by the calling thread, if any
+   */
+  static void deallocate(void * ptr, tlsf_arena * current)
+  {
+    if (!ptr) {
+      return;
+    }
+    block_header * header = static_cast<block_header *>(ptr) - 1;
+    tlsf_arena * arena = header->arena;
+    if (arena == current) {
+      free_ex(header, arena->pool_);
+    } else {
+      // Treiber stack push, the owner takes the whole list at once so there is no ABA problem
+      block_header * head = arena->pending_.load(std::memory_order_relaxed);
+      do {
+        header->next = head;
+      } while (!arena->pending_.compare_exchange_weak(
+        head, header, std::memory_order_release, std::memory_order_relaxed));
+    }
+    arena->unref();
+  }
+
+  /// Get the size requested for a block allocated by any arena.
+  static size_t get_size(const void * ptr)
+  {
+    return (static_cast<const block_header *>(ptr) - 1)->size;
+  }
+
+  /// Give up the ownership of the arena, from the owner thread once it stops allocating.
+  void release()
+  {
+    collect_pending();
+    unref();
+  }
+
+private:
+  // Precedes each block, keeping it aligned like std::max_align_t
+  struct alignas(alignof(std::max_align_t)) block_header
+  {
+    tlsf_arena * arena;
+    union
+    {
+      // Requested size, while the block is allocated
+      size_t size;
+      // Next block to return to the pool, once the block was freed by another thread
+      block_header * next;
+    };
+  };
+
+  ~tlsf_arena()
+  {
+    destroy_memory_pool(pool_);
+    delete[] pool_;
+  }
+
+  void collect_pending()
+  {
+    if (!pending_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    block_header * header = pending_.exchange(nullptr, std::memory_order_acquire);
+    while (header) {
+      block_header * next = header->next;
+      free_ex(header, pool_);
+      header = next;
+    }
+  }
+
+  void unref()
+  {
+    if (refcount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // Blocks freed by other threads since the owner released the arena are in its pool
+      delete this;
+    }
+  }
+
+  char * pool_;
+  // Number of allocated blocks, plus one until the owner releases the arena
+  std::atomic<size_t> refcount_;
+  std::atomic<block_header *> pending_;
+};
+
+/// The arena of the calling thread, for a pool size.
+template<size_t PoolSize>
+class thread_local_tlsf_arena
+{
+public:
+  /// Get the arena of the calling thread, creating it on first use.
+  /**
+   * Creating the arena allocates its pool from the global heap, call this function during the
+   * initialization of real-time threads to avoid it at run time.
+   * \return the arena, or nullptr if the thread exited or the pool couldn't be allocated
+   */
+  static tlsf_arena * get()
+  {
+    thread_state & state = get_state();
+    if (state.arena || state.exited) {
+      return state.arena;
+    }
+    {
+      // init_memory_pool() also makes the pool the default one of tlsf_malloc(), unguarded
+      static std::mutex init_mutex;
+      std::lock_guard<std::mutex> lock(init_mutex);
+      try {
+        state.arena = new tlsf_arena(PoolSize);
+      } catch (const std::bad_alloc &) {
+        return nullptr;
+      }
+    }
+    static thread_local owner_guard guard;
+    (void)guard;
+    return state.arena;
+  }
+
+  /// Get the arena of the calling thread if it was created, without creating it.
+  static tlsf_arena * peek()
+  {
+    return get_state().arena;
+  }
+
+private:
+  // Trivially destructible, so that it stays usable by the destructors of thread local objects
+  struct thread_state
+  {
+    tlsf_arena * arena;
+    bool exited;
+  };
+
+  struct owner_guard
+  {
+    ~owner_guard()
+    {
+      // Blocks of this thread still in use keep the arena alive, and are freed through the
+      // lock-free list from now on, including by the destructors of other thread local objects
+      thread_state & state = get_state();
+      state.arena->release();
+      state.arena = nullptr;
+      state.exited = true;
+    }
+  };
+
+  static thread_state & get_state()
+  {
+    static thread_local thread_state state = {nullptr, false};
+    return state;
+  }
+};
+
+/// Allocate from the arena of the calling thread, with the rcutils allocator signature.
+template<size_t PoolSize>
+void * thread_local_tlsf_allocate(size_t size, void * state)
+{
+  (void)state;
+  tlsf_arena * arena = thread_local_tlsf_arena<PoolSize>::get();
+  return arena ? arena->allocate(size) : nullptr;
+}
+
+/// Free into the arena which allocated a block, with the rcutils allocator signature.
+template<size_t PoolSize>
+void thread_local_tlsf_deallocate(void * ptr, void * state)
+{
+  (void)state;
+  tlsf_arena::deallocate(ptr, thread_local_tlsf_arena<PoolSize>::peek());
+}
+
+/// Reallocate from the arena of the calling thread, with the rcutils allocator signature.
+template<size_t PoolSize>
+void * thread_local_tlsf_reallocate(void * ptr, size_t size, void * state)
+{
+  if (!ptr) {
+    return thread_local_tlsf_allocate<PoolSize>(size, state);
+  }
+  // The block may come from the arena of another thread, always move it to this one
+  void * new_ptr = thread_local_tlsf_allocate<PoolSize>(size, state);
+  if (!new_ptr) {
+    return nullptr;
+  }
+  size_t old_size = tlsf_arena::get_size(ptr);
+  memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+  thread_local_tlsf_deallocate<PoolSize>(ptr, state);
+  return new_ptr;
+}
+
+/// Allocate zeroed memory from the arena of the calling thread, with the rcutils signature.
+template<size_t PoolSize>
+void * thread_local_tlsf_zero_allocate(
+  size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (size_of_element != 0 && number_of_elements > SIZE_MAX / size_of_element) {
+    return nullptr;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * ptr = thread_local_tlsf_allocate<PoolSize>(size, state);
+  if (ptr) {
+    memset(ptr, 0, size);
+  }
+  return ptr;
+}
+
+/// Get a rcutils allocator allocating from the arena of the calling thread.
+/**
+ * It can be given to rcl, e.g. through rclcpp::NodeOptions::allocator(), and to any rclcpp
+ * entity through thread_local_tlsf_allocator.
+ */
+template<size_t PoolSize = 1024 * 1024>
+rcutils_allocator_t get_thread_local_tlsf_rcutils_allocator()
+{
+  rcutils_allocator_t allocator = rcutils_get_zero_initialized_allocator();
+  allocator.allocate = &thread_local_tlsf_allocate<PoolSize>;
+  allocator.deallocate = &thread_local_tlsf_deallocate<PoolSize>;
+  allocator.reallocate = &thread_local_tlsf_reallocate<PoolSize>;
+  allocator.zero_allocate = &thread_local_tlsf_zero_allocate<PoolSize>;
+  allocator.state = nullptr;
+  return allocator;
+}
+
+/// A std allocator allocating from a TLSF pool owned by the calling thread.
+/**
+ * Each thread allocates from its own pool without taking a lock, and memory can be freed from
+ * any thread without a lock either.
+ * The allocator holds no state, so all instances are interchangeable and rebinding is free.
+ * Its rcl allocator, used by rclcpp for the memory allocated by rcl on behalf of entities using
+ * this allocator, allocates from the same pools.
+ *
+ * Creating a pool makes it the default pool of tlsf_malloc(), so this allocator can't be used
+ * together with tlsf_heap_allocator.
+ */
+template<typename T, size_t PoolSize = 1024 * 1024>
+struct thread_local_tlsf_allocator
+{
+  // Needed for std::allocator_traits
+  using value_type = T;
+
+  thread_local_tlsf_allocator() = default;
+
+  // Needed for std::allocator_traits
+  template<typename U>
+  thread_local_tlsf_allocator(const thread_local_tlsf_allocator<U, PoolSize> &) noexcept
+  {
+  }
+
+  // Needed for std::allocator_traits
+  T * allocate(size_t size)
+  {
+    if (size > SIZE_MAX / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    T * ptr = static_cast<T *>(thread_local_tlsf_allocate<PoolSize>(size * sizeof(T), nullptr));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  // Needed for std::allocator_traits
+  void deallocate(T * ptr, size_t)
+  {
+    thread_local_tlsf_deallocate<PoolSize>(ptr, nullptr);
+  }
+
+  // Used by rclcpp::allocator::get_rcl_allocator()
+  rcutils_allocator_t get_rcl_allocator() const
+  {
+    return get_thread_local_tlsf_rcutils_allocator<PoolSize>();
+  }
+
+  template<typename U>
+  struct rebind
+  {
+    typedef thread_local_tlsf_allocator<U, PoolSize> other;
+  };
+};
+
+// Needed for std::allocator_traits
+template<typename T, typename U, size_t PoolSize>
+constexpr bool operator==(
+  const thread_local_tlsf_allocator<T, PoolSize> &,
+  const thread_local_tlsf_allocator<U, PoolSize> &) noexcept
+{
+  return true;
+}
+
+// Needed for std::allocator_traits
+template<typename T, typename U, size_t PoolSize>
+constexpr bool operator!=(
+  const thread_local_tlsf_allocator<T, PoolSize> &,
+  const thread_local_tlsf_allocator<U, PoolSize> &) noexcept
+{
+  return false;
+}
+
+}  // namespace tlsf_cpp
+
+#endif  // TLSF_CPP__THREAD_LOCAL_TLSF_HPP_
@@ -0,0 +1,189 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/memory_tools/gtest_quickstart.hpp"
+
+#include "rclcpp/allocator/allocator_common.hpp"
+
+#include "tlsf_cpp/thread_local_tlsf.hpp"
+
+// Small enough for the tests to exhaust it
+constexpr size_t kPoolSize = 64 * 1024;
+constexpr size_t kBlockSize = 1024;
+
+template<typename T>
+using Allocator = tlsf_cpp::thread_local_tlsf_allocator<T, kPoolSize>;
+using Arena = tlsf_cpp::thread_local_tlsf_arena<kPoolSize>;
+
+TEST(TestThreadLocalTlsf, allocate_deallocate) {
+  Allocator<uint64_t> allocator;
+  uint64_t * ptr = allocator.allocate(4);
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t));
+  ptr[3] = 42u;
+  allocator.deallocate(ptr, 4);
+
+  EXPECT_THROW(allocator.allocate(kPoolSize), std::bad_alloc);
+}
+
+TEST(TestThreadLocalTlsf, rebind_compares_equal) {
+  Allocator<int> int_allocator;
+  Allocator<char> char_allocator(int_allocator);
+  EXPECT_TRUE(int_allocator == char_allocator);
+  EXPECT_FALSE(int_allocator != char_allocator);
+
+  // Memory allocated by a rebound allocator can be freed by any other
+  char * ptr = char_allocator.allocate(16);
+  std::allocator_traits<Allocator<int>>::rebind_alloc<char>(int_allocator).deallocate(ptr, 16);
+}
+
+TEST(TestThreadLocalTlsf, rcutils_allocator) {
+  rcutils_allocator_t allocator = tlsf_cpp::get_thread_local_tlsf_rcutils_allocator<kPoolSize>();
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  auto ptr = static_cast<char *>(allocator.allocate(8, allocator.state));
+  ASSERT_NE(nullptr, ptr);
+  memcpy(ptr, "1234567", 8);
+  ptr = static_cast<char *>(allocator.reallocate(ptr, 2 * kBlockSize, allocator.state));
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_STREQ("1234567", ptr);
+  ptr = static_cast<char *>(allocator.reallocate(ptr, 4, allocator.state));
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(0, memcmp("1234", ptr, 4));
+  allocator.deallocate(ptr, allocator.state);
+
+  auto zeroed = static_cast<uint32_t *>(allocator.zero_allocate(16, 4, allocator.state));
+  ASSERT_NE(nullptr, zeroed);
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(0u, zeroed[i]);
+  }
+  allocator.deallocate(zeroed, allocator.state);
+
+  EXPECT_EQ(nullptr, allocator.zero_allocate(SIZE_MAX, 2, allocator.state));
+  EXPECT_EQ(nullptr, allocator.allocate(kPoolSize, allocator.state));
+}
+
+TEST(TestThreadLocalTlsf, get_rcl_allocator) {
+  Allocator<int> allocator;
+  rcl_allocator_t rcl_allocator = rclcpp::allocator::get_rcl_allocator<int>(allocator);
+  EXPECT_EQ(&tlsf_cpp::thread_local_tlsf_allocate<kPoolSize>, rcl_allocator.allocate);
+  EXPECT_EQ(&tlsf_cpp::thread_local_tlsf_deallocate<kPoolSize>, rcl_allocator.deallocate);
+  EXPECT_EQ(&tlsf_cpp::thread_local_tlsf_reallocate<kPoolSize>, rcl_allocator.reallocate);
+  EXPECT_EQ(nullptr, rcl_allocator.state);
+}
+
+TEST(TestThreadLocalTlsf, one_arena_per_thread) {
+  tlsf_cpp::tlsf_arena * arena = Arena::get();
+  ASSERT_NE(nullptr, arena);
+  EXPECT_EQ(arena, Arena::get());
+
+  tlsf_cpp::tlsf_arena * other_arena = nullptr;
+  std::thread thread([&other_arena]() {other_arena = Arena::get();});
+  thread.join();
+  EXPECT_NE(nullptr, other_arena);
+  EXPECT_NE(arena, other_arena);
+}
+
+TEST(TestThreadLocalTlsf, cross_thread_deallocate) {
+  Allocator<char> allocator;
+  // Allocate more than the pool holds in total, freeing everything from another thread
+  for (size_t round = 0; round < 4 * kPoolSize / kBlockSize; round += 8) {
+    std::vector<char *> blocks;
+    for (size_t i = 0; i < 8; ++i) {
+      blocks.push_back(allocator.allocate(kBlockSize));
+    }
+    std::thread thread(
+      [&blocks, &allocator]() {
+        for (char * block : blocks) {
+          allocator.deallocate(block, kBlockSize);
+        }
+      });
+    thread.join();
+  }
+}
+
+TEST(TestThreadLocalTlsf, blocks_outlive_their_thread) {
+  std::vector<char *> blocks;
+  std::thread thread(
+    [&blocks]() {
+      Allocator<char> allocator;
+      for (size_t i = 0; i < 8; ++i) {
+        blocks.push_back(allocator.allocate(kBlockSize));
+        memset(blocks.back(), static_cast<int>(i), kBlockSize);
+      }
+    });
+  thread.join();
+
+  Allocator<char> allocator;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_EQ(static_cast<char>(i), blocks[i][kBlockSize - 1]);
+    allocator.deallocate(blocks[i], kBlockSize);
+  }
+}
+
+TEST(TestThreadLocalTlsf, no_memory_operations_after_initialization) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest sqg;
+
+  // Initialization: create the arenas of both threads, and the other thread
+  ASSERT_NE(nullptr, Arena::get());
+  std::vector<char *> blocks;
+  blocks.reserve(8);
+  std::atomic<bool> allocated{false};
+  std::atomic<bool> freed{false};
+  std::thread thread(
+    [&blocks, &allocated, &freed]() {
+      Arena::get();
+      while (!allocated) {
+        std::this_thread::yield();
+      }
+      for (char * block : blocks) {
+        tlsf_cpp::thread_local_tlsf_deallocate<kPoolSize>(block, nullptr);
+      }
+      freed = true;
+    });
+
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    Allocator<char> allocator;
+    std::vector<int, Allocator<int>> numbers;
+    for (int i = 0; i < 1000; ++i) {
+      numbers.push_back(i);
+    }
+    std::allocate_shared<uint64_t>(allocator, 42u);
+    for (size_t i = 0; i < 8; ++i) {
+      blocks.push_back(allocator.allocate(kBlockSize));
+    }
+  });
+  allocated = true;
+  while (!freed) {
+    std::this_thread::yield();
+  }
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    // Returns the blocks freed by the other thread to the pool
+    Allocator<char> allocator;
+    allocator.deallocate(allocator.allocate(kBlockSize), kBlockSize);
+  });
+
+  thread.join();
+}
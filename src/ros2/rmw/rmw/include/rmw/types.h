@@ -139,6 +139,26 @@ typedef struct RMW_PUBLIC_TYPE rmw_subscription_options_t
    * may become more complicated when/if participants map to a context instead.
    */
   bool ignore_local_publications;
+
+  /// Expression selecting the messages delivered to the subscription, or NULL to receive all.
+  /**
+   * The expression is a SQL-like condition on the fields of the message type, e.g.
+   * `"header.frame_id = 'base_link' AND data > 10.5"`.
+   * Fields of nested messages are referred to with dotted names.
+   * Comparisons use the operators `=`, `<>`, `!=`, `<`, `<=`, `>`, `>=` and `LIKE`, where
+   * `%` matches any sequence of characters and `_` any single character, and are combined
+   * with `AND`, `OR`, `NOT` and parentheses.
+   * Only fields of primitive types and strings outside of arrays and sequences can be used.
+   *
+   * Middlewares supporting it evaluate the expression before sending the messages, so that the
+   * messages the subscription doesn't want aren't sent to it.
+   * Middlewares not supporting it must fail to create the subscription, if the expression
+   * is neither NULL nor empty.
+   *
+   * The string isn't used after the subscription was created, and the middleware sets the
+   * subscription options it stores to its own copy of it.
+   */
+  const char * content_filter_expression;
 } rmw_subscription_options_t;
 
 typedef struct RMW_PUBLIC_TYPE rmw_subscription_t
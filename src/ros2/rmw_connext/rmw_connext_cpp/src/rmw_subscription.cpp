@@ -96,6 +96,12 @@ rmw_create_subscription(
     }
   }
   RMW_CHECK_ARGUMENT_FOR_NULL(subscription_options, nullptr);
+  if (subscription_options->content_filter_expression &&
+    subscription_options->content_filter_expression[0] != '\0')
+  {
+    RMW_SET_ERROR_MSG("content filtered subscriptions are not supported by rmw_connext_cpp");
+    return nullptr;
+  }
 
   auto node_info = static_cast<ConnextNodeInfo *>(node->data);
   auto participant = static_cast<DDS::DomainParticipant *>(node_info->participant);
@@ -256,6 +262,7 @@ rmw_create_subscription(
   memcpy(const_cast<char *>(subscription->topic_name), topic_name, strlen(topic_name) + 1);
 
   subscription->options = *subscription_options;
+  subscription->options.content_filter_expression = nullptr;
 
   if (!qos_profile->avoid_ros_namespace_conventions) {
     mangled_name = topic_reader->get_topicdescription()->get_name();
@@ -15,9 +15,13 @@
 #ifndef RMW_DDS_COMMON__GRAPH_CACHE_HPP_
 #define RMW_DDS_COMMON__GRAPH_CACHE_HPP_
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -42,10 +46,16 @@ namespace rmw_dds_common
 // Forward-declaration, defined at end of file.
 struct EntityInfo;
 struct ParticipantInfo;
+struct TopicInfo;
+struct EntityNodeInfo;
 
 /// Graph cache data structure.
 /**
  * Manages relationships between participants, nodes and topics.
+ *
+ * Besides the discovered entities, the cache maintains secondary indices by topic name,
+ * by node name and from endpoint gid to node, which are updated as entities come and go.
+ * Queries only take a shared lock, so they don't serialize with each other.
  */
 class GraphCache
 {
@@ -63,7 +73,7 @@ public:
   void
   set_on_change_callback(CallbackT && callback)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::shared_timed_mutex> lock(mutex_);
     on_change_callback_ = callback;
   }
 
@@ -311,6 +321,17 @@ public:
    * @{
    */
 
+  /// Get the current version of the graph.
+  /**
+   * The version is increased every time the graph changes, so it can be used to
+   * cache results computed from it.
+   *
+   * \return The graph version.
+   */
+  RMW_DDS_COMMON_PUBLIC
+  uint64_t
+  get_graph_version() const;
+
   /// Get the number of publishers of a topic.
   /**
    * \param[in] topic_name Name of the topic.
@@ -504,14 +525,47 @@ public:
   using ParticipantToNodesMap = std::map<rmw_gid_t, ParticipantInfo, Compare_rmw_gid_t>;
   using GidSeq =
     decltype(std::declval<rmw_dds_common::msg::NodeEntitiesInfo>().writer_gid_seq);
+  using GidSet = std::set<rmw_gid_t, Compare_rmw_gid_t>;
+  using TopicNameToInfo = std::map<std::string, TopicInfo>;
+  using NodeKey = std::pair<std::string, std::string>;
+  using NodeKeyToParticipants = std::map<NodeKey, std::map<rmw_gid_t, size_t, Compare_rmw_gid_t>>;
+  using EntityGidToNode = std::map<rmw_gid_t, EntityNodeInfo, Compare_rmw_gid_t>;
+  using NamesAndTypes = std::map<std::string, std::set<std::string>>;
 
 private:
+  using DemangleFunctionPtrT = std::string (*)(const std::string &);
+
+  struct NamesAndTypesCacheEntry
+  {
+    uint64_t graph_version;
+    DemangleFunctionPtrT demangle_topic;
+    DemangleFunctionPtrT demangle_type;
+    std::shared_ptr<const NamesAndTypes> names_and_types;
+  };
+
+  std::shared_ptr<const NamesAndTypes>
+  get_cached_names_and_types(
+    DemangleFunctionT demangle_topic,
+    DemangleFunctionT demangle_type) const;
+
   EntityGidToInfo data_writers_;
   EntityGidToInfo data_readers_;
   ParticipantToNodesMap participants_;
   std::function<void()> on_change_callback_ = nullptr;
 
-  mutable std::mutex mutex_;
+  // Secondary indices, kept in sync with the maps above.
+  TopicNameToInfo topics_;
+  NodeKeyToParticipants nodes_;
+  EntityGidToNode writer_nodes_;
+  EntityGidToNode reader_nodes_;
+
+  uint64_t graph_version_ = 0u;
+
+  mutable std::shared_timed_mutex mutex_;
+
+  // Names and types results, keyed by graph version and demangling functions.
+  mutable std::vector<NamesAndTypesCacheEntry> names_and_types_cache_;
+  mutable std::mutex names_and_types_cache_mutex_;
 };
 
 RMW_DDS_COMMON_PUBLIC
@@ -524,6 +578,21 @@ struct ParticipantInfo
   std::string enclave;
 };
 
+struct TopicInfo
+{
+  GraphCache::GidSet writer_gids;
+  GraphCache::GidSet reader_gids;
+  // Number of endpoints using each type name.
+  std::map<std::string, size_t> types;
+};
+
+struct EntityNodeInfo
+{
+  rmw_gid_t participant_gid;
+  std::string node_name;
+  std::string node_namespace;
+};
+
 struct EntityInfo
 {
   std::string topic_name;
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -42,26 +43,182 @@
 
 using rmw_dds_common::GraphCache;
 using rmw_dds_common::operator<<;
+using rmw_dds_common::operator==;
 
 static const char log_tag[] = "rmw_dds_common";
 
 #define GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(graph_cache_ptr, condition) \
   do { \
-    if (graph_cache_ptr->on_change_callback_ && condition) { \
-      graph_cache_ptr->on_change_callback_(); \
+    if (condition) { \
+      ++graph_cache_ptr->graph_version_; \
+      if (graph_cache_ptr->on_change_callback_) { \
+        graph_cache_ptr->on_change_callback_(); \
+      } \
     } \
   } while (0);
 
 #define GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(graph_cache_ptr) \
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(graph_cache_ptr, true)
 
+using SharedLock = std::shared_lock<std::shared_timed_mutex>;
+using ExclusiveLock = std::lock_guard<std::shared_timed_mutex>;
+
 void
 GraphCache::clear_on_change_callback()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
+  ExclusiveLock lock(mutex_);
   on_change_callback_ = nullptr;
 }
 
+uint64_t
+GraphCache::get_graph_version() const
+{
+  SharedLock lock(mutex_);
+  return graph_version_;
+}
+
+static
+void
+__add_entity_to_topic_index(
+  GraphCache::TopicNameToInfo & topics,
+  const rmw_gid_t & gid,
+  const rmw_dds_common::EntityInfo & entity_info,
+  bool is_reader)
+{
+  rmw_dds_common::TopicInfo & topic_info = topics[entity_info.topic_name];
+  if (is_reader) {
+    topic_info.reader_gids.insert(gid);
+  } else {
+    topic_info.writer_gids.insert(gid);
+  }
+  ++topic_info.types[entity_info.topic_type];
+}
+
+static
+void
+__remove_entity_from_topic_index(
+  GraphCache::TopicNameToInfo & topics,
+  const rmw_gid_t & gid,
+  const rmw_dds_common::EntityInfo & entity_info,
+  bool is_reader)
+{
+  auto topic_it = topics.find(entity_info.topic_name);
+  assert(topic_it != topics.end());
+  rmw_dds_common::TopicInfo & topic_info = topic_it->second;
+  if (is_reader) {
+    topic_info.reader_gids.erase(gid);
+  } else {
+    topic_info.writer_gids.erase(gid);
+  }
+  auto type_it = topic_info.types.find(entity_info.topic_type);
+  assert(type_it != topic_info.types.end());
+  if (0u == --type_it->second) {
+    topic_info.types.erase(type_it);
+  }
+  if (topic_info.reader_gids.empty() && topic_info.writer_gids.empty()) {
+    topics.erase(topic_it);
+  }
+}
+
+static
+void
+__add_entities_to_node_index(
+  GraphCache::EntityGidToNode & entity_nodes,
+  const rmw_gid_t & participant_gid,
+  const rmw_dds_common::msg::NodeEntitiesInfo & node_info,
+  const GraphCache::GidSeq & gids)
+{
+  for (const auto & gid_msg : gids) {
+    rmw_gid_t gid;
+    rmw_dds_common::convert_msg_to_gid(&gid_msg, &gid);
+    // If an endpoint is associated with more than one node, the first one is kept.
+    entity_nodes.emplace(
+      gid,
+      rmw_dds_common::EntityNodeInfo{participant_gid, node_info.node_name,
+        node_info.node_namespace});
+  }
+}
+
+static
+void
+__remove_entities_from_node_index(
+  GraphCache::EntityGidToNode & entity_nodes,
+  const rmw_gid_t & participant_gid,
+  const GraphCache::GidSeq & gids)
+{
+  for (const auto & gid_msg : gids) {
+    rmw_gid_t gid;
+    rmw_dds_common::convert_msg_to_gid(&gid_msg, &gid);
+    auto it = entity_nodes.find(gid);
+    if (it != entity_nodes.end() && it->second.participant_gid == participant_gid) {
+      entity_nodes.erase(it);
+    }
+  }
+}
+
+static
+void
+__add_node_to_index(
+  GraphCache::NodeKeyToParticipants & nodes,
+  const rmw_gid_t & participant_gid,
+  const rmw_dds_common::msg::NodeEntitiesInfo & node_info)
+{
+  ++nodes[std::make_pair(node_info.node_namespace, node_info.node_name)][participant_gid];
+}
+
+static
+void
+__remove_node_from_index(
+  GraphCache::NodeKeyToParticipants & nodes,
+  const rmw_gid_t & participant_gid,
+  const rmw_dds_common::msg::NodeEntitiesInfo & node_info)
+{
+  auto node_it = nodes.find(std::make_pair(node_info.node_namespace, node_info.node_name));
+  assert(node_it != nodes.end());
+  auto participant_it = node_it->second.find(participant_gid);
+  assert(participant_it != node_it->second.end());
+  if (0u == --participant_it->second) {
+    node_it->second.erase(participant_it);
+  }
+  if (node_it->second.empty()) {
+    nodes.erase(node_it);
+  }
+}
+
+static
+void
+__add_participant_nodes_to_index(
+  GraphCache::NodeKeyToParticipants & nodes,
+  GraphCache::EntityGidToNode & writer_nodes,
+  GraphCache::EntityGidToNode & reader_nodes,
+  const rmw_gid_t & participant_gid,
+  const GraphCache::NodeEntitiesInfoSeq & node_entities_info_seq)
+{
+  for (const auto & node_info : node_entities_info_seq) {
+    __add_node_to_index(nodes, participant_gid, node_info);
+    __add_entities_to_node_index(
+      writer_nodes, participant_gid, node_info, node_info.writer_gid_seq);
+    __add_entities_to_node_index(
+      reader_nodes, participant_gid, node_info, node_info.reader_gid_seq);
+  }
+}
+
+static
+void
+__remove_participant_nodes_from_index(
+  GraphCache::NodeKeyToParticipants & nodes,
+  GraphCache::EntityGidToNode & writer_nodes,
+  GraphCache::EntityGidToNode & reader_nodes,
+  const rmw_gid_t & participant_gid,
+  const GraphCache::NodeEntitiesInfoSeq & node_entities_info_seq)
+{
+  for (const auto & node_info : node_entities_info_seq) {
+    __remove_node_from_index(nodes, participant_gid, node_info);
+    __remove_entities_from_node_index(writer_nodes, participant_gid, node_info.writer_gid_seq);
+    __remove_entities_from_node_index(reader_nodes, participant_gid, node_info.reader_gid_seq);
+  }
+}
+
 bool
 GraphCache::add_writer(
   const rmw_gid_t & gid,
@@ -70,11 +227,14 @@ GraphCache::add_writer(
   const rmw_gid_t & participant_gid,
   const rmw_qos_profile_t & qos)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto pair = data_writers_.emplace(
     std::piecewise_construct,
     std::forward_as_tuple(gid),
     std::forward_as_tuple(topic_name, type_name, participant_gid, qos));
+  if (pair.second) {
+    __add_entity_to_topic_index(topics_, gid, pair.first->second, false);
+  }
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(this, pair.second);
   return pair.second;
 }
@@ -87,11 +247,14 @@ GraphCache::add_reader(
   const rmw_gid_t & participant_gid,
   const rmw_qos_profile_t & qos)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto pair = data_readers_.emplace(
     std::piecewise_construct,
     std::forward_as_tuple(gid),
     std::forward_as_tuple(topic_name, type_name, participant_gid, qos));
+  if (pair.second) {
+    __add_entity_to_topic_index(topics_, gid, pair.first->second, true);
+  }
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(this, pair.second);
   return pair.second;
 }
@@ -124,8 +287,13 @@ GraphCache::add_entity(
 bool
 GraphCache::remove_writer(const rmw_gid_t & gid)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  bool ret = data_writers_.erase(gid) > 0;
+  ExclusiveLock guard(mutex_);
+  auto it = data_writers_.find(gid);
+  bool ret = it != data_writers_.end();
+  if (ret) {
+    __remove_entity_from_topic_index(topics_, gid, it->second, false);
+    data_writers_.erase(it);
+  }
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(this, ret);
   return ret;
 }
@@ -133,8 +301,13 @@ GraphCache::remove_writer(const rmw_gid_t & gid)
 bool
 GraphCache::remove_reader(const rmw_gid_t & gid)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  bool ret = data_readers_.erase(gid) > 0;
+  ExclusiveLock guard(mutex_);
+  auto it = data_readers_.find(gid);
+  bool ret = it != data_readers_.end();
+  if (ret) {
+    __remove_entity_from_topic_index(topics_, gid, it->second, true);
+    data_readers_.erase(it);
+  }
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(this, ret);
   return ret;
 }
@@ -151,7 +324,7 @@ GraphCache::remove_entity(const rmw_gid_t & gid, bool is_reader)
 void
 GraphCache::update_participant_entities(const rmw_dds_common::msg::ParticipantEntitiesInfo & msg)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   rmw_gid_t gid;
   rmw_dds_common::convert_msg_to_gid(&msg.gid, &gid);
   auto it = participants_.find(gid);
@@ -163,15 +336,25 @@ GraphCache::update_participant_entities(const rmw_dds_common::msg::ParticipantEn
     it = ret.first;
     assert(ret.second);
   }
+  __remove_participant_nodes_from_index(
+    nodes_, writer_nodes_, reader_nodes_, gid, it->second.node_entities_info_seq);
   it->second.node_entities_info_seq = msg.node_entities_info_seq;
+  __add_participant_nodes_to_index(
+    nodes_, writer_nodes_, reader_nodes_, gid, it->second.node_entities_info_seq);
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(this);
 }
 
 bool
 GraphCache::remove_participant(const rmw_gid_t & participant_gid)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  bool ret = participants_.erase(participant_gid) > 0;
+  ExclusiveLock guard(mutex_);
+  auto it = participants_.find(participant_gid);
+  bool ret = it != participants_.end();
+  if (ret) {
+    __remove_participant_nodes_from_index(
+      nodes_, writer_nodes_, reader_nodes_, participant_gid, it->second.node_entities_info_seq);
+    participants_.erase(it);
+  }
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK_IF(this, ret);
   return ret;
 }
@@ -193,7 +376,7 @@ GraphCache::add_participant(
   const rmw_gid_t & participant_gid,
   const std::string & enclave)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto it = participants_.find(participant_gid);
   if (participants_.end() == it) {
     auto ret = participants_.emplace(
@@ -213,7 +396,7 @@ GraphCache::add_node(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto it = participants_.find(participant_gid);
   assert(it != participants_.end());
 
@@ -223,6 +406,7 @@ GraphCache::add_node(
   node_info.node_name = node_name;
   node_info.node_namespace = node_namespace;
   it->second.node_entities_info_seq.emplace_back(node_info);
+  __add_node_to_index(nodes_, participant_gid, node_info);
 
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(this);
   return __create_participant_info_message(participant_gid, it->second.node_entities_info_seq);
@@ -234,7 +418,7 @@ GraphCache::remove_node(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto it = participants_.find(participant_gid);
   assert(it != participants_.end());
 
@@ -248,7 +432,12 @@ GraphCache::remove_node(
 
   assert(to_remove != it->second.node_entities_info_seq.end());
 
+  // Re-index the participant, as other nodes may share endpoints with the removed one.
+  __remove_participant_nodes_from_index(
+    nodes_, writer_nodes_, reader_nodes_, participant_gid, it->second.node_entities_info_seq);
   it->second.node_entities_info_seq.erase(to_remove);
+  __add_participant_nodes_to_index(
+    nodes_, writer_nodes_, reader_nodes_, participant_gid, it->second.node_entities_info_seq);
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(this);
 
   return __create_participant_info_message(participant_gid, it->second.node_entities_info_seq);
@@ -280,6 +469,39 @@ __modify_node_info(
     participant_info->second.node_entities_info_seq);
 }
 
+static
+void
+__reindex_entity_node(
+  GraphCache::EntityGidToNode & entity_nodes,
+  const GraphCache::ParticipantToNodesMap & participant_map,
+  const rmw_gid_t & participant_gid,
+  const rmw_gid_t & entity_gid,
+  bool is_reader)
+{
+  auto it = entity_nodes.find(entity_gid);
+  if (it == entity_nodes.end() || !(it->second.participant_gid == participant_gid)) {
+    return;
+  }
+  entity_nodes.erase(it);
+  // The endpoint may still be associated with another node of the same participant.
+  auto participant_it = participant_map.find(participant_gid);
+  if (participant_it == participant_map.end()) {
+    return;
+  }
+  rmw_dds_common::msg::Gid entity_gid_msg;
+  rmw_dds_common::convert_gid_to_msg(&entity_gid, &entity_gid_msg);
+  for (const auto & node_info : participant_it->second.node_entities_info_seq) {
+    const auto & gid_seq = is_reader ? node_info.reader_gid_seq : node_info.writer_gid_seq;
+    if (std::find(gid_seq.begin(), gid_seq.end(), entity_gid_msg) != gid_seq.end()) {
+      entity_nodes.emplace(
+        entity_gid,
+        rmw_dds_common::EntityNodeInfo{participant_gid, node_info.node_name,
+          node_info.node_namespace});
+      return;
+    }
+  }
+}
+
 rmw_dds_common::msg::ParticipantEntitiesInfo
 GraphCache::associate_writer(
   const rmw_gid_t & writer_gid,
@@ -287,11 +509,14 @@ GraphCache::associate_writer(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   auto add_writer_gid = [&](rmw_dds_common::msg::NodeEntitiesInfo & info)
     {
       info.writer_gid_seq.emplace_back();
       convert_gid_to_msg(&writer_gid, &info.writer_gid_seq.back());
+      writer_nodes_.emplace(
+        writer_gid,
+        rmw_dds_common::EntityNodeInfo{participant_gid, info.node_name, info.node_namespace});
     };
   auto msg = __modify_node_info(
     participant_gid, node_name, node_namespace, add_writer_gid, participants_);
@@ -307,7 +532,7 @@ GraphCache::dissociate_writer(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   rmw_dds_common::msg::Gid writer_gid_msg;
   convert_gid_to_msg(&writer_gid, &writer_gid_msg);
   auto delete_writer_gid = [&](rmw_dds_common::msg::NodeEntitiesInfo & info)
@@ -325,6 +550,8 @@ GraphCache::dissociate_writer(
     };
   auto msg = __modify_node_info(
     participant_gid, node_name, node_namespace, delete_writer_gid, participants_);
+  __reindex_entity_node(
+    writer_nodes_, participants_, participant_gid, writer_gid, false);
 
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(this);
   return msg;
@@ -337,11 +564,14 @@ GraphCache::associate_reader(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  auto add_reader_gid = [&reader_gid](rmw_dds_common::msg::NodeEntitiesInfo & info)
+  ExclusiveLock guard(mutex_);
+  auto add_reader_gid = [&](rmw_dds_common::msg::NodeEntitiesInfo & info)
     {
       info.reader_gid_seq.emplace_back();
       convert_gid_to_msg(&reader_gid, &info.reader_gid_seq.back());
+      reader_nodes_.emplace(
+        reader_gid,
+        rmw_dds_common::EntityNodeInfo{participant_gid, info.node_name, info.node_namespace});
     };
   auto msg = __modify_node_info(
     participant_gid, node_name, node_namespace, add_reader_gid, participants_);
@@ -357,7 +587,7 @@ GraphCache::dissociate_reader(
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  ExclusiveLock guard(mutex_);
   rmw_dds_common::msg::Gid reader_gid_msg;
   convert_gid_to_msg(&reader_gid, &reader_gid_msg);
   auto delete_reader_gid = [&](rmw_dds_common::msg::NodeEntitiesInfo & info)
@@ -375,27 +605,39 @@ GraphCache::dissociate_reader(
     };
   auto msg = __modify_node_info(
     participant_gid, node_name, node_namespace, delete_reader_gid, participants_);
+  __reindex_entity_node(
+    reader_nodes_, participants_, participant_gid, reader_gid, true);
 
   GRAPH_CACHE_CALL_ON_CHANGE_CALLBACK(this);
   return msg;
 }
 
+static
+const GraphCache::GidSet *
+__get_topic_gids(
+  const GraphCache::TopicNameToInfo & topics,
+  const std::string & topic_name,
+  bool is_reader)
+{
+  auto it = topics.find(topic_name);
+  if (it == topics.end()) {
+    return nullptr;
+  }
+  return is_reader ? &it->second.reader_gids : &it->second.writer_gids;
+}
+
 static
 rmw_ret_t
 __get_count(
-  const GraphCache::EntityGidToInfo & entities,
-  std::string topic_name,
+  const GraphCache::TopicNameToInfo & topics,
+  const std::string & topic_name,
+  bool is_reader,
   size_t * count)
 {
   assert(count);
 
-  *count = std::count_if(
-    entities.begin(),
-    entities.end(),
-    [&topic_name](const GraphCache::EntityGidToInfo::value_type & elem)
-    {
-      return elem.second.topic_name == topic_name;
-    });
+  const GraphCache::GidSet * gids = __get_topic_gids(topics, topic_name, is_reader);
+  *count = nullptr == gids ? 0u : gids->size();
   return RMW_RET_OK;
 }
 
@@ -404,11 +646,11 @@ GraphCache::get_writer_count(
   const std::string & topic_name,
   size_t * count) const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   if (!count) {
     return RMW_RET_INVALID_ARGUMENT;
   }
-  return __get_count(data_writers_, topic_name, count);
+  return __get_count(topics_, topic_name, false, count);
 }
 
 rmw_ret_t
@@ -416,11 +658,11 @@ GraphCache::get_reader_count(
   const std::string & topic_name,
   size_t * count) const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   if (!count) {
     return RMW_RET_INVALID_ARGUMENT;
   }
-  return __get_count(data_readers_, topic_name, count);
+  return __get_count(topics_, topic_name, true, count);
 }
 
 enum class EndpointCreator
@@ -434,26 +676,16 @@ static
 std::tuple<std::string, std::string, EndpointCreator>
 __find_name_and_namespace_from_entity_gid(
   const GraphCache::ParticipantToNodesMap & participant_map,
+  const GraphCache::EntityGidToNode & entity_nodes,
   rmw_gid_t participant_gid,
-  rmw_gid_t entity_gid,
-  bool is_reader)
+  rmw_gid_t entity_gid)
 {
-  auto it = participant_map.find(participant_gid);
-  if (participant_map.end() == it) {
+  if (participant_map.end() == participant_map.find(participant_gid)) {
     return {"", "", EndpointCreator::BARE_DDS_PARTICIPANT};
   }
-  for (const auto & node_info : it->second.node_entities_info_seq) {
-    auto & gid_seq = is_reader ? node_info.reader_gid_seq : node_info.writer_gid_seq;
-    auto it = std::find_if(
-      gid_seq.begin(),
-      gid_seq.end(),
-      [&](const rmw_dds_common::msg::Gid & gid) -> bool {
-        return 0u == std::memcmp(gid.data.data(), entity_gid.data, RMW_GID_STORAGE_SIZE);
-      }
-    );
-    if (gid_seq.end() != it) {
-      return {node_info.node_name, node_info.node_namespace, EndpointCreator::ROS_NODE};
-    }
+  auto it = entity_nodes.find(entity_gid);
+  if (entity_nodes.end() != it && it->second.participant_gid == participant_gid) {
+    return {it->second.node_name, it->second.node_namespace, EndpointCreator::ROS_NODE};
   }
   return {"", "", EndpointCreator::UNDISCOVERED_ROS_NODE};
 }
@@ -464,7 +696,9 @@ static
 rmw_ret_t
 __get_entities_info_by_topic(
   const GraphCache::EntityGidToInfo & entities,
+  const GraphCache::TopicNameToInfo & topics,
   const GraphCache::ParticipantToNodesMap & participant_map,
+  const GraphCache::EntityGidToNode & entity_nodes,
   const std::string & topic_name,
   DemangleFunctionT demangle_type,
   bool is_reader,
@@ -474,20 +708,11 @@ __get_entities_info_by_topic(
   assert(allocator);
   assert(endpoints_info);
 
-  if (0u == entities.size()) {
-    return RMW_RET_OK;
-  }
-
-  size_t size = std::count_if(
-    entities.begin(),
-    entities.end(),
-    [&topic_name](const GraphCache::EntityGidToInfo::value_type & item) {
-      return item.second.topic_name == topic_name;
-    }
-  );
-  if (0u == size) {
+  const GraphCache::GidSet * gids = __get_topic_gids(topics, topic_name, is_reader);
+  if (nullptr == gids || 0u == gids->size()) {
     return RMW_RET_OK;
   }
+  size_t size = gids->size();
 
   rmw_ret_t ret = rmw_topic_endpoint_info_array_init_with_size(
     endpoints_info,
@@ -515,19 +740,19 @@ __get_entities_info_by_topic(
   );
 
   size_t i = 0;
-  for (const auto & entity_pair : entities) {
-    if (entity_pair.second.topic_name != topic_name) {
-      continue;
-    }
+  for (const auto & gid : *gids) {
+    auto entity_it = entities.find(gid);
+    assert(entity_it != entities.end());
+    const auto & entity_pair = *entity_it;
 
     rmw_topic_endpoint_info_t & endpoint_info = endpoints_info->info_array[i];
     endpoint_info = rmw_get_zero_initialized_topic_endpoint_info();
 
     auto result = __find_name_and_namespace_from_entity_gid(
       participant_map,
+      entity_nodes,
       entity_pair.second.participant_gid,
-      entity_pair.first,
-      is_reader);
+      entity_pair.first);
 
     std::string node_name;
     std::string node_namespace;
@@ -605,10 +830,12 @@ GraphCache::get_writers_info_by_topic(
   rcutils_allocator_t * allocator,
   rmw_topic_endpoint_info_array_t * endpoints_info) const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
+  SharedLock lock(mutex_);
   return __get_entities_info_by_topic(
     data_writers_,
+    topics_,
     participants_,
+    writer_nodes_,
     topic_name,
     demangle_type,
     false,
@@ -623,10 +850,12 @@ GraphCache::get_readers_info_by_topic(
   rcutils_allocator_t * allocator,
   rmw_topic_endpoint_info_array_t * endpoints_info) const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
+  SharedLock lock(mutex_);
   return __get_entities_info_by_topic(
     data_readers_,
+    topics_,
     participants_,
+    reader_nodes_,
     topic_name,
     demangle_type,
     true,
@@ -634,22 +863,26 @@ GraphCache::get_readers_info_by_topic(
     endpoints_info);
 }
 
-using NamesAndTypes = std::map<std::string, std::set<std::string>>;
+using NamesAndTypes = GraphCache::NamesAndTypes;
 
 static
 void
 __get_names_and_types(
-  const GraphCache::EntityGidToInfo & entities,
+  const GraphCache::TopicNameToInfo & topics_index,
   DemangleFunctionT demangle_topic,
   DemangleFunctionT demangle_type,
   NamesAndTypes & topics)
 {
   assert(nullptr != demangle_topic);
   assert(nullptr != demangle_type);
-  for (const auto & item : entities) {
-    std::string demangled_topic_name = demangle_topic(item.second.topic_name);
-    if ("" != demangled_topic_name) {
-      topics[demangled_topic_name].insert(demangle_type(item.second.topic_type));
+  for (const auto & item : topics_index) {
+    std::string demangled_topic_name = demangle_topic(item.first);
+    if ("" == demangled_topic_name) {
+      continue;
+    }
+    auto & types = topics[demangled_topic_name];
+    for (const auto & type : item.second.types) {
+      types.insert(demangle_type(type.first));
     }
   }
 }
@@ -657,7 +890,7 @@ __get_names_and_types(
 static
 rmw_ret_t
 __populate_rmw_names_and_types(
-  NamesAndTypes topics,
+  const NamesAndTypes & topics,
   rcutils_allocator_t * allocator,
   rmw_names_and_types_t * topic_names_and_types)
 {
@@ -732,42 +965,92 @@ GraphCache::get_names_and_types(
   // TODO(ivanpauno): Avoid using an intermediate representation.
   // We need a way to reallocate `topic_names_and_types.names` and `topic_names_and_types.names`.
   // Or have a good guess of the size (lower bound), and then shrink.
-  NamesAndTypes topics;
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    __get_names_and_types(
-      data_readers_,
-      demangle_topic,
-      demangle_type,
-      topics);
-    __get_names_and_types(
-      data_writers_,
-      demangle_topic,
-      demangle_type,
-      topics);
-  }
+  std::shared_ptr<const NamesAndTypes> topics =
+    get_cached_names_and_types(demangle_topic, demangle_type);
 
   return __populate_rmw_names_and_types(
-    topics,
+    *topics,
     allocator,
     topic_names_and_types);
 }
 
+std::shared_ptr<const NamesAndTypes>
+GraphCache::get_cached_names_and_types(
+  DemangleFunctionT demangle_topic,
+  DemangleFunctionT demangle_type) const
+{
+  // Results can only be reused when the demangling functions are plain functions,
+  // as arbitrary callables can't be compared.
+  const DemangleFunctionPtrT * demangle_topic_ptr = demangle_topic.target<DemangleFunctionPtrT>();
+  const DemangleFunctionPtrT * demangle_type_ptr = demangle_type.target<DemangleFunctionPtrT>();
+  const bool cacheable = nullptr != demangle_topic_ptr && nullptr != demangle_type_ptr;
+
+  // The graph version can't change while the graph is locked, but other queries can fill the
+  // cache concurrently: the cache is only locked to look it up and to store a new result.
+  SharedLock guard(mutex_);
+  auto find_entry = [&]() {
+      return std::find_if(
+        names_and_types_cache_.begin(),
+        names_and_types_cache_.end(),
+        [&](const NamesAndTypesCacheEntry & entry) {
+          return entry.demangle_topic == *demangle_topic_ptr &&
+          entry.demangle_type == *demangle_type_ptr;
+        });
+    };
+  if (cacheable) {
+    std::lock_guard<std::mutex> cache_guard(names_and_types_cache_mutex_);
+    auto cache_it = find_entry();
+    if (cache_it != names_and_types_cache_.end() && cache_it->graph_version == graph_version_) {
+      return cache_it->names_and_types;
+    }
+  }
+
+  auto topics = std::make_shared<NamesAndTypes>();
+  __get_names_and_types(topics_, demangle_topic, demangle_type, *topics);
+  std::shared_ptr<const NamesAndTypes> result = std::move(topics);
+
+  if (cacheable) {
+    // The result replaced in the cache is released after unlocking it
+    std::shared_ptr<const NamesAndTypes> replaced = result;
+    std::lock_guard<std::mutex> cache_guard(names_and_types_cache_mutex_);
+    auto cache_it = find_entry();
+    if (cache_it == names_and_types_cache_.end()) {
+      cache_it = names_and_types_cache_.emplace(
+        names_and_types_cache_.end(),
+        NamesAndTypesCacheEntry{0u, *demangle_topic_ptr, *demangle_type_ptr, nullptr});
+    } else if (cache_it->graph_version == graph_version_) {
+      // Another query built the same result in the meantime
+      return cache_it->names_and_types;
+    }
+    cache_it->graph_version = graph_version_;
+    cache_it->names_and_types.swap(replaced);
+  }
+  return result;
+}
+
 static
 const rmw_dds_common::msg::NodeEntitiesInfo *
 __find_node(
   const GraphCache::ParticipantToNodesMap & participant_map,
+  const GraphCache::NodeKeyToParticipants & nodes,
   const std::string & node_name,
   const std::string & node_namespace)
 {
-  for (const auto & participant : participant_map) {
-    for (const auto & node : participant.second.node_entities_info_seq) {
-      if (
-        node.node_name == node_name &&
-        node.node_namespace == node_namespace)
-      {
-        return &node;
-      }
+  auto node_it = nodes.find(std::make_pair(node_namespace, node_name));
+  if (node_it == nodes.end() || node_it->second.empty()) {
+    return nullptr;
+  }
+  // Participants are ordered in the same way in both maps, so the first one is used.
+  auto participant_it = participant_map.find(node_it->second.begin()->first);
+  if (participant_it == participant_map.end()) {
+    return nullptr;
+  }
+  for (const auto & node : participant_it->second.node_entities_info_seq) {
+    if (
+      node.node_name == node_name &&
+      node.node_namespace == node_namespace)
+    {
+      return &node;
     }
   }
   return nullptr;
@@ -806,6 +1089,7 @@ static
 rmw_ret_t
 __get_names_and_types_by_node(
   const GraphCache::ParticipantToNodesMap & participants_map,
+  const GraphCache::NodeKeyToParticipants & nodes,
   const GraphCache::EntityGidToInfo & entities_map,
   const std::string & node_name,
   const std::string & namespace_,
@@ -825,6 +1109,7 @@ __get_names_and_types_by_node(
 
   auto node_info_ptr = __find_node(
     participants_map,
+    nodes,
     node_name,
     namespace_);
 
@@ -860,9 +1145,10 @@ GraphCache::get_writer_names_and_types_by_node(
   rcutils_allocator_t * allocator,
   rmw_names_and_types_t * topic_names_and_types) const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   return __get_names_and_types_by_node(
     participants_,
+    nodes_,
     data_writers_,
     node_name,
     namespace_,
@@ -889,9 +1175,10 @@ GraphCache::get_reader_names_and_types_by_node(
   rcutils_allocator_t * allocator,
   rmw_names_and_types_t * topic_names_and_types) const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   return __get_names_and_types_by_node(
     participants_,
+    nodes_,
     data_readers_,
     node_name,
     namespace_,
@@ -916,7 +1203,7 @@ __get_number_of_nodes(const GraphCache::ParticipantToNodesMap & participants_map
 size_t
 GraphCache::get_number_of_nodes() const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   return __get_number_of_nodes(participants_);
 }
 
@@ -927,7 +1214,7 @@ GraphCache::get_node_names(
   rcutils_string_array_t * enclaves,
   rcutils_allocator_t * allocator) const
 {
-  std::lock_guard<std::mutex> guard(mutex_);
+  SharedLock guard(mutex_);
   if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_names)) {
     return RMW_RET_INVALID_ARGUMENT;
   }
@@ -1016,7 +1303,7 @@ fail:
 std::ostream &
 rmw_dds_common::operator<<(std::ostream & ostream, const GraphCache & graph_cache)
 {
-  std::lock_guard<std::mutex> guard(graph_cache.mutex_);
+  SharedLock guard(graph_cache.mutex_);
   std::ostringstream ss;
 
   ss << "---------------------------------" << std::endl;
@@ -403,3 +403,158 @@ BENCHMARK_F(TestGraphCache, associate_entities_benchmark)(benchmark::State & st)
     });
   }
 }
+
+constexpr size_t kLargeGraphParticipants = 10u;
+constexpr size_t kLargeGraphNodesPerParticipant = 10u;
+constexpr size_t kLargeGraphTopics = 100u;
+constexpr size_t kLargeGraphEntitiesPerNode = 20u;
+
+class TestLargeGraphCache : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    size_t entity_index = 0u;
+    for (size_t p = 0u; p < kLargeGraphParticipants; ++p) {
+      std::string participant_gid = "participant" + std::to_string(p);
+      add_participants(graph_cache, {participant_gid});
+      for (size_t n = 0u; n < kLargeGraphNodesPerParticipant; ++n) {
+        NodeInfo node{participant_gid, "ns" + std::to_string(p), "node" + std::to_string(n)};
+        add_nodes(graph_cache, {node});
+        for (size_t e = 0u; e < kLargeGraphEntitiesPerNode; ++e, ++entity_index) {
+          bool is_reader = 0u == (e % 2u);
+          EntityInfo entity{
+            (is_reader ? "reader" : "writer") + std::to_string(entity_index),
+            participant_gid,
+            "topic" + std::to_string(entity_index % kLargeGraphTopics),
+            "Str",
+            is_reader};
+          add_entities(graph_cache, {entity});
+          associate_entities(
+            graph_cache,
+            {{entity.gid, is_reader, participant_gid, node.namespace_, node.name}});
+        }
+      }
+    }
+    performance_test_fixture::PerformanceTest::SetUp(st);
+  }
+  void TearDown(::benchmark::State & st)
+  {
+    performance_test_fixture::PerformanceTest::TearDown(st);
+  }
+
+protected:
+  GraphCache graph_cache;
+};
+
+BENCHMARK_F(TestLargeGraphCache, get_names_and_types_benchmark)(benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : st) {
+    rmw_names_and_types_t names_and_types = rmw_get_zero_initialized_names_and_types();
+    rmw_ret_t ret = graph_cache.get_names_and_types(
+      identity_demangle,
+      identity_demangle,
+      &allocator,
+      &names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("get_names_and_types failed");
+    }
+    ret = rmw_names_and_types_fini(&names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("rmw_names_and_types_fini failed");
+    }
+  }
+}
+
+BENCHMARK_F(TestLargeGraphCache, get_names_and_types_after_change_benchmark)(
+  benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : st) {
+    // Invalidate the cached result, so that it has to be computed again.
+    add_entities(graph_cache, {{"extra_reader", "participant0", "extra_topic", "Str", true}});
+    remove_entities(graph_cache, {{"extra_reader", "participant0", "extra_topic", "Str", true}});
+    rmw_names_and_types_t names_and_types = rmw_get_zero_initialized_names_and_types();
+    rmw_ret_t ret = graph_cache.get_names_and_types(
+      identity_demangle,
+      identity_demangle,
+      &allocator,
+      &names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("get_names_and_types failed");
+    }
+    ret = rmw_names_and_types_fini(&names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("rmw_names_and_types_fini failed");
+    }
+  }
+}
+
+BENCHMARK_F(TestLargeGraphCache, get_writer_count_benchmark)(benchmark::State & st)
+{
+  size_t count;
+  for (auto _ : st) {
+    rmw_ret_t ret = graph_cache.get_writer_count("topic51", &count);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("get_writer_count failed");
+    }
+  }
+}
+
+BENCHMARK_F(TestLargeGraphCache, get_readers_info_by_topic_benchmark)(benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : st) {
+    rmw_topic_endpoint_info_array_t info = rmw_get_zero_initialized_topic_endpoint_info_array();
+    rmw_ret_t ret = graph_cache.get_readers_info_by_topic(
+      "topic50",
+      identity_demangle,
+      &allocator,
+      &info);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("get_readers_info_by_topic failed");
+    }
+    ret = rmw_topic_endpoint_info_array_fini(&info, &allocator);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("rmw_topic_endpoint_info_array_fini failed");
+    }
+  }
+}
+
+BENCHMARK_F(TestLargeGraphCache, get_reader_names_and_types_by_node_benchmark)(
+  benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : st) {
+    rmw_names_and_types_t names_and_types = rmw_get_zero_initialized_names_and_types();
+    rmw_ret_t ret = graph_cache.get_reader_names_and_types_by_node(
+      "node9",
+      "ns9",
+      identity_demangle,
+      identity_demangle,
+      &allocator,
+      &names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("get_reader_names_and_types_by_node failed");
+    }
+    ret = rmw_names_and_types_fini(&names_and_types);
+    if (ret != RMW_RET_OK) {
+      st.SkipWithError("rmw_names_and_types_fini failed");
+    }
+  }
+}
+
+BENCHMARK_F(TestLargeGraphCache, add_remove_entity_benchmark)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    add_entities(graph_cache, {{"extra_writer", "participant5", "topic5", "Str", false}});
+    associate_entities(graph_cache, {{"extra_writer", false, "participant5", "ns5", "node5"}});
+    dissociate_entities(graph_cache, {{"extra_writer", false, "participant5", "ns5", "node5"}});
+    remove_entities(graph_cache, {{"extra_writer", "participant5", "topic5", "Str", false}});
+  }
+}
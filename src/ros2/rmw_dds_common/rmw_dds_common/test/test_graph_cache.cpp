@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -1243,6 +1244,91 @@ TEST(test_graph_cache, normal_usage)
   EXPECT_FALSE(change_callback_called);
 }
 
+TEST(test_graph_cache, graph_version)
+{
+  GraphCache graph_cache;
+  uint64_t version = graph_cache.get_graph_version();
+
+  check_results(graph_cache, {}, {});
+
+  // Adding a participant changes the graph.
+  add_participants(graph_cache, {"participant1"});
+  EXPECT_LT(version, graph_cache.get_graph_version());
+  version = graph_cache.get_graph_version();
+
+  add_entities(graph_cache, {{"reader1", "participant1", "topic1", "Str", true}});
+  EXPECT_LT(version, graph_cache.get_graph_version());
+  version = graph_cache.get_graph_version();
+  // Cached names and types are refreshed after a change.
+  check_results(graph_cache, {}, {{"topic1", {"Str"}}});
+
+  add_entities(graph_cache, {{"writer1", "participant1", "topic2", "Int", false}});
+  EXPECT_LT(version, graph_cache.get_graph_version());
+  version = graph_cache.get_graph_version();
+  check_results(graph_cache, {}, {{"topic1", {"Str"}}, {"topic2", {"Int"}}});
+
+  // Adding the same entity twice doesn't change the graph.
+  EXPECT_FALSE(
+    graph_cache.add_entity(
+      gid_from_string("writer1"),
+      "topic2",
+      "Int",
+      gid_from_string("participant1"),
+      rmw_qos_profile_default,
+      false));
+  EXPECT_EQ(version, graph_cache.get_graph_version());
+
+  remove_entities(graph_cache, {{"reader1", "participant1", "topic1", "Str", true}});
+  EXPECT_LT(version, graph_cache.get_graph_version());
+  check_results(graph_cache, {}, {{"topic2", {"Int"}}});
+}
+
+TEST(test_graph_cache, concurrent_names_and_types_queries)
+{
+  GraphCache graph_cache;
+  add_participants(graph_cache, {"participant1"});
+  add_entities(graph_cache, {{"reader1", "participant1", "topic1", "Str", true}});
+
+  // Queries see topic2 come and go, but always get a complete result
+  const EntityInfo writer{"writer1", "participant1", "topic2", "Int", false};
+  std::thread updater(
+    [&]() {
+      for (int i = 0; i < 200; ++i) {
+        add_entities(graph_cache, {writer});
+        remove_entities(graph_cache, {writer});
+      }
+    });
+  std::vector<std::thread> queriers;
+  for (int t = 0; t < 4; ++t) {
+    queriers.emplace_back(
+      [&]() {
+        rcutils_allocator_t allocator = rcutils_get_default_allocator();
+        for (int i = 0; i < 200; ++i) {
+          rmw_names_and_types_t names_and_types = rmw_get_zero_initialized_names_and_types();
+          ASSERT_EQ(
+            RMW_RET_OK,
+            graph_cache.get_names_and_types(
+              identity_demangle, identity_demangle, &allocator, &names_and_types));
+          ASSERT_LE(1u, names_and_types.names.size);
+          ASSERT_GE(2u, names_and_types.names.size);
+          EXPECT_STREQ("topic1", names_and_types.names.data[0]);
+          ASSERT_EQ(1u, names_and_types.types[0].size);
+          EXPECT_STREQ("Str", names_and_types.types[0].data[0]);
+          if (2u == names_and_types.names.size) {
+            EXPECT_STREQ("topic2", names_and_types.names.data[1]);
+          }
+          EXPECT_EQ(RMW_RET_OK, rmw_names_and_types_fini(&names_and_types));
+        }
+      });
+  }
+  updater.join();
+  for (auto & querier : queriers) {
+    querier.join();
+  }
+
+  check_results(graph_cache, {}, {{"topic1", {"Str"}}});
+}
+
 TEST(test_graph_cache, test_operator)
 {
   GraphCache graph_cache;
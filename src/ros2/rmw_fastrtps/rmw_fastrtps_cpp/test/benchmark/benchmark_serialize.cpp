@@ -0,0 +1,162 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/identifier.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
+
+#include "sensor_msgs/msg/point_cloud2.hpp"
+#include "visualization_msgs/msg/marker_array.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+
+visualization_msgs::msg::MarkerArray make_marker_array(size_t markers, size_t points)
+{
+  visualization_msgs::msg::MarkerArray marker_array;
+  marker_array.markers.resize(markers);
+  for (size_t i = 0; i < markers; ++i) {
+    visualization_msgs::msg::Marker & marker = marker_array.markers[i];
+    marker.header.frame_id = "base_link";
+    marker.ns = "benchmark";
+    marker.id = static_cast<int32_t>(i);
+    marker.type = visualization_msgs::msg::Marker::POINTS;
+    marker.points.resize(points);
+    marker.colors.resize(points);
+  }
+  return marker_array;
+}
+
+sensor_msgs::msg::PointCloud2 make_point_cloud(uint32_t width, uint32_t height)
+{
+  sensor_msgs::msg::PointCloud2 point_cloud;
+  point_cloud.header.frame_id = "camera";
+  point_cloud.width = width;
+  point_cloud.height = height;
+  for (const char * name : {"x", "y", "z", "rgb"}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(point_cloud.fields.size() * sizeof(float));
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    point_cloud.fields.push_back(field);
+  }
+  point_cloud.point_step = static_cast<uint32_t>(point_cloud.fields.size() * sizeof(float));
+  point_cloud.row_step = point_cloud.point_step * width;
+  point_cloud.data.resize(point_cloud.row_step * height);
+  return point_cloud;
+}
+
+const message_type_support_callbacks_t * get_callbacks(
+  const rosidl_message_type_support_t * type_support)
+{
+  const rosidl_message_type_support_t * fastrtps_type_support = get_message_typesupport_handle(
+    type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier);
+  return static_cast<const message_type_support_callbacks_t *>(fastrtps_type_support->data);
+}
+
+}  // namespace
+
+class SerializePerformanceTest : public PerformanceTest
+{
+protected:
+  /// Measure the sizing pass done before every publication.
+  template<typename MessageT>
+  void get_serialized_size(benchmark::State & state, const MessageT & message)
+  {
+    const message_type_support_callbacks_t * callbacks =
+      get_callbacks(rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>());
+
+    reset_heap_counters();
+    for (auto _ : state) {
+      uint32_t size = callbacks->get_serialized_size(&message);
+      benchmark::DoNotOptimize(size);
+    }
+  }
+
+  /// Measure the sizing pass followed by the serialization.
+  template<typename MessageT>
+  void serialize(benchmark::State & state, const MessageT & message)
+  {
+    const rosidl_message_type_support_t * type_support =
+      rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
+
+    rmw_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    if (RMW_RET_OK != rmw_serialized_message_init(&serialized_message, 0u, &allocator)) {
+      state.SkipWithError(rmw_get_error_string().str);
+      rmw_reset_error();
+      return;
+    }
+    // Warmup, so the buffer is already big enough
+    if (RMW_RET_OK != rmw_serialize(&message, type_support, &serialized_message)) {
+      state.SkipWithError(rmw_get_error_string().str);
+      rmw_reset_error();
+    }
+
+    reset_heap_counters();
+    for (auto _ : state) {
+      if (RMW_RET_OK != rmw_serialize(&message, type_support, &serialized_message)) {
+        state.SkipWithError(rmw_get_error_string().str);
+        rmw_reset_error();
+        break;
+      }
+    }
+    state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * serialized_message.buffer_length));
+
+    if (RMW_RET_OK != rmw_serialized_message_fini(&serialized_message)) {
+      rmw_reset_error();
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(SerializePerformanceTest, marker_array_get_serialized_size)(
+  benchmark::State & st)
+{
+  get_serialized_size(st, make_marker_array(static_cast<size_t>(st.range(0)), 100));
+}
+BENCHMARK_REGISTER_F(SerializePerformanceTest, marker_array_get_serialized_size)
+->Arg(10)->Arg(1000);
+
+BENCHMARK_DEFINE_F(SerializePerformanceTest, marker_array_serialize)(benchmark::State & st)
+{
+  serialize(st, make_marker_array(static_cast<size_t>(st.range(0)), 100));
+}
+BENCHMARK_REGISTER_F(SerializePerformanceTest, marker_array_serialize)->Arg(10)->Arg(1000);
+
+BENCHMARK_DEFINE_F(SerializePerformanceTest, point_cloud2_get_serialized_size)(
+  benchmark::State & st)
+{
+  get_serialized_size(st, make_point_cloud(640, 480));
+}
+BENCHMARK_REGISTER_F(SerializePerformanceTest, point_cloud2_get_serialized_size);
+
+BENCHMARK_DEFINE_F(SerializePerformanceTest, point_cloud2_serialize)(benchmark::State & st)
+{
+  serialize(st, make_point_cloud(640, 480));
+}
+BENCHMARK_REGISTER_F(SerializePerformanceTest, point_cloud2_serialize);
@@ -59,6 +59,7 @@ MessageTypeSupport<MembersType>::MessageTypeSupport(
   } else {
     this->m_typeSize++;
   }
+  this->compileSerializationPlan();
 }
 
 }  // namespace rmw_fastrtps_dynamic_cpp
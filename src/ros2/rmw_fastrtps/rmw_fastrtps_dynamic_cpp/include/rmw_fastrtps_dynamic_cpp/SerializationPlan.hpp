@@ -0,0 +1,209 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_FASTRTPS_DYNAMIC_CPP__SERIALIZATIONPLAN_HPP_
+#define RMW_FASTRTPS_DYNAMIC_CPP__SERIALIZATIONPLAN_HPP_
+
+#include <fastcdr/Cdr.h>
+
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+
+namespace rmw_fastrtps_dynamic_cpp
+{
+
+template<typename MembersType>
+struct SerializationPlan;
+
+/// One step of a SerializationPlan.
+template<typename MembersType>
+struct SerializationStep
+{
+  using MemberType = typename std::remove_pointer<decltype(MembersType::members_)>::type;
+
+  enum Kind
+  {
+    // Bytes whose CDR representation is the same as in memory, in native endianness
+    SPAN,
+    // A member serialized on its own: bool, string or sequence of primitives
+    MEMBER,
+    // An array or a sequence of nested messages
+    MESSAGE_ARRAY
+  };
+
+  Kind kind;
+  // Offset of the data from the start of the message the plan is for
+  size_t offset;
+  // SPAN only: number of bytes, and CDR alignment of the first of them
+  size_t size;
+  size_t alignment;
+  // MEMBER and MESSAGE_ARRAY only: introspection data of the member
+  const MemberType * member;
+  // MESSAGE_ARRAY only: plan of every item
+  const SerializationPlan<MembersType> * item_plan;
+};
+
+/// Flat list of steps needed to serialize, deserialize or compute the size of a message.
+/**
+ * Nested messages that are not in arrays are inlined, and consecutive primitives laid out in
+ * memory exactly as CDR would lay them out are collapsed into a single SPAN copied at once.
+ */
+template<typename MembersType>
+struct SerializationPlan
+{
+  std::vector<SerializationStep<MembersType>> steps;
+  // Size of the message in memory
+  size_t size_of = 0;
+
+  /// Whether the whole message is a single SPAN, so that arrays of it can be copied at once.
+  bool is_plain() const
+  {
+    return steps.size() == 1 && steps[0].kind == SerializationStep<MembersType>::SPAN &&
+           steps[0].offset == 0 && steps[0].size == size_of &&
+           size_of % steps[0].alignment == 0;
+  }
+};
+
+/// Compiles and owns the serialization plans of a message type and of its nested types.
+template<typename MembersType>
+class SerializationPlans
+{
+public:
+  using Plan = SerializationPlan<MembersType>;
+  using Step = SerializationStep<MembersType>;
+  using MemberType = typename Step::MemberType;
+
+  /// Get the plan for a message type, compiling it if needed.
+  const Plan * get(const MembersType * members)
+  {
+    auto it = plans_.find(members);
+    if (it != plans_.end()) {
+      return it->second.get();
+    }
+
+    std::unique_ptr<Plan> plan(new Plan());
+    plan->size_of = members->size_of_;
+    append(*plan, members, 0);
+    return plans_.emplace(members, std::move(plan)).first->second.get();
+  }
+
+private:
+  /// Size of a primitive that can be part of a SPAN, or 0.
+  static size_t span_item_size(uint8_t type_id)
+  {
+    switch (type_id) {
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+        return 1;
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+        return 2;
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+        return 4;
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+        return 8;
+      default:
+        // Bools are normalized one by one, the rest has a variable size
+        return 0;
+    }
+  }
+
+  static bool is_fixed_size_array(const MemberType * member)
+  {
+    return member->is_array_ && member->array_size_ && !member->is_upper_bound_;
+  }
+
+  void append(Plan & plan, const MembersType * members, size_t base_offset)
+  {
+    for (uint32_t i = 0; i < members->member_count_; ++i) {
+      const MemberType * member = members->members_ + i;
+      size_t offset = base_offset + member->offset_;
+
+      if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE) {
+        auto sub_members = static_cast<const MembersType *>(member->members_->data);
+        if (!member->is_array_) {
+          append(plan, sub_members, offset);
+          continue;
+        }
+
+        const Plan * item_plan = get(sub_members);
+        if (is_fixed_size_array(member) && item_plan->is_plain()) {
+          append_span(
+            plan, offset, item_plan->size_of * member->array_size_,
+            item_plan->steps[0].alignment);
+        } else {
+          Step step{};
+          step.kind = Step::MESSAGE_ARRAY;
+          step.offset = offset;
+          step.member = member;
+          step.item_plan = item_plan;
+          plan.steps.push_back(step);
+        }
+        continue;
+      }
+
+      size_t item_size = span_item_size(member->type_id_);
+      if (item_size != 0 && (!member->is_array_ || is_fixed_size_array(member))) {
+        size_t count = member->is_array_ ? member->array_size_ : 1;
+        append_span(plan, offset, item_size * count, item_size);
+        continue;
+      }
+
+      Step step{};
+      step.kind = Step::MEMBER;
+      step.offset = offset;
+      step.member = member;
+      plan.steps.push_back(step);
+    }
+  }
+
+  static void append_span(Plan & plan, size_t offset, size_t size, size_t alignment)
+  {
+    if (!plan.steps.empty() && plan.steps.back().kind == Step::SPAN) {
+      Step & last = plan.steps.back();
+      // The start of the last span is aligned to last.alignment in the CDR stream, so the
+      // padding needed by a smaller alignment is known at this point.
+      if (alignment <= last.alignment) {
+        size_t cdr_offset = last.size + eprosima::fastcdr::Cdr::alignment(last.size, alignment);
+        if (offset >= last.offset && offset - last.offset == cdr_offset) {
+          last.size = cdr_offset + size;
+          return;
+        }
+      }
+    }
+
+    Step step{};
+    step.kind = Step::SPAN;
+    step.offset = offset;
+    step.size = size;
+    step.alignment = alignment;
+    plan.steps.push_back(step);
+  }
+
+  std::unordered_map<const MembersType *, std::unique_ptr<Plan>> plans_;
+};
+
+}  // namespace rmw_fastrtps_dynamic_cpp
+
+#endif  // RMW_FASTRTPS_DYNAMIC_CPP__SERIALIZATIONPLAN_HPP_
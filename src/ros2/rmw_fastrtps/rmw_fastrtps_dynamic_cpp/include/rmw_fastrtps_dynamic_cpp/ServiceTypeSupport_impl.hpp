@@ -57,6 +57,7 @@ RequestTypeSupport<ServiceMembersType, MessageMembersType>::RequestTypeSupport(
   } else {
     this->m_typeSize++;
   }
+  this->compileSerializationPlan();
 }
 
 template<typename ServiceMembersType, typename MessageMembersType>
@@ -87,6 +88,7 @@ ResponseTypeSupport<ServiceMembersType, MessageMembersType>::ResponseTypeSupport
   } else {
     this->m_typeSize++;
   }
+  this->compileSerializationPlan();
 }
 
 }  // namespace rmw_fastrtps_dynamic_cpp
@@ -27,6 +27,8 @@
 
 #include "rcutils/logging_macros.h"
 
+#include "rmw_fastrtps_dynamic_cpp/SerializationPlan.hpp"
+
 #include "rosidl_typesupport_introspection_cpp/field_types.hpp"
 #include "rosidl_typesupport_introspection_cpp/identifier.hpp"
 #include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
@@ -176,9 +178,47 @@ protected:
 
   size_t calculateMaxSerializedSize(const MembersType * members, size_t current_alignment);
 
+  /// Compile the serialization plan of members_, to be called once members_ is set.
+  void compileSerializationPlan();
+
   const MembersType * members_;
 
 private:
+  using Plan = SerializationPlan<MembersType>;
+  using MemberType = typename SerializationStep<MembersType>::MemberType;
+
+  size_t getEstimatedSerializedSize(
+    const Plan * plan,
+    const void * ros_message,
+    size_t current_alignment) const;
+
+  bool serializeROSmessage(
+    eprosima::fastcdr::Cdr & ser,
+    const Plan * plan,
+    const void * ros_message,
+    size_t origin) const;
+
+  bool deserializeROSmessage(
+    eprosima::fastcdr::Cdr & deser,
+    const Plan * plan,
+    void * ros_message,
+    size_t origin) const;
+
+  size_t getMemberEstimatedSerializedSize(
+    const MemberType * member,
+    void * field,
+    size_t current_alignment) const;
+
+  bool serializeMember(
+    eprosima::fastcdr::Cdr & ser,
+    const MemberType * member,
+    void * field) const;
+
+  bool deserializeMember(
+    eprosima::fastcdr::Cdr & deser,
+    const MemberType * member,
+    void * field) const;
+
   size_t getEstimatedSerializedSize(
     const MembersType * members,
     const void * ros_message,
@@ -193,6 +233,9 @@ private:
     eprosima::fastcdr::Cdr & deser,
     const MembersType * members,
     void * ros_message) const;
+
+  SerializationPlans<MembersType> plans_;
+  const Plan * plan_ = nullptr;
 };
 
 }  // namespace rmw_fastrtps_dynamic_cpp
@@ -235,92 +235,105 @@ bool TypeSupport<MembersType>::serializeROSmessage(
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto member = members->members_ + i;
     void * field = const_cast<char *>(static_cast<const char *>(ros_message)) + member->offset_;
-    switch (member->type_id_) {
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+    if (!serializeMember(ser, member, field)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::serializeMember(
+  eprosima::fastcdr::Cdr & ser,
+  const MemberType * member,
+  void * field) const
+{
+  switch (member->type_id_) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+      if (!member->is_array_) {
+        // don't cast to bool here because if the bool is
+        // uninitialized the random value can't be deserialized
+        ser << (*static_cast<uint8_t *>(field) ? true : false);
+      } else {
+        serialize_field<bool>(member, field, ser);
+      }
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      serialize_field<uint8_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      serialize_field<char>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      serialize_field<float>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      serialize_field<double>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      serialize_field<int16_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      serialize_field<uint16_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      serialize_field<int32_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      serialize_field<uint32_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      serialize_field<int64_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      serialize_field<uint64_t>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
+      serialize_field<std::string>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
+      serialize_field<std::wstring>(member, field, ser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+      {
+        auto sub_members = static_cast<const MembersType *>(member->members_->data);
         if (!member->is_array_) {
-          // don't cast to bool here because if the bool is
-          // uninitialized the random value can't be deserialized
-          ser << (*static_cast<uint8_t *>(field) ? true : false);
+          serializeROSmessage(ser, sub_members, field);
         } else {
-          serialize_field<bool>(member, field, ser);
-        }
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
-        serialize_field<uint8_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
-        serialize_field<char>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
-        serialize_field<float>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
-        serialize_field<double>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
-        serialize_field<int16_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
-        serialize_field<uint16_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
-        serialize_field<int32_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
-        serialize_field<uint32_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
-        serialize_field<int64_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
-        serialize_field<uint64_t>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
-        serialize_field<std::string>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
-        serialize_field<std::wstring>(member, field, ser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
-        {
-          auto sub_members = static_cast<const MembersType *>(member->members_->data);
-          if (!member->is_array_) {
-            serializeROSmessage(ser, sub_members, field);
-          } else {
-            size_t array_size = 0;
-
-            if (member->array_size_ && !member->is_upper_bound_) {
-              array_size = member->array_size_;
-            } else {
-              if (!member->size_function) {
-                RMW_SET_ERROR_MSG("unexpected error: size function is null");
-                return false;
-              }
-              array_size = member->size_function(field);
-
-              // Serialize length
-              ser << (uint32_t)array_size;
-            }
+          size_t array_size = 0;
 
-            if (array_size != 0 && !member->get_function) {
-              RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+          if (member->array_size_ && !member->is_upper_bound_) {
+            array_size = member->array_size_;
+          } else {
+            if (!member->size_function) {
+              RMW_SET_ERROR_MSG("unexpected error: size function is null");
               return false;
             }
-            for (size_t index = 0; index < array_size; ++index) {
-              serializeROSmessage(
-                ser, sub_members,
-                get_subros_message(
-                  member, field, index, member->array_size_,
-                  member->is_upper_bound_));
-            }
+            array_size = member->size_function(field);
+
+            // Serialize length
+            ser << (uint32_t)array_size;
+          }
+
+          if (array_size != 0 && !member->get_function) {
+            RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+            return false;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            serializeROSmessage(
+              ser, sub_members,
+              get_subros_message(
+                member, field, index, member->array_size_,
+                member->is_upper_bound_));
           }
         }
-        break;
-      default:
-        throw std::runtime_error("unknown type");
-    }
+      }
+      break;
+    default:
+      throw std::runtime_error("unknown type");
   }
 
   return true;
@@ -502,90 +515,101 @@ size_t TypeSupport<MembersType>::getEstimatedSerializedSize(
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto member = members->members_ + i;
     void * field = const_cast<char *>(static_cast<const char *>(ros_message)) + member->offset_;
-    switch (member->type_id_) {
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
-        current_alignment = next_field_align<bool>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
-        current_alignment = next_field_align<uint8_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
-        current_alignment = next_field_align<char>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
-        current_alignment = next_field_align<float>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
-        current_alignment = next_field_align<double>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
-        current_alignment = next_field_align<int16_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
-        current_alignment = next_field_align<uint16_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
-        current_alignment = next_field_align<int32_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
-        current_alignment = next_field_align<uint32_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
-        current_alignment = next_field_align<int64_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
-        current_alignment = next_field_align<uint64_t>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
-        current_alignment = next_field_align_string<std::string>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
-        current_alignment = next_field_align_string<std::wstring>(member, field, current_alignment);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
-        {
-          auto sub_members = static_cast<const MembersType *>(member->members_->data);
-          if (!member->is_array_) {
-            current_alignment += getEstimatedSerializedSize(sub_members, field, current_alignment);
-          } else {
-            size_t array_size = 0;
-
-            if (member->array_size_ && !member->is_upper_bound_) {
-              array_size = member->array_size_;
-            } else {
-              if (!member->size_function) {
-                RMW_SET_ERROR_MSG("unexpected error: size function is null");
-                return false;
-              }
-              array_size = member->size_function(field);
-
-              // Length serialization
-              current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
-            }
+    current_alignment = getMemberEstimatedSerializedSize(member, field, current_alignment);
+  }
 
-            if (array_size != 0 && !member->get_function) {
-              RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+  return current_alignment - initial_alignment;
+}
+
+template<typename MembersType>
+size_t TypeSupport<MembersType>::getMemberEstimatedSerializedSize(
+  const MemberType * member,
+  void * field,
+  size_t current_alignment) const
+{
+  switch (member->type_id_) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+      current_alignment = next_field_align<bool>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      current_alignment = next_field_align<uint8_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      current_alignment = next_field_align<char>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      current_alignment = next_field_align<float>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      current_alignment = next_field_align<double>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      current_alignment = next_field_align<int16_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      current_alignment = next_field_align<uint16_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      current_alignment = next_field_align<int32_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      current_alignment = next_field_align<uint32_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      current_alignment = next_field_align<int64_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      current_alignment = next_field_align<uint64_t>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
+      current_alignment = next_field_align_string<std::string>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
+      current_alignment = next_field_align_string<std::wstring>(member, field, current_alignment);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+      {
+        auto sub_members = static_cast<const MembersType *>(member->members_->data);
+        if (!member->is_array_) {
+          current_alignment += getEstimatedSerializedSize(sub_members, field, current_alignment);
+        } else {
+          size_t array_size = 0;
+
+          if (member->array_size_ && !member->is_upper_bound_) {
+            array_size = member->array_size_;
+          } else {
+            if (!member->size_function) {
+              RMW_SET_ERROR_MSG("unexpected error: size function is null");
               return false;
             }
-            for (size_t index = 0; index < array_size; ++index) {
-              current_alignment += getEstimatedSerializedSize(
-                sub_members,
-                get_subros_message(
-                  member, field, index, member->array_size_,
-                  member->is_upper_bound_),
-                current_alignment);
-            }
+            array_size = member->size_function(field);
+
+            // Length serialization
+            current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
+          }
+
+          if (array_size != 0 && !member->get_function) {
+            RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+            return false;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            current_alignment += getEstimatedSerializedSize(
+              sub_members,
+              get_subros_message(
+                member, field, index, member->array_size_,
+                member->is_upper_bound_),
+              current_alignment);
           }
         }
-        break;
-      default:
-        throw std::runtime_error("unknown type");
-    }
+      }
+      break;
+    default:
+      throw std::runtime_error("unknown type");
   }
 
-  return current_alignment - initial_alignment;
+  return current_alignment;
 }
 
 template<typename T>
@@ -757,87 +781,100 @@ bool TypeSupport<MembersType>::deserializeROSmessage(
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto * member = members->members_ + i;
     void * field = static_cast<char *>(ros_message) + member->offset_;
-    switch (member->type_id_) {
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
-        deserialize_field<bool>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
-        deserialize_field<uint8_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
-        deserialize_field<char>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
-        deserialize_field<float>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
-        deserialize_field<double>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
-        deserialize_field<int16_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
-        deserialize_field<uint16_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
-        deserialize_field<int32_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
-        deserialize_field<uint32_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
-        deserialize_field<int64_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
-        deserialize_field<uint64_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
-        deserialize_field<std::string>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
-        deserialize_field<std::wstring>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
-        {
-          auto sub_members = static_cast<const MembersType *>(member->members_->data);
-          if (!member->is_array_) {
-            deserializeROSmessage(deser, sub_members, field);
+    if (!deserializeMember(deser, member, field)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::deserializeMember(
+  eprosima::fastcdr::Cdr & deser,
+  const MemberType * member,
+  void * field) const
+{
+  switch (member->type_id_) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+      deserialize_field<bool>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      deserialize_field<uint8_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      deserialize_field<char>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      deserialize_field<float>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      deserialize_field<double>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      deserialize_field<int16_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      deserialize_field<uint16_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      deserialize_field<int32_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      deserialize_field<uint32_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      deserialize_field<int64_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      deserialize_field<uint64_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
+      deserialize_field<std::string>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
+      deserialize_field<std::wstring>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+      {
+        auto sub_members = static_cast<const MembersType *>(member->members_->data);
+        if (!member->is_array_) {
+          deserializeROSmessage(deser, sub_members, field);
+        } else {
+          size_t array_size = 0;
+
+          if (member->array_size_ && !member->is_upper_bound_) {
+            array_size = member->array_size_;
           } else {
-            size_t array_size = 0;
-
-            if (member->array_size_ && !member->is_upper_bound_) {
-              array_size = member->array_size_;
-            } else {
-              uint32_t num_elems = 0;
-              deser >> num_elems;
-              array_size = static_cast<size_t>(num_elems);
-
-              if (!member->resize_function) {
-                RMW_SET_ERROR_MSG("unexpected error: resize function is null");
-                return false;
-              }
-              member->resize_function(field, array_size);
-            }
+            uint32_t num_elems = 0;
+            deser >> num_elems;
+            array_size = static_cast<size_t>(num_elems);
 
-            if (array_size != 0 && !member->get_function) {
-              RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+            if (!member->resize_function) {
+              RMW_SET_ERROR_MSG("unexpected error: resize function is null");
               return false;
             }
-            for (size_t index = 0; index < array_size; ++index) {
-              deserializeROSmessage(
-                deser, sub_members,
-                get_subros_message(
-                  member, field, index, member->array_size_,
-                  member->is_upper_bound_));
-            }
+            member->resize_function(field, array_size);
+          }
+
+          if (array_size != 0 && !member->get_function) {
+            RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+            return false;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            deserializeROSmessage(
+              deser, sub_members,
+              get_subros_message(
+                member, field, index, member->array_size_,
+                member->is_upper_bound_));
           }
         }
-        break;
-      default:
-        throw std::runtime_error("unknown type");
-    }
+      }
+      break;
+    default:
+      throw std::runtime_error("unknown type");
   }
 
   return true;
@@ -921,6 +958,214 @@ size_t TypeSupport<MembersType>::calculateMaxSerializedSize(
   return current_alignment - initial_alignment;
 }
 
+template<typename MembersType>
+void TypeSupport<MembersType>::compileSerializationPlan()
+{
+  assert(members_);
+  plan_ = plans_.get(members_);
+}
+
+// Padding written before a span, at most the largest CDR alignment minus one
+static const char serialization_plan_padding[8] = {};
+
+template<typename MembersType>
+size_t TypeSupport<MembersType>::getEstimatedSerializedSize(
+  const Plan * plan,
+  const void * ros_message,
+  size_t current_alignment) const
+{
+  assert(plan);
+  assert(ros_message);
+
+  size_t initial_alignment = current_alignment;
+
+  for (const auto & step : plan->steps) {
+    void * field = const_cast<char *>(static_cast<const char *>(ros_message)) + step.offset;
+    switch (step.kind) {
+      case SerializationStep<MembersType>::SPAN:
+        current_alignment += eprosima::fastcdr::Cdr::alignment(current_alignment, step.alignment);
+        current_alignment += step.size;
+        break;
+      case SerializationStep<MembersType>::MEMBER:
+        current_alignment = getMemberEstimatedSerializedSize(
+          step.member, field, current_alignment);
+        break;
+      case SerializationStep<MembersType>::MESSAGE_ARRAY:
+        {
+          const auto member = step.member;
+          size_t array_size = member->array_size_;
+          if (!array_size || member->is_upper_bound_) {
+            array_size = member->size_function(field);
+            // Length serialization
+            current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
+          }
+          if (array_size == 0) {
+            break;
+          }
+
+          const Plan * item_plan = step.item_plan;
+          if (item_plan->is_plain()) {
+            current_alignment += eprosima::fastcdr::Cdr::alignment(
+              current_alignment, item_plan->steps[0].alignment);
+            current_alignment += array_size * item_plan->size_of;
+            break;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            current_alignment += getEstimatedSerializedSize(
+              item_plan,
+              get_subros_message(
+                member, field, index, member->array_size_, member->is_upper_bound_),
+              current_alignment);
+          }
+        }
+        break;
+    }
+  }
+
+  return current_alignment - initial_alignment;
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::serializeROSmessage(
+  eprosima::fastcdr::Cdr & ser,
+  const Plan * plan,
+  const void * ros_message,
+  size_t origin) const
+{
+  assert(plan);
+  assert(ros_message);
+
+  for (const auto & step : plan->steps) {
+    void * field = const_cast<char *>(static_cast<const char *>(ros_message)) + step.offset;
+    switch (step.kind) {
+      case SerializationStep<MembersType>::SPAN:
+        ser.serializeArray(
+          serialization_plan_padding,
+          eprosima::fastcdr::Cdr::alignment(
+            ser.getSerializedDataLength() - origin, step.alignment));
+        ser.serializeArray(static_cast<const char *>(field), step.size);
+        break;
+      case SerializationStep<MembersType>::MEMBER:
+        if (!serializeMember(ser, step.member, field)) {
+          return false;
+        }
+        break;
+      case SerializationStep<MembersType>::MESSAGE_ARRAY:
+        {
+          const auto member = step.member;
+          size_t array_size = member->array_size_;
+          if (!array_size || member->is_upper_bound_) {
+            array_size = member->size_function(field);
+            // Serialize length
+            ser << static_cast<uint32_t>(array_size);
+          }
+          if (array_size == 0) {
+            break;
+          }
+
+          const Plan * item_plan = step.item_plan;
+          if (item_plan->is_plain()) {
+            // Items are contiguous and laid out as in CDR, copy all of them at once
+            ser.serializeArray(
+              serialization_plan_padding,
+              eprosima::fastcdr::Cdr::alignment(
+                ser.getSerializedDataLength() - origin, item_plan->steps[0].alignment));
+            ser.serializeArray(
+              static_cast<const char *>(get_subros_message(
+                member, field, 0, member->array_size_, member->is_upper_bound_)),
+              array_size * item_plan->size_of);
+            break;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            if (
+              !serializeROSmessage(
+                ser, item_plan,
+                get_subros_message(
+                  member, field, index, member->array_size_, member->is_upper_bound_),
+                origin))
+            {
+              return false;
+            }
+          }
+        }
+        break;
+    }
+  }
+
+  return true;
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::deserializeROSmessage(
+  eprosima::fastcdr::Cdr & deser,
+  const Plan * plan,
+  void * ros_message,
+  size_t origin) const
+{
+  assert(plan);
+  assert(ros_message);
+
+  char padding[sizeof(serialization_plan_padding)];
+  for (const auto & step : plan->steps) {
+    void * field = static_cast<char *>(ros_message) + step.offset;
+    switch (step.kind) {
+      case SerializationStep<MembersType>::SPAN:
+        deser.deserializeArray(
+          padding,
+          eprosima::fastcdr::Cdr::alignment(
+            deser.getSerializedDataLength() - origin, step.alignment));
+        deser.deserializeArray(static_cast<char *>(field), step.size);
+        break;
+      case SerializationStep<MembersType>::MEMBER:
+        if (!deserializeMember(deser, step.member, field)) {
+          return false;
+        }
+        break;
+      case SerializationStep<MembersType>::MESSAGE_ARRAY:
+        {
+          const auto member = step.member;
+          size_t array_size = member->array_size_;
+          if (!array_size || member->is_upper_bound_) {
+            uint32_t num_elems = 0;
+            deser >> num_elems;
+            array_size = static_cast<size_t>(num_elems);
+            member->resize_function(field, array_size);
+          }
+          if (array_size == 0) {
+            break;
+          }
+
+          const Plan * item_plan = step.item_plan;
+          if (item_plan->is_plain()) {
+            deser.deserializeArray(
+              padding,
+              eprosima::fastcdr::Cdr::alignment(
+                deser.getSerializedDataLength() - origin, item_plan->steps[0].alignment));
+            deser.deserializeArray(
+              static_cast<char *>(get_subros_message(
+                member, field, 0, member->array_size_, member->is_upper_bound_)),
+              array_size * item_plan->size_of);
+            break;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            if (
+              !deserializeROSmessage(
+                deser, item_plan,
+                get_subros_message(
+                  member, field, index, member->array_size_, member->is_upper_bound_),
+                origin))
+            {
+              return false;
+            }
+          }
+        }
+        break;
+    }
+  }
+
+  return true;
+}
+
 template<typename MembersType>
 size_t TypeSupport<MembersType>::getEstimatedSerializedSize(
   const void * ros_message, const void * impl) const
@@ -937,7 +1182,11 @@ size_t TypeSupport<MembersType>::getEstimatedSerializedSize(
 
   (void)impl;
   if (members_->member_count_ != 0) {
-    ret_val += TypeSupport::getEstimatedSerializedSize(members_, ros_message, 0);
+    if (plan_) {
+      ret_val += TypeSupport::getEstimatedSerializedSize(plan_, ros_message, 0);
+    } else {
+      ret_val += TypeSupport::getEstimatedSerializedSize(members_, ros_message, 0);
+    }
   } else {
     ret_val += 1;
   }
@@ -957,7 +1206,12 @@ bool TypeSupport<MembersType>::serializeROSmessage(
 
   (void)impl;
   if (members_->member_count_ != 0) {
-    TypeSupport::serializeROSmessage(ser, members_, ros_message);
+    // Spans are copied as they are in memory, which is only valid in native endianness
+    if (plan_ && ser.endianness() == eprosima::fastcdr::Cdr::DEFAULT_ENDIAN) {
+      TypeSupport::serializeROSmessage(ser, plan_, ros_message, ser.getSerializedDataLength());
+    } else {
+      TypeSupport::serializeROSmessage(ser, members_, ros_message);
+    }
   } else {
     ser << (uint8_t)0;
   }
@@ -977,7 +1231,13 @@ bool TypeSupport<MembersType>::deserializeROSmessage(
 
   (void)impl;
   if (members_->member_count_ != 0) {
-    TypeSupport::deserializeROSmessage(deser, members_, ros_message);
+    // The encapsulation may announce data in the other endianness, which spans can't handle
+    if (plan_ && deser.endianness() == eprosima::fastcdr::Cdr::DEFAULT_ENDIAN) {
+      TypeSupport::deserializeROSmessage(
+        deser, plan_, ros_message, deser.getSerializedDataLength());
+    } else {
+      TypeSupport::deserializeROSmessage(deser, members_, ros_message);
+    }
   } else {
     uint8_t dump = 0;
     deser >> dump;
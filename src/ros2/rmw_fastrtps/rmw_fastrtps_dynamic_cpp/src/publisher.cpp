@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <string>
 
 #include "rmw/allocators.h"
@@ -108,6 +109,9 @@ rmw_fastrtps_dynamic_cpp::create_publisher(
   }
   auto cleanup_info = rcpputils::make_scope_exit(
     [info, participant]() {
+      if (info->publisher_) {
+        Domain::removePublisher(info->publisher_);
+      }
       if (info->type_support_) {
         _unregister_type(participant, info->type_support_);
       }
@@ -171,12 +175,21 @@ rmw_fastrtps_dynamic_cpp::create_publisher(
     RMW_SET_ERROR_MSG("create_publisher() could not create publisher listener");
     return nullptr;
   }
+  // Only reliable writers filter, best effort ones send every change to every reader,
+  // which then filter them
+  if (eprosima::fastrtps::RELIABLE_RELIABILITY_QOS == publisherParam.qos.m_reliability.kind) {
+    info->content_filter_ = std::make_unique<rmw_fastrtps_shared_cpp::WriterContentFilter>(
+      type_supports, participant_info->listener->content_filter_registry());
+  }
 
   info->publisher_ = Domain::createPublisher(participant, publisherParam, info->listener_);
   if (!info->publisher_) {
     RMW_SET_ERROR_MSG("create_publisher() could not create publisher");
     return nullptr;
   }
+  if (info->content_filter_) {
+    info->publisher_->reader_data_filter(info->content_filter_.get());
+  }
 
   info->publisher_gid = rmw_fastrtps_shared_cpp::create_rmw_gid(
     eprosima_fastrtps_identifier, info->publisher_->getGuid());
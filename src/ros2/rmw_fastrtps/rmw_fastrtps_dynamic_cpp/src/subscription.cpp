@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -166,6 +167,19 @@ create_subscription(
     return nullptr;
   }
 
+  const char * filter_expression = subscription_options->content_filter_expression;
+  if (filter_expression && filter_expression[0] != '\0') {
+    // Compiled here to reject invalid expressions, the writers compile it again from the
+    // user data of the reader
+    info->content_filter_ = rmw_fastrtps_shared_cpp::ContentFilter::create(
+      type_supports, filter_expression);
+    if (!info->content_filter_) {
+      return nullptr;  // Error message already set
+    }
+    subscriberParam.qos.m_userData.setValue(
+      rmw_fastrtps_shared_cpp::encode_content_filter_user_data(filter_expression));
+  }
+
   info->listener_ = new (std::nothrow) SubListener(info);
   if (!info->listener_) {
     RMW_SET_ERROR_MSG("create_subscriber() could not create subscriber listener");
@@ -202,6 +216,8 @@ create_subscription(
   memcpy(const_cast<char *>(rmw_subscription->topic_name), topic_name, strlen(topic_name) + 1);
 
   rmw_subscription->options = *subscription_options;
+  rmw_subscription->options.content_filter_expression =
+    info->content_filter_ ? info->content_filter_->expression().c_str() : nullptr;
   rmw_subscription->can_loan_messages = false;
 
   cleanup_subscription.cancel();
@@ -0,0 +1,83 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcutils/allocator.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/message_fixtures.hpp"
+
+template<typename MessageT>
+void round_trip(const std::vector<std::shared_ptr<MessageT>> & messages)
+{
+  const rosidl_message_type_support_t * type_support =
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
+
+  rmw_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&serialized_message, 0u, &allocator)) <<
+    rmw_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&serialized_message)) <<
+      rmw_get_error_string().str;
+  });
+
+  for (const auto & message : messages) {
+    ASSERT_EQ(RMW_RET_OK, rmw_serialize(message.get(), type_support, &serialized_message)) <<
+      rmw_get_error_string().str;
+
+    MessageT output;
+    ASSERT_EQ(RMW_RET_OK, rmw_deserialize(&serialized_message, type_support, &output)) <<
+      rmw_get_error_string().str;
+    EXPECT_EQ(*message, output);
+  }
+}
+
+TEST(TestSerializationPlan, basic_types) {
+  round_trip(get_messages_basic_types());
+}
+
+TEST(TestSerializationPlan, arrays) {
+  round_trip(get_messages_arrays());
+}
+
+TEST(TestSerializationPlan, unbounded_sequences) {
+  round_trip(get_messages_unbounded_sequences());
+}
+
+TEST(TestSerializationPlan, bounded_sequences) {
+  round_trip(get_messages_bounded_sequences());
+}
+
+TEST(TestSerializationPlan, nested) {
+  round_trip(get_messages_nested());
+  round_trip(get_messages_multi_nested());
+}
+
+TEST(TestSerializationPlan, strings) {
+  round_trip(get_messages_strings());
+  round_trip(get_messages_wstrings());
+}
@@ -30,12 +30,24 @@
 namespace rmw_fastrtps_shared_cpp
 {
 
+class ContentFilter;
+
+enum SerializedDataType
+{
+  FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE,  // data is a plain ros message
+  FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER,  // data is a Cdr to write, or a FastBuffer to read to
+  FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE  // data is a rmw_serialized_message_t
+};
+
 // Publishers write method will receive a pointer to this struct
 struct SerializedData
 {
-  bool is_cdr_buffer;  // Whether next field is a pointer to a Cdr or to a plain ros message
+  SerializedDataType type;  // The kind of object the next field points to
   void * data;
   const void * impl;   // RMW implementation specific data
+  // When reading, samples not passing this filter are left undeserialized and flagged below
+  const ContentFilter * content_filter = nullptr;
+  bool filtered_out = false;
 };
 
 class TypeSupport : public eprosima::fastrtps::TopicDataType//从继承来的类进行改写，得到复写后的序列化、反序列化、获取数据类型等
@@ -0,0 +1,190 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_FASTRTPS_SHARED_CPP__CONTENT_FILTER_HPP_
+#define RMW_FASTRTPS_SHARED_CPP__CONTENT_FILTER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fastdds/rtps/writer/IReaderDataFilter.hpp"
+#include "fastrtps/rtps/common/CacheChange.h"
+#include "fastrtps/rtps/common/Guid.h"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+
+#include "rmw_fastrtps_shared_cpp/visibility_control.h"
+
+namespace rmw_fastrtps_shared_cpp
+{
+
+namespace detail
+{
+struct ContentFilterProgram;
+}  // namespace detail
+
+/// Filter on the content of serialized messages, compiled from a content filter expression.
+/**
+ * See rmw_subscription_options_t::content_filter_expression for the syntax of the expression.
+ * The filter reads the fields the expression refers to straight from the CDR serialized
+ * message, without deserializing it nor allocating memory.
+ */
+class ContentFilter
+{
+public:
+  /// Compile an expression for a message type.
+  /**
+   * \param[in] type_supports type support of the message, providing the C or C++ introspection
+   *   type support
+   * \param[in] expression content filter expression
+   * \return the filter, or nullptr with the rmw error set if the expression is invalid
+   */
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  static std::shared_ptr<const ContentFilter>
+  create(const rosidl_message_type_support_t * type_supports, const std::string & expression);
+
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  ~ContentFilter();
+
+  /// Tell whether a serialized message passes the filter.
+  /**
+   * \param[in] data CDR serialized message, starting with its encapsulation header
+   * \param[in] length size of the serialized message
+   * \return true if the message passes the filter, or is too short to be evaluated
+   */
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  bool
+  evaluate(const uint8_t * data, size_t length) const;
+
+  const std::string &
+  expression() const
+  {
+    return expression_;
+  }
+
+private:
+  ContentFilter(
+    const std::string & expression, std::unique_ptr<const detail::ContentFilterProgram> program);
+
+  const std::string expression_;
+  const std::unique_ptr<const detail::ContentFilterProgram> program_;
+};
+
+/// Encode a content filter expression as the user data of a DDS reader.
+RMW_FASTRTPS_SHARED_CPP_PUBLIC
+std::vector<uint8_t>
+encode_content_filter_user_data(const std::string & expression);
+
+/// Decode the content filter expression of a DDS reader from its user data.
+/**
+ * \return true if the user data holds a content filter expression
+ */
+RMW_FASTRTPS_SHARED_CPP_PUBLIC
+bool
+decode_content_filter_user_data(const std::vector<uint8_t> & user_data, std::string & expression);
+
+/// Content filter expressions of the readers discovered by a participant, local ones included.
+class ContentFilterRegistry
+{
+public:
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  void
+  add(const eprosima::fastrtps::rtps::GUID_t & reader_guid, const std::string & expression);
+
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  void
+  remove(const eprosima::fastrtps::rtps::GUID_t & reader_guid);
+
+  /// Get the expression of a reader.
+  /**
+   * \return false if the reader has no content filter
+   */
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  bool
+  get(const eprosima::fastrtps::rtps::GUID_t & reader_guid, std::string & expression) const;
+
+private:
+  mutable std::mutex mutex_;
+  std::map<eprosima::fastrtps::rtps::GUID_t, std::string> expressions_
+    RCPPUTILS_TSA_GUARDED_BY(mutex_);
+};
+
+/// Decide which changes of a writer are sent to each matched reader, from their content filters.
+/**
+ * The filters of the readers are compiled when they match, once per distinct expression, and
+ * each one is evaluated once per change whatever the number of readers using it.
+ * Changes are relevant for readers without a content filter, or whose filter can't be compiled
+ * for the type of the writer.
+ */
+class WriterContentFilter : public eprosima::fastdds::rtps::IReaderDataFilter
+{
+public:
+  /**
+   * \param[in] type_supports type support of the messages of the writer
+   * \param[in] registry content filter expressions of the readers, which must outlive the filter
+   */
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  WriterContentFilter(
+    const rosidl_message_type_support_t * type_supports,
+    const ContentFilterRegistry & registry);
+
+  /// Start filtering the changes for a reader, if it has a content filter.
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  void
+  reader_matched(const eprosima::fastrtps::rtps::GUID_t & reader_guid);
+
+  /// Stop filtering the changes for a reader.
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  void
+  reader_removed(const eprosima::fastrtps::rtps::GUID_t & reader_guid);
+
+  RMW_FASTRTPS_SHARED_CPP_PUBLIC
+  bool
+  is_relevant(
+    const eprosima::fastrtps::rtps::CacheChange_t & change,
+    const eprosima::fastrtps::rtps::GUID_t & reader_guid) const override;
+
+private:
+  struct CompiledFilter
+  {
+    std::shared_ptr<const ContentFilter> filter;
+    size_t reader_count;
+    // Result of the last change evaluated, shared by all the readers using the filter
+    eprosima::fastrtps::rtps::SequenceNumber_t last_sequence_number;
+    bool last_result;
+  };
+
+  const rosidl_message_type_support_t * const type_supports_;
+  const ContentFilterRegistry & registry_;
+
+  mutable std::mutex mutex_;
+  // By expression
+  std::map<std::string, CompiledFilter> filters_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  std::map<eprosima::fastrtps::rtps::GUID_t, CompiledFilter *> readers_
+    RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  // Size of readers_, to skip locking when no reader has a content filter
+  std::atomic_size_t filtered_reader_count_{0};
+};
+
+}  // namespace rmw_fastrtps_shared_cpp
+
+#endif  // RMW_FASTRTPS_SHARED_CPP__CONTENT_FILTER_HPP_
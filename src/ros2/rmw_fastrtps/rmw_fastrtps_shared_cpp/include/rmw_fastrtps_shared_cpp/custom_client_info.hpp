@@ -82,9 +82,9 @@ public:
     response.buffer_.reset(new eprosima::fastcdr::FastBuffer());
 
     rmw_fastrtps_shared_cpp::SerializedData data;
-    data.is_cdr_buffer = true;
+    data.type = rmw_fastrtps_shared_cpp::FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER;
     data.data = response.buffer_.get();
-    data.impl = nullptr;    // not used when is_cdr_buffer is true
+    data.impl = nullptr;    // not used when type is FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER
     if (sub->takeNextData(&data, &response.sample_info_)) {
       if (eprosima::fastrtps::rtps::ALIVE == response.sample_info_.sampleKind) {
         response.sample_identity_ = response.sample_info_.related_sample_identity;
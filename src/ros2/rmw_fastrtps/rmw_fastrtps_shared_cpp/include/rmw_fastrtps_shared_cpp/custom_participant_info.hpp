@@ -34,6 +34,7 @@
 
 #include "rmw_dds_common/context.hpp"
 
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
 #include "rmw_fastrtps_shared_cpp/create_rmw_gid.hpp"
 #include "rmw_fastrtps_shared_cpp/qos.hpp"
 #include "rmw_fastrtps_shared_cpp/rmw_common.hpp"
@@ -106,6 +107,17 @@ public:
     if (eprosima::fastrtps::rtps::ReaderDiscoveryInfo::CHANGED_QOS_READER != info.status) {
       bool is_alive =
         eprosima::fastrtps::rtps::ReaderDiscoveryInfo::DISCOVERED_READER == info.status;
+      // Readers are discovered before they are matched with the publishers of this participant
+      if (is_alive) {
+        std::string expression;
+        if (rmw_fastrtps_shared_cpp::decode_content_filter_user_data(
+            info.info.m_qos.m_userData.getValue(), expression))
+        {
+          content_filters_.add(info.info.guid(), expression);
+        }
+      } else {
+        content_filters_.remove(info.info.guid());
+      }
       process_discovery_info(info.info, is_alive, true);
     }
   }
@@ -121,6 +133,12 @@ public:
     }
   }
 
+  const rmw_fastrtps_shared_cpp::ContentFilterRegistry &
+  content_filter_registry() const
+  {
+    return content_filters_;
+  }
+
 private:
   template<class T>
   void
@@ -154,6 +172,7 @@ private:
 
   rmw_dds_common::Context * context;
   const char * const identifier_;
+  rmw_fastrtps_shared_cpp::ContentFilterRegistry content_filters_;
 };
 
 #endif  // RMW_FASTRTPS_SHARED_CPP__CUSTOM_PARTICIPANT_INFO_HPP_
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <memory>
 #include <set>
 
 #include "fastrtps/publisher/Publisher.h"
@@ -27,6 +28,7 @@
 #include "rmw/rmw.h"
 
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
 #include "rmw_fastrtps_shared_cpp/custom_event_info.hpp"
 
 
@@ -42,6 +44,8 @@ typedef struct CustomPublisherInfo : public CustomEventInfo
   const void * type_support_impl_{nullptr};
   rmw_gid_t publisher_gid{};
   const char * typesupport_identifier_{nullptr};
+  // Skips the changes filtered out by the content filters of the matched readers
+  std::unique_ptr<rmw_fastrtps_shared_cpp::WriterContentFilter> content_filter_;
 
   RMW_FASTRTPS_SHARED_CPP_PUBLIC
   EventListenerInterface *
@@ -52,12 +56,12 @@ class PubListener : public EventListenerInterface, public eprosima::fastrtps::Pu
 {
 public:
   explicit PubListener(CustomPublisherInfo * info)
-  : deadline_changes_(false),
+  : info_(info),
+    deadline_changes_(false),
     liveliness_changes_(false),
     conditionMutex_(nullptr),
     conditionVariable_(nullptr)
   {
-    (void) info;
   }
 
   // PublisherListener implementation
@@ -67,6 +71,13 @@ public:
     eprosima::fastrtps::Publisher * pub, eprosima::fastrtps::rtps::MatchingInfo & info) final
   {
     (void) pub;
+    if (info_->content_filter_) {
+      if (eprosima::fastrtps::rtps::MATCHED_MATCHING == info.status) {
+        info_->content_filter_->reader_matched(info.remoteEndpointGuid);
+      } else if (eprosima::fastrtps::rtps::REMOVED_MATCHING == info.status) {
+        info_->content_filter_->reader_removed(info.remoteEndpointGuid);
+      }
+    }
     std::lock_guard<std::mutex> lock(internalMutex_);
     if (eprosima::fastrtps::rtps::MATCHED_MATCHING == info.status) {
       subscriptions_.insert(info.remoteEndpointGuid);
@@ -121,6 +132,8 @@ public:
   }
 
 private:
+  CustomPublisherInfo * const info_;
+
   mutable std::mutex internalMutex_;
 
   std::set<eprosima::fastrtps::rtps::GUID_t> subscriptions_
@@ -245,9 +245,9 @@ public:
     request.buffer_ = new eprosima::fastcdr::FastBuffer();
 
     rmw_fastrtps_shared_cpp::SerializedData data;
-    data.is_cdr_buffer = true;
+    data.type = rmw_fastrtps_shared_cpp::FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER;
     data.data = request.buffer_;
-    data.impl = nullptr;    // not used when is_cdr_buffer is true
+    data.impl = nullptr;    // not used when type is FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER
     if (sub->takeNextData(&data, &request.sample_info_)) {
       if (eprosima::fastrtps::rtps::ALIVE == request.sample_info_.sampleKind) {
         request.sample_identity_ = request.sample_info_.sample_identity;
@@ -18,6 +18,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -29,6 +30,7 @@
 #include "rmw/impl/cpp/macros.hpp"
 
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
 #include "rmw_fastrtps_shared_cpp/custom_event_info.hpp"
 
 
@@ -44,6 +46,8 @@ struct CustomSubscriberInfo : public CustomEventInfo
   const void * type_support_impl_{nullptr};
   rmw_gid_t subscription_gid_{};
   const char * typesupport_identifier_{nullptr};
+  // Drops the samples of writers which didn't filter them out, if the subscription has one
+  std::shared_ptr<const rmw_fastrtps_shared_cpp::ContentFilter> content_filter_;
 
   RMW_FASTRTPS_SHARED_CPP_PUBLIC
   EventListenerInterface *
@@ -18,7 +18,11 @@
 #include <string>
 #include <vector>
 
+#include "rmw/ret_types.h"
+#include "rmw/serialized_message.h"
+
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
 
 namespace rmw_fastrtps_shared_cpp
 {
@@ -47,27 +51,64 @@ bool TypeSupport::serialize(
   assert(payload);
 
   auto ser_data = static_cast<SerializedData *>(data);
-  if (ser_data->is_cdr_buffer) {
-    auto ser = static_cast<eprosima::fastcdr::Cdr *>(ser_data->data);
-    if (payload->max_size >= ser->getSerializedDataLength()) {
-      payload->length = static_cast<uint32_t>(ser->getSerializedDataLength());
-      payload->encapsulation = ser->endianness() ==
-        eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-      memcpy(payload->data, ser->getBufferPointer(), ser->getSerializedDataLength());
-      return true;
-    }
-  } else {
-    eprosima::fastcdr::FastBuffer fastbuffer(
-      reinterpret_cast<char *>(payload->data),
-      payload->max_size);  // Object that manages the raw buffer.
-    eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-      eprosima::fastcdr::Cdr::DDS_CDR);  // Object that serializes the data.
-    if (this->serializeROSmessage(ser_data->data, ser, ser_data->impl)) {
-      payload->encapsulation = ser.endianness() ==
-        eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-      payload->length = (uint32_t)ser.getSerializedDataLength();
-      return true;
-    }
+  ser_data->filtered_out = false;
+  if (ser_data->content_filter &&
+    !ser_data->content_filter->evaluate(payload->data, payload->length))
+  {
+    ser_data->filtered_out = true;
+    return true;
+  }
+
+  switch (ser_data->type) {
+    case FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE:
+      {
+        eprosima::fastcdr::FastBuffer fastbuffer(
+          reinterpret_cast<char *>(payload->data),
+          payload->max_size);  // Object that manages the raw buffer.
+        eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+          eprosima::fastcdr::Cdr::DDS_CDR);  // Object that serializes the data.
+        if (this->serializeROSmessage(ser_data->data, ser, ser_data->impl)) {
+          payload->encapsulation = ser.endianness() ==
+            eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
+          payload->length = (uint32_t)ser.getSerializedDataLength();
+          return true;
+        }
+        break;
+      }
+
+    case FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER:
+      {
+        auto ser = static_cast<eprosima::fastcdr::Cdr *>(ser_data->data);
+        if (payload->max_size >= ser->getSerializedDataLength()) {
+          payload->length = static_cast<uint32_t>(ser->getSerializedDataLength());
+          payload->encapsulation = ser->endianness() ==
+            eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
+          memcpy(payload->data, ser->getBufferPointer(), ser->getSerializedDataLength());
+          return true;
+        }
+        break;
+      }
+
+    case FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE:
+      {
+        // Already serialized, copy it straight into the payload taken from the writer pool
+        auto serialized_message = static_cast<const rmw_serialized_message_t *>(ser_data->data);
+        if (payload->max_size >= serialized_message->buffer_length) {
+          payload->length = static_cast<uint32_t>(serialized_message->buffer_length);
+          // The second byte of the encapsulation header tells the endianness
+          if (serialized_message->buffer_length > 1) {
+            payload->encapsulation = serialized_message->buffer[1] == CDR_LE ? CDR_LE : CDR_BE;
+          } else {
+            payload->encapsulation = eprosima::fastcdr::Cdr::DEFAULT_ENDIAN ==
+              eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
+          }
+          if (serialized_message->buffer_length > 0) {
+            memcpy(payload->data, serialized_message->buffer, serialized_message->buffer_length);
+          }
+          return true;
+        }
+        break;
+      }
   }
 
   return false;
@@ -81,23 +122,47 @@ bool TypeSupport::deserialize(
   assert(payload);
 
   auto ser_data = static_cast<SerializedData *>(data);
-  if (ser_data->is_cdr_buffer) {
-    auto buffer = static_cast<eprosima::fastcdr::FastBuffer *>(ser_data->data);
-    if (!buffer->reserve(payload->length)) {
-      return false;
-    }
-    memcpy(buffer->getBuffer(), payload->data, payload->length);
-    return true;
+  switch (ser_data->type) {
+    case FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE:
+      {
+        eprosima::fastcdr::FastBuffer fastbuffer(
+          reinterpret_cast<char *>(payload->data),
+          payload->length);
+        eprosima::fastcdr::Cdr deser(
+          fastbuffer,
+          eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+          eprosima::fastcdr::Cdr::DDS_CDR);
+        return deserializeROSmessage(deser, ser_data->data, ser_data->impl);
+      }
+
+    case FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER:
+      {
+        auto buffer = static_cast<eprosima::fastcdr::FastBuffer *>(ser_data->data);
+        if (!buffer->reserve(payload->length)) {
+          return false;
+        }
+        memcpy(buffer->getBuffer(), payload->data, payload->length);
+        return true;
+      }
+
+    case FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE:
+      {
+        // Copy the payload straight into the caller's buffer, growing it if needed
+        auto serialized_message = static_cast<rmw_serialized_message_t *>(ser_data->data);
+        if (serialized_message->buffer_capacity < payload->length) {
+          if (RMW_RET_OK != rmw_serialized_message_resize(serialized_message, payload->length)) {
+            return false;  // Error message already set
+          }
+        }
+        if (payload->length > 0) {
+          memcpy(serialized_message->buffer, payload->data, payload->length);
+        }
+        serialized_message->buffer_length = payload->length;
+        return true;
+      }
   }
 
-  eprosima::fastcdr::FastBuffer fastbuffer(
-    reinterpret_cast<char *>(payload->data),
-    payload->length);
-  eprosima::fastcdr::Cdr deser(
-    fastbuffer,
-    eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-    eprosima::fastcdr::Cdr::DDS_CDR);
-  return deserializeROSmessage(deser, ser_data->data, ser_data->impl);
+  return false;
 }
 
 std::function<uint32_t()> TypeSupport::getSerializedSizeProvider(void * data)
@@ -107,14 +172,24 @@ std::function<uint32_t()> TypeSupport::getSerializedSizeProvider(void * data)
   auto ser_data = static_cast<SerializedData *>(data);
   auto ser_size = [this, ser_data]() -> uint32_t
     {
-      if (ser_data->is_cdr_buffer) {
-        auto ser = static_cast<eprosima::fastcdr::Cdr *>(ser_data->data);
-        return static_cast<uint32_t>(ser->getSerializedDataLength());
+      switch (ser_data->type) {
+        case FASTRTPS_SERIALIZED_DATA_TYPE_CDR_BUFFER:
+          {
+            auto ser = static_cast<eprosima::fastcdr::Cdr *>(ser_data->data);
+            return static_cast<uint32_t>(ser->getSerializedDataLength());
+          }
+        case FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE:
+          {
+            auto serialized_message =
+              static_cast<const rmw_serialized_message_t *>(ser_data->data);
+            return static_cast<uint32_t>(serialized_message->buffer_length);
+          }
+        default:
+          return static_cast<uint32_t>(
+            this->getEstimatedSerializedSize(
+              ser_data->data,
+              ser_data->impl));
       }
-      return static_cast<uint32_t>(
-        this->getEstimatedSerializedSize(
-          ser_data->data,
-          ser_data->impl));
     };
   return ser_size;
 }
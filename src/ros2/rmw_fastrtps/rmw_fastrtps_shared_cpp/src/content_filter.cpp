@@ -0,0 +1,1288 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcutils/logging_macros.h"
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/identifier.h"
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
+
+using eprosima::fastrtps::rtps::CacheChange_t;
+using eprosima::fastrtps::rtps::GUID_t;
+using eprosima::fastrtps::rtps::SequenceNumber_t;
+
+namespace rmw_fastrtps_shared_cpp
+{
+namespace detail
+{
+
+// Maximum number of distinct fields an expression can refer to, bounding the stack usage of
+// ContentFilter::evaluate()
+constexpr size_t kMaxFields = 32;
+
+// The type ids of the C and C++ introspection type supports are the same
+enum TypeId : uint8_t
+{
+  kFloat = rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT,
+  kDouble = rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE,
+  kLongDouble = rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE,
+  kChar = rosidl_typesupport_introspection_c__ROS_TYPE_CHAR,
+  kWChar = rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR,
+  kBoolean = rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN,
+  kOctet = rosidl_typesupport_introspection_c__ROS_TYPE_OCTET,
+  kUInt8 = rosidl_typesupport_introspection_c__ROS_TYPE_UINT8,
+  kInt8 = rosidl_typesupport_introspection_c__ROS_TYPE_INT8,
+  kUInt16 = rosidl_typesupport_introspection_c__ROS_TYPE_UINT16,
+  kInt16 = rosidl_typesupport_introspection_c__ROS_TYPE_INT16,
+  kUInt32 = rosidl_typesupport_introspection_c__ROS_TYPE_UINT32,
+  kInt32 = rosidl_typesupport_introspection_c__ROS_TYPE_INT32,
+  kUInt64 = rosidl_typesupport_introspection_c__ROS_TYPE_UINT64,
+  kInt64 = rosidl_typesupport_introspection_c__ROS_TYPE_INT64,
+  kString = rosidl_typesupport_introspection_c__ROS_TYPE_STRING,
+  kWString = rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING,
+  kMessage = rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE,
+};
+
+enum class ValueKind : uint8_t
+{
+  Boolean,
+  Signed,
+  Unsigned,
+  Float,
+  String,
+  Unsupported,
+};
+
+ValueKind
+get_value_kind(uint8_t type_id)
+{
+  switch (type_id) {
+    case kBoolean:
+      return ValueKind::Boolean;
+    case kInt8:
+    case kInt16:
+    case kInt32:
+    case kInt64:
+      return ValueKind::Signed;
+    case kChar:
+    case kWChar:
+    case kOctet:
+    case kUInt8:
+    case kUInt16:
+    case kUInt32:
+    case kUInt64:
+      return ValueKind::Unsigned;
+    case kFloat:
+    case kDouble:
+      return ValueKind::Float;
+    case kString:
+      return ValueKind::String;
+    default:
+      return ValueKind::Unsupported;
+  }
+}
+
+// Serialized size of the primitive types, 0 for the others
+size_t
+get_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case kBoolean:
+    case kChar:
+    case kOctet:
+    case kUInt8:
+    case kInt8:
+      return 1u;
+    case kUInt16:
+    case kInt16:
+      return 2u;
+    case kFloat:
+    case kWChar:
+    case kUInt32:
+    case kInt32:
+      return 4u;
+    case kDouble:
+    case kUInt64:
+    case kInt64:
+      return 8u;
+    case kLongDouble:
+      return 16u;
+    default:
+      return 0u;
+  }
+}
+
+// Member of a message type, whatever the language of its introspection type support
+struct Member
+{
+  std::string name;
+  uint8_t type_id;
+  bool is_array;
+  // Sequences have a length prefix, arrays don't
+  bool is_sequence;
+  size_t array_size;
+  // Index of the layout of the member in ContentFilterProgram::layouts, for messages
+  size_t layout;
+  // Index of the value read from the member, or -1 if the expression doesn't refer to it
+  int value_index;
+  // Whether the expression refers to fields of the member, for messages
+  bool needed;
+};
+
+struct Layout
+{
+  std::vector<Member> members;
+  // One past the last member the expression refers to, directly or not
+  size_t needed_end;
+};
+
+enum class Operator : uint8_t
+{
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Like,
+};
+
+struct Literal
+{
+  enum class Kind : uint8_t {Boolean, Integer, Float, String} kind;
+  bool boolean;
+  // Integers as sign and magnitude, to be compared exactly with any integer field
+  bool negative;
+  uint64_t magnitude;
+  // Also set for integers
+  double floating;
+  std::string string;
+};
+
+struct Node
+{
+  enum class Kind : uint8_t {And, Or, Not, Compare} kind;
+  size_t left;
+  size_t right;
+  Operator op;
+  size_t value_index;
+  ValueKind value_kind;
+  Literal literal;
+};
+
+struct ContentFilterProgram
+{
+  // The first one is the layout of the message
+  std::vector<Layout> layouts;
+  std::vector<Node> nodes;
+  size_t root;
+  size_t value_count;
+};
+
+struct Value
+{
+  bool valid;
+  bool boolean;
+  int64_t signed_integer;
+  uint64_t unsigned_integer;
+  double floating;
+  const char * string;
+  size_t string_length;
+};
+
+template<typename MessageMembersT>
+size_t
+add_layout(ContentFilterProgram & program, const MessageMembersT * members)
+{
+  size_t index = program.layouts.size();
+  program.layouts.emplace_back();
+  // Nested messages add layouts, invalidating references to the elements of program.layouts
+  Layout layout;
+  layout.needed_end = 0u;
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto & member = members->members_[i];
+    Member result;
+    result.name = member.name_;
+    result.type_id = member.type_id_;
+    result.is_array = member.is_array_;
+    result.is_sequence = member.is_array_ && (0u == member.array_size_ || member.is_upper_bound_);
+    result.array_size = member.array_size_;
+    result.layout = 0u;
+    result.value_index = -1;
+    result.needed = false;
+    if (kMessage == member.type_id_) {
+      result.layout = add_layout(
+        program, static_cast<const MessageMembersT *>(member.members_->data));
+    }
+    layout.members.push_back(std::move(result));
+  }
+  program.layouts[index] = std::move(layout);
+  return index;
+}
+
+class Parser
+{
+public:
+  Parser(const std::string & text, ContentFilterProgram & program)
+  : text_(text), position_(0u), program_(program), error_position_(0u)
+  {}
+
+  bool
+  parse()
+  {
+    size_t root;
+    if (!parse_or(root)) {
+      return false;
+    }
+    skip_spaces();
+    if (position_ != text_.size()) {
+      return fail("unexpected character");
+    }
+    program_.root = root;
+    return true;
+  }
+
+  const std::string &
+  error() const
+  {
+    return error_;
+  }
+
+  size_t
+  error_position() const
+  {
+    return error_position_;
+  }
+
+private:
+  struct Operand
+  {
+    bool is_field;
+    size_t position;
+    std::string field;
+    Literal literal;
+  };
+
+  static bool
+  is_identifier_start(char c)
+  {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || '_' == c;
+  }
+
+  static bool
+  is_digit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  static bool
+  is_identifier_char(char c)
+  {
+    return is_identifier_start(c) || is_digit(c);
+  }
+
+  static bool
+  equals_keyword(const std::string & word, const char * keyword)
+  {
+    if (word.size() != strlen(keyword)) {
+      return false;
+    }
+    for (size_t i = 0; i < word.size(); ++i) {
+      if (std::toupper(static_cast<unsigned char>(word[i])) != keyword[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool
+  is_keyword(const std::string & word)
+  {
+    return equals_keyword(word, "AND") || equals_keyword(word, "OR") ||
+           equals_keyword(word, "NOT") || equals_keyword(word, "LIKE") ||
+           equals_keyword(word, "TRUE") || equals_keyword(word, "FALSE");
+  }
+
+  bool
+  fail(const char * message)
+  {
+    error_ = message;
+    error_position_ = position_;
+    return false;
+  }
+
+  void
+  skip_spaces()
+  {
+    while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+      ++position_;
+    }
+  }
+
+  // Read a dotted name, without consuming it
+  std::string
+  peek_name(size_t & end) const
+  {
+    end = position_;
+    while (end < text_.size() && is_identifier_start(text_[end])) {
+      while (end < text_.size() && is_identifier_char(text_[end])) {
+        ++end;
+      }
+      if (end + 1 < text_.size() && '.' == text_[end] && is_identifier_start(text_[end + 1])) {
+        ++end;
+      } else {
+        break;
+      }
+    }
+    return text_.substr(position_, end - position_);
+  }
+
+  bool
+  accept_keyword(const char * keyword)
+  {
+    skip_spaces();
+    size_t end;
+    if (equals_keyword(peek_name(end), keyword)) {
+      position_ = end;
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  add_node(Node node, size_t & index)
+  {
+    index = program_.nodes.size();
+    program_.nodes.push_back(std::move(node));
+    return true;
+  }
+
+  bool
+  add_binary_node(Node::Kind kind, size_t left, size_t right, size_t & index)
+  {
+    Node node{};
+    node.kind = kind;
+    node.left = left;
+    node.right = right;
+    return add_node(std::move(node), index);
+  }
+
+  bool
+  parse_or(size_t & index)
+  {
+    if (!parse_and(index)) {
+      return false;
+    }
+    while (accept_keyword("OR")) {
+      size_t right;
+      if (!parse_and(right)) {
+        return false;
+      }
+      add_binary_node(Node::Kind::Or, index, right, index);
+    }
+    return true;
+  }
+
+  bool
+  parse_and(size_t & index)
+  {
+    if (!parse_not(index)) {
+      return false;
+    }
+    while (accept_keyword("AND")) {
+      size_t right;
+      if (!parse_not(right)) {
+        return false;
+      }
+      add_binary_node(Node::Kind::And, index, right, index);
+    }
+    return true;
+  }
+
+  bool
+  parse_not(size_t & index)
+  {
+    if (accept_keyword("NOT")) {
+      size_t operand;
+      if (!parse_not(operand)) {
+        return false;
+      }
+      return add_binary_node(Node::Kind::Not, operand, 0u, index);
+    }
+    skip_spaces();
+    if (position_ < text_.size() && '(' == text_[position_]) {
+      ++position_;
+      if (!parse_or(index)) {
+        return false;
+      }
+      skip_spaces();
+      if (position_ >= text_.size() || ')' != text_[position_]) {
+        return fail("expected ')'");
+      }
+      ++position_;
+      return true;
+    }
+    return parse_comparison(index);
+  }
+
+  bool
+  parse_string(Literal & literal)
+  {
+    // Quotes are escaped by doubling them
+    ++position_;
+    literal.kind = Literal::Kind::String;
+    while (position_ < text_.size()) {
+      char c = text_[position_++];
+      if ('\'' == c) {
+        if (position_ < text_.size() && '\'' == text_[position_]) {
+          ++position_;
+        } else {
+          return true;
+        }
+      }
+      literal.string.push_back(c);
+    }
+    return fail("unterminated string");
+  }
+
+  bool
+  parse_number(Literal & literal)
+  {
+    size_t start = position_;
+    bool negative = false;
+    if ('-' == text_[position_] || '+' == text_[position_]) {
+      negative = '-' == text_[position_];
+      ++position_;
+    }
+    size_t digits_start = position_;
+    bool is_integer = true;
+    while (position_ < text_.size() && is_digit(text_[position_])) {
+      ++position_;
+    }
+    size_t digits_end = position_;
+    bool has_digits = digits_end != digits_start;
+    if (position_ < text_.size() && '.' == text_[position_]) {
+      is_integer = false;
+      ++position_;
+      while (position_ < text_.size() && is_digit(text_[position_])) {
+        has_digits = true;
+        ++position_;
+      }
+    }
+    if (!has_digits) {
+      return fail("invalid number");
+    }
+    if (position_ < text_.size() && ('e' == text_[position_] || 'E' == text_[position_])) {
+      is_integer = false;
+      ++position_;
+      if (position_ < text_.size() && ('-' == text_[position_] || '+' == text_[position_])) {
+        ++position_;
+      }
+      if (position_ >= text_.size() || !is_digit(text_[position_])) {
+        return fail("invalid number");
+      }
+      while (position_ < text_.size() && is_digit(text_[position_])) {
+        ++position_;
+      }
+    }
+    if (position_ < text_.size() && is_identifier_char(text_[position_])) {
+      return fail("invalid number");
+    }
+
+    std::string number = text_.substr(start, position_ - start);
+    literal.floating = std::strtod(number.c_str(), nullptr);
+    literal.kind = Literal::Kind::Float;
+    if (is_integer) {
+      errno = 0;
+      std::string digits = text_.substr(digits_start, digits_end - digits_start);
+      unsigned long long magnitude = std::strtoull(digits.c_str(), nullptr, 10);  // NOLINT
+      if (0 == errno) {
+        // Too large integers are compared as floating point numbers
+        literal.kind = Literal::Kind::Integer;
+        literal.negative = negative && 0u != magnitude;
+        literal.magnitude = static_cast<uint64_t>(magnitude);
+      }
+    }
+    return true;
+  }
+
+  bool
+  parse_operand(Operand & operand)
+  {
+    skip_spaces();
+    operand.position = position_;
+    operand.is_field = false;
+    if (position_ >= text_.size()) {
+      return fail("expected a field or a value");
+    }
+    char c = text_[position_];
+    if ('\'' == c) {
+      return parse_string(operand.literal);
+    }
+    if (is_digit(c) || '-' == c || '+' == c || '.' == c) {
+      return parse_number(operand.literal);
+    }
+    size_t end;
+    std::string name = peek_name(end);
+    if (name.empty()) {
+      return fail("expected a field or a value");
+    }
+    if (equals_keyword(name, "TRUE") || equals_keyword(name, "FALSE")) {
+      operand.literal.kind = Literal::Kind::Boolean;
+      operand.literal.boolean = equals_keyword(name, "TRUE");
+    } else if (is_keyword(name)) {
+      return fail("expected a field or a value");
+    } else {
+      operand.is_field = true;
+      operand.field = std::move(name);
+    }
+    position_ = end;
+    return true;
+  }
+
+  bool
+  parse_operator(Operator & op)
+  {
+    skip_spaces();
+    if (accept_keyword("LIKE")) {
+      op = Operator::Like;
+      return true;
+    }
+    static const struct
+    {
+      const char * text;
+      Operator op;
+    } operators[] = {
+      {"<>", Operator::NotEqual},
+      {"!=", Operator::NotEqual},
+      {"<=", Operator::LessEqual},
+      {">=", Operator::GreaterEqual},
+      {"=", Operator::Equal},
+      {"<", Operator::Less},
+      {">", Operator::Greater},
+    };
+    for (const auto & candidate : operators) {
+      size_t length = strlen(candidate.text);
+      if (0 == text_.compare(position_, length, candidate.text)) {
+        position_ += length;
+        op = candidate.op;
+        return true;
+      }
+    }
+    return fail("expected a comparison operator");
+  }
+
+  // Find the member a dotted name refers to, and mark it as read by the filter
+  bool
+  resolve_field(const std::string & field, size_t & value_index, ValueKind & value_kind)
+  {
+    size_t layout_index = 0u;
+    size_t start = 0u;
+    // The members along the path, to be marked as needed once the field is found valid
+    std::vector<std::pair<size_t, size_t>> path;
+    while (true) {
+      size_t end = field.find('.', start);
+      std::string name = field.substr(start, end == std::string::npos ? end : end - start);
+      const Layout & layout = program_.layouts[layout_index];
+      auto it = std::find_if(
+        layout.members.begin(), layout.members.end(),
+        [&name](const Member & member) {return member.name == name;});
+      if (it == layout.members.end()) {
+        return fail("unknown field");
+      }
+      if (it->is_array) {
+        return fail("arrays and sequences aren't supported");
+      }
+      path.emplace_back(layout_index, static_cast<size_t>(it - layout.members.begin()));
+      if (end == std::string::npos) {
+        if (kMessage == it->type_id) {
+          return fail("the field is a message, use one of its fields");
+        }
+        value_kind = get_value_kind(it->type_id);
+        if (ValueKind::Unsupported == value_kind) {
+          return fail("the type of the field isn't supported");
+        }
+        break;
+      }
+      if (kMessage != it->type_id) {
+        return fail("the field isn't a message");
+      }
+      layout_index = it->layout;
+      start = end + 1;
+    }
+
+    for (const auto & step : path) {
+      Layout & layout = program_.layouts[step.first];
+      layout.members[step.second].needed = true;
+      layout.needed_end = std::max(layout.needed_end, step.second + 1);
+    }
+    Member & member = program_.layouts[path.back().first].members[path.back().second];
+    if (member.value_index < 0) {
+      if (program_.value_count >= kMaxFields) {
+        return fail("too many fields");
+      }
+      member.value_index = static_cast<int>(program_.value_count++);
+    }
+    value_index = static_cast<size_t>(member.value_index);
+    return true;
+  }
+
+  bool
+  parse_comparison(size_t & index)
+  {
+    Operand left;
+    if (!parse_operand(left)) {
+      return false;
+    }
+    size_t operator_position = position_;
+    Node node{};
+    node.kind = Node::Kind::Compare;
+    if (!parse_operator(node.op)) {
+      return false;
+    }
+    Operand right;
+    if (!parse_operand(right)) {
+      return false;
+    }
+    size_t end_position = position_;
+
+    if (left.is_field == right.is_field) {
+      position_ = left.position;
+      return fail("a comparison must be between a field and a value");
+    }
+    if (!left.is_field) {
+      if (Operator::Like == node.op) {
+        position_ = operator_position;
+        return fail("the pattern of LIKE must be on its right");
+      }
+      // Compare the field to the value instead
+      switch (node.op) {
+        case Operator::Less: node.op = Operator::Greater; break;
+        case Operator::LessEqual: node.op = Operator::GreaterEqual; break;
+        case Operator::Greater: node.op = Operator::Less; break;
+        case Operator::GreaterEqual: node.op = Operator::LessEqual; break;
+        default: break;
+      }
+      std::swap(left, right);
+    }
+
+    position_ = left.position;
+    if (!resolve_field(left.field, node.value_index, node.value_kind)) {
+      return false;
+    }
+    position_ = right.position;
+    bool compatible = false;
+    switch (node.value_kind) {
+      case ValueKind::Boolean:
+        compatible = Literal::Kind::Boolean == right.literal.kind &&
+          (Operator::Equal == node.op || Operator::NotEqual == node.op);
+        break;
+      case ValueKind::String:
+        compatible = Literal::Kind::String == right.literal.kind;
+        break;
+      default:
+        compatible = (Literal::Kind::Integer == right.literal.kind ||
+          Literal::Kind::Float == right.literal.kind) && Operator::Like != node.op;
+        break;
+    }
+    if (!compatible) {
+      return fail("the value can't be compared to the field");
+    }
+    node.literal = std::move(right.literal);
+    position_ = end_position;
+    return add_node(std::move(node), index);
+  }
+
+  const std::string & text_;
+  size_t position_;
+  ContentFilterProgram & program_;
+  std::string error_;
+  size_t error_position_;
+};
+
+// Reader of the CDR encoding, with the alignment of Fast CDR
+class CdrReader
+{
+public:
+  CdrReader(const uint8_t * data, size_t length)
+  : data_(data + 4), length_(length - 4), position_(0u)
+  {
+    // The second byte of the encapsulation header tells the endianness
+    const uint16_t probe = 1u;
+    bool host_is_little_endian = 1u == *reinterpret_cast<const uint8_t *>(&probe);
+    swap_ = (1u == data[1]) != host_is_little_endian;
+  }
+
+  bool
+  align(size_t size)
+  {
+    size_t alignment = size > 8u ? 8u : size;
+    if (alignment <= 1u) {
+      return true;
+    }
+    size_t aligned = (position_ + alignment - 1u) & ~(alignment - 1u);
+    if (aligned > length_) {
+      return false;
+    }
+    position_ = aligned;
+    return true;
+  }
+
+  bool
+  skip(size_t size)
+  {
+    if (size > length_ - position_) {
+      return false;
+    }
+    position_ += size;
+    return true;
+  }
+
+  template<typename T>
+  bool
+  read(T & value)
+  {
+    if (!align(sizeof(T)) || sizeof(T) > length_ - position_) {
+      return false;
+    }
+    uint8_t bytes[sizeof(T)];
+    memcpy(bytes, data_ + position_, sizeof(T));
+    if (swap_) {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    memcpy(&value, bytes, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  bool
+  read_string(const char *& string, size_t & length)
+  {
+    uint32_t size;
+    if (!read(size) || size > length_ - position_) {
+      return false;
+    }
+    string = reinterpret_cast<const char *>(data_ + position_);
+    // The size includes the terminating null character
+    length = size > 0u && '\0' == string[size - 1u] ? size - 1u : size;
+    position_ += size;
+    return true;
+  }
+
+private:
+  const uint8_t * data_;
+  size_t length_;
+  size_t position_;
+  bool swap_;
+};
+
+bool
+skip_value(uint8_t type_id, CdrReader & reader)
+{
+  if (kString == type_id) {
+    const char * string;
+    size_t length;
+    return reader.read_string(string, length);
+  }
+  if (kWString == type_id) {
+    uint32_t length;
+    return reader.read(length) && reader.align(4u) &&
+           (length <= std::numeric_limits<size_t>::max() / 4u) && reader.skip(length * 4u);
+  }
+  size_t size = get_primitive_size(type_id);
+  return 0u != size && reader.align(size) && reader.skip(size);
+}
+
+template<typename SerializedT, typename ValueT>
+bool
+read_as(CdrReader & reader, ValueT & value)
+{
+  SerializedT data;
+  if (!reader.read(data)) {
+    return false;
+  }
+  value = static_cast<ValueT>(data);
+  return true;
+}
+
+bool
+read_value(uint8_t type_id, CdrReader & reader, Value & value)
+{
+  value.valid = true;
+  switch (type_id) {
+    case kBoolean:
+      {
+        uint8_t data;
+        if (!reader.read(data)) {
+          return false;
+        }
+        value.boolean = 0u != data;
+        return true;
+      }
+    case kInt8:
+      return read_as<int8_t>(reader, value.signed_integer);
+    case kInt16:
+      return read_as<int16_t>(reader, value.signed_integer);
+    case kInt32:
+      return read_as<int32_t>(reader, value.signed_integer);
+    case kInt64:
+      return read_as<int64_t>(reader, value.signed_integer);
+    case kChar:
+    case kOctet:
+    case kUInt8:
+      return read_as<uint8_t>(reader, value.unsigned_integer);
+    case kUInt16:
+      return read_as<uint16_t>(reader, value.unsigned_integer);
+    case kWChar:
+    case kUInt32:
+      return read_as<uint32_t>(reader, value.unsigned_integer);
+    case kUInt64:
+      return read_as<uint64_t>(reader, value.unsigned_integer);
+    case kFloat:
+      return read_as<float>(reader, value.floating);
+    case kDouble:
+      return read_as<double>(reader, value.floating);
+    case kString:
+      return reader.read_string(value.string, value.string_length);
+    default:
+      value.valid = false;
+      return false;
+  }
+}
+
+bool
+read_message(
+  const ContentFilterProgram & program, const Layout & layout, CdrReader & reader,
+  Value * values, bool skip_all);
+
+bool
+skip_elements(
+  const ContentFilterProgram & program, const Member & member, size_t count, CdrReader & reader)
+{
+  if (0u == count) {
+    // Fast CDR doesn't align empty arrays
+    return true;
+  }
+  if (kMessage == member.type_id) {
+    const Layout & layout = program.layouts[member.layout];
+    for (size_t i = 0; i < count; ++i) {
+      if (!read_message(program, layout, reader, nullptr, true)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (kString == member.type_id || kWString == member.type_id) {
+    for (size_t i = 0; i < count; ++i) {
+      if (!skip_value(member.type_id, reader)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Primitive arrays are aligned once, and have no padding between elements
+  size_t size = get_primitive_size(member.type_id);
+  return 0u != size && reader.align(size) && count <= std::numeric_limits<size_t>::max() / size &&
+         reader.skip(count * size);
+}
+
+bool
+read_message(
+  const ContentFilterProgram & program, const Layout & layout, CdrReader & reader,
+  Value * values, bool skip_all)
+{
+  // Stop after the last member the filter reads
+  size_t end = skip_all ? layout.members.size() : layout.needed_end;
+  for (size_t i = 0; i < end; ++i) {
+    const Member & member = layout.members[i];
+    bool ok;
+    if (member.is_array) {
+      uint32_t count = static_cast<uint32_t>(member.array_size);
+      if (member.is_sequence && !reader.read(count)) {
+        return false;
+      }
+      ok = skip_elements(program, member, count, reader);
+    } else if (kMessage == member.type_id) {
+      ok = read_message(
+        program, program.layouts[member.layout], reader, values, skip_all || !member.needed);
+    } else if (!skip_all && member.value_index >= 0) {
+      ok = read_value(member.type_id, reader, values[member.value_index]);
+    } else {
+      ok = skip_value(member.type_id, reader);
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -1, 0 or 1 like strcmp, kUnordered if one of the values is NaN
+constexpr int kUnordered = 2;
+
+template<typename T>
+int
+compare(T left, T right)
+{
+  if (left < right) {
+    return -1;
+  }
+  if (left > right) {
+    return 1;
+  }
+  return left == right ? 0 : kUnordered;
+}
+
+int
+compare_integers(bool left_negative, uint64_t left, bool right_negative, uint64_t right)
+{
+  if (left_negative != right_negative) {
+    return left_negative ? -1 : 1;
+  }
+  int result = compare(left, right);
+  return left_negative ? -result : result;
+}
+
+int
+compare_value(const Node & node, const Value & value)
+{
+  const Literal & literal = node.literal;
+  switch (node.value_kind) {
+    case ValueKind::Boolean:
+      return value.boolean == literal.boolean ? 0 : 1;
+    case ValueKind::String:
+      {
+        size_t length = std::min(value.string_length, literal.string.size());
+        int result = memcmp(value.string, literal.string.data(), length);
+        if (0 != result) {
+          return result < 0 ? -1 : 1;
+        }
+        return compare(value.string_length, literal.string.size());
+      }
+    case ValueKind::Float:
+      return compare(value.floating, literal.floating);
+    case ValueKind::Signed:
+      if (Literal::Kind::Float == literal.kind) {
+        return compare(static_cast<double>(value.signed_integer), literal.floating);
+      } else {
+        uint64_t magnitude = value.signed_integer < 0 ?
+          static_cast<uint64_t>(-(value.signed_integer + 1)) + 1u :
+          static_cast<uint64_t>(value.signed_integer);
+        return compare_integers(
+          value.signed_integer < 0, magnitude, literal.negative, literal.magnitude);
+      }
+    case ValueKind::Unsigned:
+      if (Literal::Kind::Float == literal.kind) {
+        return compare(static_cast<double>(value.unsigned_integer), literal.floating);
+      }
+      return compare_integers(false, value.unsigned_integer, literal.negative, literal.magnitude);
+    default:
+      return kUnordered;
+  }
+}
+
+// SQL LIKE, where '%' matches any sequence of characters and '_' any character
+bool
+like(const char * string, size_t length, const std::string & pattern)
+{
+  size_t s = 0u;
+  size_t p = 0u;
+  size_t star_p = std::string::npos;
+  size_t star_s = 0u;
+  while (s < length) {
+    if (p < pattern.size() && '%' == pattern[p]) {
+      star_p = p++;
+      star_s = s;
+    } else if (p < pattern.size() && ('_' == pattern[p] || string[s] == pattern[p])) {
+      ++p;
+      ++s;
+    } else if (std::string::npos != star_p) {
+      // Let the last '%' match one more character
+      p = star_p + 1u;
+      s = ++star_s;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && '%' == pattern[p]) {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+bool
+evaluate_node(const ContentFilterProgram & program, size_t index, const Value * values)
+{
+  const Node & node = program.nodes[index];
+  switch (node.kind) {
+    case Node::Kind::And:
+      return evaluate_node(program, node.left, values) &&
+             evaluate_node(program, node.right, values);
+    case Node::Kind::Or:
+      return evaluate_node(program, node.left, values) ||
+             evaluate_node(program, node.right, values);
+    case Node::Kind::Not:
+      return !evaluate_node(program, node.left, values);
+    case Node::Kind::Compare:
+      break;
+  }
+
+  const Value & value = values[node.value_index];
+  if (!value.valid) {
+    return false;
+  }
+  if (Operator::Like == node.op) {
+    return like(value.string, value.string_length, node.literal.string);
+  }
+  int result = compare_value(node, value);
+  if (kUnordered == result) {
+    return false;
+  }
+  switch (node.op) {
+    case Operator::Equal:
+      return 0 == result;
+    case Operator::NotEqual:
+      return 0 != result;
+    case Operator::Less:
+      return result < 0;
+    case Operator::LessEqual:
+      return result <= 0;
+    case Operator::Greater:
+      return result > 0;
+    case Operator::GreaterEqual:
+      return result >= 0;
+    default:
+      return false;
+  }
+}
+
+}  // namespace detail
+
+ContentFilter::ContentFilter(
+  const std::string & expression, std::unique_ptr<const detail::ContentFilterProgram> program)
+: expression_(expression), program_(std::move(program))
+{
+}
+
+ContentFilter::~ContentFilter() = default;
+
+std::shared_ptr<const ContentFilter>
+ContentFilter::create(
+  const rosidl_message_type_support_t * type_supports, const std::string & expression)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_supports, nullptr);
+
+  std::unique_ptr<detail::ContentFilterProgram> program(new detail::ContentFilterProgram());
+  program->root = 0u;
+  program->value_count = 0u;
+  const rosidl_message_type_support_t * type_support = get_message_typesupport_handle(
+    type_supports, rosidl_typesupport_introspection_c__identifier);
+  if (type_support) {
+    detail::add_layout(
+      *program,
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(type_support->data));
+  } else {
+    type_support = get_message_typesupport_handle(
+      type_supports, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+    if (!type_support) {
+      RMW_SET_ERROR_MSG("content filters need the introspection type support of the message");
+      return nullptr;
+    }
+    detail::add_layout(
+      *program,
+      static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+        type_support->data));
+  }
+
+  detail::Parser parser(expression, *program);
+  if (!parser.parse()) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "invalid content filter expression '%s' at character %zu: %s",
+      expression.c_str(), parser.error_position(), parser.error().c_str());
+    return nullptr;
+  }
+  return std::shared_ptr<const ContentFilter>(new ContentFilter(expression, std::move(program)));
+}
+
+bool
+ContentFilter::evaluate(const uint8_t * data, size_t length) const
+{
+  if (!data || length < 4u) {
+    return true;
+  }
+  detail::Value values[detail::kMaxFields];
+  for (size_t i = 0; i < program_->value_count; ++i) {
+    values[i].valid = false;
+  }
+  detail::CdrReader reader(data, length);
+  if (!detail::read_message(*program_, program_->layouts[0], reader, values, false)) {
+    // Let the subscription report the message it can't deserialize
+    return true;
+  }
+  return detail::evaluate_node(*program_, program_->root, values);
+}
+
+static const char kContentFilterKey[] = "contentfilter=";
+
+std::vector<uint8_t>
+encode_content_filter_user_data(const std::string & expression)
+{
+  // Not a rmw key value list, whose values can't contain ';'
+  std::string user_data = kContentFilterKey + expression + ";";
+  return std::vector<uint8_t>(user_data.begin(), user_data.end());
+}
+
+bool
+decode_content_filter_user_data(const std::vector<uint8_t> & user_data, std::string & expression)
+{
+  const size_t key_length = sizeof(kContentFilterKey) - 1u;
+  if (user_data.size() <= key_length || ';' != user_data.back() ||
+    0 != memcmp(user_data.data(), kContentFilterKey, key_length))
+  {
+    return false;
+  }
+  expression.assign(user_data.begin() + key_length, user_data.end() - 1);
+  return true;
+}
+
+void
+ContentFilterRegistry::add(const GUID_t & reader_guid, const std::string & expression)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  expressions_[reader_guid] = expression;
+}
+
+void
+ContentFilterRegistry::remove(const GUID_t & reader_guid)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  expressions_.erase(reader_guid);
+}
+
+bool
+ContentFilterRegistry::get(const GUID_t & reader_guid, std::string & expression) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = expressions_.find(reader_guid);
+  if (it == expressions_.end()) {
+    return false;
+  }
+  expression = it->second;
+  return true;
+}
+
+WriterContentFilter::WriterContentFilter(
+  const rosidl_message_type_support_t * type_supports,
+  const ContentFilterRegistry & registry)
+: type_supports_(type_supports),
+  registry_(registry)
+{
+}
+
+void
+WriterContentFilter::reader_matched(const GUID_t & reader_guid)
+{
+  std::string expression;
+  if (!registry_.get(reader_guid, expression)) {
+    return;
+  }
+
+  std::shared_ptr<const ContentFilter> filter;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = filters_.find(expression);
+    if (it != filters_.end()) {
+      filter = it->second.filter;
+    }
+  }
+  if (!filter) {
+    // Compiled without holding the lock, which the writer takes when sending changes
+    filter = ContentFilter::create(type_supports_, expression);
+    if (!filter) {
+      // The subscription filters the messages itself
+      RCUTILS_LOG_DEBUG_NAMED(
+        "rmw_fastrtps_shared_cpp",
+        "content filter of a subscription not used by the publisher: %s",
+        rmw_get_error_string().str);
+      rmw_reset_error();
+      return;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (readers_.count(reader_guid) != 0u) {
+    return;
+  }
+  auto it = filters_.emplace(
+    expression, CompiledFilter{filter, 0u, SequenceNumber_t::unknown(), true}).first;
+  ++it->second.reader_count;
+  readers_[reader_guid] = &it->second;
+  filtered_reader_count_.store(readers_.size());
+}
+
+void
+WriterContentFilter::reader_removed(const GUID_t & reader_guid)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = readers_.find(reader_guid);
+  if (it == readers_.end()) {
+    return;
+  }
+  CompiledFilter * compiled = it->second;
+  readers_.erase(it);
+  if (0u == --compiled->reader_count) {
+    std::string expression = compiled->filter->expression();
+    filters_.erase(expression);
+  }
+  filtered_reader_count_.store(readers_.size());
+}
+
+bool
+WriterContentFilter::is_relevant(const CacheChange_t & change, const GUID_t & reader_guid) const
+{
+  if (0u == filtered_reader_count_.load()) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = readers_.find(reader_guid);
+  if (it == readers_.end()) {
+    return true;
+  }
+  CompiledFilter & compiled = *it->second;
+  if (compiled.last_sequence_number != change.sequenceNumber) {
+    compiled.last_result = compiled.filter->evaluate(
+      change.serializedPayload.data, change.serializedPayload.length);
+    compiled.last_sequence_number = change.sequenceNumber;
+  }
+  return compiled.last_result;
+}
+
+}  // namespace rmw_fastrtps_shared_cpp
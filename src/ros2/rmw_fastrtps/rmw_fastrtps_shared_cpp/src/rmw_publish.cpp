@@ -12,9 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "fastcdr/Cdr.h"
-#include "fastcdr/FastBuffer.h"
-
 #include "rmw/allocators.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
@@ -24,6 +21,8 @@
 #include "rmw_fastrtps_shared_cpp/custom_publisher_info.hpp"
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
 
+#include "tracetools/tracetools.h"
+
 namespace rmw_fastrtps_shared_cpp
 {
 rmw_ret_t
@@ -47,8 +46,9 @@ __rmw_publish(
   auto info = static_cast<CustomPublisherInfo *>(publisher->data);
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(info, "publisher info pointer is null", return RMW_RET_ERROR);
 
+  TRACEPOINT(rmw_publish, static_cast<const void *>(publisher), ros_message);
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = false;
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE;
   data.data = const_cast<void *>(ros_message);
   data.impl = info->type_support_impl_;
   if (!info->publisher_->write(&data)) {
@@ -80,19 +80,10 @@ __rmw_publish_serialized_message(
   auto info = static_cast<CustomPublisherInfo *>(publisher->data);
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(info, "publisher info pointer is null", return RMW_RET_ERROR);
 
-  eprosima::fastcdr::FastBuffer buffer(
-    reinterpret_cast<char *>(serialized_message->buffer), serialized_message->buffer_length);
-  eprosima::fastcdr::Cdr ser(
-    buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::Cdr::DDS_CDR);
-  if (!ser.jump(serialized_message->buffer_length)) {
-    RMW_SET_ERROR_MSG("cannot correctly set serialized buffer");
-    return RMW_RET_ERROR;
-  }
-
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = true;
-  data.data = &ser;
-  data.impl = nullptr;    // not used when is_cdr_buffer is true
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE;
+  data.data = const_cast<rmw_serialized_message_t *>(serialized_message);
+  data.impl = nullptr;    // not used when type is FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE
   if (!info->publisher_->write(&data)) {
     RMW_SET_ERROR_MSG("cannot publish data");
     return RMW_RET_ERROR;
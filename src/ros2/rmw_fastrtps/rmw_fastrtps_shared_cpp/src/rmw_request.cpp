@@ -54,7 +54,7 @@ __rmw_send_request(
 
   eprosima::fastrtps::rtps::WriteParams wparams;
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = false;
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE;
   data.data = const_cast<void *>(ros_request);
   data.impl = info->request_type_support_impl_;
   wparams.related_sample_identity().writer_guid() = info->reader_guid_;
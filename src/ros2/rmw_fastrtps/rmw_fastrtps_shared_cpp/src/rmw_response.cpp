@@ -129,7 +129,7 @@ __rmw_send_response(
   }
 
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = false;
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE;
   data.data = const_cast<void *>(ros_response);
   data.impl = info->response_type_support_impl_;
   if (info->response_publisher_->write(&data, wparams)) {
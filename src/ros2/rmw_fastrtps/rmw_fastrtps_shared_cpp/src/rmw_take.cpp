@@ -21,9 +21,6 @@
 #include "fastrtps/subscriber/SampleInfo.h"
 #include "fastrtps/attributes/SubscriberAttributes.h"
 
-#include "fastcdr/Cdr.h"
-#include "fastcdr/FastBuffer.h"
-
 #include "rmw_fastrtps_shared_cpp/custom_subscriber_info.hpp"
 #include "rmw_fastrtps_shared_cpp/guid_utils.hpp"
 #include "rmw_fastrtps_shared_cpp/rmw_common.hpp"
@@ -71,18 +68,24 @@ _take(
   eprosima::fastrtps::SampleInfo_t sinfo;
 
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = false;
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_ROS_MESSAGE;
   data.data = ros_message;
   data.impl = info->type_support_impl_;
-  if (info->subscriber_->takeNextData(&data, &sinfo)) {
+  data.content_filter = info->content_filter_.get();
+  while (info->subscriber_->takeNextData(&data, &sinfo)) {
     info->listener_->data_taken(info->subscriber_);
 
+    if (data.filtered_out) {
+      // Sent by a writer which doesn't filter for this subscription
+      continue;
+    }
     if (eprosima::fastrtps::rtps::ALIVE == sinfo.sampleKind) {
       if (message_info) {
         _assign_message_info(identifier, message_info, &sinfo);
       }
       *taken = true;
     }
+    break;
   }
 
   return RMW_RET_OK;
@@ -273,32 +276,28 @@ _take_serialized_message(
   CustomSubscriberInfo * info = static_cast<CustomSubscriberInfo *>(subscription->data);
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(info, "custom subscriber info is null", return RMW_RET_ERROR);
 
-  eprosima::fastcdr::FastBuffer buffer;
   eprosima::fastrtps::SampleInfo_t sinfo;
 
+  // The payload is copied straight into serialized_message, resizing it if needed
   rmw_fastrtps_shared_cpp::SerializedData data;
-  data.is_cdr_buffer = true;
-  data.data = &buffer;
-  data.impl = nullptr;    // not used when is_cdr_buffer is true
-  if (info->subscriber_->takeNextData(&data, &sinfo)) {
+  data.type = FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE;
+  data.data = serialized_message;
+  data.impl = nullptr;    // not used when type is FASTRTPS_SERIALIZED_DATA_TYPE_SERIALIZED_MESSAGE
+  data.content_filter = info->content_filter_.get();
+  while (info->subscriber_->takeNextData(&data, &sinfo)) {
     info->listener_->data_taken(info->subscriber_);
 
+    if (data.filtered_out) {
+      // Sent by a writer which doesn't filter for this subscription
+      continue;
+    }
     if (eprosima::fastrtps::rtps::ALIVE == sinfo.sampleKind) {
-      auto buffer_size = static_cast<size_t>(buffer.getBufferSize());
-      if (serialized_message->buffer_capacity < buffer_size) {
-        auto ret = rmw_serialized_message_resize(serialized_message, buffer_size);
-        if (ret != RMW_RET_OK) {
-          return ret;  // Error message already set
-        }
-      }
-      serialized_message->buffer_length = buffer_size;
-      memcpy(serialized_message->buffer, buffer.getBuffer(), serialized_message->buffer_length);
-
       if (message_info) {
         _assign_message_info(identifier, message_info, &sinfo);
       }
       *taken = true;
     }
+    break;
   }
 
   return RMW_RET_OK;
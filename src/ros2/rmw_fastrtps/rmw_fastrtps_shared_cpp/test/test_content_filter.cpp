@@ -0,0 +1,311 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "fastcdr/Cdr.h"
+#include "fastcdr/FastBuffer.h"
+
+#include "fastrtps/rtps/common/CacheChange.h"
+#include "fastrtps/rtps/common/Guid.h"
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rmw_fastrtps_shared_cpp/content_filter.hpp"
+
+using rmw_fastrtps_shared_cpp::ContentFilter;
+using rosidl_typesupport_introspection_cpp::MessageMember;
+using rosidl_typesupport_introspection_cpp::MessageMembers;
+
+namespace
+{
+
+MessageMember
+make_member(
+  const char * name, uint8_t type_id, bool is_array = false, size_t array_size = 0u,
+  const rosidl_message_type_support_t * members = nullptr)
+{
+  MessageMember member{};
+  member.name_ = name;
+  member.type_id_ = type_id;
+  member.is_array_ = is_array;
+  member.array_size_ = array_size;
+  member.members_ = members;
+  return member;
+}
+
+// struct Header {int32 id; string frame_id;}
+const MessageMember header_members[] = {
+  make_member("id", rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32),
+  make_member("frame_id", rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING),
+};
+const MessageMembers header_type{
+  "test", "Header", 2u, 0u, header_members, nullptr, nullptr};
+const rosidl_message_type_support_t header_type_support{
+  rosidl_typesupport_introspection_cpp::typesupport_identifier, &header_type,
+  get_message_typesupport_handle_function};
+
+// struct Sample {
+//   bool flag; uint8[] blob; Header header; double value; int64 big; string name;
+//   float[2] pair; string[] tags; uint64 count;
+// }
+const MessageMember sample_members[] = {
+  make_member("flag", rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOLEAN),
+  make_member("blob", rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8, true),
+  make_member(
+    "header", rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE, false, 0u,
+    &header_type_support),
+  make_member("value", rosidl_typesupport_introspection_cpp::ROS_TYPE_DOUBLE),
+  make_member("big", rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64),
+  make_member("name", rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING),
+  make_member("pair", rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT, true, 2u),
+  make_member("tags", rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING, true),
+  make_member("count", rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64),
+};
+const MessageMembers sample_type{
+  "test", "Sample", 9u, 0u, sample_members, nullptr, nullptr};
+const rosidl_message_type_support_t sample_type_support{
+  rosidl_typesupport_introspection_cpp::typesupport_identifier, &sample_type,
+  get_message_typesupport_handle_function};
+
+struct Sample
+{
+  bool flag = true;
+  std::vector<uint8_t> blob = {1u, 2u, 3u};
+  int32_t id = -7;
+  std::string frame_id = "base_link";
+  double value = 10.5;
+  int64_t big = INT64_MIN;
+  std::string name = "it's a robot";
+  float pair[2] = {1.0f, 2.0f};
+  std::vector<std::string> tags = {"a", "bc"};
+  uint64_t count = UINT64_MAX;
+};
+
+std::vector<uint8_t>
+serialize(
+  const Sample & sample,
+  eprosima::fastcdr::Cdr::Endianness endianness = eprosima::fastcdr::Cdr::DEFAULT_ENDIAN)
+{
+  std::vector<char> buffer(4096);
+  eprosima::fastcdr::FastBuffer fastbuffer(buffer.data(), buffer.size());
+  eprosima::fastcdr::Cdr ser(fastbuffer, endianness, eprosima::fastcdr::Cdr::DDS_CDR);
+  ser.serialize_encapsulation();
+  ser << sample.flag << sample.blob << sample.id << sample.frame_id << sample.value <<
+    sample.big << sample.name;
+  ser.serializeArray(sample.pair, 2u);
+  ser << sample.tags << sample.count;
+  return std::vector<uint8_t>(buffer.begin(), buffer.begin() + ser.getSerializedDataLength());
+}
+
+bool
+evaluate(const std::string & expression, const Sample & sample)
+{
+  auto filter = ContentFilter::create(&sample_type_support, expression);
+  if (!filter) {
+    ADD_FAILURE() << expression << ": " << rmw_get_error_string().str;
+    rmw_reset_error();
+    return false;
+  }
+  std::vector<uint8_t> data = serialize(sample);
+  return filter->evaluate(data.data(), data.size());
+}
+
+}  // namespace
+
+TEST(TestContentFilter, compare_fields) {
+  Sample sample;
+  EXPECT_TRUE(evaluate("flag = TRUE", sample));
+  EXPECT_FALSE(evaluate("flag <> true", sample));
+  EXPECT_TRUE(evaluate("value > 10", sample));
+  EXPECT_TRUE(evaluate("value <= 10.5", sample));
+  EXPECT_FALSE(evaluate("value < 1e1", sample));
+  EXPECT_TRUE(evaluate("header.id = -7", sample));
+  EXPECT_TRUE(evaluate("header.id >= -7.5", sample));
+  EXPECT_TRUE(evaluate("header.frame_id = 'base_link'", sample));
+  EXPECT_TRUE(evaluate("header.frame_id > 'base'", sample));
+  EXPECT_TRUE(evaluate("name = 'it''s a robot'", sample));
+  // Integers are compared exactly, whatever their size
+  EXPECT_TRUE(evaluate("big = -9223372036854775808", sample));
+  EXPECT_TRUE(evaluate("big < -9223372036854775807", sample));
+  EXPECT_TRUE(evaluate("count = 18446744073709551615", sample));
+  EXPECT_TRUE(evaluate("count > 18446744073709551614", sample));
+  EXPECT_TRUE(evaluate("count > -1", sample));
+}
+
+TEST(TestContentFilter, value_on_the_left) {
+  Sample sample;
+  EXPECT_TRUE(evaluate("11 > value", sample));
+  EXPECT_FALSE(evaluate("10 >= value", sample));
+  EXPECT_TRUE(evaluate("'base_link' = header.frame_id", sample));
+}
+
+TEST(TestContentFilter, like) {
+  Sample sample;
+  EXPECT_TRUE(evaluate("header.frame_id LIKE 'base%'", sample));
+  EXPECT_TRUE(evaluate("header.frame_id like '%_link'", sample));
+  EXPECT_TRUE(evaluate("header.frame_id LIKE 'b%s%k'", sample));
+  EXPECT_FALSE(evaluate("header.frame_id LIKE 'base'", sample));
+  EXPECT_FALSE(evaluate("header.frame_id LIKE '%linkk'", sample));
+  sample.frame_id = "";
+  EXPECT_TRUE(evaluate("header.frame_id LIKE '%'", sample));
+  EXPECT_FALSE(evaluate("header.frame_id LIKE '_'", sample));
+}
+
+TEST(TestContentFilter, logical_operators) {
+  Sample sample;
+  EXPECT_TRUE(evaluate("value > 100 OR header.id = -7 AND flag = TRUE", sample));
+  EXPECT_FALSE(evaluate("(value > 100 OR header.id = -7) AND flag = FALSE", sample));
+  EXPECT_TRUE(evaluate("NOT value > 100", sample));
+  EXPECT_FALSE(evaluate("NOT (value > 1 AND NOT flag = FALSE)", sample));
+}
+
+TEST(TestContentFilter, fields_after_arrays) {
+  Sample sample;
+  sample.blob.clear();
+  sample.tags = {"a much longer tag", "", "c"};
+  EXPECT_TRUE(evaluate("count = 18446744073709551615 AND header.id = -7", sample));
+  sample.blob.resize(1000u, 3u);
+  sample.count = 42u;
+  EXPECT_TRUE(evaluate("count = 42", sample));
+}
+
+TEST(TestContentFilter, big_endian) {
+  Sample sample;
+  sample.value = -2.25;
+  auto filter = ContentFilter::create(
+    &sample_type_support, "value = -2.25 AND header.id = -7 AND count > 1");
+  ASSERT_NE(nullptr, filter);
+  std::vector<uint8_t> data = serialize(sample, eprosima::fastcdr::Cdr::BIG_ENDIANNESS);
+  EXPECT_TRUE(filter->evaluate(data.data(), data.size()));
+  data = serialize(sample, eprosima::fastcdr::Cdr::LITTLE_ENDIANNESS);
+  EXPECT_TRUE(filter->evaluate(data.data(), data.size()));
+}
+
+TEST(TestContentFilter, malformed_messages_pass) {
+  Sample sample;
+  auto filter = ContentFilter::create(&sample_type_support, "count = 0");
+  ASSERT_NE(nullptr, filter);
+  std::vector<uint8_t> data = serialize(sample);
+  EXPECT_FALSE(filter->evaluate(data.data(), data.size()));
+  EXPECT_TRUE(filter->evaluate(data.data(), data.size() - 1u));
+  EXPECT_TRUE(filter->evaluate(data.data(), 2u));
+  EXPECT_TRUE(filter->evaluate(nullptr, 0u));
+}
+
+TEST(TestContentFilter, invalid_expressions) {
+  const char * expressions[] = {
+    "",
+    "value",
+    "value >",
+    "value > 1 AND",
+    "(value > 1",
+    "value > 1)",
+    "unknown = 1",
+    "header = 1",
+    "header.unknown = 1",
+    "value.x = 1",
+    "blob = 1",
+    "pair = 1",
+    "value = 'text'",
+    "value LIKE '1'",
+    "name = 1",
+    "flag > TRUE",
+    "flag = 1",
+    "1 = 1",
+    "value = value",
+    "'a%' LIKE name",
+    "name = 'unterminated",
+    "value = 1x",
+    "value = -",
+  };
+  for (const char * expression : expressions) {
+    EXPECT_EQ(nullptr, ContentFilter::create(&sample_type_support, expression)) << expression;
+    EXPECT_TRUE(rmw_error_is_set()) << expression;
+    rmw_reset_error();
+  }
+}
+
+TEST(TestContentFilter, user_data) {
+  std::string expression = "name = 'a;b' AND value > 1";
+  std::string decoded;
+  EXPECT_TRUE(
+    rmw_fastrtps_shared_cpp::decode_content_filter_user_data(
+      rmw_fastrtps_shared_cpp::encode_content_filter_user_data(expression), decoded));
+  EXPECT_EQ(expression, decoded);
+
+  std::string user_data = "enclave=/;";
+  EXPECT_FALSE(
+    rmw_fastrtps_shared_cpp::decode_content_filter_user_data(
+      std::vector<uint8_t>(user_data.begin(), user_data.end()), decoded));
+  EXPECT_FALSE(rmw_fastrtps_shared_cpp::decode_content_filter_user_data({}, decoded));
+}
+
+TEST(TestContentFilter, writer_filter) {
+  eprosima::fastrtps::rtps::GuidPrefix_t prefix;
+  prefix.value[0] = 1u;
+  eprosima::fastrtps::rtps::GUID_t unfiltered_reader{prefix, 1u};
+  eprosima::fastrtps::rtps::GUID_t filtered_reader{prefix, 2u};
+  eprosima::fastrtps::rtps::GUID_t other_filtered_reader{prefix, 3u};
+  eprosima::fastrtps::rtps::GUID_t invalid_filter_reader{prefix, 4u};
+
+  rmw_fastrtps_shared_cpp::ContentFilterRegistry registry;
+  registry.add(filtered_reader, "value > 100");
+  registry.add(other_filtered_reader, "value > 100");
+  registry.add(invalid_filter_reader, "unknown > 100");
+  rmw_fastrtps_shared_cpp::WriterContentFilter filter(&sample_type_support, registry);
+  for (const auto & guid : {unfiltered_reader, filtered_reader, invalid_filter_reader}) {
+    filter.reader_matched(guid);
+  }
+  filter.reader_matched(other_filtered_reader);
+  EXPECT_FALSE(rmw_error_is_set());
+
+  Sample sample;
+  std::vector<uint8_t> data = serialize(sample);
+  eprosima::fastrtps::rtps::CacheChange_t change(static_cast<uint32_t>(data.size()));
+  memcpy(change.serializedPayload.data, data.data(), data.size());
+  change.serializedPayload.length = static_cast<uint32_t>(data.size());
+  change.sequenceNumber = {0, 1u};
+
+  EXPECT_TRUE(filter.is_relevant(change, unfiltered_reader));
+  EXPECT_FALSE(filter.is_relevant(change, filtered_reader));
+  EXPECT_FALSE(filter.is_relevant(change, other_filtered_reader));
+  EXPECT_TRUE(filter.is_relevant(change, invalid_filter_reader));
+
+  sample.value = 101.0;
+  data = serialize(sample);
+  memcpy(change.serializedPayload.data, data.data(), data.size());
+  change.sequenceNumber = {0, 2u};
+  EXPECT_TRUE(filter.is_relevant(change, filtered_reader));
+  EXPECT_TRUE(filter.is_relevant(change, other_filtered_reader));
+
+  sample.value = 1.0;
+  data = serialize(sample);
+  memcpy(change.serializedPayload.data, data.data(), data.size());
+  change.sequenceNumber = {0, 3u};
+  filter.reader_removed(filtered_reader);
+  EXPECT_TRUE(filter.is_relevant(change, filtered_reader));
+  EXPECT_FALSE(filter.is_relevant(change, other_filtered_reader));
+  filter.reader_removed(other_filtered_reader);
+  EXPECT_TRUE(filter.is_relevant(change, other_filtered_reader));
+}
@@ -15,6 +15,7 @@
 #ifndef ROSBAG2_CPP__WRITERS__SEQUENTIAL_WRITER_HPP_
 #define ROSBAG2_CPP__WRITERS__SEQUENTIAL_WRITER_HPP_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -113,6 +114,13 @@ private:
   // Used in bagfile splitting; specifies the best-effort maximum sub-section of a bagfile in bytes.
   uint64_t max_bagfile_size_;
 
+  // Size of the current bagfile when last queried from the storage, and size of the messages
+  // written since. The storage is only queried again once these messages, scaled by how much the
+  // bagfile grew for the previous ones, may have filled a quarter of the room left in it.
+  uint64_t bagfile_size_;
+  uint64_t bytes_written_since_size_check_;
+  double bagfile_growth_ratio_;
+
   // Intermediate cache to write multiple messages into the storage.
   // `max_cache_size` is the amount of messages to hold in storage before writing to disk.
   uint64_t max_cache_size_;
@@ -123,11 +131,21 @@ private:
 
   rosbag2_storage::BagMetadata metadata_;
 
+  // The metadata file is written periodically while recording, so that the bag can be read
+  // even if the writer is not closed.
+  std::chrono::steady_clock::time_point last_metadata_checkpoint_time_;
+
   // Closes the current backed storage and opens the next bagfile.
   void split_bagfile();
 
   // Checks if the current recording bagfile needs to be split and rolled over to a new file.
-  bool should_split_bagfile() const;
+  bool should_split_bagfile();
+
+  // Queries the size of the current bagfile from the storage.
+  void reset_bagfile_size();
+
+  // Writes the metadata file with the messages written so far.
+  void checkpoint_metadata();
 
   // Prepares the metadata by setting initial values.
   void init_metadata();
@@ -49,6 +49,16 @@ std::string strip_parent_path(const std::string & relative_path)
   return rcpputils::fs::path(relative_path).filename().string();
 }
 
+// Size of a message in a bagfile, not counting the overhead of the storage.
+uint64_t get_message_size(const rosbag2_storage::SerializedBagMessage & message)
+{
+  const uint64_t data_size = message.serialized_data ? message.serialized_data->buffer_length : 0;
+  return data_size + sizeof(message.time_stamp);
+}
+
+// Period of the checkpoints of the metadata file while recording.
+constexpr const std::chrono::seconds METADATA_CHECKPOINT_PERIOD{1};
+
 }  // namespace
 
 SequentialWriter::SequentialWriter(
@@ -61,6 +71,9 @@ SequentialWriter::SequentialWriter(
   metadata_io_(std::move(metadata_io)),
   converter_(nullptr),
   max_bagfile_size_(rosbag2_storage::storage_interfaces::MAX_BAGFILE_SIZE_NO_SPLIT),
+  bagfile_size_(0),
+  bytes_written_since_size_check_(0),
+  bagfile_growth_ratio_(1.0),
   topics_names_to_info_(),
   metadata_()
 {}
@@ -113,6 +126,9 @@ void SequentialWriter::open(
   }
 
   init_metadata();
+  reset_bagfile_size();
+  // The metadata file is first written along with the first message
+  last_metadata_checkpoint_time_ = std::chrono::steady_clock::now() - METADATA_CHECKPOINT_PERIOD;
 }
 
 void SequentialWriter::reset()
@@ -188,11 +204,15 @@ void SequentialWriter::split_bagfile()
   }
 
   metadata_.relative_file_paths.push_back(strip_parent_path(storage_->get_relative_file_path()));
+  reset_bagfile_size();
 
   // Re-register all topics since we rolled-over to a new bagfile.
   for (const auto & topic : topics_names_to_info_) {
     storage_->create_topic(topic.second.topic_metadata);
   }
+
+  // Readers find the new bagfile from the metadata file
+  checkpoint_metadata();
 }
 
 void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessage> message)
@@ -207,6 +227,7 @@ void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessa
   if (should_split_bagfile()) {
     split_bagfile();
   }
+  bytes_written_since_size_check_ += get_message_size(*message);
 
   const auto message_timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
     std::chrono::nanoseconds(message->time_stamp));
@@ -227,15 +248,56 @@ void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessa
       cache_.reserve(max_cache_size_);
     }
   }
+
+  if (std::chrono::steady_clock::now() - last_metadata_checkpoint_time_ >=
+    METADATA_CHECKPOINT_PERIOD)
+  {
+    checkpoint_metadata();
+  }
 }
 
-bool SequentialWriter::should_split_bagfile() const
+bool SequentialWriter::should_split_bagfile()
 {
   if (max_bagfile_size_ == rosbag2_storage::storage_interfaces::MAX_BAGFILE_SIZE_NO_SPLIT) {
     return false;
-  } else {
-    return storage_->get_bagfile_size() > max_bagfile_size_;
   }
+
+  // Querying the size of the bagfile takes a system call, which is only worth it when the
+  // bagfile may be getting close to its maximum size.
+  if (bagfile_size_ < max_bagfile_size_) {
+    const auto estimated_growth = bytes_written_since_size_check_ * bagfile_growth_ratio_;
+    if (estimated_growth < (max_bagfile_size_ - bagfile_size_) / 4) {
+      return false;
+    }
+  }
+
+  const auto bagfile_size = storage_->get_bagfile_size();
+  // The storage can take more room than the messages, never less once they are flushed to disk
+  if (bytes_written_since_size_check_ > 0 && bagfile_size > bagfile_size_) {
+    bagfile_growth_ratio_ = std::max(
+      1.0,
+      static_cast<double>(bagfile_size - bagfile_size_) / bytes_written_since_size_check_);
+  }
+  bagfile_size_ = bagfile_size;
+  bytes_written_since_size_check_ = 0;
+
+  return bagfile_size_ > max_bagfile_size_;
+}
+
+void SequentialWriter::reset_bagfile_size()
+{
+  bagfile_size_ = 0;
+  bytes_written_since_size_check_ = 0;
+  if (max_bagfile_size_ != rosbag2_storage::storage_interfaces::MAX_BAGFILE_SIZE_NO_SPLIT) {
+    bagfile_size_ = storage_->get_bagfile_size();
+  }
+}
+
+void SequentialWriter::checkpoint_metadata()
+{
+  finalize_metadata();
+  metadata_io_->write_metadata(base_folder_, metadata_);
+  last_metadata_checkpoint_time_ = std::chrono::steady_clock::now();
 }
 
 void SequentialWriter::finalize_metadata()
@@ -161,11 +161,12 @@ TEST_F(SequentialWriterTest, open_throws_error_on_invalid_splitting_size) {
   EXPECT_THROW(writer_->open(storage_options_, {rmw_format, rmw_format}), std::runtime_error);
 }
 
-TEST_F(SequentialWriterTest, bagfile_size_is_checked_on_every_write) {
+TEST_F(SequentialWriterTest, bagfile_size_is_not_checked_on_every_write) {
   const int counter = 10;
   const uint64_t max_bagfile_size = 100;
 
-  EXPECT_CALL(*storage_, get_bagfile_size()).Times(counter);
+  // Messages are far smaller than the maximum size, so that the bagfile is not close to it
+  EXPECT_CALL(*storage_, get_bagfile_size()).Times(AtMost(counter / 2));
 
   auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
     std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
@@ -209,7 +210,8 @@ TEST_F(SequentialWriterTest, writer_splits_when_storage_bagfile_size_gt_max_bagf
       return fake_storage_uri_;
     });
 
-  EXPECT_CALL(*metadata_io_, write_metadata).Times(1);
+  // The metadata is checkpointed while writing, the last write being done on release.
+  EXPECT_CALL(*metadata_io_, write_metadata).Times(AtLeast(1));
 
   // intercept the metadata write so we can analyze it.
   ON_CALL(*metadata_io_, write_metadata).WillByDefault(
@@ -255,6 +257,64 @@ TEST_F(SequentialWriterTest, writer_splits_when_storage_bagfile_size_gt_max_bagf
   }
 }
 
+TEST_F(SequentialWriterTest, metadata_is_checkpointed_when_splitting) {
+  const int message_count = 15;
+  const int max_bagfile_size = 5;
+  fake_storage_size_ = 0;
+
+  ON_CALL(
+    *storage_,
+    write(An<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>())).WillByDefault(
+    [this](std::shared_ptr<const rosbag2_storage::SerializedBagMessage>) {
+      fake_storage_size_ += 1;
+    });
+
+  ON_CALL(*storage_, get_bagfile_size).WillByDefault(
+    [this]() {
+      return fake_storage_size_;
+    });
+
+  ON_CALL(*storage_, get_relative_file_path).WillByDefault(
+    [this]() {
+      return fake_storage_uri_;
+    });
+
+  // Number of files and messages of the bag each time the metadata is written
+  std::vector<std::pair<size_t, size_t>> checkpoints;
+  ON_CALL(*metadata_io_, write_metadata).WillByDefault(
+    [&checkpoints](const std::string &, const rosbag2_storage::BagMetadata & metadata) {
+      checkpoints.emplace_back(metadata.relative_file_paths.size(), metadata.message_count);
+    });
+
+  auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+  writer_ = std::make_unique<rosbag2_cpp::Writer>(std::move(sequential_writer));
+
+  std::string rmw_format = "rmw_format";
+
+  auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  message->topic_name = "test_topic";
+
+  storage_options_.max_bagfile_size = max_bagfile_size;
+
+  writer_->open(storage_options_, {rmw_format, rmw_format});
+  writer_->create_topic({"test_topic", "test_msgs/BasicTypes", "", ""});
+
+  for (auto i = 0; i < message_count; ++i) {
+    writer_->write(message);
+  }
+
+  // Without releasing the writer, the metadata lists every bagfile and the messages written
+  // before the last split.
+  ASSERT_FALSE(checkpoints.empty());
+  EXPECT_EQ(3u, checkpoints.back().first);
+  EXPECT_GE(checkpoints.back().second, 12u);
+
+  writer_.reset();
+  EXPECT_EQ(3u, checkpoints.back().first);
+  EXPECT_EQ(static_cast<size_t>(message_count), checkpoints.back().second);
+}
+
 TEST_F(SequentialWriterTest, only_write_after_cache_is_full) {
   const size_t counter = 1000;
   const uint64_t max_cache_size = 100;
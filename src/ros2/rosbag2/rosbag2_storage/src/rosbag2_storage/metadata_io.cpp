@@ -14,6 +14,7 @@
 
 #include "rosbag2_storage/metadata_io.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 
 #include "rcutils/filesystem.h"
 
+#include "rosbag2_storage/logging.hpp"
 #include "rosbag2_storage/topic_metadata.hpp"
 
 #ifdef _WIN32
@@ -222,8 +224,30 @@ void MetadataIo::write_metadata(const std::string & uri, const BagMetadata & met
 {
   YAML::Node metadata_node;
   metadata_node["rosbag2_bagfile_information"] = metadata;
-  std::ofstream fout(get_metadata_file_name(uri));
-  fout << metadata_node;
+
+  // The metadata is written while recording, so it replaces the previous file all at once,
+  // leaving it untouched if writing fails.
+  const auto metadata_file = get_metadata_file_name(uri);
+  const auto temporary_file = metadata_file + ".tmp";
+  {
+    std::ofstream fout(temporary_file);
+    fout << metadata_node;
+    fout.close();
+    if (!fout) {
+      ROSBAG2_STORAGE_LOG_ERROR_STREAM("Failed to write metadata file '" << temporary_file << "'");
+      std::remove(temporary_file.c_str());
+      return;
+    }
+  }
+#ifdef _WIN32
+  // rename() does not replace existing files on Windows
+  std::remove(metadata_file.c_str());
+#endif
+  if (std::rename(temporary_file.c_str(), metadata_file.c_str()) != 0) {
+    ROSBAG2_STORAGE_LOG_ERROR_STREAM(
+      "Failed to replace metadata file '" << metadata_file << "' with '" << temporary_file << "'");
+    std::remove(temporary_file.c_str());
+  }
 }
 
 BagMetadata MetadataIo::read_metadata(const std::string & uri)
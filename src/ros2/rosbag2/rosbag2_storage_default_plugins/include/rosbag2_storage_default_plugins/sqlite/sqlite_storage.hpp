@@ -16,6 +16,7 @@
 #define ROSBAG2_STORAGE_DEFAULT_PLUGINS__SQLITE__SQLITE_STORAGE_HPP_
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -84,7 +85,20 @@ public:
   void reset_filter() override;
 
 private:
+  struct TopicStatistics
+  {
+    rcutils_time_point_value_t message_count;
+    rcutils_time_point_value_t min_timestamp;
+    rcutils_time_point_value_t max_timestamp;
+  };
+
   void initialize();
+  bool has_statistics();
+  std::unordered_map<int, TopicStatistics> read_statistics();
+  void load_statistics();
+  void update_statistics(int topic_id, rcutils_time_point_value_t timestamp);
+  void checkpoint_statistics_if_due();
+  void checkpoint_statistics();
   void prepare_for_writing();
   void prepare_for_reading();
   void fill_topics_and_types();
@@ -104,6 +118,14 @@ private:
   std::vector<rosbag2_storage::TopicMetadata> all_topics_and_types_;
   std::string relative_path_;
   std::atomic_bool active_transaction_ {false};
+  // Message counts and time bounds of the topics, which are checkpointed periodically into the
+  // database along with the id of the last message they account for, so that get_metadata()
+  // only needs to aggregate the messages written after the last checkpoint.
+  bool checkpoint_statistics_ {false};
+  std::unordered_map<int, TopicStatistics> topic_statistics_;
+  rcutils_time_point_value_t last_message_id_ {0};
+  rcutils_time_point_value_t checkpointed_message_id_ {0};
+  std::chrono::steady_clock::time_point last_checkpoint_time_;
   rosbag2_storage::StorageFilter storage_filter_ {};
 };
 
@@ -16,11 +16,13 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -60,12 +62,21 @@ constexpr const auto FILE_EXTENSION = ".db3";
 
 // Minimum size of a sqlite3 database file in bytes (84 kiB).
 constexpr const uint64_t MIN_SPLIT_FILE_SIZE = 86016;
+
+// Period of the checkpoints of the topic statistics into the database.
+constexpr const std::chrono::seconds STATISTICS_CHECKPOINT_PERIOD{1};
 }  // namespace
 
 namespace rosbag2_storage_plugins
 {
 SqliteStorage::~SqliteStorage()
 {
+  try {
+    checkpoint_statistics();
+  } catch (const SqliteException & e) {
+    ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_ERROR_STREAM(
+      "Failed to checkpoint the topic statistics of '" << relative_path_ << "': " << e.what());
+  }
   if (active_transaction_) {
     commit_transaction();
   }
@@ -101,7 +112,10 @@ void SqliteStorage::open(
   // initialize only for READ_WRITE since the DB is already initialized if in APPEND.
   if (is_read_write(io_flag)) {
     initialize();
+  } else if (io_flag == rosbag2_storage::storage_interfaces::IOFlag::APPEND) {
+    load_statistics();
   }
+  last_checkpoint_time_ = std::chrono::steady_clock::now();
 
   // Reset the read and write statements in case the database changed.
   // These will be reinitialized lazily on the first read or write.
@@ -150,6 +164,13 @@ void SqliteStorage::write(std::shared_ptr<const rosbag2_storage::SerializedBagMe
 
   write_statement_->bind(message->time_stamp, topic_entry->second, message->serialized_data);
   write_statement_->execute_and_reset();
+
+  last_message_id_ = static_cast<int64_t>(database_->get_last_insert_id());
+  update_statistics(topic_entry->second, message->time_stamp);
+  // Within a transaction, the checkpoint is done before it is committed
+  if (!active_transaction_) {
+    checkpoint_statistics_if_due();
+  }
 }
 
 void SqliteStorage::write(
@@ -165,6 +186,7 @@ void SqliteStorage::write(
     write(message);
   }
 
+  checkpoint_statistics_if_due();
   commit_transaction();
 }
 
@@ -225,6 +247,132 @@ void SqliteStorage::initialize()
   database_->prepare_statement(create_stmt)->execute_and_reset();
   create_stmt = "CREATE INDEX timestamp_idx ON messages (timestamp ASC);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
+  create_stmt = "CREATE TABLE topic_statistics(" \
+    "topic_id INTEGER PRIMARY KEY," \
+    "message_count INTEGER NOT NULL," \
+    "min_timestamp INTEGER NOT NULL," \
+    "max_timestamp INTEGER NOT NULL);";
+  database_->prepare_statement(create_stmt)->execute_and_reset();
+  create_stmt = "CREATE TABLE statistics_checkpoint(" \
+    "last_message_id INTEGER NOT NULL);";
+  database_->prepare_statement(create_stmt)->execute_and_reset();
+  database_->prepare_statement(
+    "INSERT INTO statistics_checkpoint (last_message_id) VALUES (0);")->execute_and_reset();
+
+  checkpoint_statistics_ = true;
+}
+
+bool SqliteStorage::has_statistics()
+{
+  auto statement = database_->prepare_statement(
+    "SELECT COUNT(*) FROM sqlite_master "
+    "WHERE type = 'table' AND name = 'statistics_checkpoint';");
+  return std::get<0>(statement->execute_query<int>().get_single_line()) > 0;
+}
+
+std::unordered_map<int, SqliteStorage::TopicStatistics> SqliteStorage::read_statistics()
+{
+  std::unordered_map<int, TopicStatistics> statistics;
+  int64_t last_message_id = 0;
+
+  if (has_statistics()) {
+    auto statement = database_->prepare_statement(
+      "SELECT topic_id, message_count, min_timestamp, max_timestamp FROM topic_statistics;");
+    auto query_results = statement->execute_query<
+      int, int64_t, rcutils_time_point_value_t, rcutils_time_point_value_t>();
+    for (auto result : query_results) {
+      statistics[std::get<0>(result)] =
+        TopicStatistics{std::get<1>(result), std::get<2>(result), std::get<3>(result)};
+    }
+
+    statement = database_->prepare_statement(
+      "SELECT last_message_id FROM statistics_checkpoint;");
+    last_message_id = std::get<0>(statement->execute_query<int64_t>().get_single_line());
+  }
+
+  // Add the messages written after the checkpoint, which are all of them in bags recorded
+  // without statistics. This is a range scan of the messages by id.
+  auto statement = database_->prepare_statement(
+    "SELECT topic_id, COUNT(id), MIN(timestamp), MAX(timestamp) "
+    "FROM messages WHERE id > ? GROUP BY topic_id;");
+  statement->bind(last_message_id);
+  auto query_results = statement->execute_query<
+    int, int64_t, rcutils_time_point_value_t, rcutils_time_point_value_t>();
+  for (auto result : query_results) {
+    auto inserted = statistics.emplace(
+      std::get<0>(result),
+      TopicStatistics{0, std::get<2>(result), std::get<3>(result)});
+    auto & topic_statistics = inserted.first->second;
+    topic_statistics.message_count += std::get<1>(result);
+    topic_statistics.min_timestamp = std::min(topic_statistics.min_timestamp, std::get<2>(result));
+    topic_statistics.max_timestamp = std::max(topic_statistics.max_timestamp, std::get<3>(result));
+  }
+
+  return statistics;
+}
+
+void SqliteStorage::load_statistics()
+{
+  // Bags recorded without statistics keep being aggregated from their messages
+  if (!has_statistics()) {
+    return;
+  }
+
+  topic_statistics_ = read_statistics();
+  auto statement = database_->prepare_statement("SELECT IFNULL(MAX(id), 0) FROM messages;");
+  last_message_id_ = std::get<0>(statement->execute_query<int64_t>().get_single_line());
+  // Checkpointed again with the next messages
+  checkpointed_message_id_ = 0;
+  checkpoint_statistics_ = true;
+}
+
+void SqliteStorage::update_statistics(int topic_id, rcutils_time_point_value_t timestamp)
+{
+  auto inserted = topic_statistics_.emplace(topic_id, TopicStatistics{0, timestamp, timestamp});
+  auto & statistics = inserted.first->second;
+  ++statistics.message_count;
+  statistics.min_timestamp = std::min(statistics.min_timestamp, timestamp);
+  statistics.max_timestamp = std::max(statistics.max_timestamp, timestamp);
+}
+
+void SqliteStorage::checkpoint_statistics_if_due()
+{
+  if (std::chrono::steady_clock::now() - last_checkpoint_time_ >= STATISTICS_CHECKPOINT_PERIOD) {
+    checkpoint_statistics();
+  }
+}
+
+void SqliteStorage::checkpoint_statistics()
+{
+  if (!checkpoint_statistics_ || last_message_id_ == checkpointed_message_id_) {
+    return;
+  }
+
+  // The checkpoint must match the messages in the database, so it joins their transaction if
+  // they are being written in one.
+  const bool own_transaction = !active_transaction_;
+  activate_transaction();
+
+  auto insert_statistics = database_->prepare_statement(
+    "INSERT OR REPLACE INTO topic_statistics "
+    "(topic_id, message_count, min_timestamp, max_timestamp) VALUES (?, ?, ?, ?);");
+  for (const auto & statistics : topic_statistics_) {
+    insert_statistics->bind(
+      statistics.first, statistics.second.message_count,
+      statistics.second.min_timestamp, statistics.second.max_timestamp);
+    insert_statistics->execute_and_reset();
+  }
+  auto update_checkpoint = database_->prepare_statement(
+    "UPDATE statistics_checkpoint SET last_message_id = ?;");
+  update_checkpoint->bind(last_message_id_);
+  update_checkpoint->execute_and_reset();
+
+  if (own_transaction) {
+    commit_transaction();
+  }
+
+  checkpointed_message_id_ = last_message_id_;
+  last_checkpoint_time_ = std::chrono::steady_clock::now();
 }
 
 void SqliteStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
@@ -249,6 +397,15 @@ void SqliteStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
       "DELETE FROM topics where name = ? and type = ? and serialization_format = ?");
     delete_topic->bind(topic.name, topic.type, topic.serialization_format);
     delete_topic->execute_and_reset();
+    // The id of the topic could be reused by the next one
+    const int topic_id = topics_.at(topic.name);
+    if (checkpoint_statistics_) {
+      auto delete_statistics =
+        database_->prepare_statement("DELETE FROM topic_statistics where topic_id = ?");
+      delete_statistics->bind(topic_id);
+      delete_statistics->execute_and_reset();
+    }
+    topic_statistics_.erase(topic_id);
     topics_.erase(topic.name);
   }
 }
@@ -323,27 +480,35 @@ rosbag2_storage::BagMetadata SqliteStorage::get_metadata()
   metadata.message_count = 0;
   metadata.topics_with_message_count = {};
 
+  const auto statistics = read_statistics();
+
+  // Topics recorded more than once are merged by name
+  std::map<std::string, rosbag2_storage::TopicInformation> topics_with_message_count;
   auto statement = database_->prepare_statement(
-    "SELECT name, type, serialization_format, COUNT(messages.id), MIN(messages.timestamp), "
-    "MAX(messages.timestamp) "
-    "FROM messages JOIN topics on topics.id = messages.topic_id "
-    "GROUP BY topics.name;");
-  auto query_results = statement->execute_query<
-    std::string, std::string, std::string, int, rcutils_time_point_value_t,
-    rcutils_time_point_value_t>();
+    "SELECT id, name, type, serialization_format FROM topics;");
+  auto query_results = statement->execute_query<int, std::string, std::string, std::string>();
 
   rcutils_time_point_value_t min_time = INT64_MAX;
   rcutils_time_point_value_t max_time = 0;
   for (auto result : query_results) {
-    metadata.topics_with_message_count.push_back(
-      {
-        {std::get<0>(result), std::get<1>(result), std::get<2>(result), ""},
-        static_cast<size_t>(std::get<3>(result))
-      });
-
-    metadata.message_count += std::get<3>(result);
-    min_time = std::get<4>(result) < min_time ? std::get<4>(result) : min_time;
-    max_time = std::get<5>(result) > max_time ? std::get<5>(result) : max_time;
+    const auto topic_statistics = statistics.find(std::get<0>(result));
+    if (topic_statistics == statistics.end()) {
+      continue;
+    }
+
+    auto inserted = topics_with_message_count.emplace(
+      std::get<1>(result),
+      rosbag2_storage::TopicInformation{
+        {std::get<1>(result), std::get<2>(result), std::get<3>(result), ""}, 0});
+    inserted.first->second.message_count +=
+      static_cast<size_t>(topic_statistics->second.message_count);
+
+    metadata.message_count += topic_statistics->second.message_count;
+    min_time = std::min(min_time, topic_statistics->second.min_timestamp);
+    max_time = std::max(max_time, topic_statistics->second.max_timestamp);
+  }
+  for (const auto & topic : topics_with_message_count) {
+    metadata.topics_with_message_count.push_back(topic.second);
   }
 
   if (metadata.message_count == 0) {
@@ -26,6 +26,8 @@
 
 #include "rosbag2_storage/storage_filter.hpp"
 
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_wrapper.hpp"
+
 #include "storage_test_fixture.hpp"
 
 using namespace ::testing;  // NOLINT
@@ -245,6 +247,148 @@ TEST_F(StorageTestFixture, get_metadata_returns_correct_struct_if_no_messages) {
   EXPECT_THAT(metadata.duration, Eq(std::chrono::seconds(0)));
 }
 
+TEST_F(StorageTestFixture, get_metadata_adds_messages_written_after_the_last_checkpoint) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {std::make_tuple("first message", static_cast<int64_t>(1e9), "topic1", "type1", "rmw_format"),
+    std::make_tuple("second message", static_cast<int64_t>(2e9), "topic1", "type1", "rmw_format"),
+    std::make_tuple("third message", static_cast<int64_t>(3e9), "topic2", "type2", "rmw_format")};
+
+  // The statistics of these messages are checkpointed when the storage is closed
+  write_messages_to_sqlite(messages);
+
+  const auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  {
+    rosbag2_storage_plugins::SqliteWrapper database(
+      db_filename, rosbag2_storage::storage_interfaces::IOFlag::APPEND);
+    // Checkpointed messages aren't aggregated again
+    database.prepare_statement("DELETE FROM messages WHERE id = 1;")->execute_and_reset();
+    // As if the recorder had been killed after writing a message
+    database.prepare_statement(
+      "INSERT INTO messages (timestamp, topic_id, data) VALUES (5000000000, 2, x'00');")
+    ->execute_and_reset();
+  }
+
+  const auto readable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(db_filename, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  const auto metadata = readable_storage->get_metadata();
+
+  EXPECT_THAT(
+    metadata.topics_with_message_count, ElementsAreArray(
+  {
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic1", "type1", "rmw_format", ""}, 2u},
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic2", "type2", "rmw_format", ""}, 2u}
+  }));
+  EXPECT_THAT(metadata.message_count, Eq(4u));
+  EXPECT_THAT(
+    metadata.starting_time, Eq(
+      std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::seconds(1))
+  ));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::seconds(4)));
+}
+
+TEST_F(StorageTestFixture, get_metadata_aggregates_messages_of_bags_without_statistics) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {std::make_tuple("first message", static_cast<int64_t>(1e9), "topic1", "type1", "rmw_format"),
+    std::make_tuple("second message", static_cast<int64_t>(2e9), "topic1", "type1", "rmw_format"),
+    std::make_tuple("third message", static_cast<int64_t>(3e9), "topic2", "type2", "rmw_format")};
+
+  write_messages_to_sqlite(messages);
+
+  const auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  {
+    // As recorded by earlier versions
+    rosbag2_storage_plugins::SqliteWrapper database(
+      db_filename, rosbag2_storage::storage_interfaces::IOFlag::APPEND);
+    database.prepare_statement("DROP TABLE topic_statistics;")->execute_and_reset();
+    database.prepare_statement("DROP TABLE statistics_checkpoint;")->execute_and_reset();
+  }
+
+  const auto readable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(db_filename, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  const auto metadata = readable_storage->get_metadata();
+
+  EXPECT_THAT(
+    metadata.topics_with_message_count, ElementsAreArray(
+  {
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic1", "type1", "rmw_format", ""}, 2u},
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic2", "type2", "rmw_format", ""}, 1u}
+  }));
+  EXPECT_THAT(metadata.message_count, Eq(3u));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::seconds(2)));
+}
+
+TEST_F(StorageTestFixture, get_metadata_counts_messages_of_bag_being_written) {
+  auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  writable_storage->open((rcpputils::fs::path(temporary_dir_path_) / "rosbag").string());
+  writable_storage->create_topic({"topic1", "type1", "rmw_format", ""});
+  for (int64_t i = 1; i <= 3; ++i) {
+    auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    bag_message->serialized_data = make_serialized_message("message");
+    bag_message->time_stamp = i * static_cast<int64_t>(1e9);
+    bag_message->topic_name = "topic1";
+    writable_storage->write(bag_message);
+  }
+
+  // Read while the storage is still open, as after a crash of the recorder
+  const auto readable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(
+    writable_storage->get_relative_file_path(),
+    rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  const auto metadata = readable_storage->get_metadata();
+
+  EXPECT_THAT(
+    metadata.topics_with_message_count, ElementsAreArray(
+  {
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic1", "type1", "rmw_format", ""}, 3u}
+  }));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::seconds(2)));
+}
+
+TEST_F(StorageTestFixture, statistics_are_kept_when_appending_to_a_bag) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {std::make_tuple("first message", static_cast<int64_t>(1e9), "topic1", "type1", "rmw_format"),
+    std::make_tuple("second message", static_cast<int64_t>(2e9), "topic1", "type1", "rmw_format")};
+
+  write_messages_to_sqlite(messages);
+
+  const auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  {
+    auto appendable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+    appendable_storage->open(db_filename, rosbag2_storage::storage_interfaces::IOFlag::APPEND);
+    appendable_storage->create_topic({"topic2", "type2", "rmw_format", ""});
+    auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    bag_message->serialized_data = make_serialized_message("third message");
+    bag_message->time_stamp = static_cast<int64_t>(4e9);
+    bag_message->topic_name = "topic2";
+    appendable_storage->write(bag_message);
+  }
+  {
+    // Only the statistics can tell about the messages of the first recording now
+    rosbag2_storage_plugins::SqliteWrapper database(
+      db_filename, rosbag2_storage::storage_interfaces::IOFlag::APPEND);
+    database.prepare_statement("DELETE FROM messages WHERE topic_id = 1;")->execute_and_reset();
+  }
+
+  const auto readable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open(db_filename, rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  const auto metadata = readable_storage->get_metadata();
+
+  EXPECT_THAT(
+    metadata.topics_with_message_count, ElementsAreArray(
+  {
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic1", "type1", "rmw_format", ""}, 2u},
+    rosbag2_storage::TopicInformation{rosbag2_storage::TopicMetadata{
+        "topic2", "type2", "rmw_format", ""}, 1u}
+  }));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::seconds(3)));
+}
+
 TEST_F(StorageTestFixture, remove_topics_and_types_returns_the_empty_vector) {
   std::unique_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> writable_storage =
     std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
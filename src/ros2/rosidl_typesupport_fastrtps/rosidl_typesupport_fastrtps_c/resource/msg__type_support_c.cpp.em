@@ -27,6 +27,8 @@ header_files = [
     'rosidl_typesupport_fastrtps_c/wstring_conversion.hpp',
     # Provides the definition of the message_type_support_callbacks_t struct.
     'rosidl_typesupport_fastrtps_cpp/message_type_support.h',
+    # Provides the computation of the serialized size of fully bounded items.
+    'rosidl_typesupport_fastrtps_cpp/serialized_size.hpp',
     package_name + '/msg/rosidl_typesupport_fastrtps_c__visibility_control.h',
     include_base + '__struct.h',
     include_base + '__functions.h',
@@ -467,9 +469,25 @@ size_t get_serialized_size_@('__'.join([package_name] + list(interface_path.pare
     current_alignment += array_size * item_size +
       eprosima::fastcdr::Cdr::alignment(current_alignment, item_size);
 @[    else]
-    for (size_t index = 0; index < array_size; ++index) {
-      current_alignment += get_serialized_size_@('__'.join(member.type.value_type.namespaced_name()))(
-        &array_ptr[index], current_alignment);
+    static const bool item_fully_bounded = []() {
+        bool full_bounded = true;
+        max_serialized_size_@('__'.join(member.type.value_type.namespaced_name()))(full_bounded, 0);
+        return full_bounded;
+      }();
+    if (item_fully_bounded && array_size > 0) {
+      // All the items have the same size at a given alignment, measure only one of them
+      const void * item = &array_ptr[0];
+      current_alignment += rosidl_typesupport_fastrtps_cpp::get_fully_bounded_items_serialized_size(
+        array_size, current_alignment,
+        [item](size_t item_alignment) {
+          return get_serialized_size_@('__'.join(member.type.value_type.namespaced_name()))(
+            item, item_alignment);
+        });
+    } else {
+      for (size_t index = 0; index < array_size; ++index) {
+        current_alignment += get_serialized_size_@('__'.join(member.type.value_type.namespaced_name()))(
+          &array_ptr[index], current_alignment);
+      }
     }
 @[    end if]@
   }
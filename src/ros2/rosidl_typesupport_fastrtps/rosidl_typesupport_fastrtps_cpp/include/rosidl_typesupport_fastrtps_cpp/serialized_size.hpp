@@ -0,0 +1,77 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSIDL_TYPESUPPORT_FASTRTPS_CPP__SERIALIZED_SIZE_HPP_
+#define ROSIDL_TYPESUPPORT_FASTRTPS_CPP__SERIALIZED_SIZE_HPP_
+
+#include <cstddef>
+
+namespace rosidl_typesupport_fastrtps_cpp
+{
+
+/// Largest alignment CDR may apply to a primitive (that of long double).
+constexpr size_t kMaxCdrAlignment = 16;
+
+/// Compute the serialized size of a run of fully bounded items.
+/**
+ * The serialized size of an item of a fully bounded type (no strings nor sequences, as reported
+ * by its max_serialized_size function) only depends on the alignment it starts at.
+ * The sizes of consecutive items are therefore periodic, and only the items up to the first
+ * repeated alignment need to be measured, instead of every item of the run.
+ *
+ * \param[in] item_count Number of items in the run.
+ * \param[in] current_alignment Alignment at the start of the first item.
+ * \param[in] item_size Callable returning the serialized size of an item starting at the given
+ *   alignment.
+ * \return The serialized size of the whole run, including the padding between items.
+ */
+template<typename ItemSizeFunction>
+size_t
+get_fully_bounded_items_serialized_size(
+  size_t item_count,
+  size_t current_alignment,
+  ItemSizeFunction item_size)
+{
+  // Index + 1 and offset of the item that started at each alignment.
+  size_t seen_index[kMaxCdrAlignment] = {};
+  size_t seen_offset[kMaxCdrAlignment];
+
+  size_t offset = 0;
+  size_t index = 0;
+  while (index < item_count) {
+    size_t alignment = (current_alignment + offset) % kMaxCdrAlignment;
+    if (seen_index[alignment] != 0) {
+      // Items from here on repeat the sizes of the items since the previous one at this alignment.
+      size_t period = index - (seen_index[alignment] - 1);
+      size_t period_size = offset - seen_offset[alignment];
+      offset += ((item_count - index) / period) * period_size;
+      index = item_count - (item_count - index) % period;
+      break;
+    }
+    seen_index[alignment] = index + 1;
+    seen_offset[alignment] = offset;
+    offset += item_size(current_alignment + offset);
+    ++index;
+  }
+
+  for (; index < item_count; ++index) {
+    offset += item_size(current_alignment + offset);
+  }
+
+  return offset;
+}
+
+}  // namespace rosidl_typesupport_fastrtps_cpp
+
+#endif  // ROSIDL_TYPESUPPORT_FASTRTPS_CPP__SERIALIZED_SIZE_HPP_
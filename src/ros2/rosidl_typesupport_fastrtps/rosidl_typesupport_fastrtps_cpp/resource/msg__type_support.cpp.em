@@ -17,6 +17,7 @@ header_files = [
     'rosidl_typesupport_fastrtps_cpp/identifier.hpp',
     'rosidl_typesupport_fastrtps_cpp/message_type_support.h',
     'rosidl_typesupport_fastrtps_cpp/message_type_support_decl.hpp',
+    'rosidl_typesupport_fastrtps_cpp/serialized_size.hpp',
     'rosidl_typesupport_fastrtps_cpp/wstring_conversion.hpp',
     'fastcdr/Cdr.h',
 ]
@@ -310,10 +311,27 @@ get_serialized_size(
     current_alignment += array_size * item_size +
       eprosima::fastcdr::Cdr::alignment(current_alignment, item_size);
 @[    else]
-    for (size_t index = 0; index < array_size; ++index) {
-      current_alignment +=
-        @('::'.join(member.type.value_type.namespaces))::typesupport_fastrtps_cpp::get_serialized_size(
-        ros_message.@(member.name)[index], current_alignment);
+    static const bool item_fully_bounded = []() {
+        bool full_bounded = true;
+        @('::'.join(member.type.value_type.namespaces))::typesupport_fastrtps_cpp::max_serialized_size_@(member.type.value_type.name)(
+          full_bounded, 0);
+        return full_bounded;
+      }();
+    if (item_fully_bounded && array_size > 0) {
+      // All the items have the same size at a given alignment, measure only one of them
+      const auto & item = ros_message.@(member.name)[0];
+      current_alignment += rosidl_typesupport_fastrtps_cpp::get_fully_bounded_items_serialized_size(
+        array_size, current_alignment,
+        [&item](size_t item_alignment) {
+          return @('::'.join(member.type.value_type.namespaces))::typesupport_fastrtps_cpp::get_serialized_size(
+            item, item_alignment);
+        });
+    } else {
+      for (size_t index = 0; index < array_size; ++index) {
+        current_alignment +=
+          @('::'.join(member.type.value_type.namespaces))::typesupport_fastrtps_cpp::get_serialized_size(
+          ros_message.@(member.name)[index], current_alignment);
+      }
     }
 @[    end if]@
   }
@@ -0,0 +1,82 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "rosidl_typesupport_fastrtps_cpp/serialized_size.hpp"
+
+using rosidl_typesupport_fastrtps_cpp::get_fully_bounded_items_serialized_size;
+
+namespace
+{
+
+size_t alignment(size_t current_alignment, size_t data_size)
+{
+  return (data_size - (current_alignment % data_size)) & (data_size - 1);
+}
+
+/// Serialized size of a fully bounded item made of primitives of the given sizes.
+size_t item_size(const std::vector<size_t> & fields, size_t current_alignment)
+{
+  size_t initial_alignment = current_alignment;
+  for (size_t field : fields) {
+    current_alignment += field + alignment(current_alignment, field);
+  }
+  return current_alignment - initial_alignment;
+}
+
+}  // namespace
+
+TEST(test_serialized_size, matches_item_by_item_size)
+{
+  const std::vector<std::vector<size_t>> items = {
+    {8, 8, 8},  // geometry_msgs/Point
+    {4, 4, 4, 4},  // std_msgs/ColorRGBA
+    {4, 4},  // builtin_interfaces/Time
+    {1},
+    {1, 2},
+    {2, 8, 1},
+    {1, 4, 1},
+    {16, 1},
+    {1, 16, 2, 4},
+  };
+
+  for (const std::vector<size_t> & fields : items) {
+    auto size = [&fields](size_t current_alignment) {
+        return item_size(fields, current_alignment);
+      };
+    for (size_t start = 0; start < 2 * rosidl_typesupport_fastrtps_cpp::kMaxCdrAlignment; ++start) {
+      size_t expected = 0;
+      for (size_t count = 0; count < 100; ++count) {
+        EXPECT_EQ(expected, get_fully_bounded_items_serialized_size(count, start, size)) <<
+          "count " << count << " start " << start << " first field " << fields[0];
+        expected += size(start + expected);
+      }
+    }
+  }
+}
+
+TEST(test_serialized_size, measures_few_items)
+{
+  size_t calls = 0;
+  auto size = [&calls](size_t current_alignment) {
+      ++calls;
+      return item_size({8, 8, 8}, current_alignment);
+    };
+
+  EXPECT_EQ(4u + 24u * 100000u, get_fully_bounded_items_serialized_size(100000, 4, size));
+  EXPECT_LE(calls, rosidl_typesupport_fastrtps_cpp::kMaxCdrAlignment + 1);
+}
@@ -0,0 +1,88 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/** \file recorder.h
+ * \brief Control of the in-process recording of tracepoints.
+ *
+ * Initialisation tracepoints (`rcl_node_init`, `rclcpp_callback_register`, etc.) are always
+ * kept, so that the entities they describe are known whenever recording starts.
+ * The other tracepoints are only recorded while the recorder is started, each thread writing
+ * into its own lock-free ring buffer which keeps the most recent events.
+ *
+ * Recording starts automatically when the `ROS_TRACE_FILE` environment variable is set, and the
+ * recorded events are then flushed to the file it names when the process exits.
+ * The number of events kept per thread can be set with `ROS_TRACE_BUFFER_SIZE`.
+ *
+ * Flushed files start with a header made of the 8 characters `ROSTRACE`, a `uint32_t` format
+ * version and the `uint32_t` process id, followed by records until the end of the file.
+ * Each record is made of a `uint64_t` timestamp in nanoseconds (steady clock), a `uint32_t`
+ * thread index, a `uint16_t` event id, a `uint16_t` payload size and the payload.
+ * The payload holds the tracepoint arguments in order: a `uint64_t` for integers, booleans
+ * and pointers, and a `uint16_t` length followed by the characters for strings.
+ * All values are in the byte order of the host that recorded them.
+ */
+
+#ifndef TRACETOOLS__RECORDER_H_
+#define TRACETOOLS__RECORDER_H_
+
+#include <stdbool.h>
+
+#include "tracetools/visibility_control.hpp"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Start recording tracepoints.
+TRACETOOLS_PUBLIC void tracetools_recorder_start(void);
+
+/// Stop recording tracepoints, keeping the events recorded so far.
+TRACETOOLS_PUBLIC void tracetools_recorder_stop(void);
+
+/// Get whether tracepoints are being recorded.
+/**
+ * \return `true` if the recorder is started, `false` otherwise
+ */
+TRACETOOLS_PUBLIC bool tracetools_recorder_is_started(void);
+
+/// Write the recorded events to a file.
+/**
+ * Events are not removed from the ring buffers, so consecutive flushes overlap.
+ * Threads may keep recording while the flush is in progress, events overwritten during the
+ * flush are then left out of the file.
+ *
+ * \param[in] path path of the file to write, overwritten if it exists
+ * \return `true` if the file was written, `false` otherwise
+ */
+TRACETOOLS_PUBLIC bool tracetools_recorder_flush(const char * path);
+
+/// Convert a flushed trace file to the JSON format of the Chrome trace viewer.
+/**
+ * Start and end tracepoints (`callback_start` and `callback_end`, `rcl_wait_start` and
+ * `rcl_wait_end`, etc.) are converted to duration events, the others to instant events.
+ *
+ * \param[in] input_path path of a file written by tracetools_recorder_flush()
+ * \param[in] output_path path of the JSON file to write, overwritten if it exists
+ * \return `true` if the conversion succeeded, `false` otherwise
+ */
+TRACETOOLS_PUBLIC bool tracetools_convert_to_chrome_trace(
+  const char * input_path,
+  const char * output_path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TRACETOOLS__RECORDER_H_
@@ -0,0 +1,233 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "tracetools/recorder.h"
+
+#include "./recorder.hpp"
+
+namespace
+{
+
+using tracetools::recorder::ArgType;
+using tracetools::recorder::EventDescriptor;
+
+/// Reads the fields of a trace file, failing on truncated data.
+class Reader
+{
+public:
+  explicit Reader(const std::vector<char> & data)
+  : data_(data)
+  {}
+
+  template<typename T>
+  bool read(T & value)
+  {
+    if (data_.size() - position_ < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + position_, sizeof(value));
+    position_ += sizeof(value);
+    return true;
+  }
+
+  bool read_bytes(size_t size, const char * & bytes)
+  {
+    if (data_.size() - position_ < size) {
+      return false;
+    }
+    bytes = data_.data() + position_;
+    position_ += size;
+    return true;
+  }
+
+  bool at_end() const
+  {
+    return position_ == data_.size();
+  }
+
+private:
+  const std::vector<char> & data_;
+  size_t position_ = 0;
+};
+
+void
+append_json_string(std::string & out, const char * string, size_t length)
+{
+  out += '"';
+  for (size_t i = 0; i < length; ++i) {
+    const unsigned char c = static_cast<unsigned char>(string[i]);
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out += escaped;
+        } else {
+          out += static_cast<char>(c);
+        }
+    }
+  }
+  out += '"';
+}
+
+/// Append the arguments of an event as a JSON object, reading them from its payload.
+bool
+append_args(std::string & out, const EventDescriptor & descriptor, Reader & payload)
+{
+  char buffer[32];
+  out += '{';
+  for (uint8_t i = 0; i < descriptor.arg_count; ++i) {
+    if (i > 0) {
+      out += ',';
+    }
+    append_json_string(out, descriptor.arg_names[i], std::strlen(descriptor.arg_names[i]));
+    out += ':';
+
+    if (descriptor.arg_types[i] == ArgType::STRING) {
+      uint16_t length;
+      const char * string;
+      if (!payload.read(length) || !payload.read_bytes(length, string)) {
+        return false;
+      }
+      append_json_string(out, string, length);
+      continue;
+    }
+
+    uint64_t value;
+    if (!payload.read(value)) {
+      return false;
+    }
+    switch (descriptor.arg_types[i]) {
+      case ArgType::POINTER:
+        std::snprintf(buffer, sizeof(buffer), "\"0x%" PRIx64 "\"", value);
+        break;
+      case ArgType::INT:
+        std::snprintf(buffer, sizeof(buffer), "%" PRId64, static_cast<int64_t>(value));
+        break;
+      case ArgType::UINT:
+        std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+        break;
+      case ArgType::BOOL:
+        std::snprintf(buffer, sizeof(buffer), "%s", value ? "true" : "false");
+        break;
+      case ArgType::STRING:
+        break;
+    }
+    out += buffer;
+  }
+  out += '}';
+  return true;
+}
+
+}  // namespace
+
+bool
+tracetools_convert_to_chrome_trace(const char * input_path, const char * output_path)
+{
+  using tracetools::recorder::kFileMagic;
+  using tracetools::recorder::kFileVersion;
+
+  if (!input_path || !output_path) {
+    return false;
+  }
+  std::ifstream input(input_path, std::ios::binary);
+  if (!input) {
+    return false;
+  }
+  const std::vector<char> data(
+    (std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+  Reader reader(data);
+  const char * magic;
+  uint32_t version;
+  uint32_t pid;
+  if (!reader.read_bytes(sizeof(kFileMagic), magic) ||
+    std::memcmp(magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+    !reader.read(version) || version != kFileVersion || !reader.read(pid))
+  {
+    return false;
+  }
+
+  std::string out = "{\"traceEvents\":[";
+  bool first = true;
+  char buffer[96];
+  while (!reader.at_end()) {
+    uint64_t timestamp;
+    uint32_t thread;
+    uint16_t id;
+    uint16_t payload_size;
+    const char * payload_data;
+    if (!reader.read(timestamp) || !reader.read(thread) || !reader.read(id) ||
+      !reader.read(payload_size) || !reader.read_bytes(payload_size, payload_data))
+    {
+      return false;
+    }
+    const EventDescriptor * descriptor = tracetools::recorder::get_event_descriptor(id);
+    if (!descriptor) {
+      // Skip events this version does not know about
+      continue;
+    }
+
+    if (!first) {
+      out += ",\n";
+    }
+    first = false;
+    out += "{\"name\":";
+    append_json_string(out, descriptor->display_name, std::strlen(descriptor->display_name));
+    std::snprintf(
+      buffer, sizeof(buffer), ",\"cat\":\"ros\",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03u",
+      descriptor->phase, timestamp / 1000, static_cast<unsigned>(timestamp % 1000));
+    out += buffer;
+    std::snprintf(buffer, sizeof(buffer), ",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32, pid, thread);
+    out += buffer;
+    if (descriptor->phase == 'i') {
+      out += ",\"s\":\"t\"";
+    }
+    out += ",\"args\":";
+    const std::vector<char> payload_bytes(payload_data, payload_data + payload_size);
+    Reader payload(payload_bytes);
+    if (!append_args(out, *descriptor, payload)) {
+      return false;
+    }
+    out += '}';
+  }
+  out += "]}\n";
+
+  FILE * file = std::fopen(output_path, "w");
+  if (!file) {
+    return false;
+  }
+  const bool written = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+  return std::fclose(file) == 0 && written;
+}
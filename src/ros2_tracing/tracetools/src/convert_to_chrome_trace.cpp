@@ -0,0 +1,30 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include "tracetools/recorder.h"
+
+int main(int argc, char ** argv)
+{
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <trace file> <output JSON file>\n", argv[0]);
+    return 1;
+  }
+  if (!tracetools_convert_to_chrome_trace(argv[1], argv[2])) {
+    std::fprintf(stderr, "failed to convert '%s' to '%s'\n", argv[1], argv[2]);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,371 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tracetools/recorder.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "./recorder.hpp"
+
+namespace tracetools
+{
+namespace recorder
+{
+
+namespace
+{
+
+using P = ArgType;
+
+const EventDescriptor kEventDescriptors[] = {
+  {"rcl_init", 'i', "rcl_init", 1, {P::POINTER}, {"context_handle"}},
+  {"rcl_node_init", 'i', "rcl_node_init", 4,
+    {P::POINTER, P::POINTER, P::STRING, P::STRING},
+    {"node_handle", "rmw_handle", "node_name", "namespace"}},
+  {"rcl_publisher_init", 'i', "rcl_publisher_init", 5,
+    {P::POINTER, P::POINTER, P::POINTER, P::STRING, P::UINT},
+    {"publisher_handle", "node_handle", "rmw_publisher_handle", "topic_name", "queue_depth"}},
+  {"rcl_subscription_init", 'i', "rcl_subscription_init", 6,
+    {P::POINTER, P::POINTER, P::POINTER, P::STRING, P::UINT, P::STRING},
+    {"subscription_handle", "node_handle", "rmw_subscription_handle", "topic_name",
+      "queue_depth", "topic_key"}},
+  {"rclcpp_subscription_init", 'i', "rclcpp_subscription_init", 2,
+    {P::POINTER, P::POINTER}, {"subscription_handle", "subscription"}},
+  {"rclcpp_subscription_callback_added", 'i', "rclcpp_subscription_callback_added", 2,
+    {P::POINTER, P::POINTER}, {"subscription", "callback"}},
+  {"rcl_service_init", 'i', "rcl_service_init", 4,
+    {P::POINTER, P::POINTER, P::POINTER, P::STRING},
+    {"service_handle", "node_handle", "rmw_service_handle", "service_name"}},
+  {"rclcpp_service_callback_added", 'i', "rclcpp_service_callback_added", 2,
+    {P::POINTER, P::POINTER}, {"service_handle", "callback"}},
+  {"rcl_client_init", 'i', "rcl_client_init", 4,
+    {P::POINTER, P::POINTER, P::POINTER, P::STRING},
+    {"client_handle", "node_handle", "rmw_client_handle", "service_name"}},
+  {"rcl_timer_init", 'i', "rcl_timer_init", 2,
+    {P::POINTER, P::INT}, {"timer_handle", "period"}},
+  {"rclcpp_timer_callback_added", 'i', "rclcpp_timer_callback_added", 2,
+    {P::POINTER, P::POINTER}, {"timer_handle", "callback"}},
+  {"rclcpp_callback_register", 'i', "rclcpp_callback_register", 2,
+    {P::POINTER, P::STRING}, {"callback", "symbol"}},
+  {"callback_start", 'B', "callback", 2,
+    {P::POINTER, P::BOOL}, {"callback", "is_intra_process"}},
+  {"callback_end", 'E', "callback", 1, {P::POINTER}, {"callback"}},
+  {"rclcpp_executor_execute_start", 'B', "execute", 1, {P::POINTER}, {"handle"}},
+  {"rclcpp_executor_execute_end", 'E', "execute", 1, {P::POINTER}, {"handle"}},
+  {"rcl_wait_start", 'B', "rcl_wait", 2,
+    {P::POINTER, P::INT}, {"wait_set_handle", "timeout"}},
+  {"rcl_wait_end", 'E', "rcl_wait", 2, {P::POINTER, P::INT}, {"wait_set_handle", "ret"}},
+  {"rcl_publish", 'i', "rcl_publish", 2,
+    {P::POINTER, P::POINTER}, {"publisher_handle", "message"}},
+  {"rcl_take", 'i', "rcl_take", 2,
+    {P::POINTER, P::POINTER}, {"subscription_handle", "message"}},
+  {"rmw_publish", 'i', "rmw_publish", 2,
+    {P::POINTER, P::POINTER}, {"rmw_publisher_handle", "message"}},
+  {"rclcpp_intra_publish_start", 'B', "intra_process_publish", 2,
+    {P::UINT, P::POINTER}, {"intra_process_publisher_id", "message"}},
+  {"rclcpp_intra_publish_end", 'E', "intra_process_publish", 1,
+    {P::UINT}, {"intra_process_publisher_id"}},
+};
+
+static_assert(
+  sizeof(kEventDescriptors) / sizeof(kEventDescriptors[0]) == EVENT_COUNT,
+  "every event needs a descriptor");
+
+constexpr size_t kDefaultBufferSize = 16384;
+
+/// Runtime event, as stored in a ring buffer.
+struct Event
+{
+  uint64_t timestamp;
+  uint64_t args[kMaxRingArgs];
+  uint32_t thread;
+  uint16_t id;
+  uint16_t arg_count;
+};
+
+/// Single producer ring buffer of a thread, keeping its most recent events.
+struct ThreadBuffer
+{
+  // Number of events ever written, the next one goes to events[head & mask]
+  std::atomic<uint64_t> head{0};
+  // Number of events whose writing started, head + 1 while an event is being written
+  std::atomic<uint64_t> reserved{0};
+  uint64_t mask;
+  uint32_t thread;
+  std::unique_ptr<Event[]> events;
+  // Next buffer in the list of all buffers
+  ThreadBuffer * next;
+};
+
+// Buffers are never freed, so that the events of threads that exited can still be flushed and
+// threads that are still running at exit can't write into freed memory.
+std::atomic<ThreadBuffer *> g_buffers{nullptr};
+std::atomic<uint32_t> g_thread_count{0};
+thread_local ThreadBuffer * t_buffer = nullptr;
+
+std::mutex g_init_events_mutex;
+// Initialisation events, already in the file record format
+std::vector<uint8_t> g_init_events;
+
+uint64_t
+now()
+{
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t
+get_thread_index()
+{
+  static thread_local uint32_t thread = g_thread_count.fetch_add(1, std::memory_order_relaxed);
+  return thread;
+}
+
+size_t
+get_buffer_size()
+{
+  size_t size = kDefaultBufferSize;
+  const char * env = std::getenv("ROS_TRACE_BUFFER_SIZE");
+  if (env && *env) {
+    size_t requested = std::strtoull(env, nullptr, 10);
+    if (requested > 0) {
+      size = requested;
+    }
+  }
+  // Round up to a power of two, so that indices wrap with a mask
+  size_t power = 1;
+  while (power < size) {
+    power <<= 1;
+  }
+  return power;
+}
+
+ThreadBuffer *
+create_thread_buffer()
+{
+  static const size_t buffer_size = get_buffer_size();
+
+  auto buffer = new ThreadBuffer();
+  buffer->mask = buffer_size - 1;
+  buffer->thread = get_thread_index();
+  buffer->events.reset(new Event[buffer_size]);
+  buffer->next = g_buffers.load(std::memory_order_relaxed);
+  while (!g_buffers.compare_exchange_weak(
+    buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+  return buffer;
+}
+
+template<typename T>
+void
+append(std::vector<uint8_t> & data, T value)
+{
+  const auto bytes = reinterpret_cast<const uint8_t *>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+void
+append_record_header(
+  std::vector<uint8_t> & data, uint64_t timestamp, uint32_t thread, uint16_t id,
+  uint16_t payload_size)
+{
+  append(data, timestamp);
+  append(data, thread);
+  append(data, id);
+  append(data, payload_size);
+}
+
+/// Copy the events of a ring buffer that are not overwritten while copying.
+std::vector<Event>
+snapshot(const ThreadBuffer & buffer)
+{
+  const uint64_t capacity = buffer.mask + 1;
+  const uint64_t head = buffer.head.load(std::memory_order_acquire);
+  const uint64_t first = head > capacity ? head - capacity : 0;
+
+  std::vector<Event> events;
+  events.reserve(static_cast<size_t>(head - first));
+  for (uint64_t index = first; index < head; ++index) {
+    events.push_back(buffer.events[index & buffer.mask]);
+  }
+
+  // Seqlock-like validation: the writer may have overwritten the oldest copied events in the
+  // meantime, including the one it is writing right now.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t reserved = buffer.reserved.load(std::memory_order_relaxed);
+  if (reserved > first + capacity) {
+    const uint64_t overwritten = std::min<uint64_t>(reserved - (first + capacity), head - first);
+    events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(overwritten));
+  }
+  return events;
+}
+
+void
+flush_at_exit()
+{
+  const char * path = std::getenv("ROS_TRACE_FILE");
+  if (path && *path && !tracetools_recorder_flush(path)) {
+    std::fprintf(stderr, "tracetools: failed to write trace file '%s'\n", path);
+  }
+}
+
+/// Start recording at load time if a trace file is requested.
+struct AutoStart
+{
+  AutoStart()
+  {
+    const char * path = std::getenv("ROS_TRACE_FILE");
+    if (path && *path) {
+      tracetools_recorder_start();
+      std::atexit(flush_at_exit);
+    }
+  }
+};
+
+AutoStart g_auto_start;
+
+}  // namespace
+
+std::atomic<bool> g_started{false};
+
+const EventDescriptor *
+get_event_descriptor(uint16_t id)
+{
+  return id < EVENT_COUNT ? &kEventDescriptors[id] : nullptr;
+}
+
+void
+record(EventId id, uint64_t arg0, uint64_t arg1)
+{
+  ThreadBuffer * buffer = t_buffer;
+  if (!buffer) {
+    buffer = t_buffer = create_thread_buffer();
+  }
+
+  const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  buffer->reserved.store(head + 1, std::memory_order_relaxed);
+  // Make the reservation visible before overwriting the oldest event, see snapshot()
+  std::atomic_thread_fence(std::memory_order_release);
+  Event & event = buffer->events[head & buffer->mask];
+  event.timestamp = now();
+  event.args[0] = arg0;
+  event.args[1] = arg1;
+  event.thread = buffer->thread;
+  event.id = id;
+  event.arg_count = kEventDescriptors[id].arg_count;
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void
+record_init(EventId id, const Arg * args)
+{
+  const EventDescriptor & descriptor = kEventDescriptors[id];
+  std::vector<uint8_t> payload;
+  for (uint8_t i = 0; i < descriptor.arg_count; ++i) {
+    if (descriptor.arg_types[i] == ArgType::STRING) {
+      const char * string = args[i].string ? args[i].string : "";
+      const uint16_t length = static_cast<uint16_t>(std::min<size_t>(strlen(string), UINT16_MAX));
+      append(payload, length);
+      payload.insert(payload.end(), string, string + length);
+    } else {
+      append(payload, args[i].value);
+    }
+  }
+
+  const uint64_t timestamp = now();
+  std::lock_guard<std::mutex> lock(g_init_events_mutex);
+  append_record_header(
+    g_init_events, timestamp, get_thread_index(), id, static_cast<uint16_t>(payload.size()));
+  g_init_events.insert(g_init_events.end(), payload.begin(), payload.end());
+}
+
+}  // namespace recorder
+}  // namespace tracetools
+
+using tracetools::recorder::g_started;
+
+void
+tracetools_recorder_start(void)
+{
+  g_started.store(true, std::memory_order_relaxed);
+}
+
+void
+tracetools_recorder_stop(void)
+{
+  g_started.store(false, std::memory_order_relaxed);
+}
+
+bool
+tracetools_recorder_is_started(void)
+{
+  return g_started.load(std::memory_order_relaxed);
+}
+
+bool
+tracetools_recorder_flush(const char * path)
+{
+  using tracetools::recorder::append;
+  using tracetools::recorder::append_record_header;
+
+  if (!path) {
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  data.insert(
+    data.end(), tracetools::recorder::kFileMagic,
+    tracetools::recorder::kFileMagic + sizeof(tracetools::recorder::kFileMagic));
+  append(data, tracetools::recorder::kFileVersion);
+  append(data, static_cast<uint32_t>(getpid()));
+  {
+    std::lock_guard<std::mutex> lock(tracetools::recorder::g_init_events_mutex);
+    data.insert(
+      data.end(), tracetools::recorder::g_init_events.begin(),
+      tracetools::recorder::g_init_events.end());
+  }
+
+  for (auto buffer = tracetools::recorder::g_buffers.load(std::memory_order_acquire);
+    buffer != nullptr; buffer = buffer->next)
+  {
+    for (const auto & event : tracetools::recorder::snapshot(*buffer)) {
+      append_record_header(
+        data, event.timestamp, event.thread, event.id,
+        static_cast<uint16_t>(event.arg_count * sizeof(uint64_t)));
+      for (uint16_t i = 0; i < event.arg_count; ++i) {
+        append(data, event.args[i]);
+      }
+    }
+  }
+
+  FILE * file = std::fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  return std::fclose(file) == 0 && written;
+}
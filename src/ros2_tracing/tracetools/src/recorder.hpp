@@ -0,0 +1,129 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RECORDER_HPP_
+#define RECORDER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tracetools
+{
+namespace recorder
+{
+
+/// Magic string at the start of trace files.
+constexpr char kFileMagic[8] = {'R', 'O', 'S', 'T', 'R', 'A', 'C', 'E'};
+/// Version of the trace file format, to bump whenever events or their arguments change.
+constexpr uint32_t kFileVersion = 1;
+
+/// Maximum number of arguments of a tracepoint.
+constexpr size_t kMaxArgs = 6;
+/// Maximum number of arguments of a tracepoint recorded into the ring buffers.
+constexpr size_t kMaxRingArgs = 2;
+
+enum EventId : uint16_t
+{
+  // Initialisation events, always recorded
+  RCL_INIT,
+  RCL_NODE_INIT,
+  RCL_PUBLISHER_INIT,
+  RCL_SUBSCRIPTION_INIT,
+  RCLCPP_SUBSCRIPTION_INIT,
+  RCLCPP_SUBSCRIPTION_CALLBACK_ADDED,
+  RCL_SERVICE_INIT,
+  RCLCPP_SERVICE_CALLBACK_ADDED,
+  RCL_CLIENT_INIT,
+  RCL_TIMER_INIT,
+  RCLCPP_TIMER_CALLBACK_ADDED,
+  RCLCPP_CALLBACK_REGISTER,
+  // Runtime events, recorded into the ring buffers while the recorder is started
+  CALLBACK_START,
+  CALLBACK_END,
+  RCLCPP_EXECUTOR_EXECUTE_START,
+  RCLCPP_EXECUTOR_EXECUTE_END,
+  RCL_WAIT_START,
+  RCL_WAIT_END,
+  RCL_PUBLISH,
+  RCL_TAKE,
+  RMW_PUBLISH,
+  RCLCPP_INTRA_PUBLISH_START,
+  RCLCPP_INTRA_PUBLISH_END,
+  EVENT_COUNT
+};
+
+enum class ArgType : uint8_t
+{
+  POINTER,
+  INT,
+  UINT,
+  BOOL,
+  STRING
+};
+
+struct EventDescriptor
+{
+  // Tracepoint name
+  const char * name;
+  // Chrome trace phase: 'B' for the start of a duration, 'E' for its end, 'i' for an instant
+  char phase;
+  // Name of the duration for 'B' and 'E' events, tracepoint name otherwise
+  const char * display_name;
+  uint8_t arg_count;
+  ArgType arg_types[kMaxArgs];
+  const char * arg_names[kMaxArgs];
+};
+
+/// Get the description of an event, or nullptr if the id is unknown.
+const EventDescriptor *
+get_event_descriptor(uint16_t id);
+
+/// Argument of an initialisation event.
+struct Arg
+{
+  uint64_t value;
+  const char * string;
+};
+
+extern std::atomic<bool> g_started;
+
+/// Whether runtime events should be recorded.
+inline bool
+is_started()
+{
+  return g_started.load(std::memory_order_relaxed);
+}
+
+/// Record a runtime event into the ring buffer of the calling thread.
+void
+record(EventId id, uint64_t arg0, uint64_t arg1);
+
+/// Record an initialisation event.
+/**
+ * \param[in] args arguments of the event, as many as its descriptor lists
+ */
+void
+record_init(EventId id, const Arg * args);
+
+inline uint64_t
+to_arg(const void * pointer)
+{
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+}
+
+}  // namespace recorder
+}  // namespace tracetools
+
+#endif  // RECORDER_HPP_
@@ -0,0 +1,282 @@
+// Copyright 2019 Robert Bosch GmbH
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tracetools/tracetools.h"
+
+#ifndef TRACETOOLS_DISABLED
+#include "./recorder.hpp"
+
+using tracetools::recorder::Arg;
+using tracetools::recorder::is_started;
+using tracetools::recorder::record;
+using tracetools::recorder::record_init;
+using tracetools::recorder::to_arg;
+namespace events = tracetools::recorder;
+
+// Initialisation events are rare, so they are always recorded, in order to be able to make sense
+// of the runtime events whenever recording starts.
+#define RECORD_INIT(event_id, ...) \
+  do { \
+    const Arg args[] = {__VA_ARGS__}; \
+    record_init(event_id, args); \
+  } while (0)
+
+// Runtime events cost a relaxed load and a predictable branch while the recorder is stopped.
+#define RECORD(event_id, arg0, arg1) \
+  do { \
+    if (is_started()) { \
+      record(event_id, arg0, arg1); \
+    } \
+  } while (0)
+
+static Arg
+pointer_arg(const void * pointer)
+{
+  return Arg{to_arg(pointer), nullptr};
+}
+
+static Arg
+string_arg(const char * string)
+{
+  return Arg{0, string};
+}
+
+static Arg
+int_arg(uint64_t value)
+{
+  return Arg{value, nullptr};
+}
+#endif  // TRACETOOLS_DISABLED
+
+bool ros_trace_compile_status()
+{
+#ifndef TRACETOOLS_DISABLED
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifndef TRACETOOLS_DISABLED
+void TRACEPOINT(
+  rcl_init,
+  const void * context_handle)
+{
+  RECORD_INIT(events::RCL_INIT, pointer_arg(context_handle));
+}
+
+void TRACEPOINT(
+  rcl_node_init,
+  const void * node_handle,
+  const void * rmw_handle,
+  const char * node_name,
+  const char * node_namespace)
+{
+  RECORD_INIT(
+    events::RCL_NODE_INIT, pointer_arg(node_handle), pointer_arg(rmw_handle),
+    string_arg(node_name), string_arg(node_namespace));
+}
+
+void TRACEPOINT(
+  rcl_publisher_init,
+  const void * publisher_handle,
+  const void * node_handle,
+  const void * rmw_publisher_handle,
+  const char * topic_name,
+  const size_t queue_depth)
+{
+  RECORD_INIT(
+    events::RCL_PUBLISHER_INIT, pointer_arg(publisher_handle), pointer_arg(node_handle),
+    pointer_arg(rmw_publisher_handle), string_arg(topic_name), int_arg(queue_depth));
+}
+
+void TRACEPOINT(
+  rcl_subscription_init,
+  const void * subscription_handle,
+  const void * node_handle,
+  const void * rmw_subscription_handle,
+  const char * topic_name,
+  const size_t queue_depth,
+  const char * topic_key)
+{
+  RECORD_INIT(
+    events::RCL_SUBSCRIPTION_INIT, pointer_arg(subscription_handle), pointer_arg(node_handle),
+    pointer_arg(rmw_subscription_handle), string_arg(topic_name), int_arg(queue_depth),
+    string_arg(topic_key));
+}
+
+void TRACEPOINT(
+  rclcpp_subscription_init,
+  const void * subscription_handle,
+  const void * subscription)
+{
+  RECORD_INIT(
+    events::RCLCPP_SUBSCRIPTION_INIT, pointer_arg(subscription_handle),
+    pointer_arg(subscription));
+}
+
+void TRACEPOINT(
+  rclcpp_subscription_callback_added,
+  const void * subscription,
+  const void * callback)
+{
+  RECORD_INIT(
+    events::RCLCPP_SUBSCRIPTION_CALLBACK_ADDED, pointer_arg(subscription),
+    pointer_arg(callback));
+}
+
+void TRACEPOINT(
+  rcl_service_init,
+  const void * service_handle,
+  const void * node_handle,
+  const void * rmw_service_handle,
+  const char * service_name)
+{
+  RECORD_INIT(
+    events::RCL_SERVICE_INIT, pointer_arg(service_handle), pointer_arg(node_handle),
+    pointer_arg(rmw_service_handle), string_arg(service_name));
+}
+
+void TRACEPOINT(
+  rclcpp_service_callback_added,
+  const void * service_handle,
+  const void * callback)
+{
+  RECORD_INIT(
+    events::RCLCPP_SERVICE_CALLBACK_ADDED, pointer_arg(service_handle), pointer_arg(callback));
+}
+
+void TRACEPOINT(
+  rcl_client_init,
+  const void * client_handle,
+  const void * node_handle,
+  const void * rmw_client_handle,
+  const char * service_name)
+{
+  RECORD_INIT(
+    events::RCL_CLIENT_INIT, pointer_arg(client_handle), pointer_arg(node_handle),
+    pointer_arg(rmw_client_handle), string_arg(service_name));
+}
+
+void TRACEPOINT(
+  rcl_timer_init,
+  const void * timer_handle,
+  int64_t period)
+{
+  RECORD_INIT(
+    events::RCL_TIMER_INIT, pointer_arg(timer_handle), int_arg(static_cast<uint64_t>(period)));
+}
+
+void TRACEPOINT(
+  rclcpp_timer_callback_added,
+  const void * timer_handle,
+  const void * callback)
+{
+  RECORD_INIT(
+    events::RCLCPP_TIMER_CALLBACK_ADDED, pointer_arg(timer_handle), pointer_arg(callback));
+}
+
+void TRACEPOINT(
+  rclcpp_callback_register,
+  const void * callback,
+  const char * function_symbol)
+{
+  RECORD_INIT(
+    events::RCLCPP_CALLBACK_REGISTER, pointer_arg(callback), string_arg(function_symbol));
+}
+
+void TRACEPOINT(
+  callback_start,
+  const void * callback,
+  const bool is_intra_process)
+{
+  RECORD(events::CALLBACK_START, to_arg(callback), is_intra_process ? 1u : 0u);
+}
+
+void TRACEPOINT(
+  callback_end,
+  const void * callback)
+{
+  RECORD(events::CALLBACK_END, to_arg(callback), 0u);
+}
+
+void TRACEPOINT(
+  rclcpp_executor_execute_start,
+  const void * handle)
+{
+  RECORD(events::RCLCPP_EXECUTOR_EXECUTE_START, to_arg(handle), 0u);
+}
+
+void TRACEPOINT(
+  rclcpp_executor_execute_end,
+  const void * handle)
+{
+  RECORD(events::RCLCPP_EXECUTOR_EXECUTE_END, to_arg(handle), 0u);
+}
+
+void TRACEPOINT(
+  rcl_wait_start,
+  const void * wait_set_handle,
+  int64_t timeout)
+{
+  RECORD(events::RCL_WAIT_START, to_arg(wait_set_handle), static_cast<uint64_t>(timeout));
+}
+
+void TRACEPOINT(
+  rcl_wait_end,
+  const void * wait_set_handle,
+  int64_t ret)
+{
+  RECORD(events::RCL_WAIT_END, to_arg(wait_set_handle), static_cast<uint64_t>(ret));
+}
+
+void TRACEPOINT(
+  rcl_publish,
+  const void * publisher_handle,
+  const void * message)
+{
+  RECORD(events::RCL_PUBLISH, to_arg(publisher_handle), to_arg(message));
+}
+
+void TRACEPOINT(
+  rcl_take,
+  const void * subscription_handle,
+  const void * message)
+{
+  RECORD(events::RCL_TAKE, to_arg(subscription_handle), to_arg(message));
+}
+
+void TRACEPOINT(
+  rmw_publish,
+  const void * rmw_publisher_handle,
+  const void * message)
+{
+  RECORD(events::RMW_PUBLISH, to_arg(rmw_publisher_handle), to_arg(message));
+}
+
+void TRACEPOINT(
+  rclcpp_intra_publish_start,
+  uint64_t intra_process_publisher_id,
+  const void * message)
+{
+  RECORD(events::RCLCPP_INTRA_PUBLISH_START, intra_process_publisher_id, to_arg(message));
+}
+
+void TRACEPOINT(
+  rclcpp_intra_publish_end,
+  uint64_t intra_process_publisher_id)
+{
+  RECORD(events::RCLCPP_INTRA_PUBLISH_END, intra_process_publisher_id, 0u);
+}
+#endif  // TRACETOOLS_DISABLED
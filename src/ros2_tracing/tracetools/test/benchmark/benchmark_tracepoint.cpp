@@ -0,0 +1,50 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "tracetools/recorder.h"
+#include "tracetools/tracetools.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+const void * const kPublisher = reinterpret_cast<const void *>(0x1000);
+const void * const kMessage = reinterpret_cast<const void *>(0x2000);
+}  // namespace
+
+BENCHMARK_F(PerformanceTest, tracepoint_stopped)(benchmark::State & st)
+{
+  tracetools_recorder_stop();
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    TRACEPOINT(rcl_publish, kPublisher, kMessage);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, tracepoint_started)(benchmark::State & st)
+{
+  tracetools_recorder_start();
+  // Create the ring buffer of this thread outside of the measurement
+  TRACEPOINT(rcl_publish, kPublisher, kMessage);
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    TRACEPOINT(rcl_publish, kPublisher, kMessage);
+  }
+
+  tracetools_recorder_stop();
+}
@@ -0,0 +1,163 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "tracetools/recorder.h"
+#include "tracetools/tracetools.h"
+
+namespace
+{
+
+std::string read_file(const char * path)
+{
+  std::ifstream file(path);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+size_t count(const std::string & string, const std::string & pattern)
+{
+  size_t occurrences = 0;
+  for (size_t position = string.find(pattern); position != std::string::npos;
+    position = string.find(pattern, position + pattern.size()))
+  {
+    ++occurrences;
+  }
+  return occurrences;
+}
+
+/// Flush the recorded events, convert them and return the JSON.
+std::string flush_and_convert()
+{
+  const char * trace_path = "test_recorder.rostrace";
+  const char * json_path = "test_recorder.json";
+  EXPECT_TRUE(tracetools_recorder_flush(trace_path));
+  EXPECT_TRUE(tracetools_convert_to_chrome_trace(trace_path, json_path));
+  std::string json = read_file(json_path);
+  std::remove(trace_path);
+  std::remove(json_path);
+  return json;
+}
+
+}  // namespace
+
+class TestRecorder : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    tracetools_recorder_stop();
+  }
+};
+
+TEST_F(TestRecorder, start_stop) {
+  EXPECT_TRUE(ros_trace_compile_status());
+  tracetools_recorder_start();
+  EXPECT_TRUE(tracetools_recorder_is_started());
+  tracetools_recorder_stop();
+  EXPECT_FALSE(tracetools_recorder_is_started());
+}
+
+TEST_F(TestRecorder, runtime_events_only_recorded_while_started) {
+  const void * publisher = reinterpret_cast<const void *>(0xabc001);
+  const void * message = reinterpret_cast<const void *>(0xabc002);
+
+  std::thread(
+    [&]() {
+      TRACEPOINT(rcl_publish, publisher, message);
+      tracetools_recorder_start();
+      TRACEPOINT(rcl_take, publisher, message);
+      tracetools_recorder_stop();
+      TRACEPOINT(rmw_publish, publisher, message);
+    }).join();
+
+  std::string json = flush_and_convert();
+  EXPECT_EQ(0u, count(json, "{\"publisher_handle\":\"0xabc001\""));
+  EXPECT_EQ(0u, count(json, "{\"rmw_publisher_handle\":\"0xabc001\""));
+  EXPECT_EQ(
+    1u, count(
+      json, "\"args\":{\"subscription_handle\":\"0xabc001\",\"message\":\"0xabc002\"}"));
+}
+
+TEST_F(TestRecorder, initialisation_events_always_recorded) {
+  const void * node = reinterpret_cast<const void *>(0xdef001);
+  const void * rmw_node = reinterpret_cast<const void *>(0xdef002);
+  TRACEPOINT(rcl_node_init, node, rmw_node, "my_\"node\"", "/ns");
+  TRACEPOINT(rcl_timer_init, node, -5);
+
+  std::string json = flush_and_convert();
+  EXPECT_EQ(
+    1u, count(
+      json,
+      "{\"node_handle\":\"0xdef001\",\"rmw_handle\":\"0xdef002\","
+      "\"node_name\":\"my_\\\"node\\\"\",\"namespace\":\"/ns\"}"));
+  EXPECT_EQ(1u, count(json, "{\"timer_handle\":\"0xdef001\",\"period\":-5}"));
+}
+
+TEST_F(TestRecorder, durations) {
+  const void * callback = reinterpret_cast<const void *>(0x123001);
+
+  tracetools_recorder_start();
+  std::thread(
+    [&]() {
+      TRACEPOINT(callback_start, callback, true);
+      TRACEPOINT(callback_end, callback);
+    }).join();
+  tracetools_recorder_stop();
+
+  std::string json = flush_and_convert();
+  EXPECT_EQ(1u, count(json, "\"name\":\"callback\",\"cat\":\"ros\",\"ph\":\"B\""));
+  EXPECT_EQ(
+    1u, count(json, "\"args\":{\"callback\":\"0x123001\",\"is_intra_process\":true}"));
+  EXPECT_EQ(1u, count(json, "\"name\":\"callback\",\"cat\":\"ros\",\"ph\":\"E\""));
+  EXPECT_EQ(1u, count(json, "\"args\":{\"callback\":\"0x123001\"}"));
+}
+
+TEST_F(TestRecorder, ring_buffer_keeps_most_recent_events) {
+  // ROS_TRACE_BUFFER_SIZE is set to 64 for this test
+  const void * publisher = reinterpret_cast<const void *>(0x456001);
+
+  tracetools_recorder_start();
+  std::thread(
+    [&]() {
+      for (uintptr_t i = 0; i < 1000; ++i) {
+        TRACEPOINT(rcl_publish, publisher, reinterpret_cast<const void *>(i));
+      }
+    }).join();
+  tracetools_recorder_stop();
+
+  std::string json = flush_and_convert();
+  EXPECT_EQ(64u, count(json, "{\"publisher_handle\":\"0x456001\""));
+  EXPECT_EQ(0u, count(json, "{\"publisher_handle\":\"0x456001\",\"message\":\"0x3a7\"}"));
+  EXPECT_EQ(1u, count(json, "{\"publisher_handle\":\"0x456001\",\"message\":\"0x3a8\"}"));
+  EXPECT_EQ(1u, count(json, "{\"publisher_handle\":\"0x456001\",\"message\":\"0x3e7\"}"));
+}
+
+TEST_F(TestRecorder, convert_invalid_file) {
+  const char * path = "test_recorder_invalid.rostrace";
+  {
+    std::ofstream file(path);
+    file << "not a trace";
+  }
+  EXPECT_FALSE(tracetools_convert_to_chrome_trace(path, "test_recorder_invalid.json"));
+  EXPECT_FALSE(tracetools_convert_to_chrome_trace("does_not_exist", "test_recorder.json"));
+  std::remove(path);
+}